@@ -0,0 +1,72 @@
+// Stress the CFG-based warnings that Sema runs on every function body, with
+// many large functions full of branches, loops, switches and locals. Time it
+// with:
+//   clang -cc1 -std=c++11 -fsyntax-only -ftime-report -print-stats -Wall \
+//     -Wunreachable-code -Wthread-safety -Wimplicit-fallthrough \
+//     analysis-based-warnings.cpp
+// and compare against the same command without the warning flags.
+
+#define CAT_(A, B) A##B
+#define CAT(A, B) CAT_(A, B)
+
+struct __attribute__((lockable)) Mutex {
+  void lock() __attribute__((exclusive_lock_function));
+  void unlock() __attribute__((unlock_function));
+};
+
+struct Guarded {
+  Mutex mu;
+  int value __attribute__((guarded_by(mu)));
+};
+
+int sink(int);
+void fail() __attribute__((noreturn));
+
+#define STEP(N)                                                       \
+  if (x > N) {                                                        \
+    int CAT(t, N);                                                    \
+    if (y & N)                                                        \
+      CAT(t, N) = x - N;                                              \
+    else                                                              \
+      CAT(t, N) = y + N;                                              \
+    sum += sink(CAT(t, N));                                           \
+  }                                                                   \
+  switch ((x + N) & 3) {                                              \
+  case 0:                                                             \
+    sum += N;                                                         \
+    [[clang::fallthrough]];                                           \
+  case 1:                                                             \
+    sum -= y;                                                         \
+    break;                                                            \
+  default:                                                            \
+    for (int i = 0; i < N; ++i)                                       \
+      if (sink(i) == x)                                               \
+        break;                                                        \
+  }                                                                   \
+  G.mu.lock();                                                        \
+  G.value += sum;                                                     \
+  G.mu.unlock();
+
+#define STEP_8(N) STEP(N##0) STEP(N##1) STEP(N##2) STEP(N##3) \
+  STEP(N##4) STEP(N##5) STEP(N##6) STEP(N##7)
+
+#define FUNC(N)                                                       \
+  int CAT(func, N)(Guarded &G, int x, int y) {                        \
+    int sum = 0;                                                      \
+    STEP_8(1) STEP_8(2) STEP_8(3) STEP_8(4)                           \
+    if (sum < 0)                                                      \
+      fail();                                                         \
+    return sum;                                                       \
+  }
+
+#define FUNC_8(N) FUNC(N##0) FUNC(N##1) FUNC(N##2) FUNC(N##3) \
+  FUNC(N##4) FUNC(N##5) FUNC(N##6) FUNC(N##7)
+
+FUNC_8(1)
+FUNC_8(2)
+FUNC_8(3)
+FUNC_8(4)
+FUNC_8(5)
+FUNC_8(6)
+FUNC_8(7)
+FUNC_8(8)
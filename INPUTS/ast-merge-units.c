@@ -0,0 +1,48 @@
+// Stress -ast-merge with many AST files that share the same "header" types,
+// so that most of the merge is spent matching already-imported declarations.
+// Build a set of AST files and time merging them with:
+//   for i in 1 2 3 4 5 6 7 8; do
+//     clang -cc1 -emit-pch -DUNIT=$i -o unit$i.ast ast-merge-units.c
+//   done
+//   clang -cc1 -fsyntax-only -ftime-report -ast-merge-jobs 4 \
+//     -ast-merge unit1.ast ... -ast-merge unit8.ast /dev/null
+// and compare against -ast-merge-jobs 1.
+
+#ifndef UNIT
+#define UNIT 0
+#endif
+
+#define CAT_(A, B) A##B
+#define CAT(A, B) CAT_(A, B)
+
+// Shared types, as if from common headers.
+#define RECORDS(N)                                                     \
+  typedef struct CAT(node, N) {                                        \
+    struct CAT(node, N) *next, *prev;                                  \
+    int key; double weight; char tag[16];                              \
+    union { long l; float f; void *p; } payload;                       \
+  } CAT(node_t, N);                                                    \
+  struct CAT(list, N) { CAT(node_t, N) *head, *tail; unsigned size; }; \
+  enum CAT(kind, N) { CAT(kind_a, N), CAT(kind_b, N), CAT(kind_c, N) };\
+  struct CAT(list, N) *CAT(list_new, N)(enum CAT(kind, N));            \
+  extern struct CAT(list, N) CAT(global_list, N);
+
+#define RECORDS_8(N) RECORDS(N##0) RECORDS(N##1) RECORDS(N##2) \
+  RECORDS(N##3) RECORDS(N##4) RECORDS(N##5) RECORDS(N##6) RECORDS(N##7)
+#define RECORDS_64(N) RECORDS_8(N##0) RECORDS_8(N##1) RECORDS_8(N##2) \
+  RECORDS_8(N##3) RECORDS_8(N##4) RECORDS_8(N##5) RECORDS_8(N##6)     \
+  RECORDS_8(N##7)
+
+RECORDS_64(1)
+RECORDS_64(2)
+RECORDS_64(3)
+RECORDS_64(4)
+
+// Per-unit code that uses the shared types.
+unsigned CAT(unit_sum, UNIT)(struct list100 *L, struct list477 *M) {
+  unsigned Sum = 0;
+  node_t100 *N;
+  for (N = L->head; N; N = N->next)
+    Sum += N->key;
+  return Sum + M->size;
+}
@@ -0,0 +1,40 @@
+// Measure the latency of narrowing down a large set of member completions as
+// the user types. Each keystroke either reruns code completion:
+//   env CINDEXTEST_EDITING=1 c-index-test \
+//     -code-completion-timing=code-completion-filter.cpp:39:5 \
+//     code-completion-filter.cpp
+// or filters the results of the first completion, without reparsing:
+//   env CINDEXTEST_EDITING=1 CINDEXTEST_COMPLETION_FILTER=setwidget \
+//     c-index-test -code-completion-timing=code-completion-filter.cpp:39:5 \
+//     code-completion-filter.cpp
+
+#define CAT_(A, B) A##B
+#define CAT(A, B) CAT_(A, B)
+
+#define MEMBERS(N)                                                    \
+  int CAT(widget_width_, N);                                          \
+  int CAT(widget_height_, N);                                         \
+  void CAT(setWidgetWidth, N)(int);                                   \
+  void CAT(setWidgetHeight, N)(int);                                  \
+  int CAT(getWidgetWidth, N)() const;                                 \
+  int CAT(getWidgetHeight, N)() const;                                \
+  bool CAT(isVisible, N)() const;
+
+#define MEMBERS_8(N) MEMBERS(N##0) MEMBERS(N##1) MEMBERS(N##2) \
+  MEMBERS(N##3) MEMBERS(N##4) MEMBERS(N##5) MEMBERS(N##6) MEMBERS(N##7)
+#define MEMBERS_64(N) MEMBERS_8(N##0) MEMBERS_8(N##1) MEMBERS_8(N##2) \
+  MEMBERS_8(N##3) MEMBERS_8(N##4) MEMBERS_8(N##5) MEMBERS_8(N##6)      \
+  MEMBERS_8(N##7)
+
+struct Base {
+  MEMBERS_64(1)
+};
+
+struct Widget : Base {
+  MEMBERS_64(2)
+  MEMBERS_64(3)
+};
+
+void use(Widget &w) {
+  w.isVisible10();
+}
@@ -0,0 +1,72 @@
+// Stress overload resolution with long operator<< chains over a large
+// overload set, where the same argument and parameter types are converted
+// over and over. Time it with:
+//   clang -cc1 -fsyntax-only -ftime-report -print-stats overload-resolution.cpp
+// The statistics include the hit rate of the implicit conversion cache and the
+// allocations made for overload candidates.
+
+struct String {
+  String(const char *);
+  String(const String &);
+};
+
+struct Stream {
+  Stream &operator<<(bool);
+  Stream &operator<<(short);
+  Stream &operator<<(unsigned short);
+  Stream &operator<<(int);
+  Stream &operator<<(unsigned);
+  Stream &operator<<(long);
+  Stream &operator<<(unsigned long);
+  Stream &operator<<(long long);
+  Stream &operator<<(unsigned long long);
+  Stream &operator<<(float);
+  Stream &operator<<(double);
+  Stream &operator<<(long double);
+  Stream &operator<<(const void *);
+  Stream &operator<<(Stream &(*)(Stream &));
+};
+
+Stream &operator<<(Stream &, char);
+Stream &operator<<(Stream &, signed char);
+Stream &operator<<(Stream &, unsigned char);
+Stream &operator<<(Stream &, const char *);
+Stream &operator<<(Stream &, const signed char *);
+Stream &operator<<(Stream &, const unsigned char *);
+Stream &operator<<(Stream &, const String &);
+Stream &endl(Stream &);
+
+#define CAT_(A, B) A##B
+#define CAT(A, B) CAT_(A, B)
+
+#define TYPES(N)                                                       \
+  struct CAT(Point, N) { int x, y; };                                  \
+  Stream &operator<<(Stream &, const CAT(Point, N) &);                 \
+  struct CAT(Size, N) { double w, h; };                                \
+  Stream &operator<<(Stream &, const CAT(Size, N) &);
+
+#define TYPES_8(N) TYPES(N##0) TYPES(N##1) TYPES(N##2) TYPES(N##3) \
+  TYPES(N##4) TYPES(N##5) TYPES(N##6) TYPES(N##7)
+
+TYPES_8(1)
+TYPES_8(2)
+TYPES_8(3)
+TYPES_8(4)
+
+#define PRINT(N)                                                       \
+  void CAT(print, N)(Stream &OS, const String &Name, int I, double D,  \
+                     const Point10 &P, const Size47 &S) {              \
+    OS << "name: " << Name << ", i = " << I << ", d = " << D           \
+       << ", p = " << P << ", s = " << S << ' ' << I + 1 << ' '        \
+       << D * 2 << ' ' << (void *)0 << ' ' << 42u << endl;             \
+  }
+
+#define PRINT_8(N) PRINT(N##0) PRINT(N##1) PRINT(N##2) PRINT(N##3) \
+  PRINT(N##4) PRINT(N##5) PRINT(N##6) PRINT(N##7)
+#define PRINT_64(N) PRINT_8(N##0) PRINT_8(N##1) PRINT_8(N##2) \
+  PRINT_8(N##3) PRINT_8(N##4) PRINT_8(N##5) PRINT_8(N##6) PRINT_8(N##7)
+
+PRINT_64(1)
+PRINT_64(2)
+PRINT_64(3)
+PRINT_64(4)
@@ -0,0 +1,48 @@
+// Stress the Itanium name mangler with deeply nested template specializations
+// whose mangled names contain many substitution candidates. Time with:
+//   clang -cc1 -std=c++11 -triple x86_64-linux-gnu -emit-llvm -o /dev/null \
+//     -ftime-report template-mangling.cpp
+
+namespace outer { namespace inner {
+
+template <typename T> struct Box { T value; };
+template <typename T, typename U> struct Pair { T first; U second; };
+template <typename... Ts> struct List {};
+
+template <typename T, typename U, typename V>
+Pair<Box<T>, Pair<Box<U>, List<T, U, V, Box<V> > > >
+combine(const Box<T> &, const Pair<U, Box<V> > &, List<T, U, V> *) {
+  return Pair<Box<T>, Pair<Box<U>, List<T, U, V, Box<V> > > >();
+}
+
+template <typename T, typename U>
+struct Holder {
+  template <typename V>
+  static void use() {
+    combine(Box<T>(), Pair<U, Box<V> >(), (List<T, U, V> *)0);
+    combine(Box<Pair<T, U> >(), Pair<Box<U>, Box<List<V> > >(),
+            (List<Pair<T, U>, Box<U>, List<V> > *)0);
+  }
+};
+
+} }
+
+using namespace outer::inner;
+
+typedef Pair<char, long> CharLong;
+typedef List<int, Box<int> > IntList;
+
+#define USE_1(T, U, V) Holder<T, U>::use<V>();
+#define USE_2(T, U, V) USE_1(T, U, V) USE_1(Box<T>, U, V) \
+                       USE_1(T, Box<U>, V) USE_1(T, U, Box<V>)
+#define USE_4(T, U, V) USE_2(T, U, V) USE_2(List<T>, U, V) \
+                       USE_2(T, List<U>, V) USE_2(T, U, List<V>)
+#define USE_8(T, U, V) USE_4(T, U, V) USE_4(Box<Box<T> >, U, V) \
+                       USE_4(T, List<Box<U> >, V) USE_4(T, U, Box<List<V> >)
+
+void mangle_heavy() {
+  USE_8(int, char, double)
+  USE_8(long, short, float)
+  USE_8(unsigned, bool, long double)
+  USE_8(Box<int>, CharLong, IntList)
+}
@@ -0,0 +1,45 @@
+// Stress the disambiguation of declarations and expressions with statements,
+// template arguments and lambdas that have to be parsed tentatively, often
+// more than once over the same tokens. Time it with:
+//   clang -cc1 -std=c++11 -fsyntax-only -ftime-report tentative-parsing.cpp
+
+#define CAT_(A, B) A##B
+#define CAT(A, B) CAT_(A, B)
+
+struct T {
+  T(int);
+  T(T, T);
+  T operator()(T) const;
+};
+
+template<typename A, typename B = int, typename C = int> struct Tmpl {
+  Tmpl(int);
+};
+
+int x, y, z;
+
+// Each statement starts with a function-style cast that could also begin a
+// declaration, so the whole statement is parsed tentatively; its
+// declarators, template arguments and lambda parameters are then
+// disambiguated both inside that tentative parse and when parsed for real.
+#define BODY(N)                                                          \
+  void CAT(f, N)() {                                                     \
+    T CAT(a, N)(T(T(x), T(y)), T(T(T(z), T(x)), T(y)));                  \
+    T CAT(b, N)(T(T(x)), T(T(y))), CAT(c, N)(T(T(z), T(CAT(a, N))));     \
+    T(CAT(d, N))(T(T(x), T(y)));                                         \
+    Tmpl<T(T(T)), int(T(T(int))), T(*)(T(T(T)))> CAT(e, N)(x);           \
+    Tmpl<Tmpl<T(T), Tmpl<int(int)> >, Tmpl<T(T(T(T)))> > CAT(g, N)(y);   \
+    auto CAT(h, N) = [](T(p), T(q)) { return T(T(p), T(q)); };           \
+    CAT(h, N)(T(T(x), T(y)), T(T(y), T(z)));                             \
+    for (T(i)(x); int(j) = y; ) { }                                      \
+  }
+
+#define BODY_8(N) BODY(N##0) BODY(N##1) BODY(N##2) BODY(N##3) \
+  BODY(N##4) BODY(N##5) BODY(N##6) BODY(N##7)
+#define BODY_64(N) BODY_8(N##0) BODY_8(N##1) BODY_8(N##2) BODY_8(N##3) \
+  BODY_8(N##4) BODY_8(N##5) BODY_8(N##6) BODY_8(N##7)
+
+BODY_64(1)
+BODY_64(2)
+BODY_64(3)
+BODY_64(4)
@@ -0,0 +1,45 @@
+// Stress typo correction with a translation unit that has many identifiers
+// and namespaces, and many misspelled names to correct. Time it with:
+//   clang -cc1 -fsyntax-only -ftime-report -fspell-checking-limit 0 \
+//     typo-correction.cpp
+// and, to see the effect of bounding each correction, add
+//   -fspell-checking-candidate-limit 16
+
+#define CAT_(A, B) A##B
+#define CAT(A, B) CAT_(A, B)
+
+// Many similarly-named entities spread over many namespaces, so that both
+// the identifier walk and the nested-name-specifier search are expensive.
+#define DECLS(N)                                                      \
+  namespace CAT(module_, N) {                                         \
+    struct CAT(widget_, N) { int CAT(width_, N), CAT(height_, N); };  \
+    int CAT(compute_widget_size_, N)(CAT(widget_, N) *);              \
+    extern int CAT(widget_count_, N);                                 \
+    enum CAT(widget_kind_, N) { CAT(plain_, N), CAT(fancy_, N) };     \
+  }
+
+#define DECLS_8(N) DECLS(N##0) DECLS(N##1) DECLS(N##2) DECLS(N##3) \
+  DECLS(N##4) DECLS(N##5) DECLS(N##6) DECLS(N##7)
+#define DECLS_64(N) DECLS_8(N##0) DECLS_8(N##1) DECLS_8(N##2) DECLS_8(N##3) \
+  DECLS_8(N##4) DECLS_8(N##5) DECLS_8(N##6) DECLS_8(N##7)
+
+DECLS_64(1)
+DECLS_64(2)
+DECLS_64(3)
+DECLS_64(4)
+
+// Every use below is misspelled or unqualified, so each one triggers typo
+// correction.
+#define TYPOS(N)                                                      \
+  int CAT(use_, N)() {                                                \
+    CAT(widgt_, N) *W = 0;                                            \
+    return CAT(compute_widget_sise_, N)(W) + CAT(widget_cuont_, N);   \
+  }
+
+#define TYPOS_8(N) TYPOS(N##0) TYPOS(N##1) TYPOS(N##2) TYPOS(N##3) \
+  TYPOS(N##4) TYPOS(N##5) TYPOS(N##6) TYPOS(N##7)
+
+TYPOS_8(10)
+TYPOS_8(21)
+TYPOS_8(32)
+TYPOS_8(43)
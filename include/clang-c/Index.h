@@ -32,7 +32,7 @@
  * compatible, thus CINDEX_VERSION_MAJOR is expected to remain stable.
  */
 #define CINDEX_VERSION_MAJOR 0
-#define CINDEX_VERSION_MINOR 19
+#define CINDEX_VERSION_MINOR 21
 
 #define CINDEX_VERSION_ENCODE(major, minor) ( \
       ((major) * 10000)                       \
@@ -1147,7 +1147,17 @@ enum CXTranslationUnit_Flags {
    * included into the set of code completions returned from this translation
    * unit.
    */
-  CXTranslationUnit_IncludeBriefCommentsInCodeCompletion = 0x80
+  CXTranslationUnit_IncludeBriefCommentsInCodeCompletion = 0x80,
+
+  /**
+   * \brief Used to indicate that only the bodies of the functions outside the
+   * main file should be skipped while parsing.
+   *
+   * The bodies of inline functions and templates are still parsed, since
+   * the code in the main file may need them. This option can be used by
+   * tools that analyze the function bodies of the main file only.
+   */
+  CXTranslationUnit_SkipFunctionBodiesOutsideMainFile = 0x100
 };
 
 /**
@@ -2066,7 +2076,11 @@ enum CXCursorKind {
    */
   CXCursor_OMPParallelDirective          = 232,
 
-  CXCursor_LastStmt                      = CXCursor_OMPParallelDirective,
+  /** \brief OpenMP parallel for directive.
+   */
+  CXCursor_OMPParallelForDirective       = 233,
+
+  CXCursor_LastStmt                      = CXCursor_OMPParallelForDirective,
 
   /**
    * \brief Cursor that represents the translation unit itself.
@@ -4613,6 +4627,27 @@ clang_getNumCompletionChunks(CXCompletionString completion_string);
  */
 CINDEX_LINKAGE unsigned
 clang_getCompletionPriority(CXCompletionString completion_string);
+
+/**
+ * \brief Determine how well the typed text of this code completion matches
+ * a pattern the user has typed.
+ *
+ * The match is fuzzy: every character of the pattern has to appear in the
+ * typed text, in order, ignoring case. Matches at the start of the typed
+ * text or of a word within it (after an underscore or other punctuation, or
+ * at a lowercase-to-uppercase transition), runs of consecutive matches and
+ * matches with the same case all score higher.
+ *
+ * \param completion_string The completion string to query.
+ *
+ * \param pattern The text the user has typed.
+ *
+ * \returns Zero if the typed text does not match \p pattern; otherwise, a
+ * score where larger values indicate better matches.
+ */
+CINDEX_LINKAGE unsigned
+clang_getCompletionFuzzyMatchScore(CXCompletionString completion_string,
+                                   const char *pattern);
   
 /**
  * \brief Determine the availability of the entity that this code-completion
@@ -4962,6 +4997,35 @@ CXCodeCompleteResults *clang_codeCompleteAt(CXTranslationUnit TU,
 CINDEX_LINKAGE
 void clang_sortCodeCompletionResults(CXCompletionResult *Results,
                                      unsigned NumResults);
+
+/**
+ * \brief Filter the code-completion results down to those that match the
+ * text the user has typed since code completion was performed, and rank them.
+ *
+ * This lets a client treat a set of code-completion results as a session:
+ * rather than calling \c clang_codeCompleteAt() again after each keystroke,
+ * which reparses the source, the client filters the results it already has
+ * with the prefix typed so far.
+ *
+ * Results are matched with \c clang_getCompletionFuzzyMatchScore(). The
+ * matching results are stored in \c Results->Results, ordered by decreasing
+ * score, then by priority, then alphabetically by their typed text, and
+ * \c Results->NumResults is updated accordingly.
+ *
+ * When \p prefix extends the prefix of the previous call, only the results
+ * that matched that prefix are considered again. Otherwise, all of the
+ * results produced by code completion are. An empty prefix restores all of
+ * the results in their original order.
+ *
+ * \param Results The code-completion results to filter.
+ *
+ * \param prefix The text the user has typed at the code-completion point.
+ *
+ * \returns The number of results that match \p prefix.
+ */
+CINDEX_LINKAGE
+unsigned clang_codeCompleteFilterResults(CXCodeCompleteResults *Results,
+                                         const char *prefix);
   
 /**
  * \brief Free the given set of code-completion results.
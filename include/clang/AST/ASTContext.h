@@ -59,6 +59,7 @@ namespace clang {
   class SelectorTable;
   class TargetInfo;
   class CXXABI;
+  class GlobalDecl;
   // Decls
   class MangleContext;
   class ObjCIvarDecl;
@@ -136,7 +137,9 @@ class ASTContext : public RefCountedBase<ASTContext> {
 
   /// \brief A cache mapping from RecordDecls to ASTRecordLayouts.
   ///
-  /// This is lazily created.  This is intentionally not serialized.
+  /// This is lazily created. Layouts computed while building an AST file are
+  /// serialized into it, and loaded back through the external source the
+  /// first time they are requested.
   mutable llvm::DenseMap<const RecordDecl*, const ASTRecordLayout*>
     ASTRecordLayouts;
   mutable llvm::DenseMap<const ObjCContainerDecl*, const ASTRecordLayout*>
@@ -360,6 +363,16 @@ private:
   /// need them (like static local vars).
   llvm::DenseMap<const NamedDecl *, unsigned> MangleNumbers;
 
+  /// \brief Mangled names of global declarations, keyed by the opaque value
+  /// of their canonical GlobalDecl.
+  ///
+  /// Every MangleContext created by createMangleContext() mangles for the
+  /// same C++ ABI, so CodeGen and tools such as the indexer share this cache
+  /// instead of each re-mangling the same entities. Function-local entities
+  /// are not cached here, because each MangleContext numbers their
+  /// discriminators on its own.
+  llvm::DenseMap<void *, StringRef> MangledNames;
+
   /// \brief Mapping that stores parameterIndex values for ParmVarDecls when
   /// that value exceeds the bitfield size of ParmVarDeclBits.ParameterIndex.
   typedef llvm::DenseMap<const VarDecl *, unsigned> ParameterIndexTable;
@@ -383,6 +396,15 @@ private:
   /// AST objects will be released when the ASTContext itself is destroyed.
   mutable llvm::BumpPtrAllocator BumpAlloc;
 
+  /// \brief Whether Allocate() counts allocations. Counting is off unless
+  /// something reports the counts, since Allocate() is called for every node.
+  bool CountAllocations;
+
+  /// \brief The number of allocations made through Allocate() while counting
+  /// was on, and the number of bytes they requested.
+  mutable unsigned NumASTAllocations;
+  mutable uint64_t NumASTAllocatedBytes;
+
   /// \brief Allocator for partial diagnostics.
   PartialDiagnostic::StorageAllocator DiagAllocator;
 
@@ -462,6 +484,10 @@ public:
   }
 
   void *Allocate(size_t Size, unsigned Align = 8) const {
+    if (CountAllocations) {
+      ++NumASTAllocations;
+      NumASTAllocatedBytes += Size;
+    }
     return BumpAlloc.Allocate(Size, Align);
   }
   void Deallocate(void *Ptr) const { }
@@ -471,6 +497,17 @@ public:
   size_t getASTAllocatedMemory() const {
     return BumpAlloc.getTotalMemory();
   }
+
+  /// \brief Start or stop counting the allocations made through Allocate().
+  void setCountAllocations(bool Count) { CountAllocations = Count; }
+
+  /// \brief Return the number of AST nodes (and other objects) allocated
+  /// through Allocate() while counting was on.
+  unsigned getNumASTAllocations() const { return NumASTAllocations; }
+
+  /// \brief Return the number of bytes requested through Allocate() while
+  /// counting was on.
+  uint64_t getNumASTAllocatedBytes() const { return NumASTAllocatedBytes; }
   /// Return the total memory used for various side tables.
   size_t getSideTableAllocatedMemory() const;
   
@@ -2116,6 +2153,18 @@ public:
   /// DeclContext.
   MangleNumberingContext &getManglingNumberContext(const DeclContext *DC);
 
+  /// \brief Retrieve the cached mangled name of the given declaration, or an
+  /// empty string if it has not been mangled yet.
+  ///
+  /// The cache is thread-compatible rather than thread-safe: clients that
+  /// share an ASTContext between threads must serialize access themselves.
+  StringRef getCachedMangledName(GlobalDecl GD) const;
+
+  /// \brief Record the mangled name of the given declaration.
+  ///
+  /// \returns a copy of \p Name owned by this ASTContext.
+  StringRef setCachedMangledName(GlobalDecl GD, StringRef Name);
+
   /// \brief Used by ParmVarDecl to store on the side the
   /// index of the parameter when it exceeds the size of the normal bitfield.
   void setParameterIndex(const ParmVarDecl *D, unsigned index);
@@ -21,6 +21,7 @@
 namespace clang {
 
 class ASTConsumer;
+class ASTRecordLayout;
 class CXXBaseSpecifier;
 class DeclarationName;
 class ExternalSemaSource; // layering violation required for downcasting
@@ -118,6 +119,18 @@ public:
   /// The default implementation of this method is a no-op.
   virtual CXXBaseSpecifier *GetExternalCXXBaseSpecifiers(uint64_t Offset);
 
+  /// \brief Retrieve the complete layout of the given record definition, as
+  /// computed when the external source was built, so that the record does
+  /// not have to be laid out again.
+  ///
+  /// The layout must be allocated in the ASTContext, which takes ownership
+  /// of it. A layout returned here is used as is, without calling
+  /// \c layoutRecordType(), so a source that lays out a record through that
+  /// method should return NULL for it.
+  ///
+  /// The default implementation of this method is a no-op returning NULL.
+  virtual const ASTRecordLayout *GetExternalRecordLayout(const RecordDecl *RD);
+
   /// \brief Update an out-of-date identifier.
   virtual void updateOutOfDateIdentifier(IdentifierInfo &II) { }
 
@@ -28,6 +28,7 @@ namespace clang {
   class CXXDestructorDecl;
   class CXXMethodDecl;
   class FunctionDecl;
+  class GlobalDecl;
   class NamedDecl;
   class ObjCMethodDecl;
   class VarDecl;
@@ -71,6 +72,11 @@ class MangleContext {
 
   llvm::DenseMap<const BlockDecl*, unsigned> GlobalBlockIds;
   llvm::DenseMap<const BlockDecl*, unsigned> LocalBlockIds;
+
+  /// \brief Mangled names of function-local declarations, keyed by the opaque
+  /// value of their canonical GlobalDecl. Their discriminators are numbered
+  /// by each MangleContext, so they cannot go in the ASTContext's cache.
+  llvm::DenseMap<void *, StringRef> LocalMangledNames;
   
 public:
   explicit MangleContext(ASTContext &Context,
@@ -93,6 +99,14 @@ public:
     return Result.first->second;
   }
   
+  /// \brief Retrieve the mangled name of the given global declaration,
+  /// mangling it only if no MangleContext for this ASTContext has done so
+  /// already. Names of function-local declarations are only cached by this
+  /// MangleContext.
+  ///
+  /// Declarations that do not require mangling yield their identifier.
+  StringRef getMangledName(GlobalDecl GD);
+
   /// @name Mangler Entry Points
   /// @{
 
@@ -13,6 +13,7 @@
 #include "clang/Basic/CommentOptions.h"
 #include "clang/Basic/SourceManager.h"
 #include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
 
 namespace clang {
 
@@ -189,10 +190,14 @@ public:
 
 /// \brief This class represents all comments included in the translation unit,
 /// sorted in order of appearance in the translation unit.
+///
+/// For lookups, the comments are also grouped by the file they start in. The
+/// grouping is brought up to date lazily, when the comments of a file are
+/// requested.
 class RawCommentList {
 public:
   RawCommentList(SourceManager &SourceMgr) :
-    SourceMgr(SourceMgr), OnlyWhitespaceSeen(true) { }
+    SourceMgr(SourceMgr), OnlyWhitespaceSeen(true), NumCommentsInFiles(0) { }
 
   void addComment(const RawComment &RC, llvm::BumpPtrAllocator &Allocator);
 
@@ -200,18 +205,35 @@ public:
     return Comments;
   }
 
+  /// \brief Retrieve the comments that begin in the given file, sorted by
+  /// their location.
+  ArrayRef<RawComment *> getCommentsInFile(FileID File) const;
+
 private:
   SourceManager &SourceMgr;
   std::vector<RawComment *> Comments;
   SourceLocation PrevCommentEndLoc;
   bool OnlyWhitespaceSeen;
 
+  /// \brief The comments grouped by the file they begin in. This covers the
+  /// first \c NumCommentsInFiles elements of \c Comments.
+  mutable llvm::DenseMap<FileID, std::vector<RawComment *> > CommentsInFiles;
+  mutable unsigned NumCommentsInFiles;
+
+  /// \brief Forget the grouping of comments by file, because comments have
+  /// been added before the ones that were already grouped.
+  void invalidateCommentsInFiles() {
+    CommentsInFiles.clear();
+    NumCommentsInFiles = 0;
+  }
+
   void addCommentsToFront(const std::vector<RawComment *> &C) {
     size_t OldSize = Comments.size();
     Comments.resize(C.size() + OldSize);
     std::copy_backward(Comments.begin(), Comments.begin() + OldSize,
                        Comments.end());
     std::copy(C.begin(), C.end(), Comments.begin());
+    invalidateCommentsInFiles();
   }
 
   friend class ASTReader;
@@ -2399,6 +2399,13 @@ DEF_TRAVERSE_STMT(OMPParallelDirective, {
     if (!TraverseOMPClause(*I)) return false;
 })
 
+DEF_TRAVERSE_STMT(OMPParallelForDirective, {
+  ArrayRef<OMPClause *> Clauses = S->clauses();
+  for (ArrayRef<OMPClause *>::iterator I = Clauses.begin(), E = Clauses.end();
+       I != E; ++I)
+    if (!TraverseOMPClause(*I)) return false;
+})
+
 // OpenMP clauses.
 template<typename Derived>
 bool RecursiveASTVisitor<Derived>::TraverseOMPClause(OMPClause *C) {
@@ -2418,6 +2425,13 @@ bool RecursiveASTVisitor<Derived>::VisitOMPDefaultClause(OMPDefaultClause *C) {
   return true;
 }
 
+template<typename Derived>
+bool RecursiveASTVisitor<Derived>::VisitOMPScheduleClause(
+                                                     OMPScheduleClause *C) {
+  TraverseStmt(C->getChunkSize());
+  return true;
+}
+
 #define PROCESS_OMP_CLAUSE_LIST(Class, Node)                                   \
   for (OMPVarList<Class>::varlist_iterator I = Node->varlist_begin(),          \
                                            E = Node->varlist_end();            \
@@ -249,6 +249,90 @@ public:
   }
 };
 
+/// \brief This represents 'schedule' clause in the '#pragma omp ...' directive.
+///
+/// \code
+/// #pragma omp parallel for schedule(dynamic, 4)
+/// \endcode
+/// In this example directive '#pragma omp parallel for' has 'schedule' clause
+/// with kind 'dynamic' and chunk size '4'.
+///
+class OMPScheduleClause : public OMPClause {
+  friend class OMPClauseReader;
+  /// \brief Location of '('.
+  SourceLocation LParenLoc;
+  /// \brief A kind of the 'schedule' clause.
+  OpenMPScheduleClauseKind Kind;
+  /// \brief Start location of the kind in source code.
+  SourceLocation KindKwLoc;
+  /// \brief Chunk size, or null if none was specified.
+  Stmt *ChunkSize;
+
+  /// \brief Set kind of the clause.
+  ///
+  /// \param K Kind of the schedule.
+  ///
+  void setScheduleKind(OpenMPScheduleClauseKind K) { Kind = K; }
+
+  /// \brief Set kind location.
+  ///
+  /// \param KLoc Kind location.
+  ///
+  void setScheduleKindKwLoc(SourceLocation KLoc) { KindKwLoc = KLoc; }
+
+  /// \brief Set chunk size.
+  ///
+  /// \param E Chunk size.
+  ///
+  void setChunkSize(Expr *E) { ChunkSize = E; }
+public:
+  /// \brief Build 'schedule' clause with kind \a K and chunk size \a E.
+  ///
+  /// \param K Kind of the schedule ('static', 'dynamic', etc.).
+  /// \param KLoc Starting location of the kind.
+  /// \param E Chunk size, or null.
+  /// \param StartLoc Starting location of the clause.
+  /// \param LParenLoc Location of '('.
+  /// \param EndLoc Ending location of the clause.
+  ///
+  OMPScheduleClause(OpenMPScheduleClauseKind K, SourceLocation KLoc, Expr *E,
+                    SourceLocation StartLoc, SourceLocation LParenLoc,
+                    SourceLocation EndLoc)
+    : OMPClause(OMPC_schedule, StartLoc, EndLoc), LParenLoc(LParenLoc),
+      Kind(K), KindKwLoc(KLoc), ChunkSize(E) { }
+
+  /// \brief Build an empty clause.
+  ///
+  OMPScheduleClause()
+    : OMPClause(OMPC_schedule, SourceLocation(), SourceLocation()),
+      LParenLoc(SourceLocation()), Kind(OMPC_SCHEDULE_unknown),
+      KindKwLoc(SourceLocation()), ChunkSize(0) { }
+
+  /// \brief Sets the location of '('.
+  void setLParenLoc(SourceLocation Loc) { LParenLoc = Loc; }
+  /// \brief Returns the location of '('.
+  SourceLocation getLParenLoc() const { return LParenLoc; }
+
+  /// \brief Returns kind of the clause.
+  OpenMPScheduleClauseKind getScheduleKind() const { return Kind; }
+
+  /// \brief Returns location of clause kind.
+  SourceLocation getScheduleKindKwLoc() const { return KindKwLoc; }
+
+  /// \brief Returns the chunk size, or null if none was specified.
+  Expr *getChunkSize() const { return cast_or_null<Expr>(ChunkSize); }
+
+  static bool classof(const OMPClause *T) {
+    return T->getClauseKind() == OMPC_schedule;
+  }
+
+  StmtRange children() {
+    if (!ChunkSize)
+      return StmtRange();
+    return StmtRange(&ChunkSize, &ChunkSize + 1);
+  }
+};
+
 //===----------------------------------------------------------------------===//
 // AST classes for directives.
 //===----------------------------------------------------------------------===//
@@ -404,6 +488,115 @@ public:
   }
 };
 
+/// \brief This represents '#pragma omp parallel for' directive.
+///
+/// \code
+/// #pragma omp parallel for private(a) schedule(dynamic)
+/// \endcode
+/// In this example directive '#pragma omp parallel for' has clauses 'private'
+/// with the variable 'a' and 'schedule' with kind 'dynamic'. The associated
+/// statement is a for loop in the canonical form described by
+/// \c OMPCanonicalLoop.
+///
+class OMPParallelForDirective : public OMPExecutableDirective {
+  /// \brief Build directive with the given start and end location.
+  ///
+  /// \param StartLoc Starting location of the directive (directive keyword).
+  /// \param EndLoc Ending Location of the directive.
+  ///
+  OMPParallelForDirective(SourceLocation StartLoc, SourceLocation EndLoc,
+                          unsigned N)
+    : OMPExecutableDirective(this, OMPParallelForDirectiveClass,
+                             OMPD_parallel_for, StartLoc, EndLoc, N, 1) { }
+
+  /// \brief Build an empty directive.
+  ///
+  /// \param N Number of clauses.
+  ///
+  explicit OMPParallelForDirective(unsigned N)
+    : OMPExecutableDirective(this, OMPParallelForDirectiveClass,
+                             OMPD_parallel_for, SourceLocation(),
+                             SourceLocation(), N, 1) { }
+public:
+  /// \brief Creates directive with a list of \a Clauses.
+  ///
+  /// \param C AST context.
+  /// \param StartLoc Starting location of the directive kind.
+  /// \param EndLoc Ending Location of the directive.
+  /// \param Clauses List of clauses.
+  /// \param AssociatedStmt Statement associated with the directive.
+  ///
+  static OMPParallelForDirective *Create(ASTContext &C,
+                                         SourceLocation StartLoc,
+                                         SourceLocation EndLoc,
+                                         ArrayRef<OMPClause *> Clauses,
+                                         Stmt *AssociatedStmt);
+
+  /// \brief Creates an empty directive with the place for \a N clauses.
+  ///
+  /// \param C AST context.
+  /// \param N The number of clauses.
+  ///
+  static OMPParallelForDirective *CreateEmpty(ASTContext &C, unsigned N,
+                                              EmptyShell);
+
+  static bool classof(const Stmt *T) {
+    return T->getStmtClass() == OMPParallelForDirectiveClass;
+  }
+};
+
+/// \brief The iteration space of a for loop in the canonical form that
+/// OpenMP requires of the loops associated with loop directives
+/// (OpenMP [2.5.1, Loop Construct, Canonical Loop Form]):
+///
+/// \code
+/// for (init-expr; test-expr; incr-expr) structured-block
+/// \endcode
+///
+/// init-expr is 'var = lb' or 'integer-type var = lb', test-expr compares
+/// 'var' with 'b' using '<', '<=', '>' or '>=', and incr-expr is one of
+/// '++var', 'var++', '--var', 'var--', 'var += incr', 'var -= incr',
+/// 'var = var + incr', 'var = incr + var' or 'var = var - incr'.
+///
+/// Only local variables of integer type are supported as the loop iteration
+/// variable.
+class OMPCanonicalLoop {
+public:
+  /// \brief The result of analyzing a loop.
+  enum Form {
+    Canonical,   ///< The loop is in canonical form.
+    BadInit,     ///< init-expr does not have one of the required forms.
+    BadVarType,  ///< The loop iteration variable is not an integer.
+    BadTest,     ///< test-expr does not have one of the required forms.
+    BadIncr      ///< incr-expr does not have one of the required forms.
+  };
+
+  /// \brief The loop iteration variable.
+  const VarDecl *Var;
+  /// \brief The initial value of the loop iteration variable ('lb').
+  const Expr *LowerBound;
+  /// \brief The value the loop iteration variable is compared with ('b').
+  const Expr *TestBound;
+  /// \brief The comparison of test-expr, as if 'var' were on its left.
+  BinaryOperatorKind TestOp;
+  /// \brief The amount the loop iteration variable changes by in each
+  /// iteration ('incr'), or null if it changes by one.
+  const Expr *Step;
+  /// \brief Whether \c Step is subtracted from the loop iteration variable.
+  bool IsDecrement;
+
+  OMPCanonicalLoop()
+    : Var(0), LowerBound(0), TestBound(0), TestOp(BO_LT), Step(0),
+      IsDecrement(false) { }
+
+  /// \brief Analyze \p For and fill in the parts of the loop. The parts are
+  /// only meaningful if the loop is in canonical form.
+  Form analyze(const ForStmt *For);
+
+  /// \brief Whether the loop iteration variable counts up.
+  bool isIncreasing() const { return TestOp == BO_LT || TestOp == BO_LE; }
+};
+
 }  // end namespace clang
 
 #endif
@@ -0,0 +1,106 @@
+//===--- StructuralHash.h - Structural hashing of AST subtrees --*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  Defines StructuralHasher, which computes compact 128-bit hashes of
+//  statement and declaration subtrees that are stable across compilations.
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_AST_STRUCTURALHASH_H
+#define LLVM_CLANG_AST_STRUCTURALHASH_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/Support/DataTypes.h"
+
+namespace clang {
+
+class ASTContext;
+class Decl;
+class Stmt;
+
+/// \brief A 128-bit structural hash of an AST subtree.
+struct StructuralHash {
+  uint64_t Low;
+  uint64_t High;
+
+  StructuralHash() : Low(0), High(0) { }
+  StructuralHash(uint64_t Low, uint64_t High) : Low(Low), High(High) { }
+
+  /// \brief Retrieve a 64-bit hash, for clients that do not need the full
+  /// 128 bits.
+  uint64_t get64() const { return Low; }
+
+  friend bool operator==(const StructuralHash &X, const StructuralHash &Y) {
+    return X.Low == Y.Low && X.High == Y.High;
+  }
+  friend bool operator!=(const StructuralHash &X, const StructuralHash &Y) {
+    return !(X == Y);
+  }
+  friend bool operator<(const StructuralHash &X, const StructuralHash &Y) {
+    return X.High < Y.High || (X.High == Y.High && X.Low < Y.Low);
+  }
+};
+
+/// \brief Flags that control which parts of a subtree contribute to its
+/// structural hash.
+enum StructuralHashFlags {
+  SHF_Default = 0x0,
+
+  /// \brief Ignore the names of declarations and members, so that subtrees
+  /// differing only by a consistent renaming hash equally.
+  SHF_IgnoreIdentifiers = 0x1,
+
+  /// \brief Ignore the values of integer, floating, character and string
+  /// literals.
+  SHF_IgnoreLiterals = 0x2
+};
+
+/// \brief Computes structural hashes of statements and declarations.
+///
+/// Unlike Stmt::Profile(), which produces a FoldingSetNodeID that identifies
+/// referenced declarations and types by address, the hash is streamed into a
+/// fixed-size state and identifies declarations and types by name, so that
+/// hashes can be compared across compilations (e.g., to detect which function
+/// bodies changed) and are cheap enough to compute for every function in a
+/// translation unit.
+///
+/// The hasher caches the hashes of the names of types and declarations it
+/// has seen, so reuse a single hasher when hashing many subtrees of the same
+/// ASTContext.
+class StructuralHasher {
+public:
+  /// \brief Maps an entity (its address and kind) to the hash of its name.
+  typedef llvm::DenseMap<std::pair<const void *, unsigned>, uint64_t>
+    NameHashMap;
+
+private:
+  const ASTContext &Context;
+  unsigned Flags;
+
+  /// \brief Hashes of the printed names of the types, declarations,
+  /// nested-name-specifiers and templates referenced so far.
+  NameHashMap NameHashes;
+
+public:
+  explicit StructuralHasher(const ASTContext &Context,
+                            unsigned Flags = SHF_Default)
+    : Context(Context), Flags(Flags) { }
+
+  /// \brief Hash the given statement and all of its children.
+  StructuralHash hash(const Stmt *S);
+
+  /// \brief Hash the given declaration: its kind, name and type, plus the
+  /// body of a function or the initializer of a variable.
+  StructuralHash hash(const Decl *D);
+};
+
+} // end namespace clang
+
+#endif
@@ -14,18 +14,16 @@
 #ifndef LLVM_CLANG_REACHABLECODE_H
 #define LLVM_CLANG_REACHABLECODE_H
 
+#include "clang/Analysis/AnalysisContext.h"
 #include "clang/Basic/SourceLocation.h"
+#include "llvm/ADT/BitVector.h"
 
 //===----------------------------------------------------------------------===//
 // Forward declarations.
 //===----------------------------------------------------------------------===//
 
-namespace llvm {
-  class BitVector;
-}
-
 namespace clang {
-  class AnalysisDeclContext;
+  class CFG;
   class CFGBlock;
 }
 
@@ -49,6 +47,32 @@ public:
 unsigned ScanReachableFromBlock(const CFGBlock *Start,
                                 llvm::BitVector &Reachable);
 
+/// ReachableBlocks - The blocks of a CFG that are reachable from its entry
+/// block.  This is computed once per AnalysisDeclContext, through
+/// AnalysisDeclContext::getAnalysis(), so that all of the analyses that need
+/// to know which code is live share a single scan of the CFG.
+class ReachableBlocks : public ManagedAnalysis {
+  virtual void anchor();
+
+  llvm::BitVector Reachable;
+  unsigned NumReachable;
+
+  explicit ReachableBlocks(const CFG &cfg);
+
+public:
+  /// \brief The blocks reachable from the entry block, indexed by block ID.
+  const llvm::BitVector &getBlocks() const { return Reachable; }
+
+  /// \brief The number of blocks reachable from the entry block.
+  unsigned getNumReachable() const { return NumReachable; }
+
+  bool isReachable(const CFGBlock *B) const;
+
+  static const void *getTag();
+
+  static ReachableBlocks *create(AnalysisDeclContext &AC);
+};
+
 void FindUnreachableCode(AnalysisDeclContext &AC, Callback &CB);
 
 }} // end namespace clang::reachable_code
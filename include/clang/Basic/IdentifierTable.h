@@ -25,6 +25,7 @@
 #include "llvm/Support/PointerLikeTypeTraits.h"
 #include <cassert>
 #include <string>
+#include <vector>
 
 namespace llvm {
   template <typename T> struct DenseMapInfo;
@@ -396,6 +397,10 @@ public:
   /// \returns A new iterator into the set of known identifiers. The
   /// caller is responsible for deleting this iterator.
   virtual IdentifierIterator *getIdentifiers();
+
+  /// \brief Retrieve a number that changes whenever the set of identifiers
+  /// returned by getIdentifiers() may have changed.
+  virtual unsigned getIdentifiersGeneration() const;
 };
 
 /// \brief An abstract class used to resolve numerical identifier
@@ -424,6 +429,10 @@ class IdentifierTable {
 
   IdentifierInfoLookup* ExternalLookup;
 
+  /// \brief If non-null, every IdentifierInfo this table creates is appended
+  /// to this list.
+  std::vector<IdentifierInfo *> *NewIdentifiers;
+
 public:
   /// \brief Create the identifier table, populating it with info about the
   /// language keywords for the language specified by \p LangOpts.
@@ -439,6 +448,13 @@ public:
   IdentifierInfoLookup *getExternalIdentifierLookup() const {
     return ExternalLookup;
   }
+
+  /// \brief Set the list to which identifiers are appended when they are
+  /// created, so that a client can find the identifiers added since it last
+  /// looked without walking the whole table. Pass null to stop.
+  void setNewIdentifierList(std::vector<IdentifierInfo *> *List) {
+    NewIdentifiers = List;
+  }
   
   llvm::BumpPtrAllocator& getAllocator() {
     return HashTable.getAllocator();
@@ -471,6 +487,8 @@ public:
     // Make sure getName() knows how to find the IdentifierInfo
     // contents.
     II->Entry = &Entry;
+    if (NewIdentifiers)
+      NewIdentifiers->push_back(II);
 
     return *II;
   }
@@ -503,6 +521,8 @@ public:
       // Make sure getName() knows how to find the IdentifierInfo
       // contents.
       II->Entry = &Entry;
+      if (NewIdentifiers)
+        NewIdentifiers->push_back(II);
       
       // If this is the 'import' contextual keyword, mark it as such.
       if (Name.equals("import"))
@@ -0,0 +1,62 @@
+//===- ThreadGroup.h - Threads Waited For Together --------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+///
+/// \file
+/// \brief Defines the clang::ThreadGroup class, which runs functions on
+/// threads that all run at once and are waited for together.
+///
+//===----------------------------------------------------------------------===//
+#ifndef LLVM_CLANG_BASIC_THREADGROUP_H
+#define LLVM_CLANG_BASIC_THREADGROUP_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/Support/Compiler.h"
+
+namespace clang {
+
+/// \brief Runs functions on threads of their own, which are waited for by
+/// \c join().
+///
+/// Unlike llvm_execute_on_thread, \c start() returns as soon as the thread is
+/// running, so the threads of a group do their work at the same time.
+class ThreadGroup {
+  class Impl;
+  Impl *TheImpl;
+
+  ThreadGroup(const ThreadGroup &) LLVM_DELETED_FUNCTION;
+  void operator=(const ThreadGroup &) LLVM_DELETED_FUNCTION;
+
+public:
+  /// \brief Create a group whose threads have a stack of \p StackSize bytes,
+  /// or the system's default if it is 0.
+  explicit ThreadGroup(unsigned StackSize = 0);
+
+  /// \brief Waits for the threads that are still running.
+  ~ThreadGroup();
+
+  /// \brief Whether threads can be started. This puts LLVM into
+  /// multithreaded mode, so it must be asked before a thread is started.
+  ///
+  /// This is false if LLVM was built without threads or the host has no
+  /// pthreads.
+  static bool isSupported();
+
+  /// \brief Start calling \p Fn with \p Arg on a new thread.
+  ///
+  /// \returns false if the thread could not be started, in which case the
+  /// caller should call \p Fn itself.
+  bool start(void (*Fn)(void *), void *Arg);
+
+  /// \brief Wait for all of the threads started so far to finish.
+  void join();
+};
+
+} // end namespace clang
+
+#endif // LLVM_CLANG_BASIC_THREADGROUP_H
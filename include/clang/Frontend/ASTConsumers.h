@@ -53,6 +53,10 @@ ASTConsumer *CreateASTViewer();
 // to stderr; this is intended for debugging.
 ASTConsumer *CreateDeclContextPrinter();
 
+// AST hash timer: hashes every function body with StructuralHasher and with
+// Stmt::Profile, and prints the time each took to stderr.
+ASTConsumer *CreateASTHashTimer();
+
 } // end clang namespace
 
 #endif
@@ -103,9 +103,17 @@ public:
   /// The float precision limit to use, if non-empty.
   std::string LimitFloatPrecision;
 
+  /// Name of the profile file to use with -fprofile-instr-use.
+  std::string InstrProfileInput;
+
   /// The name of the bitcode file to link before optzns.
   std::string LinkBitcodeFile;
 
+  /// The linker that merges the objects generated in parts into one, by
+  /// linking them in relocatable mode. Code is only generated in parts if
+  /// this is set.
+  std::string CodeGenPartitionsLinker;
+
   /// The user provided name for the "main file", if non-empty. This is useful
   /// in situations where the input file name does not match the original input
   /// file, for example with -save-temps.
@@ -62,6 +62,12 @@ protected:
                                          StringRef InFile);
 };
 
+class ASTHashTimingAction : public ASTFrontendAction {
+protected:
+  virtual ASTConsumer *CreateASTConsumer(CompilerInstance &CI,
+                                         StringRef InFile);
+};
+
 class ASTViewAction : public ASTFrontendAction {
 protected:
   virtual ASTConsumer *CreateASTConsumer(CompilerInstance &CI,
@@ -167,6 +173,10 @@ class ASTMergeAction : public FrontendAction {
   /// \brief The set of AST files to merge.
   std::vector<std::string> ASTFiles;
 
+  /// \brief The number of threads that load the AST files. If greater than
+  /// 1, all of the files are loaded before any is merged.
+  unsigned NumJobs;
+
 protected:
   virtual ASTConsumer *CreateASTConsumer(CompilerInstance &CI,
                                          StringRef InFile);
@@ -178,7 +188,8 @@ protected:
   virtual void EndSourceFileAction();
 
 public:
-  ASTMergeAction(FrontendAction *AdaptedAction, ArrayRef<std::string> ASTFiles);
+  ASTMergeAction(FrontendAction *AdaptedAction, ArrayRef<std::string> ASTFiles,
+                 unsigned NumJobs = 1);
   virtual ~ASTMergeAction();
 
   virtual bool usesPreprocessorOnly() const;
@@ -27,6 +27,7 @@ namespace frontend {
     ASTDeclList,            ///< Parse ASTs and list Decl nodes.
     ASTDump,                ///< Parse ASTs and dump them.
     ASTDumpXML,             ///< Parse ASTs and dump them in XML.
+    ASTHashTiming,          ///< Parse ASTs and time hashing their bodies.
     ASTPrint,               ///< Parse ASTs and print them.
     ASTView,                ///< Parse ASTs and view them in Graphviz.
     DumpRawTokens,          ///< Dump out raw tokens.
@@ -138,12 +139,17 @@ public:
                                            /// speed up parsing in cases you do
                                            /// not need them (e.g. with code
                                            /// completion).
+  unsigned SkipFunctionBodiesOutsideMainFile : 1; ///< Only skip the bodies
+                                           /// of functions outside the main
+                                           /// file.
   unsigned UseGlobalModuleIndex : 1;       ///< Whether we can use the
                                            ///< global module index if available.
   unsigned GenerateGlobalModuleIndex : 1;  ///< Whether we can generate the
                                            ///< global module index if needed.
   unsigned ASTDumpLookups : 1;             ///< Whether we include lookup table
                                            ///< dumps in AST dumps.
+  unsigned TemplateProfile : 1;            ///< Profile template
+                                           ///< instantiations.
 
   CodeCompleteOptions CodeCompleteOpts;
 
@@ -180,6 +186,13 @@ public:
   /// If given, filter dumped AST Decl nodes by this substring.
   std::string ASTDumpFilter;
 
+  /// If given, write a Chrome trace of template instantiations to this file.
+  std::string TemplateProfileTrace;
+
+  /// If not empty, only skip the bodies of functions in files whose path
+  /// starts with one of these.
+  std::vector<std::string> SkipFunctionBodiesPaths;
+
   /// If given, enable code completion at the provided location.
   ParsedSourceLocation CodeCompletionAt;
 
@@ -204,6 +217,10 @@ public:
   /// \brief The list of AST files to merge.
   std::vector<std::string> ASTMergeFiles;
 
+  /// \brief The number of threads that load the AST files to merge. If
+  /// greater than 1, all of the files are loaded before any is merged.
+  unsigned ASTMergeJobs;
+
   /// \brief A list of arguments to forward to LLVM's option processing; this
   /// should only be used for debugging and experimental features.
   std::vector<std::string> LLVMArgs;
@@ -218,9 +235,11 @@ public:
     ShowStats(false), ShowTimers(false), ShowVersion(false),
     FixWhatYouCan(false), FixOnlyWarnings(false), FixAndRecompile(false),
     FixToTemporaries(false), ARCMTMigrateEmitARCErrors(false),
-    SkipFunctionBodies(false), UseGlobalModuleIndex(true),
+    SkipFunctionBodies(false), SkipFunctionBodiesOutsideMainFile(false),
+    UseGlobalModuleIndex(true),
     GenerateGlobalModuleIndex(true), ASTDumpLookups(false),
-    ARCMTAction(ARCMT_None), ObjCMTAction(ObjCMT_None),
+    TemplateProfile(false),
+    ASTMergeJobs(1), ARCMTAction(ARCMT_None), ObjCMTAction(ObjCMT_None),
     ProgramAction(frontend::ParseSyntaxOnly)
   {}
 
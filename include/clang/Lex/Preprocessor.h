@@ -378,6 +378,11 @@ private:  // Cached tokens state.
   /// a normal Lex() should be invoked.
   CachedTokensTy::size_type CachedLexPos;
 
+  /// CachedTokensWindow - Incremented each time all of the cached tokens have
+  /// been consumed and the cache is discarded. A client that remembers facts
+  /// about cached tokens can use it to tell when those facts are stale.
+  unsigned CachedTokensWindow;
+
   /// BacktrackPositions - Stack of backtrack positions, allowing nested
   /// backtracks. The EnableBacktrackAtThisPos() method pushes a position to
   /// indicate where CachedLexPos should be set when the BackTrack() method is
@@ -716,6 +721,10 @@ public:
   /// caching of tokens is on.
   bool isBacktrackEnabled() const { return !BacktrackPositions.empty(); }
 
+  /// \brief Returns a number identifying the current run of cached tokens;
+  /// it changes whenever the token cache is discarded.
+  unsigned getCachedTokensWindow() const { return CachedTokensWindow; }
+
   /// Lex - To lex a token from the preprocessor, just pull a token from the
   /// current lexer or macro object.
   void Lex(Token &Result) {
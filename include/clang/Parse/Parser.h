@@ -149,6 +149,7 @@ class Parser : public CodeCompletionHandler {
   OwningPtr<PragmaHandler> RedefineExtnameHandler;
   OwningPtr<PragmaHandler> FPContractHandler;
   OwningPtr<PragmaHandler> OpenCLExtensionHandler;
+  OwningPtr<PragmaHandler> LoopHintHandler;
   OwningPtr<CommentHandler> CommentSemaHandler;
   OwningPtr<PragmaHandler> OpenMPHandler;
   OwningPtr<PragmaHandler> MSCommentHandler;
@@ -205,6 +206,31 @@ class Parser : public CodeCompletionHandler {
   /// \brief Identifiers which have been declared within a tentative parse.
   SmallVector<IdentifierInfo *, 8> TentativelyDeclaredIdentifiers;
 
+  /// \brief The kinds of disambiguation whose results are memoized.
+  enum DisambiguationKind {
+    DK_SimpleDeclaration,
+    DK_ForRangeDeclaration,
+    DK_ConditionDeclaration,
+    DK_FunctionDeclarator,
+    DK_TypeIdInParens,
+    DK_TypeIdAsTemplateArgument
+  };
+
+  /// \brief The results of the disambiguations performed in the current
+  /// window of cached tokens, keyed on the raw encoding of the location of
+  /// the token they start at and the kind of disambiguation.
+  ///
+  /// Each result is the answer in bit 0 and whether it was ambiguous in bit 1.
+  llvm::DenseMap<std::pair<unsigned, unsigned>, unsigned char> Disambiguations;
+
+  /// \brief The preprocessor's window of cached tokens that the entries in
+  /// Disambiguations belong to.
+  unsigned DisambiguationsWindow;
+
+  /// \brief Whether the disambiguation in progress has looked at a
+  /// tentatively-declared identifier, so that its result must not be reused.
+  bool DisambiguationUsedTentativeDecl;
+
   IdentifierInfo *getSEHExceptKeyword();
 
   /// True if we are within an Objective-C container while parsing C-like decls.
@@ -454,6 +480,10 @@ private:
   /// #pragma clang __debug captured
   StmtResult HandlePragmaCaptured();
 
+  /// \brief Handle the annotation token produced for
+  /// #pragma clang loop..., adding the loop hint it carries to \p Attrs.
+  void HandlePragmaLoopHint(ParsedAttributes &Attrs);
+
   /// GetLookAheadToken - This peeks ahead N tokens and returns that token
   /// without consuming any tokens.  LookAhead(0) returns 'Tok', LookAhead(1)
   /// returns the token after Tok, etc.
@@ -609,6 +639,29 @@ private:
     }
   };
 
+  /// DisambiguationMemo - Memoizes the result of a disambiguation that starts
+  /// at the current token. The parser often disambiguates the same tokens
+  /// more than once, e.g. within the tentative parse of an enclosing
+  /// construct and again when parsing them for real; the memo lets the later
+  /// disambiguations skip their tentative parse.
+  class DisambiguationMemo {
+    Parser &P;
+    std::pair<unsigned, unsigned> Key;
+    bool PrevUsedTentativeDecl;
+
+  public:
+    DisambiguationMemo(Parser &P, DisambiguationKind Kind);
+    ~DisambiguationMemo();
+
+    /// \brief Retrieve the result of an earlier identical disambiguation,
+    /// returning false if there was none.
+    bool lookup(bool &Result, bool &IsAmbiguous) const;
+
+    /// \brief Record the result of this disambiguation, unless it depended
+    /// on identifiers that were only tentatively declared.
+    void remember(bool Result, bool IsAmbiguous = false);
+  };
+
   /// ObjCDeclContextSwitch - An object used to switch context from
   /// an objective-c decl context to its enclosing decl context and
   /// back.
@@ -1508,6 +1561,9 @@ private:
   StmtResult ParseReturnStatement();
   StmtResult ParseAsmStatement(bool &msAsm);
   StmtResult ParseMicrosoftAsmStatement(SourceLocation AsmLoc);
+  StmtResult ParsePragmaLoopHint(StmtVector &Stmts, bool OnlyStatement,
+                                 SourceLocation *TrailingElseLoc,
+                                 ParsedAttributesWithRange &Attrs);
 
   /// \brief Describes the behavior that should be taken for an __if_exists
   /// block.
@@ -2144,6 +2200,9 @@ private:
 
   //===--------------------------------------------------------------------===//
   // OpenMP: Directives and clauses.
+  /// \brief Parses the name of an OpenMP directive, including the names of
+  /// combined directives that are spelled with several tokens.
+  OpenMPDirectiveKind ParseOpenMPDirectiveKind();
   /// \brief Parses declarative OpenMP directives.
   DeclGroupPtrTy ParseOpenMPDeclarativeDirective();
   /// \brief Parses simple list of variables.
@@ -2177,6 +2236,9 @@ private:
   /// \param Kind Kind of current clause.
   ///
   OMPClause *ParseOpenMPSimpleClause(OpenMPClauseKind Kind);
+  /// \brief Parses 'schedule' clause.
+  ///
+  OMPClause *ParseOpenMPScheduleClause();
   /// \brief Parses clause with the list of variables of a kind \a Kind.
   ///
   /// \param Kind Kind of current clause.
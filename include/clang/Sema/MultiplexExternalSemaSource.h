@@ -82,6 +82,10 @@ public:
   /// stream into an array of specifiers.
   virtual CXXBaseSpecifier *GetExternalCXXBaseSpecifiers(uint64_t Offset);
 
+  /// \brief Retrieve the layout of a record computed when building one of
+  /// the sources, if any.
+  virtual const ASTRecordLayout *GetExternalRecordLayout(const RecordDecl *RD);
+
   /// \brief Find all declarations with the given name in the
   /// given context.
   virtual bool
@@ -23,6 +23,7 @@
 #include "clang/AST/UnresolvedSet.h"
 #include "clang/Sema/SemaFixItUtils.h"
 #include "clang/Sema/TemplateDeduction.h"
+#include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/SmallVector.h"
 #include "llvm/Support/Allocator.h"
@@ -572,6 +573,46 @@ namespace clang {
     void DebugPrint() const;
   };
 
+  /// ImplicitConversionCache - A cache of the implicit conversion sequences
+  /// computed for conversions that only depend on the type and value kind of
+  /// the expression being converted, so that overload resolution does not
+  /// recompute them for every candidate set.
+  class ImplicitConversionCache {
+  public:
+    /// Key - The source type, the target type, and the value kind of the
+    /// source expression together with the conversion flags.
+    typedef std::pair<std::pair<void *, void *>, unsigned> Key;
+
+  private:
+    llvm::DenseMap<Key, ImplicitConversionSequence> Conversions;
+    unsigned NumHits;
+    unsigned NumMisses;
+
+  public:
+    ImplicitConversionCache() : NumHits(0), NumMisses(0) { }
+
+    /// lookup - Retrieve the cached conversion sequence for the given key,
+    /// or null if there is none.
+    const ImplicitConversionSequence *lookup(const Key &K) {
+      llvm::DenseMap<Key, ImplicitConversionSequence>::iterator Known
+        = Conversions.find(K);
+      if (Known == Conversions.end()) {
+        ++NumMisses;
+        return 0;
+      }
+      ++NumHits;
+      return &Known->second;
+    }
+
+    void insert(const Key &K, const ImplicitConversionSequence &ICS) {
+      Conversions[K] = ICS;
+    }
+
+    void clear() { Conversions.clear(); }
+
+    void PrintStats() const;
+  };
+
   enum OverloadFailureKind {
     ovl_fail_too_many_arguments,
     ovl_fail_too_few_arguments,
@@ -692,29 +733,79 @@ namespace clang {
     }
   };
 
+  /// OverloadCandidateArena - Storage for the candidates of all of the
+  /// overload candidate sets and template specialization candidate sets that
+  /// are alive at the same time: the candidates themselves, their conversion
+  /// sequences and the details of failed template argument deductions.
+  /// Candidate sets nest (e.g., a user-defined conversion is resolved while
+  /// the call it is an argument of is being resolved), so the storage is only
+  /// released, and then reused, once the outermost set has been destroyed.
+  class OverloadCandidateArena {
+    llvm::BumpPtrAllocator Allocator;
+
+    /// NumActiveSets - The number of candidate sets using the arena.
+    unsigned NumActiveSets;
+
+    // Statistics.
+    unsigned NumSets;
+    unsigned NumAllocations;
+    unsigned NumResets;
+    unsigned MaxSlabs;
+    size_t MaxMemory;
+
+    OverloadCandidateArena(const OverloadCandidateArena &) LLVM_DELETED_FUNCTION;
+    void operator=(const OverloadCandidateArena &) LLVM_DELETED_FUNCTION;
+
+  public:
+    OverloadCandidateArena()
+      : NumActiveSets(0), NumSets(0), NumAllocations(0), NumResets(0),
+        MaxSlabs(0), MaxMemory(0) { }
+
+    /// Allocate - Allocate uninitialized storage for Num objects of type T,
+    /// which lives until the outermost candidate set is destroyed.
+    template <typename T> T *Allocate(size_t Num = 1) {
+      ++NumAllocations;
+      return Allocator.Allocate<T>(Num);
+    }
+
+    /// enterSet - Note that a new candidate set uses the arena.
+    void enterSet() {
+      ++NumActiveSets;
+      ++NumSets;
+    }
+
+    /// exitSet - Note that a candidate set has been destroyed, and reset the
+    /// arena if it was the outermost one.
+    void exitSet();
+
+    void PrintStats() const;
+  };
+
   /// OverloadCandidateSet - A set of overload candidates, used in C++
   /// overload resolution (C++ 13.3).
   class OverloadCandidateSet {
-    SmallVector<OverloadCandidate, 16> Candidates;
-    llvm::SmallPtrSet<Decl *, 16> Functions;
+    OverloadCandidateArena &Arena;
 
-    // Allocator for OverloadCandidate::Conversions. We store the first few
-    // elements inline to avoid allocation for small sets.
-    llvm::BumpPtrAllocator ConversionSequenceAllocator;
+    /// Candidates - The candidates, allocated in the arena. When the array
+    /// is full it is copied into a larger one; the old array is reclaimed
+    /// along with the rest of the arena.
+    OverloadCandidate *Candidates;
+    unsigned NumCandidates;
+    unsigned CandidateCapacity;
 
-    SourceLocation Loc;
+    llvm::SmallPtrSet<Decl *, 16> Functions;
 
-    unsigned NumInlineSequences;
-    char InlineSpace[16 * sizeof(ImplicitConversionSequence)];
+    SourceLocation Loc;
 
     OverloadCandidateSet(const OverloadCandidateSet &) LLVM_DELETED_FUNCTION;
     void operator=(const OverloadCandidateSet &) LLVM_DELETED_FUNCTION;
 
     void destroyCandidates();
+    void growCandidates();
 
   public:
-    OverloadCandidateSet(SourceLocation Loc) : Loc(Loc), NumInlineSequences(0){}
-    ~OverloadCandidateSet() { destroyCandidates(); }
+    OverloadCandidateSet(Sema &S, SourceLocation Loc);
+    ~OverloadCandidateSet();
 
     SourceLocation getLocation() const { return Loc; }
 
@@ -727,33 +818,25 @@ namespace clang {
     /// \brief Clear out all of the candidates.
     void clear();
 
-    typedef SmallVectorImpl<OverloadCandidate>::iterator iterator;
-    iterator begin() { return Candidates.begin(); }
-    iterator end() { return Candidates.end(); }
+    typedef OverloadCandidate *iterator;
+    iterator begin() { return Candidates; }
+    iterator end() { return Candidates + NumCandidates; }
 
-    size_t size() const { return Candidates.size(); }
-    bool empty() const { return Candidates.empty(); }
+    size_t size() const { return NumCandidates; }
+    bool empty() const { return NumCandidates == 0; }
 
     /// \brief Add a new candidate with NumConversions conversion sequence slots
     /// to the overload set.
     OverloadCandidate &addCandidate(unsigned NumConversions = 0) {
-      Candidates.push_back(OverloadCandidate());
-      OverloadCandidate &C = Candidates.back();
-
-      // Assign space from the inline array if there are enough free slots
-      // available.
-      if (NumConversions + NumInlineSequences <= 16) {
-        ImplicitConversionSequence *I =
-          (ImplicitConversionSequence*)InlineSpace;
-        C.Conversions = &I[NumInlineSequences];
-        NumInlineSequences += NumConversions;
-      } else {
-        // Otherwise get memory from the allocator.
-        C.Conversions = ConversionSequenceAllocator
-                          .Allocate<ImplicitConversionSequence>(NumConversions);
-      }
-
-      // Construct the new objects.
+      if (NumCandidates == CandidateCapacity)
+        growCandidates();
+      OverloadCandidate &C
+        = *new (&Candidates[NumCandidates++]) OverloadCandidate();
+
+      // Get memory for the conversion sequences from the arena, and construct
+      // the new objects.
+      C.Conversions = NumConversions
+          ? Arena.Allocate<ImplicitConversionSequence>(NumConversions) : 0;
       for (unsigned i = 0; i != NumConversions; ++i)
         new (&C.Conversions[i]) ImplicitConversionSequence();
 
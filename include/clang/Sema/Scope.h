@@ -91,7 +91,11 @@ public:
     TryScope = 0x2000,
 
     /// \brief This is the scope for a function-level C++ try or catch scope.
-    FnTryCatchScope = 0x4000
+    FnTryCatchScope = 0x4000,
+
+    /// \brief This is the scope of an OpenMP directive that is associated
+    /// with a loop, like '#pragma omp parallel for'.
+    OpenMPLoopDirectiveScope = 0x8000
   };
 private:
   /// The parent scope for this scope.  This is null for the translation-unit
@@ -305,6 +309,13 @@ public:
   /// \brief Determine whether this scope is a C++ 'try' block.
   bool isTryScope() const { return getFlags() & Scope::TryScope; }
 
+  /// \brief Determine whether this scope is the scope of the loop associated
+  /// with an OpenMP loop directive.
+  bool isOpenMPLoopScope() const {
+    const Scope *P = getParent();
+    return P && (P->getFlags() & Scope::OpenMPLoopDirectiveScope);
+  }
+
   /// containedInPrototypeScope - Return true if this or a parent scope
   /// is a FunctionPrototypeScope.
   bool containedInPrototypeScope() const;
@@ -110,6 +110,7 @@ namespace clang {
   class FunctionDecl;
   class FunctionProtoType;
   class FunctionTemplateDecl;
+  class ImplicitConversionCache;
   class ImplicitConversionSequence;
   class InitListExpr;
   class InitializationKind;
@@ -140,6 +141,7 @@ namespace clang {
   class ObjCProtocolDecl;
   class OMPThreadPrivateDecl;
   class OMPClause;
+  class OverloadCandidateArena;
   class OverloadCandidateSet;
   class OverloadExpr;
   class ParenListExpr;
@@ -157,6 +159,7 @@ namespace clang {
   class TemplateArgumentList;
   class TemplateArgumentLoc;
   class TemplateDecl;
+  class TemplateInstantiationProfiler;
   class TemplateParameterList;
   class TemplatePartialOrderingContext;
   class TemplateTemplateParmDecl;
@@ -772,6 +775,15 @@ public:
   /// \brief The number of SFINAE diagnostics that have been trapped.
   unsigned NumSFINAEErrors;
 
+  /// \brief The number of times the built-in candidates for an overloaded
+  /// operator were requested, and how many of those requests were answered
+  /// without generating any candidates.
+  unsigned NumBuiltinOperatorSets, NumBuiltinOperatorSetsSkipped;
+
+  /// \brief The number of built-in operator candidates generated, and how
+  /// many of them turned out not to be viable.
+  unsigned NumBuiltinCandidates, NumNonViableBuiltinCandidates;
+
   typedef llvm::DenseMap<ParmVarDecl *, SmallVector<ParmVarDecl *, 1> >
     UnparsedDefaultArgInstantiationsMap;
 
@@ -888,6 +900,19 @@ public:
 
   void PrintStats() const;
 
+  /// \brief Start recording the time and memory spent on each template
+  /// instantiation (-ftemplate-profile).
+  ///
+  /// \param RecordTrace Whether to also record each instantiation for a
+  /// timeline.
+  void enableTemplateProfiling(bool RecordTrace);
+
+  /// \brief Retrieve the template instantiation profiler, if profiling is
+  /// enabled.
+  TemplateInstantiationProfiler *getTemplateProfiler() const {
+    return TemplateProfiler.get();
+  }
+
   /// \brief Helper class that creates diagnostics with optional
   /// template instantiation stacks.
   ///
@@ -1547,6 +1572,24 @@ public:
   /// \c constexpr in C++11 or has an 'auto' return type in C++14).
   bool canSkipFunctionBody(Decl *D);
 
+  /// \brief Whether only the bodies of functions outside the main file may
+  /// be skipped (along with those in SkipFunctionBodiesPaths).
+  bool SkipFunctionBodiesOutsideMainFile;
+
+  /// \brief If not empty, only the bodies of functions in files under one of
+  /// these paths may be skipped (along with those outside the main file, if
+  /// SkipFunctionBodiesOutsideMainFile is set).
+  std::vector<std::string> SkipFunctionBodiesPaths;
+
+  /// \brief Only allow skipping the bodies of functions outside the main file
+  /// and in the files under \p Paths, for tools that need the bodies of the
+  /// functions they analyze but not those of the headers they include.
+  ///
+  /// The bodies of inline functions and templates are still parsed, since
+  /// instantiation and constant evaluation may need them.
+  void restrictSkippedFunctionBodies(bool OutsideMainFile,
+                                     ArrayRef<std::string> Paths);
+
   void computeNRVO(Stmt *Body, sema::FunctionScopeInfo *Scope);
   Decl *ActOnFinishFunctionBody(Decl *Decl, Stmt *Body);
   Decl *ActOnFinishFunctionBody(Decl *Decl, Stmt *Body, bool IsInstantiation);
@@ -1909,6 +1952,18 @@ public:
   /// an available function, false otherwise.
   bool isFunctionConsideredUnavailable(FunctionDecl *FD);
 
+  /// \brief The implicit conversion sequences computed so far for
+  /// conversions that only depend on the types involved.
+  OwningPtr<ImplicitConversionCache> ImplicitConversions;
+
+  /// \brief Discard the cached implicit conversion sequences, because a
+  /// declaration that may change them has been seen.
+  void invalidateImplicitConversionCache();
+
+  /// \brief Storage for the candidates of overload resolution and template
+  /// specialization matching, reused from one resolution to the next.
+  OwningPtr<OverloadCandidateArena> CandidateArena;
+
   ImplicitConversionSequence
   TryImplicitConversion(Expr *From, QualType ToType,
                         bool SuppressUserConversions,
@@ -6056,6 +6111,10 @@ public:
     SuppressedDiagnosticsMap;
   SuppressedDiagnosticsMap SuppressedDiagnostics;
 
+  /// \brief Records the cost of each template instantiation, when
+  /// -ftemplate-profile is enabled.
+  OwningPtr<TemplateInstantiationProfiler> TemplateProfiler;
+
   /// \brief A stack object to be created when performing template
   /// instantiation.
   ///
@@ -6237,6 +6296,10 @@ public:
   /// string represents a keyword.
   UnqualifiedTyposCorrectedMap UnqualifiedTyposCorrected;
 
+  /// \brief An index of the identifiers in the translation unit, used to
+  /// find candidate names for typo correction.
+  TypoCorrectionIndex TypoIndex;
+
   /// \brief Worker object for performing CFG-based warnings.
   sema::AnalysisBasedWarnings AnalysisWarnings;
 
@@ -6263,6 +6326,14 @@ public:
   /// types, static variables, enumerators, etc.
   std::deque<PendingImplicitInstantiation> PendingLocalImplicitInstantiations;
 
+  /// \brief The implicit instantiations that were left alone while
+  /// performing the instantiations of a PCH, because they need a template
+  /// definition that is not available yet, or are variable definitions.
+  ///
+  /// They are serialized as pending instantiations, to be performed by the
+  /// translation units that use the PCH.
+  SmallVector<PendingImplicitInstantiation, 4> DeferredPCHInstantiations;
+
   void PerformPendingInstantiations(bool LocalOnly = false);
 
   TypeSourceInfo *SubstType(TypeSourceInfo *T,
@@ -6885,6 +6956,12 @@ public:
                                           Stmt *AStmt,
                                           SourceLocation StartLoc,
                                           SourceLocation EndLoc);
+  /// \brief Called on well-formed '\#pragma omp parallel for' after parsing
+  /// of the associated statement.
+  StmtResult ActOnOpenMPParallelForDirective(ArrayRef<OMPClause *> Clauses,
+                                             Stmt *AStmt,
+                                             SourceLocation StartLoc,
+                                             SourceLocation EndLoc);
 
   OMPClause *ActOnOpenMPSimpleClause(OpenMPClauseKind Kind,
                                      unsigned Argument,
@@ -6898,6 +6975,13 @@ public:
                                       SourceLocation StartLoc,
                                       SourceLocation LParenLoc,
                                       SourceLocation EndLoc);
+  /// \brief Called on well-formed 'schedule' clause.
+  OMPClause *ActOnOpenMPScheduleClause(OpenMPScheduleClauseKind Kind,
+                                       SourceLocation KindLoc,
+                                       Expr *ChunkSize,
+                                       SourceLocation StartLoc,
+                                       SourceLocation LParenLoc,
+                                       SourceLocation EndLoc);
 
   OMPClause *ActOnOpenMPVarListClause(OpenMPClauseKind Kind,
                                       ArrayRef<Expr *> Vars,
@@ -7647,6 +7731,7 @@ public:
 private:
   bool SemaBuiltinPrefetch(CallExpr *TheCall);
   bool SemaBuiltinObjectSize(CallExpr *TheCall);
+  bool SemaBuiltinAssumeAligned(CallExpr *TheCall);
   bool SemaBuiltinLongjmp(CallExpr *TheCall);
   ExprResult SemaBuiltinAtomicOverloaded(ExprResult TheCallResult);
   ExprResult SemaAtomicOpsOverloaded(ExprResult TheCallResult,
@@ -7826,7 +7911,7 @@ public:
 };
 
 DeductionFailureInfo
-MakeDeductionFailureInfo(ASTContext &Context, Sema::TemplateDeductionResult TDK,
+MakeDeductionFailureInfo(Sema &S, Sema::TemplateDeductionResult TDK,
                          sema::TemplateDeductionInfo &Info);
 
 }  // end namespace clang
@@ -19,6 +19,7 @@
 
 namespace clang {
 
+class OverloadCandidateArena;
 class TemplateArgumentList;
 class Sema;
 
@@ -241,6 +242,9 @@ struct TemplateSpecCandidate {
 /// TODO: In the future, we may need to unify/generalize this with
 /// OverloadCandidateSet.
 class TemplateSpecCandidateSet {
+  /// \brief The arena holding the details of the candidates' deduction
+  /// failures, which is not reset while this set is alive.
+  OverloadCandidateArena &Arena;
   SmallVector<TemplateSpecCandidate, 16> Candidates;
   SourceLocation Loc;
 
@@ -251,8 +255,8 @@ class TemplateSpecCandidateSet {
   void destroyCandidates();
 
 public:
-  TemplateSpecCandidateSet(SourceLocation Loc) : Loc(Loc) {}
-  ~TemplateSpecCandidateSet() { destroyCandidates(); }
+  TemplateSpecCandidateSet(Sema &S, SourceLocation Loc);
+  ~TemplateSpecCandidateSet();
 
   SourceLocation getLocation() const { return Loc; }
 
@@ -0,0 +1,131 @@
+//===--- TemplateInstantiationProfiler.h - Instantiation costs --*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file defines TemplateInstantiationProfiler, which records the time
+//  and AST memory spent instantiating each template (-ftemplate-profile).
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef LLVM_CLANG_SEMA_TEMPLATE_INSTANTIATION_PROFILER_H
+#define LLVM_CLANG_SEMA_TEMPLATE_INSTANTIATION_PROFILER_H
+
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/Support/DataTypes.h"
+#include <vector>
+
+namespace clang {
+
+class ASTContext;
+class Decl;
+
+/// \brief Records the cost of each template instantiation performed by Sema.
+///
+/// Costs are aggregated both per specialization (e.g., \c vector<int>) and
+/// per primary template (e.g., \c vector), and can be printed as a report
+/// sorted by cost or written as a Chrome trace ("chrome://tracing") showing
+/// the nesting of instantiations over time.
+class TemplateInstantiationProfiler {
+public:
+  /// \brief The aggregated cost of a specialization or template.
+  struct Stats {
+    /// \brief The number of times it was instantiated.
+    unsigned Count;
+
+    /// \brief The number of instantiations triggered directly from within
+    /// its instantiations.
+    unsigned Nested;
+
+    /// \brief Wall time spent in its instantiations, including nested
+    /// instantiations (counted once for recursive instantiations).
+    double TotalTime;
+
+    /// \brief Wall time spent in its instantiations, excluding nested
+    /// instantiations.
+    double SelfTime;
+
+    /// \brief AST allocations made by its instantiations, excluding nested
+    /// instantiations.
+    unsigned SelfAllocations;
+    uint64_t SelfBytes;
+
+    /// \brief The number of its instantiations currently in progress.
+    unsigned Active;
+
+    Stats()
+      : Count(0), Nested(0), TotalTime(0), SelfTime(0), SelfAllocations(0),
+        SelfBytes(0), Active(0) { }
+  };
+
+private:
+  const ASTContext &Context;
+
+  /// \brief An instantiation that is in progress.
+  struct ActiveInstantiation {
+    const Decl *Entity;
+    const Decl *Template;
+    double StartTime;
+    unsigned StartAllocations;
+    uint64_t StartBytes;
+
+    /// \brief Totals for the nested instantiations completed so far.
+    double NestedTime;
+    unsigned NestedAllocations;
+    uint64_t NestedBytes;
+    unsigned NumNested;
+  };
+  SmallVector<ActiveInstantiation, 16> Stack;
+
+  llvm::DenseMap<const Decl *, Stats> BySpecialization;
+  llvm::DenseMap<const Decl *, Stats> ByTemplate;
+
+  /// \brief A completed instantiation, for the trace.
+  struct TraceEvent {
+    const Decl *Entity;
+    double StartTime;
+    double Duration;
+    unsigned Allocations;
+    uint64_t Bytes;
+  };
+  bool RecordTrace;
+  std::vector<TraceEvent> Trace;
+
+  /// \brief The time at which profiling started.
+  double ProfileStartTime;
+
+  /// \brief Total wall time spent in outermost instantiations.
+  double TotalTime;
+  unsigned NumInstantiations;
+
+  void printTable(raw_ostream &OS, StringRef Title,
+                  const llvm::DenseMap<const Decl *, Stats> &Table) const;
+
+public:
+  TemplateInstantiationProfiler(const ASTContext &Context, bool RecordTrace);
+
+  /// \brief Note that Sema has started instantiating the given entity (a
+  /// specialization or a member of a class template specialization).
+  void startInstantiation(const Decl *Entity);
+
+  /// \brief Note that Sema has finished instantiating the given entity,
+  /// which must be the most recently started instantiation.
+  void finishInstantiation(const Decl *Entity);
+
+  /// \brief Print the most expensive templates and specializations.
+  void printReport(raw_ostream &OS) const;
+
+  /// \brief Write the recorded instantiations in the Chrome trace event
+  /// format.
+  void writeTrace(raw_ostream &OS) const;
+};
+
+} // end namespace clang
+
+#endif
@@ -18,6 +18,7 @@
 #include "clang/AST/DeclCXX.h"
 #include "clang/Sema/DeclSpec.h"
 #include "llvm/ADT/SmallVector.h"
+#include <vector>
 
 namespace clang {
 
@@ -310,6 +311,72 @@ public:
   }
 };
 
+/// @brief An index of the identifiers known to a translation unit, used by
+/// Sema::CorrectTypo to find the names that may be close enough to a typo
+/// without computing the edit distance to every identifier.
+///
+/// Identifiers are bucketed by length, and each one carries a mask of the
+/// characters it contains, which gives a cheap lower bound on its edit
+/// distance to the typo. The identifiers of the external identifier source
+/// are indexed separately, so that a translation unit built on a large
+/// precompiled header or module only indexes them again when another AST
+/// file is loaded.
+class TypoCorrectionIndex {
+  struct Entry {
+    StringRef Name;
+    uint64_t Characters;
+  };
+  typedef std::vector<std::vector<Entry> > LengthBuckets;
+
+  LengthBuckets Local;
+  LengthBuckets External;
+
+  /// @brief The identifier table \c Local indexes, which appends the
+  /// identifiers it creates to \c NewIdentifiers.
+  IdentifierTable *LocalTable;
+
+  /// @brief The identifiers created since \c Local was last updated.
+  std::vector<IdentifierInfo *> NewIdentifiers;
+
+  /// @brief The generation of the external identifier source when
+  /// \c External was built.
+  unsigned ExternalGeneration;
+
+  bool HasLocal;
+  bool HasExternal;
+
+  static void addName(LengthBuckets &Buckets, StringRef Name);
+  static void lookup(const LengthBuckets &Buckets, StringRef Typo,
+                     uint64_t TypoCharacters, unsigned MaxEditDistance,
+                     SmallVectorImpl<StringRef> &Names);
+
+public:
+  TypoCorrectionIndex()
+    : LocalTable(0), ExternalGeneration(0), HasLocal(false),
+      HasExternal(false) {}
+
+  ~TypoCorrectionIndex() {
+    if (LocalTable)
+      LocalTable->setNewIdentifierList(0);
+  }
+
+  /// @brief Bring the index up to date with the identifiers in \p Idents
+  /// and its external identifier source.
+  void update(IdentifierTable &Idents);
+
+  /// @brief Note that the identifiers added to \p Idents since the last
+  /// update were all interned from names returned by lookup(), and so are
+  /// already indexed.
+  void noteIndexedIdentifiers(const IdentifierTable &Idents) {
+    NewIdentifiers.clear();
+  }
+
+  /// @brief Collect the indexed names whose edit distance to \p Typo may be
+  /// at most \p MaxEditDistance.
+  void lookup(StringRef Typo, unsigned MaxEditDistance,
+              SmallVectorImpl<StringRef> &Names) const;
+};
+
 }
 
 #endif
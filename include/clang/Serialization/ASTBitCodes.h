@@ -535,7 +535,18 @@ namespace clang {
 
       /// \brief Record code for undefined but used functions and variables that
       /// need a definition in this TU.
-      UNDEFINED_BUT_USED = 49
+      UNDEFINED_BUT_USED = 49,
+
+      /// \brief Record code for the array describing the locations (in the
+      /// RECORD_LAYOUTS record) of the record layouts computed while building
+      /// the AST file, indexed by the ID of the record definition.
+      RECORD_LAYOUTS_MAP = 50,
+
+      /// \brief Record code for the array of record layouts.
+      ///
+      /// This array can only be interpreted properly using the record
+      /// layouts map.
+      RECORD_LAYOUTS = 51
     };
 
     /// \brief Record types used within a source manager block.
@@ -1328,6 +1339,7 @@ namespace clang {
 
       // OpenMP drectives
       STMT_OMP_PARALLEL_DIRECTIVE,
+      STMT_OMP_PARALLEL_FOR_DIRECTIVE,
 
       // ARC
       EXPR_OBJC_BRIDGED_CAST,     // ObjCBridgedCastExpr
@@ -1411,6 +1423,17 @@ namespace clang {
       }
     };
 
+    /// \brief Describes the serialized layout of a record definition.
+    struct RecordLayoutInfo {
+      DeclID RecordID;     // The ID of the record definition
+      unsigned Offset;     // Offset into the array of record layouts.
+
+      friend bool operator<(const RecordLayoutInfo &X,
+                            const RecordLayoutInfo &Y) {
+        return X.RecordID < Y.RecordID;
+      }
+    };
+
     /// @}
   }
 } // end namespace clang
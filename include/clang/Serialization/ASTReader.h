@@ -821,6 +821,10 @@ private:
   /// Number of CXX base specifiers currently loaded
   unsigned NumCXXBaseSpecifiersLoaded;
 
+  /// \brief Number of record layouts read from the AST files, and the
+  /// total number of record layouts they contain.
+  unsigned NumRecordLayoutsRead, TotalNumRecordLayouts;
+
   /// \brief The set of identifiers that were read while the AST reader was
   /// (recursively) loading declarations.
   ///
@@ -1476,6 +1480,10 @@ public:
 
   virtual CXXBaseSpecifier *GetExternalCXXBaseSpecifiers(uint64_t Offset);
 
+  /// \brief Retrieve the layout of the given record definition if it was
+  /// computed while building the AST file that contains it.
+  virtual const ASTRecordLayout *GetExternalRecordLayout(const RecordDecl *RD);
+
   /// \brief Resolve the offset of a statement into a statement.
   ///
   /// This operation will read a new statement from the external
@@ -1567,6 +1575,12 @@ public:
   /// in all loaded AST files.
   virtual IdentifierIterator *getIdentifiers();
 
+  /// \brief Retrieve the generation of the AST reader, which changes
+  /// whenever another AST file is loaded.
+  virtual unsigned getIdentifiersGeneration() const {
+    return CurrentGeneration;
+  }
+
   /// \brief Load the contents of the global method pool for a given
   /// selector.
   virtual void ReadMethodPool(Selector Sel);
@@ -455,6 +455,7 @@ private:
   void WriteFPPragmaOptions(const FPOptions &Opts);
   void WriteOpenCLExtensions(Sema &SemaRef);
   void WriteObjCCategories();
+  void WriteRecordLayouts();
   void WriteRedeclarations();
   void WriteMergedDecls();
                         
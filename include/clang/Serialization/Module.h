@@ -397,6 +397,17 @@ public:
   /// module.
   SmallVector<uint64_t, 1> ObjCCategories;
 
+  /// \brief Array of record layout location information within this module
+  /// file, sorted by the ID of the record definition.
+  const serialization::RecordLayoutInfo *RecordLayoutsMap;
+
+  /// \brief The number of record layout entries in RecordLayoutsMap.
+  unsigned LocalNumRecordLayoutsInMap;
+
+  /// \brief The layouts of the records laid out while building this module
+  /// file.
+  SmallVector<uint64_t, 1> RecordLayouts;
+
   // === Types ===
 
   /// \brief The number of types in this AST file.
@@ -24,6 +24,7 @@
 #include "clang/AST/Expr.h"
 #include "clang/AST/ExprCXX.h"
 #include "clang/AST/ExternalASTSource.h"
+#include "clang/AST/GlobalDecl.h"
 #include "clang/AST/Mangle.h"
 #include "clang/AST/RecordLayout.h"
 #include "clang/AST/RecursiveASTVisitor.h"
@@ -57,6 +58,16 @@ enum FloatingRank {
   HalfRank, FloatRank, DoubleRank, LongDoubleRank
 };
 
+namespace {
+  /// \brief Orders the comments in a single file by their starting location.
+  struct CommentBeginsBefore {
+    bool operator()(const RawComment *RC, SourceLocation Loc) const {
+      return RC->getSourceRange().getBegin().getRawEncoding() <
+             Loc.getRawEncoding();
+    }
+  };
+}
+
 RawComment *ASTContext::getRawCommentForDeclNoCache(const Decl *D) const {
   if (!CommentsLoaded && ExternalSource) {
     ExternalSource->ReadComments();
@@ -115,10 +126,8 @@ RawComment *ASTContext::getRawCommentForDeclNoCache(const Decl *D) const {
       isa<TemplateTemplateParmDecl>(D))
     return NULL;
 
-  ArrayRef<RawComment *> RawComments = Comments.getComments();
-
   // If there are no comments anywhere, we won't find anything.
-  if (RawComments.empty())
+  if (Comments.getComments().empty())
     return NULL;
 
   // Find declaration location.
@@ -147,53 +156,53 @@ RawComment *ASTContext::getRawCommentForDeclNoCache(const Decl *D) const {
   if (DeclLoc.isInvalid() || !DeclLoc.isFileID())
     return NULL;
 
-  // Find the comment that occurs just after this declaration.
+  // Decompose the location for the declaration and find the beginning of the
+  // file buffer. Only comments in the same file can be attached to it.
+  std::pair<FileID, unsigned> DeclLocDecomp = SourceMgr.getDecomposedLoc(DeclLoc);
+  ArrayRef<RawComment *> RawComments
+    = Comments.getCommentsInFile(DeclLocDecomp.first);
+  if (RawComments.empty())
+    return NULL;
+
+  // Find the comment that occurs just after this declaration. All of the
+  // comments are in the same file as the declaration, so they can be ordered
+  // by the raw encoding of their locations.
   ArrayRef<RawComment *>::iterator Comment;
   {
     // When searching for comments during parsing, the comment we are looking
     // for is usually among the last two comments we parsed -- check them
     // first.
-    RawComment CommentAtDeclLoc(
-        SourceMgr, SourceRange(DeclLoc), false,
-        LangOpts.CommentOpts.ParseAllComments);
-    BeforeThanCompare<RawComment> Compare(SourceMgr);
+    CommentBeginsBefore Compare;
     ArrayRef<RawComment *>::iterator MaybeBeforeDecl = RawComments.end() - 1;
-    bool Found = Compare(*MaybeBeforeDecl, &CommentAtDeclLoc);
+    bool Found = Compare(*MaybeBeforeDecl, DeclLoc);
     if (!Found && RawComments.size() >= 2) {
       MaybeBeforeDecl--;
-      Found = Compare(*MaybeBeforeDecl, &CommentAtDeclLoc);
+      Found = Compare(*MaybeBeforeDecl, DeclLoc);
     }
 
     if (Found) {
       Comment = MaybeBeforeDecl + 1;
       assert(Comment == std::lower_bound(RawComments.begin(), RawComments.end(),
-                                         &CommentAtDeclLoc, Compare));
+                                         DeclLoc, Compare));
     } else {
       // Slow path.
       Comment = std::lower_bound(RawComments.begin(), RawComments.end(),
-                                 &CommentAtDeclLoc, Compare);
+                                 DeclLoc, Compare);
     }
   }
 
-  // Decompose the location for the declaration and find the beginning of the
-  // file buffer.
-  std::pair<FileID, unsigned> DeclLocDecomp = SourceMgr.getDecomposedLoc(DeclLoc);
-
   // First check whether we have a trailing comment.
   if (Comment != RawComments.end() &&
       (*Comment)->isDocumentation() && (*Comment)->isTrailingComment() &&
       (isa<FieldDecl>(D) || isa<EnumConstantDecl>(D) || isa<VarDecl>(D) ||
        isa<ObjCMethodDecl>(D) || isa<ObjCPropertyDecl>(D))) {
-    std::pair<FileID, unsigned> CommentBeginDecomp
-      = SourceMgr.getDecomposedLoc((*Comment)->getSourceRange().getBegin());
-    // Check that Doxygen trailing comment comes after the declaration, starts
-    // on the same line and in the same file as the declaration.
-    if (DeclLocDecomp.first == CommentBeginDecomp.first &&
-        SourceMgr.getLineNumber(DeclLocDecomp.first, DeclLocDecomp.second)
-          == SourceMgr.getLineNumber(CommentBeginDecomp.first,
-                                     CommentBeginDecomp.second)) {
+    unsigned CommentBeginOffset
+      = SourceMgr.getFileOffset((*Comment)->getSourceRange().getBegin());
+    // Check that Doxygen trailing comment comes after the declaration and
+    // starts on the same line as the declaration.
+    if (SourceMgr.getLineNumber(DeclLocDecomp.first, DeclLocDecomp.second)
+          == SourceMgr.getLineNumber(DeclLocDecomp.first, CommentBeginOffset))
       return *Comment;
-    }
   }
 
   // The comment just after the declaration was not a trailing comment.
@@ -717,6 +726,7 @@ ASTContext::ASTContext(LangOptions& LOpts, SourceManager &SM,
     NullTypeSourceInfo(QualType()), 
     FirstLocalImport(), LastLocalImport(),
     SourceMgr(SM), LangOpts(LOpts), 
+    CountAllocations(false), NumASTAllocations(0), NumASTAllocatedBytes(0),
     AddrSpaceMap(0), Target(t), PrintingPolicy(LOpts),
     Idents(idents), Selectors(sels),
     BuiltinInfo(builtins),
@@ -7999,6 +8009,7 @@ size_t ASTContext::getSideTableAllocatedMemory() const {
          llvm::capacity_in_bytes(InstantiatedFromUsingShadowDecl) +
          llvm::capacity_in_bytes(InstantiatedFromUnnamedFieldDecl) +
          llvm::capacity_in_bytes(OverriddenMethods) +
+         llvm::capacity_in_bytes(MangledNames) +
          llvm::capacity_in_bytes(Types) +
          llvm::capacity_in_bytes(VariableArrayTypes) +
          llvm::capacity_in_bytes(ClassScopeSpecializationPattern);
@@ -8020,6 +8031,20 @@ ASTContext::getManglingNumberContext(const DeclContext *DC) {
   return MangleNumberingContexts[DC];
 }
 
+StringRef ASTContext::getCachedMangledName(GlobalDecl GD) const {
+  llvm::DenseMap<void *, StringRef>::const_iterator I =
+    MangledNames.find(GD.getCanonicalDecl().getAsOpaquePtr());
+  return I != MangledNames.end() ? I->second : StringRef();
+}
+
+StringRef ASTContext::setCachedMangledName(GlobalDecl GD, StringRef Name) {
+  char *Mem = static_cast<char *>(Allocate(Name.size(), 1));
+  std::copy(Name.begin(), Name.end(), Mem);
+  StringRef Stored(Mem, Name.size());
+  MangledNames[GD.getCanonicalDecl().getAsOpaquePtr()] = Stored;
+  return Stored;
+}
+
 void ASTContext::setParameterIndex(const ParmVarDecl *D, unsigned int index) {
   ParamIndices[D] = index;
 }
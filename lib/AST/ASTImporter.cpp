@@ -205,6 +205,10 @@ namespace {
     /// \brief Declaration (from, to) pairs that are known not to be equivalent
     /// (which we have already complained about).
     llvm::DenseSet<std::pair<Decl *, Decl *> > &NonEquivalentDecls;
+
+    /// \brief Declaration (from, to) pairs that a previous check has already
+    /// proven to be equivalent.
+    llvm::DenseSet<std::pair<Decl *, Decl *> > &EquivalentDecls;
     
     /// \brief Whether we're being strict about the spelling of types when 
     /// unifying two types.
@@ -218,9 +222,11 @@ namespace {
 
     StructuralEquivalenceContext(ASTContext &C1, ASTContext &C2,
                llvm::DenseSet<std::pair<Decl *, Decl *> > &NonEquivalentDecls,
+               llvm::DenseSet<std::pair<Decl *, Decl *> > &EquivalentDecls,
                                  bool StrictTypeSpelling = false,
                                  bool Complain = true)
       : C1(C1), C2(C2), NonEquivalentDecls(NonEquivalentDecls),
+        EquivalentDecls(EquivalentDecls),
         StrictTypeSpelling(StrictTypeSpelling), Complain(Complain),
         LastDiagFromC2(false) {}
 
@@ -236,6 +242,10 @@ namespace {
     ///
     /// \returns true if an error occurred, false otherwise.
     bool Finish();
+
+    /// \brief Record all of the tentative equivalences as proven, once
+    /// Finish() has checked them successfully.
+    void CommitEquivalences();
     
   public:
     DiagnosticBuilder Diag1(SourceLocation Loc, unsigned DiagID) {
@@ -1272,12 +1282,13 @@ static bool IsStructurallyEquivalent(StructuralEquivalenceContext &Context,
 /// \brief Determine structural equivalence of two declarations.
 static bool IsStructurallyEquivalent(StructuralEquivalenceContext &Context,
                                      Decl *D1, Decl *D2) {
-  // FIXME: Check for known structural equivalences via a callback of some sort.
-  
-  // Check whether we already know that these two declarations are not
-  // structurally equivalent.
-  if (Context.NonEquivalentDecls.count(std::make_pair(D1->getCanonicalDecl(),
-                                                      D2->getCanonicalDecl())))
+  // Check whether we already know that these two declarations are (or are
+  // not) structurally equivalent.
+  std::pair<Decl *, Decl *> Key(D1->getCanonicalDecl(),
+                                D2->getCanonicalDecl());
+  if (Context.EquivalentDecls.count(Key))
+    return true;
+  if (Context.NonEquivalentDecls.count(Key))
     return false;
   
   // Determine whether we've already produced a tentative equivalence for D1.
@@ -1296,7 +1307,11 @@ bool StructuralEquivalenceContext::IsStructurallyEquivalent(Decl *D1,
   if (!::IsStructurallyEquivalent(*this, D1, D2))
     return false;
   
-  return !Finish();
+  if (Finish())
+    return false;
+
+  CommitEquivalences();
+  return true;
 }
 
 bool StructuralEquivalenceContext::IsStructurallyEquivalent(QualType T1, 
@@ -1304,7 +1319,51 @@ bool StructuralEquivalenceContext::IsStructurallyEquivalent(QualType T1,
   if (!::IsStructurallyEquivalent(*this, T1, T2))
     return false;
   
-  return !Finish();
+  if (Finish())
+    return false;
+
+  CommitEquivalences();
+  return true;
+}
+
+/// \brief Determine whether the structure that equivalence checking compares
+/// for \p D is final. A tag or Objective-C class without a complete
+/// definition may later be given one that differs from its counterpart.
+static bool hasFinalStructure(Decl *D) {
+  if (TagDecl *Tag = dyn_cast<TagDecl>(D)) {
+    TagDecl *Def = Tag->getDefinition();
+    return Def && Def->isCompleteDefinition();
+  }
+  if (ObjCInterfaceDecl *Class = dyn_cast<ObjCInterfaceDecl>(D))
+    return Class->hasDefinition();
+  if (ClassTemplateDecl *Template = dyn_cast<ClassTemplateDecl>(D))
+    return hasFinalStructure(Template->getTemplatedDecl());
+  return true;
+}
+
+void StructuralEquivalenceContext::CommitEquivalences() {
+  // Every tentative equivalence has now been checked under the assumption
+  // that the others hold, so they hold together. Remember them, so that later
+  // checks involving the same declarations (e.g., when the declarations
+  // themselves are imported) don't have to walk their structure again.
+  //
+  // An equivalence that involved a declaration without a complete definition
+  // may stop holding once the definition is seen, and so may the others that
+  // relied on it, so in that case remember none of them.
+  for (llvm::DenseMap<Decl *, Decl *>::iterator
+         I = TentativeEquivalences.begin(), E = TentativeEquivalences.end();
+       I != E; ++I) {
+    if (I->second &&
+        (!hasFinalStructure(I->first) || !hasFinalStructure(I->second)))
+      return;
+  }
+
+  for (llvm::DenseMap<Decl *, Decl *>::iterator
+         I = TentativeEquivalences.begin(), E = TentativeEquivalences.end();
+       I != E; ++I) {
+    if (I->second)
+      EquivalentDecls.insert(std::make_pair(I->first, I->second));
+  }
 }
 
 bool StructuralEquivalenceContext::Finish() {
@@ -2180,6 +2239,7 @@ bool ASTNodeImporter::IsStructuralMatch(RecordDecl *FromRecord,
   StructuralEquivalenceContext Ctx(Importer.getFromContext(),
                                    Importer.getToContext(),
                                    Importer.getNonEquivalentDecls(),
+                                   Importer.getEquivalentDecls(),
                                    false, Complain);
   return Ctx.IsStructurallyEquivalent(FromRecord, ToRecord);
 }
@@ -2188,14 +2248,16 @@ bool ASTNodeImporter::IsStructuralMatch(VarDecl *FromVar, VarDecl *ToVar,
                                         bool Complain) {
   StructuralEquivalenceContext Ctx(
       Importer.getFromContext(), Importer.getToContext(),
-      Importer.getNonEquivalentDecls(), false, Complain);
+      Importer.getNonEquivalentDecls(), Importer.getEquivalentDecls(),
+      false, Complain);
   return Ctx.IsStructurallyEquivalent(FromVar, ToVar);
 }
 
 bool ASTNodeImporter::IsStructuralMatch(EnumDecl *FromEnum, EnumDecl *ToEnum) {
   StructuralEquivalenceContext Ctx(Importer.getFromContext(),
                                    Importer.getToContext(),
-                                   Importer.getNonEquivalentDecls());
+                                   Importer.getNonEquivalentDecls(),
+                                   Importer.getEquivalentDecls());
   return Ctx.IsStructurallyEquivalent(FromEnum, ToEnum);
 }
 
@@ -2214,7 +2276,8 @@ bool ASTNodeImporter::IsStructuralMatch(ClassTemplateDecl *From,
                                         ClassTemplateDecl *To) {
   StructuralEquivalenceContext Ctx(Importer.getFromContext(),
                                    Importer.getToContext(),
-                                   Importer.getNonEquivalentDecls());
+                                   Importer.getNonEquivalentDecls(),
+                                   Importer.getEquivalentDecls());
   return Ctx.IsStructurallyEquivalent(From, To);  
 }
 
@@ -2222,7 +2285,8 @@ bool ASTNodeImporter::IsStructuralMatch(VarTemplateDecl *From,
                                         VarTemplateDecl *To) {
   StructuralEquivalenceContext Ctx(Importer.getFromContext(),
                                    Importer.getToContext(),
-                                   Importer.getNonEquivalentDecls());
+                                   Importer.getNonEquivalentDecls(),
+                                   Importer.getEquivalentDecls());
   return Ctx.IsStructurallyEquivalent(From, To);
 }
 
@@ -5119,6 +5183,6 @@ bool ASTImporter::IsStructurallyEquivalent(QualType From, QualType To,
     return true;
       
   StructuralEquivalenceContext Ctx(FromContext, ToContext, NonEquivalentDecls,
-                                   false, Complain);
+                                   EquivalentDecls, false, Complain);
   return Ctx.IsStructurallyEquivalent(From, To);
 }
@@ -43,6 +43,11 @@ ExternalASTSource::GetExternalCXXBaseSpecifiers(uint64_t Offset) {
   return 0;
 }
 
+const ASTRecordLayout *
+ExternalASTSource::GetExternalRecordLayout(const RecordDecl *RD) {
+  return 0;
+}
+
 bool
 ExternalASTSource::FindExternalVisibleDeclsByName(const DeclContext *DC,
                                                   DeclarationName Name) {
@@ -104,6 +104,21 @@ static const NamedDecl *getStructor(const NamedDecl *decl) {
                                                     
 static const unsigned UnknownArity = ~0U;
 
+/// \brief DenseMap traits for substitution candidates.
+///
+/// The keys are AST node pointers, possibly carrying qualifier bits in their
+/// low bits, so hash them the way pointers are hashed: the integer hash
+/// leaves the always-zero alignment bits in place and collides heavily.
+struct SubstitutionKeyInfo {
+  static inline uintptr_t getEmptyKey() { return ~uintptr_t(0); }
+  static inline uintptr_t getTombstoneKey() { return ~uintptr_t(0) - 1; }
+  static unsigned getHashValue(uintptr_t Val) {
+    unsigned V = static_cast<unsigned>(Val);
+    return (V >> 4) ^ (V >> 9) ^ (V & 0xF);
+  }
+  static bool isEqual(uintptr_t LHS, uintptr_t RHS) { return LHS == RHS; }
+};
+
 class ItaniumMangleContext : public MangleContext {
   llvm::DenseMap<const TagDecl *, uint64_t> AnonStructIds;
   typedef std::pair<const DeclContext*, IdentifierInfo*> DiscriminatorKeyTy;
@@ -244,7 +259,11 @@ class CXXNameMangler {
 
   } FunctionTypeDepth;
 
-  llvm::DenseMap<uintptr_t, unsigned> Substitutions;
+  /// \brief The substitution candidates seen so far, mapped to their
+  /// sequence numbers. Most manglings only have a handful of them, so keep
+  /// them inline.
+  llvm::SmallDenseMap<uintptr_t, unsigned, 16, SubstitutionKeyInfo>
+    Substitutions;
 
   ASTContext &getASTContext() const { return Context.getASTContext(); }
 
@@ -3420,7 +3439,8 @@ bool CXXNameMangler::mangleSubstitution(TemplateName Template) {
 }
 
 bool CXXNameMangler::mangleSubstitution(uintptr_t Ptr) {
-  llvm::DenseMap<uintptr_t, unsigned>::iterator I = Substitutions.find(Ptr);
+  llvm::SmallDenseMap<uintptr_t, unsigned, 16, SubstitutionKeyInfo>::iterator
+    I = Substitutions.find(Ptr);
   if (I == Substitutions.end())
     return false;
 
@@ -3606,8 +3626,10 @@ void CXXNameMangler::addSubstitution(TemplateName Template) {
 }
 
 void CXXNameMangler::addSubstitution(uintptr_t Ptr) {
-  assert(!Substitutions.count(Ptr) && "Substitution already exists!");
-  Substitutions[Ptr] = SeqID++;
+  bool Inserted = Substitutions.insert(std::make_pair(Ptr, SeqID)).second;
+  assert(Inserted && "Substitution already exists!");
+  (void)Inserted;
+  ++SeqID;
 }
 
 //
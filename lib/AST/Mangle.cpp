@@ -17,6 +17,7 @@
 #include "clang/AST/DeclObjC.h"
 #include "clang/AST/DeclTemplate.h"
 #include "clang/AST/ExprCXX.h"
+#include "clang/AST/GlobalDecl.h"
 #include "clang/Basic/ABI.h"
 #include "clang/Basic/SourceManager.h"
 #include "llvm/ADT/StringExtras.h"
@@ -47,6 +48,49 @@ static void mangleFunctionBlock(MangleContext &Context,
 
 void MangleContext::anchor() { }
 
+StringRef MangleContext::getMangledName(GlobalDecl GD) {
+  const NamedDecl *ND = cast<NamedDecl>(GD.getDecl());
+
+  // Local entities are numbered by getNextDiscriminator() in each mangle
+  // context, so another context may have given them different names.
+  bool IsLocal = ND->getParentFunctionOrMethod() != 0;
+  void *Key = GD.getCanonicalDecl().getAsOpaquePtr();
+  if (IsLocal) {
+    llvm::DenseMap<void *, StringRef>::iterator I = LocalMangledNames.find(Key);
+    if (I != LocalMangledNames.end())
+      return I->second;
+  } else {
+    StringRef Cached = Context.getCachedMangledName(GD);
+    if (!Cached.empty())
+      return Cached;
+  }
+
+  if (!shouldMangleDeclName(ND)) {
+    IdentifierInfo *II = ND->getIdentifier();
+    assert(II && "Attempt to mangle unnamed decl.");
+    return II->getName();
+  }
+
+  SmallString<256> Buffer;
+  llvm::raw_svector_ostream Out(Buffer);
+  if (const CXXConstructorDecl *D = dyn_cast<CXXConstructorDecl>(ND))
+    mangleCXXCtor(D, GD.getCtorType(), Out);
+  else if (const CXXDestructorDecl *D = dyn_cast<CXXDestructorDecl>(ND))
+    mangleCXXDtor(D, GD.getDtorType(), Out);
+  else
+    mangleName(ND, Out);
+  Out.flush();
+
+  if (!IsLocal)
+    return Context.setCachedMangledName(GD, Buffer.str());
+
+  char *Mem = static_cast<char *>(Context.Allocate(Buffer.size(), 1));
+  std::copy(Buffer.begin(), Buffer.end(), Mem);
+  StringRef Stored(Mem, Buffer.size());
+  LocalMangledNames[Key] = Stored;
+  return Stored;
+}
+
 void MangleContext::mangleGlobalBlock(const BlockDecl *BD,
                                       const NamedDecl *ID,
                                       raw_ostream &Out) {
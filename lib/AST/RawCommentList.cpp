@@ -220,7 +220,19 @@ void RawCommentList::addComment(const RawComment &RC,
               RC.getSourceRange().getBegin())) {
     // If they are, just pop a few last comments that don't fit.
     // This happens if an \#include directive contains comments.
+    RawComment *Popped = Comments.back();
     Comments.pop_back();
+
+    // The popped comment is the last one grouped into its file, if it has
+    // been grouped at all.
+    if (Comments.size() < NumCommentsInFiles) {
+      std::vector<RawComment *> &InFile = CommentsInFiles[
+          SourceMgr.getFileID(Popped->getSourceRange().getBegin())];
+      assert(!InFile.empty() && InFile.back() == Popped &&
+             "comment grouped out of order");
+      InFile.pop_back();
+      --NumCommentsInFiles;
+    }
   }
 
   if (OnlyWhitespaceSeen) {
@@ -268,3 +280,22 @@ void RawCommentList::addComment(const RawComment &RC,
 
   OnlyWhitespaceSeen = true;
 }
+
+ArrayRef<RawComment *> RawCommentList::getCommentsInFile(FileID File) const {
+  // Group the comments added since the last lookup by file. Comments are
+  // added in translation unit order, so each group stays sorted. Merging only
+  // ever extends the last comment within its file.
+  for (unsigned N = Comments.size(); NumCommentsInFiles != N;
+       ++NumCommentsInFiles) {
+    RawComment *RC = Comments[NumCommentsInFiles];
+    FileID CommentFile
+      = SourceMgr.getFileID(RC->getSourceRange().getBegin());
+    CommentsInFiles[CommentFile].push_back(RC);
+  }
+
+  llvm::DenseMap<FileID, std::vector<RawComment *> >::const_iterator Pos
+    = CommentsInFiles.find(File);
+  if (Pos == CommentsInFiles.end())
+    return ArrayRef<RawComment *>();
+  return Pos->second;
+}
@@ -2362,9 +2362,17 @@ ASTContext::getASTRecordLayout(const RecordDecl *D) const {
   const ASTRecordLayout *Entry = ASTRecordLayouts[D];
   if (Entry) return *Entry;
 
-  const ASTRecordLayout *NewEntry;
-
-  if (const CXXRecordDecl *RD = dyn_cast<CXXRecordDecl>(D)) {
+  // If the record was laid out while building the AST file it came from,
+  // reuse that layout rather than laying the record out again. Otherwise the
+  // builder below asks the external source for a layout of its own.
+  const ASTRecordLayout *NewEntry = 0;
+  if (D->isFromASTFile())
+    if (ExternalASTSource *External = getExternalSource())
+      NewEntry = External->GetExternalRecordLayout(D);
+
+  if (NewEntry) {
+    // The layout came from the AST file.
+  } else if (const CXXRecordDecl *RD = dyn_cast<CXXRecordDecl>(D)) {
     EmptySubobjectMap EmptySubobjects(*this, RD);
     RecordLayoutBuilder Builder(*this, &EmptySubobjects);
     Builder.Layout(RD);
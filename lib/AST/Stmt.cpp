@@ -1170,3 +1170,131 @@ OMPParallelDirective *OMPParallelDirective::CreateEmpty(ASTContext &C,
                          llvm::alignOf<OMPParallelDirective>());
   return new (Mem) OMPParallelDirective(N);
 }
+
+OMPParallelForDirective *OMPParallelForDirective::Create(
+                                              ASTContext &C,
+                                              SourceLocation StartLoc,
+                                              SourceLocation EndLoc,
+                                              ArrayRef<OMPClause *> Clauses,
+                                              Stmt *AssociatedStmt) {
+  void *Mem = C.Allocate(sizeof(OMPParallelForDirective) +
+                         sizeof(OMPClause *) * Clauses.size() + sizeof(Stmt *),
+                         llvm::alignOf<OMPParallelForDirective>());
+  OMPParallelForDirective *Dir =
+    new (Mem) OMPParallelForDirective(StartLoc, EndLoc, Clauses.size());
+  Dir->setClauses(Clauses);
+  Dir->setAssociatedStmt(AssociatedStmt);
+  return Dir;
+}
+
+OMPParallelForDirective *OMPParallelForDirective::CreateEmpty(ASTContext &C,
+                                                              unsigned N,
+                                                              EmptyShell) {
+  void *Mem = C.Allocate(sizeof(OMPParallelForDirective) +
+                         sizeof(OMPClause *) * N + sizeof(Stmt *),
+                         llvm::alignOf<OMPParallelForDirective>());
+  return new (Mem) OMPParallelForDirective(N);
+}
+
+/// \brief Returns the variable \p E refers to, looking through parentheses
+/// and implicit casts, or null if it is not a reference to a variable.
+static const VarDecl *getReferencedVar(const Expr *E) {
+  if (const DeclRefExpr *DRE = dyn_cast<DeclRefExpr>(E->IgnoreParenImpCasts()))
+    return dyn_cast<VarDecl>(DRE->getDecl());
+  return 0;
+}
+
+static bool refersToVar(const Expr *E, const VarDecl *VD) {
+  const VarDecl *RefVD = getReferencedVar(E);
+  return RefVD && RefVD->getCanonicalDecl() == VD->getCanonicalDecl();
+}
+
+OMPCanonicalLoop::Form OMPCanonicalLoop::analyze(const ForStmt *For) {
+  // init-expr: var = lb, or integer-type var = lb.
+  const Stmt *Init = For->getInit();
+  if (!Init)
+    return BadInit;
+  if (const DeclStmt *DS = dyn_cast<DeclStmt>(Init)) {
+    if (!DS->isSingleDecl())
+      return BadInit;
+    Var = dyn_cast<VarDecl>(DS->getSingleDecl());
+    if (!Var || !Var->getInit())
+      return BadInit;
+    LowerBound = Var->getInit();
+  } else if (const BinaryOperator *BO = dyn_cast<BinaryOperator>(Init)) {
+    if (BO->getOpcode() != BO_Assign)
+      return BadInit;
+    Var = getReferencedVar(BO->getLHS());
+    if (!Var)
+      return BadInit;
+    LowerBound = BO->getRHS();
+  } else {
+    return BadInit;
+  }
+  if (!Var->getType()->isIntegerType())
+    return BadVarType;
+
+  // test-expr: var relational-op b, or b relational-op var.
+  const BinaryOperator *Test =
+    dyn_cast_or_null<BinaryOperator>(For->getCond());
+  if (!Test || !Test->isRelationalOp())
+    return BadTest;
+  if (refersToVar(Test->getLHS(), Var)) {
+    TestBound = Test->getRHS();
+    TestOp = Test->getOpcode();
+  } else if (refersToVar(Test->getRHS(), Var)) {
+    TestBound = Test->getLHS();
+    switch (Test->getOpcode()) {
+    case BO_LT: TestOp = BO_GT; break;
+    case BO_LE: TestOp = BO_GE; break;
+    case BO_GT: TestOp = BO_LT; break;
+    case BO_GE: TestOp = BO_LE; break;
+    default: llvm_unreachable("not a relational operator");
+    }
+  } else {
+    return BadTest;
+  }
+
+  // incr-expr: ++var, var++, --var, var--, var += incr, var -= incr,
+  // var = var + incr, var = incr + var, or var = var - incr.
+  const Expr *Inc = For->getInc();
+  if (!Inc)
+    return BadIncr;
+  Inc = Inc->IgnoreParens();
+  if (const UnaryOperator *UO = dyn_cast<UnaryOperator>(Inc)) {
+    if (!UO->isIncrementDecrementOp() || !refersToVar(UO->getSubExpr(), Var))
+      return BadIncr;
+    Step = 0;
+    IsDecrement = UO->isDecrementOp();
+  } else if (const CompoundAssignOperator *CAO =
+               dyn_cast<CompoundAssignOperator>(Inc)) {
+    if ((CAO->getOpcode() != BO_AddAssign &&
+         CAO->getOpcode() != BO_SubAssign) ||
+        !refersToVar(CAO->getLHS(), Var))
+      return BadIncr;
+    Step = CAO->getRHS();
+    IsDecrement = CAO->getOpcode() == BO_SubAssign;
+  } else if (const BinaryOperator *BO = dyn_cast<BinaryOperator>(Inc)) {
+    if (BO->getOpcode() != BO_Assign || !refersToVar(BO->getLHS(), Var))
+      return BadIncr;
+    const BinaryOperator *Add =
+      dyn_cast<BinaryOperator>(BO->getRHS()->IgnoreParenImpCasts());
+    if (!Add)
+      return BadIncr;
+    if (Add->getOpcode() == BO_Add && refersToVar(Add->getLHS(), Var))
+      Step = Add->getRHS();
+    else if (Add->getOpcode() == BO_Add && refersToVar(Add->getRHS(), Var))
+      Step = Add->getLHS();
+    else if (Add->getOpcode() == BO_Sub && refersToVar(Add->getLHS(), Var))
+      Step = Add->getRHS();
+    else
+      return BadIncr;
+    IsDecrement = Add->getOpcode() == BO_Sub;
+  } else {
+    return BadIncr;
+  }
+  if (Step && !Step->getType()->isIntegerType())
+    return BadIncr;
+
+  return Canonical;
+}
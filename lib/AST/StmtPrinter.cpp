@@ -70,6 +70,7 @@ namespace  {
     void PrintCallArgs(CallExpr *E);
     void PrintRawSEHExceptHandler(SEHExceptStmt *S);
     void PrintRawSEHFinallyStmt(SEHFinallyStmt *S);
+    void PrintOMPExecutableDirective(OMPExecutableDirective *S);
 
     void PrintExpr(Expr *E) {
       if (E)
@@ -172,19 +173,35 @@ void StmtPrinter::VisitLabelStmt(LabelStmt *Node) {
 }
 
 void StmtPrinter::VisitAttributedStmt(AttributedStmt *Node) {
-  OS << "[[";
-  bool first = true;
+  // Loop hints are printed as the pragmas they were spelled with, each on a
+  // line of its own.
+  SmallVector<const Attr *, 4> Attrs;
   for (ArrayRef<const Attr*>::iterator it = Node->getAttrs().begin(),
                                        end = Node->getAttrs().end();
                                        it != end; ++it) {
-    if (!first) {
-      OS << ", ";
-      first = false;
+    if (isa<LoopHintAttr>(*it)) {
+      Indent();
+      (*it)->printPretty(OS, Policy);
+    } else {
+      Attrs.push_back(*it);
     }
-    // TODO: check this
-    (*it)->printPretty(OS, Policy);
   }
-  OS << "]] ";
+
+  if (!Attrs.empty()) {
+    OS << "[[";
+    bool first = true;
+    for (SmallVectorImpl<const Attr*>::iterator it = Attrs.begin(),
+                                                end = Attrs.end();
+                                                it != end; ++it) {
+      if (!first) {
+        OS << ", ";
+        first = false;
+      }
+      // TODO: check this
+      (*it)->printPretty(OS, Policy);
+    }
+    OS << "]] ";
+  }
   PrintStmt(Node->getSubStmt(), 0);
 }
 
@@ -586,8 +603,10 @@ void StmtPrinter::VisitSEHFinallyStmt(SEHFinallyStmt *Node) {
 namespace {
 class OMPClausePrinter : public OMPClauseVisitor<OMPClausePrinter> {
   raw_ostream &OS;
+  const PrintingPolicy &Policy;
 public:
-  OMPClausePrinter(raw_ostream &OS) : OS(OS) { }
+  OMPClausePrinter(raw_ostream &OS, const PrintingPolicy &Policy)
+    : OS(OS), Policy(Policy) { }
 #define OPENMP_CLAUSE(Name, Class)                              \
   void Visit##Class(Class *S);
 #include "clang/Basic/OpenMPKinds.def"
@@ -599,6 +618,16 @@ void OMPClausePrinter::VisitOMPDefaultClause(OMPDefaultClause *Node) {
      << ")";
 }
 
+void OMPClausePrinter::VisitOMPScheduleClause(OMPScheduleClause *Node) {
+  OS << "schedule("
+     << getOpenMPSimpleClauseTypeName(OMPC_schedule, Node->getScheduleKind());
+  if (Expr *ChunkSize = Node->getChunkSize()) {
+    OS << ", ";
+    ChunkSize->printPretty(OS, 0, Policy);
+  }
+  OS << ")";
+}
+
 #define PROCESS_OMP_CLAUSE_LIST(Class, Node, StartSym)                         \
   for (OMPVarList<Class>::varlist_iterator I = Node->varlist_begin(),          \
                                            E = Node->varlist_end();            \
@@ -621,11 +650,9 @@ void OMPClausePrinter::VisitOMPPrivateClause(OMPPrivateClause *Node) {
 //  OpenMP directives printing methods
 //===----------------------------------------------------------------------===//
 
-void StmtPrinter::VisitOMPParallelDirective(OMPParallelDirective *Node) {
-  Indent() << "#pragma omp parallel ";
-
-  OMPClausePrinter Printer(OS);
-  ArrayRef<OMPClause *> Clauses = Node->clauses();
+void StmtPrinter::PrintOMPExecutableDirective(OMPExecutableDirective *S) {
+  OMPClausePrinter Printer(OS, Policy);
+  ArrayRef<OMPClause *> Clauses = S->clauses();
   for (ArrayRef<OMPClause *>::iterator I = Clauses.begin(), E = Clauses.end();
        I != E; ++I)
     if (*I && !(*I)->isImplicit()) {
@@ -633,13 +660,24 @@ void StmtPrinter::VisitOMPParallelDirective(OMPParallelDirective *Node) {
       OS << ' ';
     }
   OS << "\n";
-  if (Node->getAssociatedStmt()) {
-    assert(isa<CapturedStmt>(Node->getAssociatedStmt()) &&
+  if (S->getAssociatedStmt()) {
+    assert(isa<CapturedStmt>(S->getAssociatedStmt()) &&
            "Expected captured statement!");
-    Stmt *CS = cast<CapturedStmt>(Node->getAssociatedStmt())->getCapturedStmt();
+    Stmt *CS = cast<CapturedStmt>(S->getAssociatedStmt())->getCapturedStmt();
     PrintStmt(CS);
   }
 }
+
+void StmtPrinter::VisitOMPParallelDirective(OMPParallelDirective *Node) {
+  Indent() << "#pragma omp parallel ";
+  PrintOMPExecutableDirective(Node);
+}
+
+void StmtPrinter::VisitOMPParallelForDirective(OMPParallelForDirective *Node) {
+  Indent() << "#pragma omp parallel for ";
+  PrintOMPExecutableDirective(Node);
+}
+
 //===----------------------------------------------------------------------===//
 //  Expr printing methods.
 //===----------------------------------------------------------------------===//
@@ -8,7 +8,8 @@
 //===----------------------------------------------------------------------===//
 //
 // This file implements the Stmt::Profile method, which builds a unique bit
-// representation that identifies a statement/expression.
+// representation that identifies a statement/expression, and the
+// StructuralHasher, which streams the same structure into a compact hash.
 //
 //===----------------------------------------------------------------------===//
 #include "clang/AST/ASTContext.h"
@@ -19,19 +20,146 @@
 #include "clang/AST/ExprCXX.h"
 #include "clang/AST/ExprObjC.h"
 #include "clang/AST/StmtVisitor.h"
+#include "clang/AST/StructuralHash.h"
 #include "llvm/ADT/FoldingSet.h"
+#include "llvm/Support/raw_ostream.h"
 using namespace clang;
 
 namespace {
+  /// \brief Streams the profile of a statement into a 128-bit hash, using the
+  /// block mixing and finalization steps of MurmurHash3.
+  class StructuralHashBuilder {
+    uint64_t H1, H2;
+
+    static uint64_t rotl(uint64_t X, unsigned R) {
+      return (X << R) | (X >> (64 - R));
+    }
+
+    static uint64_t fmix(uint64_t K) {
+      K ^= K >> 33;
+      K *= 0xff51afd7ed558ccdULL;
+      K ^= K >> 33;
+      K *= 0xc4ceb9fe1a85ec53ULL;
+      K ^= K >> 33;
+      return K;
+    }
+
+  public:
+    StructuralHashBuilder()
+      : H1(0x9ae16a3b2f90404fULL), H2(0xc949d7c7509e6557ULL) { }
+
+    void AddInteger(uint64_t V) {
+      const uint64_t C1 = 0x87c37b91114253d5ULL;
+      const uint64_t C2 = 0x4cf5ad432745937fULL;
+
+      uint64_t K1 = rotl(V * C1, 31) * C2;
+      H1 ^= K1;
+      H1 = rotl(H1, 27) + H2;
+      H1 = H1 * 5 + 0x52dce729;
+
+      uint64_t K2 = rotl(V * C2, 33) * C1;
+      H2 ^= K2;
+      H2 = rotl(H2, 31) + H1;
+      H2 = H2 * 5 + 0x38495ab5;
+    }
+
+    void AddPointer(const void *P) {
+      // Addresses differ from one compilation to the next, so the hasher
+      // identifies entities by name; only null pointers get here.
+      assert(!P && "structural hash depends on an address");
+      AddInteger(0);
+    }
+
+    void AddString(StringRef S) {
+      // Assemble the words byte by byte, so that the hash does not depend on
+      // the endianness of the host.
+      AddInteger(S.size());
+      for (size_t I = 0, N = S.size(); I < N; I += 8) {
+        uint64_t Word = 0;
+        for (size_t J = 0; J != 8 && I + J != N; ++J)
+          Word |= uint64_t(static_cast<unsigned char>(S[I + J])) << (8 * J);
+        AddInteger(Word);
+      }
+    }
+
+    StructuralHash finish() const {
+      uint64_t A = H1 + H2;
+      uint64_t B = H2 + A;
+      A = fmix(A);
+      B = fmix(B);
+      A += B;
+      B += A;
+      return StructuralHash(A, B);
+    }
+  };
+
+  /// \brief Receives the data that identifies a statement, and adds it either
+  /// to a FoldingSetNodeID or to a StructuralHashBuilder.
+  ///
+  /// Stmt::Profile runs whenever a dependent type or template argument is
+  /// uniqued, so the sink picks its destination with a branch that inlines
+  /// into the profiler rather than with a virtual call.
+  class StmtProfileSink {
+    llvm::FoldingSetNodeID *NodeID;
+    StructuralHashBuilder *Builder;
+
+  public:
+    explicit StmtProfileSink(llvm::FoldingSetNodeID &ID)
+      : NodeID(&ID), Builder(0) { }
+    explicit StmtProfileSink(StructuralHashBuilder &Builder)
+      : NodeID(0), Builder(&Builder) { }
+
+    void AddInteger(uint64_t V) {
+      if (NodeID)
+        NodeID->AddInteger(static_cast<unsigned long long>(V));
+      else
+        Builder->AddInteger(V);
+    }
+
+    void AddPointer(const void *P) {
+      if (NodeID)
+        NodeID->AddPointer(P);
+      else
+        Builder->AddPointer(P);
+    }
+
+    void AddString(StringRef S) {
+      if (NodeID)
+        NodeID->AddString(S);
+      else
+        Builder->AddString(S);
+    }
+
+    void AddBoolean(bool B) { AddInteger(B); }
+
+    void AddAPInt(const llvm::APInt &I) {
+      AddInteger(I.getBitWidth());
+      const uint64_t *Words = I.getRawData();
+      for (unsigned W = 0, N = I.getNumWords(); W != N; ++W)
+        AddInteger(Words[W]);
+    }
+
+    void AddAPFloat(const llvm::APFloat &F) {
+      AddAPInt(F.bitcastToAPInt());
+    }
+  };
+
   class StmtProfiler : public ConstStmtVisitor<StmtProfiler> {
-    llvm::FoldingSetNodeID &ID;
+  protected:
+    StmtProfileSink ID;
     const ASTContext &Context;
     bool Canonical;
 
+    /// \brief Whether the values of literals are part of the profile.
+    bool ProfileLiteralValues;
+
   public:
-    StmtProfiler(llvm::FoldingSetNodeID &ID, const ASTContext &Context,
+    StmtProfiler(StmtProfileSink ID, const ASTContext &Context,
                  bool Canonical)
-      : ID(ID), Context(Context), Canonical(Canonical) { }
+      : ID(ID), Context(Context), Canonical(Canonical),
+        ProfileLiteralValues(true) { }
+
+    virtual ~StmtProfiler() { }
 
     void VisitStmt(const Stmt *S);
 
@@ -40,22 +168,22 @@ namespace {
 
     /// \brief Visit a declaration that is referenced within an expression
     /// or statement.
-    void VisitDecl(const Decl *D);
+    virtual void VisitDecl(const Decl *D);
 
     /// \brief Visit a type that is referenced within an expression or
     /// statement.
-    void VisitType(QualType T);
+    virtual void VisitType(QualType T);
 
     /// \brief Visit a name that occurs within an expression or statement.
-    void VisitName(DeclarationName Name);
+    virtual void VisitName(DeclarationName Name);
 
     /// \brief Visit a nested-name-specifier that occurs within an expression
     /// or statement.
-    void VisitNestedNameSpecifier(NestedNameSpecifier *NNS);
+    virtual void VisitNestedNameSpecifier(NestedNameSpecifier *NNS);
 
     /// \brief Visit a template name that occurs within an expression or
     /// statement.
-    void VisitTemplateName(TemplateName Name);
+    virtual void VisitTemplateName(TemplateName Name);
 
     /// \brief Visit template arguments that occur within an expression or
     /// statement.
@@ -263,6 +391,10 @@ public:
 };
 
 void OMPClauseProfiler::VisitOMPDefaultClause(const OMPDefaultClause *C) { }
+void OMPClauseProfiler::VisitOMPScheduleClause(const OMPScheduleClause *C) {
+  if (C->getChunkSize())
+    Profiler->VisitStmt(C->getChunkSize());
+}
 #define PROCESS_OMP_CLAUSE_LIST(Class, Node)                                   \
   for (OMPVarList<Class>::varlist_const_iterator I = Node->varlist_begin(),    \
                                                  E = Node->varlist_end();      \
@@ -276,7 +408,7 @@ void OMPClauseProfiler::VisitOMPPrivateClause(const OMPPrivateClause *C) {
 }
 
 void
-StmtProfiler::VisitOMPParallelDirective(const OMPParallelDirective *S) {
+StmtProfiler::VisitOMPExecutableDirective(const OMPExecutableDirective *S) {
   VisitStmt(S);
   OMPClauseProfiler P(this);
   ArrayRef<OMPClause *> Clauses = S->clauses();
@@ -286,6 +418,16 @@ StmtProfiler::VisitOMPParallelDirective(const OMPParallelDirective *S) {
       P.Visit(*I);
 }
 
+void
+StmtProfiler::VisitOMPParallelDirective(const OMPParallelDirective *S) {
+  VisitOMPExecutableDirective(S);
+}
+
+void
+StmtProfiler::VisitOMPParallelForDirective(const OMPParallelForDirective *S) {
+  VisitOMPExecutableDirective(S);
+}
+
 void StmtProfiler::VisitExpr(const Expr *S) {
   VisitStmt(S);
 }
@@ -306,19 +448,23 @@ void StmtProfiler::VisitPredefinedExpr(const PredefinedExpr *S) {
 
 void StmtProfiler::VisitIntegerLiteral(const IntegerLiteral *S) {
   VisitExpr(S);
-  S->getValue().Profile(ID);
+  if (ProfileLiteralValues)
+    ID.AddAPInt(S->getValue());
 }
 
 void StmtProfiler::VisitCharacterLiteral(const CharacterLiteral *S) {
   VisitExpr(S);
   ID.AddInteger(S->getKind());
-  ID.AddInteger(S->getValue());
+  if (ProfileLiteralValues)
+    ID.AddInteger(S->getValue());
 }
 
 void StmtProfiler::VisitFloatingLiteral(const FloatingLiteral *S) {
   VisitExpr(S);
-  S->getValue().Profile(ID);
-  ID.AddBoolean(S->isExact());
+  if (ProfileLiteralValues) {
+    ID.AddAPFloat(S->getValue());
+    ID.AddBoolean(S->isExact());
+  }
 }
 
 void StmtProfiler::VisitImaginaryLiteral(const ImaginaryLiteral *S) {
@@ -327,7 +473,8 @@ void StmtProfiler::VisitImaginaryLiteral(const ImaginaryLiteral *S) {
 
 void StmtProfiler::VisitStringLiteral(const StringLiteral *S) {
   VisitExpr(S);
-  ID.AddString(S->getBytes());
+  if (ProfileLiteralValues)
+    ID.AddString(S->getBytes());
   ID.AddInteger(S->getKind());
 }
 
@@ -360,7 +507,7 @@ void StmtProfiler::VisitOffsetOfExpr(const OffsetOfExpr *S) {
       break;
 
     case OffsetOfExpr::OffsetOfNode::Identifier:
-      ID.AddPointer(ON.getFieldName());
+      VisitName(ON.getFieldName());
       break;
         
     case OffsetOfExpr::OffsetOfNode::Base:
@@ -1204,7 +1351,7 @@ void StmtProfiler::VisitTemplateName(TemplateName Name) {
   if (Canonical)
     Name = Context.getCanonicalTemplateName(Name);
 
-  Name.Profile(ID);
+  ID.AddPointer(Name.getAsVoidPointer());
 }
 
 void StmtProfiler::VisitTemplateArguments(const TemplateArgumentLoc *Args,
@@ -1239,7 +1386,8 @@ void StmtProfiler::VisitTemplateArgument(const TemplateArgument &Arg) {
     break;
 
   case TemplateArgument::Integral:
-    Arg.getAsIntegral().Profile(ID);
+    ID.AddBoolean(Arg.getAsIntegral().isUnsigned());
+    ID.AddAPInt(Arg.getAsIntegral());
     VisitType(Arg.getIntegralType());
     break;
 
@@ -1257,6 +1405,198 @@ void StmtProfiler::VisitTemplateArgument(const TemplateArgument &Arg) {
 
 void Stmt::Profile(llvm::FoldingSetNodeID &ID, const ASTContext &Context,
                    bool Canonical) const {
-  StmtProfiler Profiler(ID, Context, Canonical);
+  StmtProfileSink Sink(ID);
+  StmtProfiler Profiler(Sink, Context, Canonical);
   Profiler.Visit(this);
 }
+
+namespace {
+  /// \brief Profiles a statement for a StructuralHasher, identifying the
+  /// declarations, types and names it refers to by their spelling rather than
+  /// by address.
+  class StmtHasher : public StmtProfiler {
+    bool IgnoreIdentifiers;
+    StructuralHasher::NameHashMap &NameHashes;
+
+    /// \brief The kinds of entities whose names are cached. A template name
+    /// and the template declaration it refers to share an address, but are
+    /// printed differently.
+    enum NameKind { NK_Decl, NK_Type, NK_NestedNameSpecifier, NK_Template };
+
+    /// \brief Hash a string on its own, for caching in NameHashes.
+    static uint64_t hashString(StringRef Str) {
+      StructuralHashBuilder Builder;
+      Builder.AddString(Str);
+      return Builder.finish().get64();
+    }
+
+    /// \brief Add the hash of the string printed by \p Print for the entity
+    /// \p Ptr, printing it only the first time the entity is seen.
+    template<typename PrintFn>
+    void AddCachedName(NameKind Kind, const void *Ptr, PrintFn Print) {
+      std::pair<StructuralHasher::NameHashMap::iterator, bool> Known
+        = NameHashes.insert(std::make_pair(std::make_pair(Ptr, (unsigned)Kind),
+                                           uint64_t(0)));
+      if (Known.second) {
+        std::string Buffer;
+        llvm::raw_string_ostream OS(Buffer);
+        Print(OS);
+        Known.first->second = hashString(OS.str());
+      }
+      ID.AddInteger(Known.first->second);
+    }
+
+    struct PrintType {
+      QualType T;
+      const PrintingPolicy &Policy;
+      void operator()(raw_ostream &OS) const { T.print(OS, Policy); }
+    };
+
+    struct PrintDeclName {
+      const NamedDecl *ND;
+      void operator()(raw_ostream &OS) const {
+        // Local declarations are identified by their unqualified name, so
+        // that moving a body into a differently-named function does not
+        // change its hash.
+        if (ND->getParentFunctionOrMethod())
+          OS << ND->getDeclName();
+        else
+          OS << ND->getQualifiedNameAsString();
+      }
+    };
+
+    struct PrintNestedNameSpecifier {
+      NestedNameSpecifier *NNS;
+      const PrintingPolicy &Policy;
+      void operator()(raw_ostream &OS) const { NNS->print(OS, Policy); }
+    };
+
+    struct PrintTemplateName {
+      TemplateName Name;
+      const PrintingPolicy &Policy;
+      void operator()(raw_ostream &OS) const { Name.print(OS, Policy); }
+    };
+
+    PrintingPolicy Policy;
+
+  public:
+    StmtHasher(StructuralHashBuilder &Builder, const ASTContext &Context,
+               unsigned Flags, StructuralHasher::NameHashMap &NameHashes)
+      : StmtProfiler(StmtProfileSink(Builder), Context, /*Canonical=*/false),
+        IgnoreIdentifiers(Flags & SHF_IgnoreIdentifiers),
+        NameHashes(NameHashes), Policy(Context.getLangOpts()) {
+      ProfileLiteralValues = !(Flags & SHF_IgnoreLiterals);
+    }
+
+    virtual void VisitDecl(const Decl *D) {
+      ID.AddInteger(D? D->getKind() : 0);
+      if (!D)
+        return;
+
+      // Identify parameters by position, as canonical profiles do.
+      if (const ParmVarDecl *Parm = dyn_cast<ParmVarDecl>(D)) {
+        VisitType(Parm->getType());
+        ID.AddInteger(Parm->getFunctionScopeDepth());
+        ID.AddInteger(Parm->getFunctionScopeIndex());
+        return;
+      }
+
+      if (const ValueDecl *VD = dyn_cast<ValueDecl>(D))
+        VisitType(VD->getType());
+
+      const NamedDecl *ND = dyn_cast<NamedDecl>(D);
+      if (IgnoreIdentifiers || !ND || !ND->getDeclName())
+        return;
+
+      ND = cast<NamedDecl>(ND->getCanonicalDecl());
+      PrintDeclName Print = { ND };
+      AddCachedName(NK_Decl, ND, Print);
+    }
+
+    virtual void VisitType(QualType T) {
+      if (T.isNull()) {
+        ID.AddInteger(0);
+        return;
+      }
+
+      T = Context.getCanonicalType(T);
+      PrintType Print = { T, Policy };
+      AddCachedName(NK_Type, T.getAsOpaquePtr(), Print);
+    }
+
+    virtual void VisitName(DeclarationName Name) {
+      ID.AddInteger(Name.getNameKind());
+      if (IgnoreIdentifiers)
+        return;
+
+      if (IdentifierInfo *II = Name.getAsIdentifierInfo()) {
+        ID.AddString(II->getName());
+        return;
+      }
+      ID.AddString(Name.getAsString());
+    }
+
+    virtual void VisitNestedNameSpecifier(NestedNameSpecifier *NNS) {
+      if (!NNS || IgnoreIdentifiers) {
+        ID.AddInteger(0);
+        return;
+      }
+
+      PrintNestedNameSpecifier Print = { NNS, Policy };
+      AddCachedName(NK_NestedNameSpecifier, NNS, Print);
+    }
+
+    virtual void VisitTemplateName(TemplateName Name) {
+      if (IgnoreIdentifiers) {
+        ID.AddInteger(Name.getKind());
+        return;
+      }
+
+      PrintTemplateName Print = { Name, Policy };
+      AddCachedName(NK_Template, Name.getAsVoidPointer(), Print);
+    }
+
+    /// \brief Visit the definition of a declaration: its signature, plus the
+    /// body of a function or the initializer of a variable.
+    void VisitDeclDefinition(const Decl *D) {
+      VisitDecl(D);
+
+      if (const FunctionDecl *FD = dyn_cast_or_null<FunctionDecl>(D)) {
+        ID.AddInteger(FD->getNumParams());
+        for (unsigned I = 0, N = FD->getNumParams(); I != N; ++I) {
+          VisitType(FD->getParamDecl(I)->getType());
+          VisitName(FD->getParamDecl(I)->getDeclName());
+        }
+        if (const Stmt *Body = FD->getBody())
+          Visit(Body);
+        else
+          ID.AddInteger(0);
+        return;
+      }
+
+      if (const VarDecl *VD = dyn_cast_or_null<VarDecl>(D)) {
+        if (const Expr *Init = VD->getInit())
+          Visit(Init);
+        else
+          ID.AddInteger(0);
+      }
+    }
+  };
+}
+
+StructuralHash StructuralHasher::hash(const Stmt *S) {
+  StructuralHashBuilder Builder;
+  StmtHasher Hasher(Builder, Context, Flags, NameHashes);
+  if (S)
+    Hasher.Visit(S);
+  else
+    Builder.AddInteger(0);
+  return Builder.finish();
+}
+
+StructuralHash StructuralHasher::hash(const Decl *D) {
+  StructuralHashBuilder Builder;
+  StmtHasher Hasher(Builder, Context, Flags, NameHashes);
+  Hasher.VisitDeclDefinition(D);
+  return Builder.finish();
+}
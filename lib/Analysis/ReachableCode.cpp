@@ -288,18 +288,39 @@ unsigned ScanReachableFromBlock(const CFGBlock *Start,
   }
   return count;
 }
+
+void ReachableBlocks::anchor() { }
+
+ReachableBlocks::ReachableBlocks(const CFG &cfg)
+  : Reachable(cfg.getNumBlockIDs()) {
+  NumReachable = ScanReachableFromBlock(&cfg.getEntry(), Reachable);
+}
+
+bool ReachableBlocks::isReachable(const CFGBlock *B) const {
+  return Reachable[B->getBlockID()];
+}
+
+const void *ReachableBlocks::getTag() { static int x; return &x; }
+
+ReachableBlocks *ReachableBlocks::create(AnalysisDeclContext &AC) {
+  const CFG *cfg = AC.getCFG();
+  if (!cfg)
+    return 0;
+  return new ReachableBlocks(*cfg);
+}
   
 void FindUnreachableCode(AnalysisDeclContext &AC, Callback &CB) {
-  CFG *cfg = AC.getCFG();
-  if (!cfg)
+  ReachableBlocks *RB = AC.getAnalysis<ReachableBlocks>();
+  if (!RB)
     return;
+  CFG *cfg = AC.getCFG();
 
-  // Scan for reachable blocks from the entrance of the CFG.  
+  // Start from the blocks reachable from the entrance of the CFG.
   // If there are no unreachable blocks, we're done.
-  llvm::BitVector reachable(cfg->getNumBlockIDs());
-  unsigned numReachable = ScanReachableFromBlock(&cfg->getEntry(), reachable);
+  unsigned numReachable = RB->getNumReachable();
   if (numReachable == cfg->getNumBlockIDs())
     return;
+  llvm::BitVector reachable(RB->getBlocks());
   
   // If there aren't explicit EH edges, we should include the 'try' dispatch
   // blocks as roots.
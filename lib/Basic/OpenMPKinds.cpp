@@ -24,6 +24,8 @@ OpenMPDirectiveKind clang::getOpenMPDirectiveKind(StringRef Str) {
   return llvm::StringSwitch<OpenMPDirectiveKind>(Str)
 #define OPENMP_DIRECTIVE(Name) \
            .Case(#Name, OMPD_##Name)
+#define OPENMP_DIRECTIVE_EXT(Name, Str) \
+           .Case(Str, OMPD_##Name)
 #include "clang/Basic/OpenMPKinds.def"
            .Default(OMPD_unknown);
 }
@@ -35,6 +37,8 @@ const char *clang::getOpenMPDirectiveName(OpenMPDirectiveKind Kind) {
     return "unknown";
 #define OPENMP_DIRECTIVE(Name) \
   case OMPD_##Name : return #Name;
+#define OPENMP_DIRECTIVE_EXT(Name, Str) \
+  case OMPD_##Name : return Str;
 #include "clang/Basic/OpenMPKinds.def"
   case NUM_OPENMP_DIRECTIVES:
     break;
@@ -75,6 +79,12 @@ unsigned clang::getOpenMPSimpleClauseType(OpenMPClauseKind Kind,
              .Case(#Name, OMPC_DEFAULT_##Name)
 #include "clang/Basic/OpenMPKinds.def"
              .Default(OMPC_DEFAULT_unknown);
+  case OMPC_schedule:
+    return llvm::StringSwitch<OpenMPScheduleClauseKind>(Str)
+#define OPENMP_SCHEDULE_KIND(Name) \
+             .Case(#Name, OMPC_SCHEDULE_##Name)
+#include "clang/Basic/OpenMPKinds.def"
+             .Default(OMPC_SCHEDULE_unknown);
   case OMPC_unknown:
   case OMPC_threadprivate:
   case OMPC_private:
@@ -96,6 +106,15 @@ const char *clang::getOpenMPSimpleClauseTypeName(OpenMPClauseKind Kind,
 #include "clang/Basic/OpenMPKinds.def"
     }
     llvm_unreachable("Invalid OpenMP 'default' clause type");
+  case OMPC_schedule:
+    switch (Type) {
+    case OMPC_SCHEDULE_unknown:
+      return "unknown";
+#define OPENMP_SCHEDULE_KIND(Name) \
+    case OMPC_SCHEDULE_##Name : return #Name;
+#include "clang/Basic/OpenMPKinds.def"
+    }
+    llvm_unreachable("Invalid OpenMP 'schedule' clause type");
   case OMPC_unknown:
   case OMPC_threadprivate:
   case OMPC_private:
@@ -114,6 +133,15 @@ bool clang::isAllowedClauseForDirective(OpenMPDirectiveKind DKind,
     switch (CKind) {
 #define OPENMP_PARALLEL_CLAUSE(Name) \
     case OMPC_##Name: return true;
+#include "clang/Basic/OpenMPKinds.def"
+    default:
+      break;
+    }
+    break;
+  case OMPD_parallel_for:
+    switch (CKind) {
+#define OPENMP_PARALLEL_FOR_CLAUSE(Name) \
+    case OMPC_##Name: return true;
 #include "clang/Basic/OpenMPKinds.def"
     default:
       break;
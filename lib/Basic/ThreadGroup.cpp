@@ -0,0 +1,110 @@
+//===- ThreadGroup.cpp - Threads Waited For Together ------------*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This file implements the ThreadGroup class, which runs functions on threads
+// that all run at once and are waited for together.
+//
+//===----------------------------------------------------------------------===//
+#include "clang/Basic/ThreadGroup.h"
+#include "llvm/Config/config.h"
+#include "llvm/Support/Threading.h"
+#include <vector>
+
+#if LLVM_ENABLE_THREADS != 0 && HAVE_PTHREAD_H
+#include <pthread.h>
+#define CLANG_HAVE_THREAD_GROUP 1
+#endif
+
+using namespace clang;
+
+#ifdef CLANG_HAVE_THREAD_GROUP
+namespace {
+/// \brief What a thread of the group calls.
+struct ThreadStart {
+  void (*Fn)(void *);
+  void *Arg;
+};
+}
+
+static void *runThreadStart(void *Arg) {
+  ThreadStart Start = *static_cast<ThreadStart *>(Arg);
+  delete static_cast<ThreadStart *>(Arg);
+  Start.Fn(Start.Arg);
+  return 0;
+}
+
+class ThreadGroup::Impl {
+public:
+  unsigned StackSize;
+  std::vector<pthread_t> Threads;
+};
+#else
+class ThreadGroup::Impl {
+public:
+  unsigned StackSize;
+};
+#endif
+
+ThreadGroup::ThreadGroup(unsigned StackSize) : TheImpl(new Impl) {
+  TheImpl->StackSize = StackSize;
+}
+
+ThreadGroup::~ThreadGroup() {
+  join();
+  delete TheImpl;
+}
+
+bool ThreadGroup::isSupported() {
+#ifdef CLANG_HAVE_THREAD_GROUP
+  return llvm::llvm_is_multithreaded() || llvm::llvm_start_multithreaded();
+#else
+  return false;
+#endif
+}
+
+bool ThreadGroup::start(void (*Fn)(void *), void *Arg) {
+#ifdef CLANG_HAVE_THREAD_GROUP
+  if (!llvm::llvm_is_multithreaded())
+    return false;
+
+  pthread_attr_t Attr;
+  if (::pthread_attr_init(&Attr) != 0)
+    return false;
+  if (TheImpl->StackSize &&
+      ::pthread_attr_setstacksize(&Attr, TheImpl->StackSize) != 0) {
+    ::pthread_attr_destroy(&Attr);
+    return false;
+  }
+
+  ThreadStart *Start = new ThreadStart;
+  Start->Fn = Fn;
+  Start->Arg = Arg;
+  pthread_t Thread;
+  bool Started = ::pthread_create(&Thread, &Attr, runThreadStart, Start) == 0;
+  ::pthread_attr_destroy(&Attr);
+  if (!Started) {
+    delete Start;
+    return false;
+  }
+  TheImpl->Threads.push_back(Thread);
+  return true;
+#else
+  (void)Fn;
+  (void)Arg;
+  return false;
+#endif
+}
+
+void ThreadGroup::join() {
+#ifdef CLANG_HAVE_THREAD_GROUP
+  for (unsigned I = 0, N = TheImpl->Threads.size(); I != N; ++I)
+    ::pthread_join(TheImpl->Threads[I], 0);
+  TheImpl->Threads.clear();
+#endif
+}
@@ -11,23 +11,40 @@
 #include "clang/Basic/Diagnostic.h"
 #include "clang/Basic/LangOptions.h"
 #include "clang/Basic/TargetOptions.h"
+#include "clang/Basic/ThreadGroup.h"
 #include "clang/Frontend/CodeGenOptions.h"
 #include "clang/Frontend/FrontendDiagnostic.h"
+#include "llvm/ADT/EquivalenceClasses.h"
+#include "llvm/ADT/SmallPtrSet.h"
+#include "llvm/ADT/SmallString.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/Triple.h"
 #include "llvm/Analysis/Verifier.h"
 #include "llvm/Assembly/PrintModulePass.h"
 #include "llvm/Bitcode/ReaderWriter.h"
 #include "llvm/CodeGen/RegAllocRegistry.h"
 #include "llvm/CodeGen/SchedulerRegistry.h"
+#include "llvm/Config/llvm-config.h"
+#include "llvm/IR/Constants.h"
 #include "llvm/IR/DataLayout.h"
+#include "llvm/IR/Instructions.h"
+#include "llvm/IR/LLVMContext.h"
 #include "llvm/IR/Module.h"
 #include "llvm/MC/SubtargetFeature.h"
 #include "llvm/PassManager.h"
 #include "llvm/Support/CommandLine.h"
+#include "llvm/Support/FileSystem.h"
 #include "llvm/Support/FormattedStream.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/Mutex.h"
 #include "llvm/Support/PrettyStackTrace.h"
+#include "llvm/Support/Program.h"
+#include "llvm/Support/SourceMgr.h"
 #include "llvm/Support/TargetRegistry.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
+#include "llvm/Support/system_error.h"
 #include "llvm/Target/TargetLibraryInfo.h"
 #include "llvm/Target/TargetMachine.h"
 #include "llvm/Target/TargetOptions.h"
@@ -36,6 +53,8 @@
 #include "llvm/Transforms/Instrumentation.h"
 #include "llvm/Transforms/ObjCARC.h"
 #include "llvm/Transforms/Scalar.h"
+#include "llvm/Transforms/Utils/Cloning.h"
+#include <algorithm>
 using namespace clang;
 using namespace llvm;
 
@@ -104,6 +123,12 @@ private:
   bool AddEmitPasses(BackendAction Action, formatted_raw_ostream &OS,
                      TargetMachine *TM);
 
+  /// EmitPartitionedObject - Split the module into parts, generate an object
+  /// file for each part on a thread of its own, and write the objects to
+  /// \p OS, merged by running \p Linker in relocatable mode.
+  void EmitPartitionedObject(raw_ostream &OS, TargetMachine *TM,
+                             const std::string &Linker);
+
 public:
   EmitAssemblyHelper(DiagnosticsEngine &_Diags,
                      const CodeGenOptions &CGOpts,
@@ -324,6 +349,19 @@ void EmitAssemblyHelper::CreatePasses(TargetMachine *TM) {
   PMBuilder.populateModulePassManager(*MPM);
 }
 
+/// Return the features of the translation unit, as the target machine and
+/// the "target-features" function attribute list them.
+static std::string getFeaturesString(const clang::TargetOptions &TargetOpts) {
+  if (TargetOpts.Features.empty())
+    return std::string();
+  SubtargetFeatures Features;
+  for (std::vector<std::string>::const_iterator
+         it = TargetOpts.Features.begin(),
+         ie = TargetOpts.Features.end(); it != ie; ++it)
+    Features.AddFeature(*it);
+  return Features.getString();
+}
+
 TargetMachine *EmitAssemblyHelper::CreateTargetMachine(bool MustCreateTM) {
   // Create the TargetMachine for generating code.
   std::string Error;
@@ -379,15 +417,7 @@ TargetMachine *EmitAssemblyHelper::CreateTargetMachine(bool MustCreateTM) {
   llvm::cl::ParseCommandLineOptions(BackendArgs.size() - 1,
                                     BackendArgs.data());
 
-  std::string FeaturesStr;
-  if (TargetOpts.Features.size()) {
-    SubtargetFeatures Features;
-    for (std::vector<std::string>::const_iterator
-           it = TargetOpts.Features.begin(),
-           ie = TargetOpts.Features.end(); it != ie; ++it)
-      Features.AddFeature(*it);
-    FeaturesStr = Features.getString();
-  }
+  std::string FeaturesStr = getFeaturesString(TargetOpts);
 
   llvm::Reloc::Model RM = llvm::Reloc::Default;
   if (CodeGenOpts.RelocationModel == "static") {
@@ -517,6 +547,570 @@ bool EmitAssemblyHelper::AddEmitPasses(BackendAction Action,
   return true;
 }
 
+//===----------------------------------------------------------------------===//
+// Partitioned code generation
+//===----------------------------------------------------------------------===//
+
+/// Add to \p Owners the definitions that use \p U, looking through constants.
+static void findUsingDefinitions(const User *U,
+                                 SmallVectorImpl<const GlobalValue *> &Owners,
+                                 SmallPtrSet<const User *, 8> &Visited) {
+  if (!Visited.insert(U))
+    return;
+  if (const Instruction *I = dyn_cast<Instruction>(U)) {
+    Owners.push_back(I->getParent()->getParent());
+    return;
+  }
+  if (const GlobalValue *GV = dyn_cast<GlobalValue>(U)) {
+    Owners.push_back(GV);
+    return;
+  }
+  for (Value::const_use_iterator I = U->use_begin(), E = U->use_end();
+       I != E; ++I)
+    findUsingDefinitions(*I, Owners, Visited);
+}
+
+/// Return an estimate of the time it takes to generate code for \p GV.
+static unsigned getCodeGenCost(const GlobalValue *GV) {
+  unsigned Cost = 1;
+  if (const Function *F = dyn_cast<Function>(GV))
+    for (Function::const_iterator BB = F->begin(), E = F->end(); BB != E; ++BB)
+      Cost += BB->size();
+  return Cost;
+}
+
+/// Return whether \p GV is a constant that can be copied into each object that
+/// uses it, like the contents of a string literal.
+static bool isDuplicableConstant(const GlobalValue *GV) {
+  const GlobalVariable *Var = dyn_cast<GlobalVariable>(GV);
+  if (!Var || !Var->hasLocalLinkage() || !Var->isConstant() ||
+      !Var->hasUnnamedAddr() || !Var->hasInitializer())
+    return false;
+  const Constant *Init = Var->getInitializer();
+  return isa<ConstantDataSequential>(Init) || isa<ConstantInt>(Init) ||
+         isa<ConstantFP>(Init) || isa<ConstantAggregateZero>(Init);
+}
+
+/// Return the target features a target attribute asks \p GV to be compiled
+/// for, or an empty string if they are the ones of the module.
+static StringRef getFunctionFeatures(const GlobalValue *GV,
+                                     StringRef ModuleFeatures) {
+  const Function *F = dyn_cast<Function>(GV);
+  if (!F || F->isDeclaration())
+    return StringRef();
+  AttributeSet Attrs = F->getAttributes();
+  if (!Attrs.hasAttribute(AttributeSet::FunctionIndex, "target-features"))
+    return StringRef();
+  StringRef Features =
+    Attrs.getAttribute(AttributeSet::FunctionIndex, "target-features")
+      .getValueAsString();
+  return Features == ModuleFeatures ? StringRef() : Features;
+}
+
+namespace {
+/// \brief A group of definitions that has to be emitted into one object.
+struct DefinitionGroup {
+  const GlobalValue *Leader;
+  uint64_t Cost;
+  /// The target features the group is compiled for, as an index into the
+  /// feature sets of the module; 0 stands for the features of the module.
+  unsigned FeatureSet;
+  DefinitionGroup(const GlobalValue *Leader, unsigned FeatureSet)
+    : Leader(Leader), Cost(0), FeatureSet(FeatureSet) {}
+  /// Sort the most costly groups first.
+  bool operator<(const DefinitionGroup &RHS) const { return Cost > RHS.Cost; }
+};
+}
+
+/// Return the suffix of the names of the local symbols of \p M that are made
+/// hidden globals. Objects of other modules generated in parts may be linked
+/// into the same program, with sources of the same name in other
+/// directories, so the suffix hashes the absolute path of the source and the
+/// names of the symbols the module defines.
+static std::string getPromotedNameSuffix(const Module &M) {
+  SmallString<128> Path(M.getModuleIdentifier());
+  sys::fs::make_absolute(Path);
+  MD5 Hash;
+  Hash.update(Path.str());
+  SmallVector<const GlobalValue *, 64> Defs;
+  for (Module::const_iterator I = M.begin(), E = M.end(); I != E; ++I)
+    Defs.push_back(I);
+  for (Module::const_global_iterator I = M.global_begin(),
+                                     E = M.global_end(); I != E; ++I)
+    Defs.push_back(I);
+  for (Module::const_alias_iterator I = M.alias_begin(), E = M.alias_end();
+       I != E; ++I)
+    Defs.push_back(I);
+  for (unsigned I = 0, N = Defs.size(); I != N; ++I) {
+    if (Defs[I]->isDeclaration() || !Defs[I]->hasName())
+      continue;
+    Hash.update(StringRef("", 1));
+    Hash.update(Defs[I]->getName());
+  }
+  MD5::MD5Result Result;
+  Hash.final(Result);
+  SmallString<32> Digest;
+  MD5::stringifyResult(Result, Digest);
+  return ".part." + Digest.str().str();
+}
+
+/// Assign each definition in \p M to a part. A symbol with local linkage can
+/// only be referred to from the object that defines it, so it is kept with
+/// every definition that refers to it, unless it is a constant that every
+/// part can have a copy of. The same goes for an alias and its aliasee, for
+/// the users of the address of a block and its function, and for an
+/// appending global like llvm.global_ctors and the definitions it lists. The
+/// groups this leaves are dealt out by cost, largest first, to the part with
+/// the least work so far.
+///
+/// The code generator compiles a whole object for one set of target
+/// features, so the functions a target attribute gives other features than
+/// the module's, \p ModuleFeatures, are put in parts of their own. A local
+/// symbol such a function defines or uses is made a hidden global, with a
+/// name unique to the compilation, so that it can be referred to from other
+/// parts. Functions that still have to share an object with code for other
+/// features are compiled for the module's and added to \p Ignored.
+///
+/// The module's features get at most \p NumParts parts, and every other set
+/// of features at least one; \p PartFeatures receives the features of each
+/// part, empty for the module's.
+///
+/// \returns the number of parts that received definitions.
+static unsigned
+partitionModule(Module &M, unsigned NumParts, StringRef ModuleFeatures,
+                DenseMap<const GlobalValue *, unsigned> &PartOf,
+                std::vector<std::string> &PartFeatures,
+                SmallVectorImpl<const Function *> &Ignored) {
+  SmallVector<GlobalValue *, 64> Defs;
+  for (Module::iterator I = M.begin(), E = M.end(); I != E; ++I)
+    if (!I->isDeclaration())
+      Defs.push_back(I);
+  for (Module::global_iterator I = M.global_begin(), E = M.global_end();
+       I != E; ++I)
+    if (!I->isDeclaration())
+      Defs.push_back(I);
+  for (Module::alias_iterator I = M.alias_begin(), E = M.alias_end(); I != E;
+       ++I)
+    Defs.push_back(I);
+
+  // Number the sets of target features; an alias goes with its aliasee.
+  SmallVector<StringRef, 4> FeatureSets(1);
+  DenseMap<const GlobalValue *, unsigned> FeatureSetOf;
+  for (unsigned I = 0, N = Defs.size(); I != N; ++I) {
+    const GlobalValue *GV = Defs[I];
+    if (const GlobalAlias *GA = dyn_cast<GlobalAlias>(GV))
+      GV = GA->getAliasedGlobal();
+    StringRef Features = getFunctionFeatures(GV, ModuleFeatures);
+    if (Features.empty())
+      continue;
+    unsigned Set = std::find(FeatureSets.begin(), FeatureSets.end(),
+                             Features) - FeatureSets.begin();
+    if (Set == FeatureSets.size())
+      FeatureSets.push_back(Features);
+    FeatureSetOf[Defs[I]] = Set;
+  }
+
+  EquivalenceClasses<const GlobalValue *> Classes;
+  SmallVector<GlobalValue *, 8> Promoted;
+  for (unsigned I = 0, N = Defs.size(); I != N; ++I) {
+    GlobalValue *GV = Defs[I];
+    Classes.insert(GV);
+    if (const GlobalAlias *GA = dyn_cast<GlobalAlias>(GV))
+      if (const GlobalValue *Aliasee = GA->getAliasedGlobal())
+        Classes.unionSets(GA, Aliasee);
+
+    SmallVector<const GlobalValue *, 4> Owners;
+    for (Value::use_iterator UI = GV->use_begin(), UE = GV->use_end();
+         UI != UE; ++UI) {
+      SmallVector<const GlobalValue *, 4> UseOwners;
+      SmallPtrSet<const User *, 8> Visited;
+      findUsingDefinitions(*UI, UseOwners, Visited);
+      // The address of a block is only known in the object of its function.
+      if (isa<BlockAddress>(*UI))
+        for (unsigned J = 0, NJ = UseOwners.size(); J != NJ; ++J)
+          Classes.unionSets(GV, UseOwners[J]);
+      else
+        Owners.append(UseOwners.begin(), UseOwners.end());
+    }
+
+    bool Retargeted = FeatureSetOf.count(GV);
+    for (unsigned J = 0, NJ = Owners.size(); J != NJ; ++J)
+      if (FeatureSetOf.count(Owners[J]))
+        Retargeted = true;
+    if (GV->hasLocalLinkage() && !isDuplicableConstant(GV) && Retargeted) {
+      Promoted.push_back(GV);
+      continue;
+    }
+
+    for (unsigned J = 0, NJ = Owners.size(); J != NJ; ++J) {
+      const GlobalVariable *Var = dyn_cast<GlobalVariable>(Owners[J]);
+      if ((GV->hasLocalLinkage() && !isDuplicableConstant(GV)) ||
+          (Var && Var->hasAppendingLinkage() && !Retargeted))
+        Classes.unionSets(GV, Owners[J]);
+    }
+  }
+
+  if (!Promoted.empty()) {
+    std::string Suffix = getPromotedNameSuffix(M);
+    for (unsigned I = 0, N = Promoted.size(); I != N; ++I) {
+      GlobalValue *GV = Promoted[I];
+      GV->setName(GV->getName() + Suffix);
+      GV->setLinkage(GlobalValue::ExternalLinkage);
+      GV->setVisibility(GlobalValue::HiddenVisibility);
+    }
+  }
+
+  // Total up the cost of each group, in the order of the module. Module-level
+  // inline asm can only refer to the local symbols llvm.used keeps alive, so
+  // these go with the asm into part 0, the first part of the module's
+  // features.
+  std::vector<DefinitionGroup> Groups;
+  DenseMap<const GlobalValue *, unsigned> GroupOf;
+  for (unsigned I = 0, N = Defs.size(); I != N; ++I) {
+    const GlobalValue *Leader = Classes.getLeaderValue(Defs[I]);
+    unsigned Set = FeatureSetOf.lookup(Defs[I]);
+    std::pair<DenseMap<const GlobalValue *, unsigned>::iterator, bool> Entry =
+      GroupOf.insert(std::make_pair(Leader, unsigned(Groups.size())));
+    if (Entry.second)
+      Groups.push_back(DefinitionGroup(Leader, Set));
+    DefinitionGroup &Group = Groups[Entry.first->second];
+    Group.Cost += getCodeGenCost(Defs[I]);
+    if (Set != Group.FeatureSet)
+      Group.FeatureSet = 0;
+  }
+  for (unsigned I = 0, N = Defs.size(); I != N; ++I) {
+    const Function *F = dyn_cast<Function>(Defs[I]);
+    if (F && FeatureSetOf.count(F) &&
+        Groups[GroupOf[Classes.getLeaderValue(F)]].FeatureSet == 0)
+      Ignored.push_back(F);
+  }
+  const GlobalValue *Used = M.getNamedGlobal("llvm.used");
+  if (Used && M.getModuleInlineAsm().empty())
+    Used = 0;
+  std::stable_sort(Groups.begin(), Groups.end());
+
+  // Share the parts among the feature sets by cost.
+  std::vector<uint64_t> SetCost(FeatureSets.size());
+  std::vector<unsigned> SetGroups(FeatureSets.size());
+  uint64_t TotalCost = 0;
+  for (unsigned I = 0, N = Groups.size(); I != N; ++I) {
+    SetCost[Groups[I].FeatureSet] += Groups[I].Cost;
+    ++SetGroups[Groups[I].FeatureSet];
+    TotalCost += Groups[I].Cost;
+  }
+  std::vector<unsigned> FirstPart(FeatureSets.size() + 1);
+  for (unsigned Set = 0, E = FeatureSets.size(); Set != E; ++Set) {
+    unsigned Parts = Set == 0 ? NumParts
+                              : std::max<uint64_t>(1, NumParts * SetCost[Set] /
+                                                          TotalCost);
+    FirstPart[Set + 1] = FirstPart[Set] + std::min(Parts, SetGroups[Set]);
+    for (unsigned I = FirstPart[Set], E = FirstPart[Set + 1]; I != E; ++I)
+      PartFeatures.push_back(FeatureSets[Set]);
+  }
+
+  std::vector<uint64_t> PartCost(PartFeatures.size());
+  DenseMap<const GlobalValue *, unsigned> PartOfLeader;
+  for (unsigned I = 0, N = Groups.size(); I != N; ++I) {
+    unsigned Set = Groups[I].FeatureSet;
+    std::vector<uint64_t>::iterator First = PartCost.begin() + FirstPart[Set];
+    std::vector<uint64_t>::iterator Last = PartCost.begin() + FirstPart[Set+1];
+    unsigned Part = std::min_element(First, Last) - PartCost.begin();
+    if (Used && Groups[I].Leader == Classes.getLeaderValue(Used))
+      Part = FirstPart[Set];
+    PartCost[Part] += Groups[I].Cost;
+    PartOfLeader[Groups[I].Leader] = Part;
+  }
+  for (unsigned I = 0, N = Defs.size(); I != N; ++I)
+    PartOf[Defs[I]] = PartOfLeader[Classes.getLeaderValue(Defs[I])];
+  return PartFeatures.size();
+}
+
+/// Write to \p Bitcode a copy of \p M that only defines the symbols that
+/// \p PartOf assigns to part \p Part, and declares the others.
+static void
+extractPartition(const Module &M, unsigned Part,
+                 const DenseMap<const GlobalValue *, unsigned> &PartOf,
+                 std::string &Bitcode) {
+  ValueToValueMapTy VMap;
+  OwningPtr<Module> Clone(CloneModule(&M, VMap));
+
+  // Symbols with local linkage that are defined in other parts are not used
+  // in this one; they are deleted once nothing refers to them anymore.
+  // Constants that can be copied are kept if this part uses them.
+  SmallVector<GlobalValue *, 16> Unused;
+  SmallVector<GlobalVariable *, 16> Copies;
+  for (Module::const_iterator I = M.begin(), E = M.end(); I != E; ++I) {
+    if (I->isDeclaration() || PartOf.lookup(I) == Part)
+      continue;
+    Function *F = cast<Function>(VMap[I]);
+    F->deleteBody();
+    if (I->hasLocalLinkage())
+      Unused.push_back(F);
+  }
+  for (Module::const_global_iterator I = M.global_begin(),
+                                     E = M.global_end(); I != E; ++I) {
+    if (I->isDeclaration() || PartOf.lookup(I) == Part)
+      continue;
+    GlobalVariable *Var = cast<GlobalVariable>(VMap[I]);
+    if (isDuplicableConstant(I)) {
+      Copies.push_back(Var);
+      continue;
+    }
+    Var->setInitializer(0);
+    if (I->hasLocalLinkage() || I->hasAppendingLinkage())
+      Unused.push_back(Var);
+    else
+      Var->setLinkage(GlobalValue::ExternalLinkage);
+  }
+  for (Module::const_alias_iterator I = M.alias_begin(), E = M.alias_end();
+       I != E; ++I) {
+    if (PartOf.lookup(I) == Part)
+      continue;
+    // An alias cannot be declared; refer to its symbol with a declaration of
+    // the aliasee's type instead.
+    GlobalAlias *GA = cast<GlobalAlias>(VMap[I]);
+    if (!I->hasLocalLinkage()) {
+      PointerType *Ty = GA->getType();
+      GlobalValue *Decl;
+      if (FunctionType *FTy = dyn_cast<FunctionType>(Ty->getElementType()))
+        Decl = Function::Create(FTy, GlobalValue::ExternalLinkage, "",
+                                Clone.get());
+      else
+        Decl = new GlobalVariable(*Clone, Ty->getElementType(), false,
+                                  GlobalValue::ExternalLinkage, 0, "", 0,
+                                  GlobalVariable::NotThreadLocal,
+                                  Ty->getAddressSpace());
+      Decl->takeName(GA);
+      Decl->setVisibility(GA->getVisibility());
+      GA->replaceAllUsesWith(Decl);
+    }
+    GA->eraseFromParent();
+  }
+  for (unsigned I = 0, N = Unused.size(); I != N; ++I) {
+    Unused[I]->removeDeadConstantUsers();
+    assert(Unused[I]->use_empty() && "local symbol used in another part");
+    Unused[I]->eraseFromParent();
+  }
+  for (unsigned I = 0, N = Copies.size(); I != N; ++I) {
+    Copies[I]->removeDeadConstantUsers();
+    if (Copies[I]->use_empty())
+      Copies[I]->eraseFromParent();
+  }
+
+  // Module-level inline asm may define symbols; emit it only once.
+  if (Part != 0)
+    Clone->setModuleInlineAsm("");
+
+  raw_string_ostream OS(Bitcode);
+  WriteBitcodeToFile(Clone.get(), OS);
+}
+
+/// Create a target machine with the same settings as \p TM, but for
+/// \p Features if they are given.
+static TargetMachine *cloneTargetMachine(const TargetMachine &TM,
+                                         StringRef Features) {
+  if (Features.empty())
+    Features = TM.getTargetFeatureString();
+  TargetMachine *Clone = TM.getTarget().createTargetMachine(
+      TM.getTargetTriple(), TM.getTargetCPU(), Features,
+      TM.Options, TM.getRelocationModel(), TM.getCodeModel(),
+      TM.getOptLevel());
+  Clone->setMCRelaxAll(TM.hasMCRelaxAll());
+  Clone->setMCSaveTempLabels(TM.hasMCSaveTempLabels());
+  Clone->setMCUseCFI(TM.hasMCUseCFI());
+  Clone->setMCUseDwarfDirectory(TM.hasMCUseDwarfDirectory());
+  Clone->setMCNoExecStack(TM.hasMCNoExecStack());
+  return Clone;
+}
+
+namespace {
+/// \brief The code generator's work on one part of a module.
+///
+/// An LLVMContext can only be used by one thread at a time, so the part is
+/// handed over as bitcode and loaded into a context of the thread's own.
+struct CodeGenPartition {
+  const CodeGenOptions *CodeGenOpts;
+  bool ContractObjCARC;
+  TargetMachine *TM;
+  /// The inline asm diagnostic handler of the module's context, which the
+  /// diagnostics of the part's context are forwarded to under \c DiagLock.
+  LLVMContext::InlineAsmDiagHandlerTy DiagHandler;
+  void *DiagContext;
+  sys::Mutex *DiagLock;
+  std::string Bitcode;
+  std::string Object;
+  std::string Error;
+};
+}
+
+/// Report an inline asm diagnostic of the context of a part through the
+/// handler of the module's context, which reports it with the location of the
+/// asm statement in the source.
+static void forwardInlineAsmDiag(const SMDiagnostic &D, void *Context,
+                                 unsigned LocCookie) {
+  CodeGenPartition &P = *static_cast<CodeGenPartition *>(Context);
+  sys::ScopedLock Guard(*P.DiagLock);
+  P.DiagHandler(D, P.DiagContext, LocCookie);
+}
+
+/// Generate the object file for a part of a module. Runs on its own thread,
+/// so other problems are recorded in the partition rather than diagnosed.
+static void runCodeGenPartition(void *Arg) {
+  CodeGenPartition &P = *static_cast<CodeGenPartition *>(Arg);
+  LLVMContext Context;
+  if (P.DiagHandler)
+    Context.setInlineAsmDiagnosticHandler(forwardInlineAsmDiag, &P);
+  OwningPtr<MemoryBuffer> Buffer(
+    MemoryBuffer::getMemBuffer(P.Bitcode, "", false));
+  OwningPtr<Module> M(ParseBitcodeFile(Buffer.get(), Context, &P.Error));
+  if (!M)
+    return;
+
+  raw_string_ostream OS(P.Object);
+  formatted_raw_ostream FormattedOS(OS);
+  PassManager PM;
+  PM.add(new DataLayout(M.get()));
+  TargetLibraryInfo *TLI = new TargetLibraryInfo(Triple(M->getTargetTriple()));
+  if (!P.CodeGenOpts->SimplifyLibCalls)
+    TLI->disableAllFunctions();
+  PM.add(TLI);
+  P.TM->addAnalysisPasses(PM);
+  if (P.ContractObjCARC)
+    PM.add(createObjCARCContractPass());
+
+  if (P.TM->addPassesToEmitFile(PM, FormattedOS, TargetMachine::CGFT_ObjectFile,
+                                !P.CodeGenOpts->VerifyModule)) {
+    P.Error = "unable to interface with target machine";
+    return;
+  }
+  PM.run(*M);
+}
+
+void EmitAssemblyHelper::EmitPartitionedObject(raw_ostream &OS,
+                                               TargetMachine *TM,
+                                               const std::string &Linker) {
+  // Without threads the parts could only be generated one after another, so
+  // the module is then only split where target features require it.
+  unsigned Requested = ThreadGroup::isSupported()
+                           ? CodeGenOpts.CodeGenPartitions : 1;
+  DenseMap<const GlobalValue *, unsigned> PartOf;
+  std::vector<std::string> PartFeatures;
+  SmallVector<const Function *, 4> Ignored;
+  unsigned NumParts = partitionModule(*TheModule, Requested,
+                                      TM->getTargetFeatureString(), PartOf,
+                                      PartFeatures, Ignored);
+  for (unsigned I = 0, N = Ignored.size(); I != N; ++I)
+    Diags.Report(diag::warn_fe_target_features_ignored)
+      << Ignored[I]->getName()
+      << "it is tied to code for other target features by a block address";
+  if (NumParts < 2 && (NumParts == 0 || PartFeatures[0].empty())) {
+    formatted_raw_ostream FormattedOS(OS);
+    if (AddEmitPasses(Backend_EmitObj, FormattedOS, TM))
+      getCodeGenPasses(TM)->run(*TheModule);
+    return;
+  }
+
+  sys::Mutex DiagLock;
+  LLVMContext &Ctx = TheModule->getContext();
+  std::vector<CodeGenPartition> Parts(NumParts);
+  for (unsigned I = 0; I != NumParts; ++I) {
+    CodeGenPartition &P = Parts[I];
+    P.CodeGenOpts = &CodeGenOpts;
+    P.ContractObjCARC = LangOpts.ObjCAutoRefCount &&
+                        CodeGenOpts.OptimizationLevel > 0;
+    P.TM = I == 0 && PartFeatures[I].empty()
+               ? TM : cloneTargetMachine(*TM, PartFeatures[I]);
+    P.DiagHandler = Ctx.getInlineAsmDiagnosticHandler();
+    P.DiagContext = Ctx.getInlineAsmDiagnosticContext();
+    P.DiagLock = &DiagLock;
+    extractPartition(*TheModule, I, PartOf, P.Bitcode);
+  }
+
+  // The calling thread generates the first part while the others run on
+  // threads of their own. The code generator recurses deeply on large
+  // functions, so give the threads the stack a main thread usually has. A
+  // part whose thread cannot be started is generated by the calling thread.
+  {
+    ThreadGroup Threads(8 << 20);
+    for (unsigned I = 1; I != NumParts; ++I)
+      if (!Threads.start(runCodeGenPartition, &Parts[I]))
+        runCodeGenPartition(&Parts[I]);
+    runCodeGenPartition(&Parts[0]);
+    Threads.join();
+  }
+
+  bool Failed = false;
+  for (unsigned I = 0; I != NumParts; ++I) {
+    if (Parts[I].TM != TM)
+      delete Parts[I].TM;
+    if (!Parts[I].Error.empty()) {
+      Diags.Report(diag::err_fe_codegen_partition_failed) << Parts[I].Error;
+      Failed = true;
+    }
+  }
+  if (Failed || Diags.hasErrorOccurred())
+    return;
+
+  // Merge the objects into one by linking them in relocatable mode.
+  std::vector<std::string> Files;
+  for (unsigned I = 0; I != NumParts; ++I) {
+    SmallString<128> Path;
+    int FD;
+    if (error_code EC = sys::fs::createTemporaryFile("codegen-part", "o", FD,
+                                                     Path)) {
+      Diags.Report(diag::err_fe_codegen_partition_failed) << EC.message();
+      Failed = true;
+      break;
+    }
+    Files.push_back(Path.str());
+    raw_fd_ostream Out(FD, /*shouldClose=*/true);
+    Out << Parts[I].Object;
+  }
+
+  SmallString<128> Merged;
+  if (!Failed) {
+    if (error_code EC = sys::fs::createTemporaryFile("codegen-merged", "o",
+                                                     Merged)) {
+      Diags.Report(diag::err_fe_codegen_partition_failed) << EC.message();
+      Failed = true;
+    }
+  }
+
+  if (!Failed) {
+    std::vector<const char *> Args;
+    Args.push_back(Linker.c_str());
+    Args.push_back("-r");
+    Args.push_back("-o");
+    Args.push_back(Merged.c_str());
+    for (unsigned I = 0, N = Files.size(); I != N; ++I)
+      Args.push_back(Files[I].c_str());
+    Args.push_back(0);
+
+    std::string ErrMsg;
+    OwningPtr<MemoryBuffer> Object;
+    if (sys::ExecuteAndWait(Linker, &Args[0], 0, 0, 0, 0, &ErrMsg)) {
+      Diags.Report(diag::err_fe_codegen_partition_failed)
+        << (ErrMsg.empty() ? "linker command failed" : ErrMsg);
+    } else if (error_code EC = MemoryBuffer::getFile(Merged.str(), Object)) {
+      Diags.Report(diag::err_fe_codegen_partition_failed) << EC.message();
+    } else {
+      OS << Object->getBuffer();
+    }
+    sys::fs::remove(Merged.str());
+  }
+
+  for (unsigned I = 0, N = Files.size(); I != N; ++I)
+    sys::fs::remove(Files[I]);
+}
+
+/// Find the linker that -codegen-partitions-linker names, either by its path
+/// or as a program on the PATH. Returns an empty string if there is none.
+static std::string findPartitionLinker(StringRef Name) {
+  if (Name.find_first_of("/\\") != StringRef::npos)
+    return sys::fs::can_execute(Name) ? Name.str() : std::string();
+  return sys::FindProgramByName(Name);
+}
+
 void EmitAssemblyHelper::EmitAssembly(BackendAction Action, raw_ostream *OS) {
   TimeRegion Region(llvm::TimePassesIsEnabled ? &CodeGenerationTime : 0);
   llvm::formatted_raw_ostream FormattedOS;
@@ -529,6 +1123,51 @@ void EmitAssemblyHelper::EmitAssembly(BackendAction Action, raw_ostream *OS) {
   llvm::OwningPtr<TargetMachine> TMOwner(CodeGenOpts.DisableFree ? 0 : TM);
   CreatePasses(TM);
 
+  // An object file can be generated in parts once the optimizer is done with
+  // the module. The parts are merged by the linker that
+  // -codegen-partitions-linker names, so this is only done if there is one.
+  // The code generator uses one set of target features for a whole module,
+  // so with that linker, functions that a target attribute compiles for
+  // others are generated in parts of their own. Without it, and in assembly
+  // output, they are compiled for the module's features with a warning. IR
+  // output keeps their "target-features" attribute for whatever compiles it.
+  std::string ModuleFeatures = getFeaturesString(TargetOpts);
+  SmallVector<const Function *, 4> Retargeted;
+  if (UsesCodeGen) {
+    for (Module::iterator I = TheModule->begin(), E = TheModule->end();
+         I != E; ++I)
+      if (!I->isDeclaration() &&
+          !getFunctionFeatures(I, ModuleFeatures).empty())
+        Retargeted.push_back(I);
+  }
+  std::string PartitionLinker;
+  std::string Reason;
+  if (Action == Backend_EmitObj &&
+      (CodeGenOpts.CodeGenPartitions > 1 || !Retargeted.empty())) {
+    const std::string &Name = CodeGenOpts.CodeGenPartitionsLinker;
+    if (Name.empty()) {
+      if (CodeGenOpts.CodeGenPartitions > 1) {
+        Diags.Report(diag::err_fe_codegen_partitions_no_linker)
+          << CodeGenOpts.CodeGenPartitions;
+        return;
+      }
+      Reason = "no linker to merge objects was given with "
+               "-codegen-partitions-linker";
+    } else {
+      PartitionLinker = findPartitionLinker(Name);
+      if (PartitionLinker.empty()) {
+        Diags.Report(diag::err_fe_codegen_partitions_linker_not_found) << Name;
+        return;
+      }
+    }
+  } else {
+    Reason = "they are only supported when generating an object file";
+  }
+  if (PartitionLinker.empty())
+    for (unsigned I = 0, N = Retargeted.size(); I != N; ++I)
+      Diags.Report(diag::warn_fe_target_features_ignored)
+        << Retargeted[I]->getName() << Reason;
+
   switch (Action) {
   case Backend_EmitNothing:
     break;
@@ -543,6 +1182,8 @@ void EmitAssemblyHelper::EmitAssembly(BackendAction Action, raw_ostream *OS) {
     break;
 
   default:
+    if (!PartitionLinker.empty())
+      break;
     FormattedOS.setStream(*OS, formatted_raw_ostream::PRESERVE_STREAM);
     if (!AddEmitPasses(Action, FormattedOS, TM))
       return;
@@ -570,6 +1211,12 @@ void EmitAssemblyHelper::EmitAssembly(BackendAction Action, raw_ostream *OS) {
     PerModulePasses->run(*TheModule);
   }
 
+  if (!PartitionLinker.empty()) {
+    PrettyStackTraceString CrashInfo("Partitioned code generation");
+    EmitPartitionedObject(*OS, TM, PartitionLinker);
+    return;
+  }
+
   if (CodeGenPasses) {
     PrettyStackTraceString CrashInfo("Code generation");
     CodeGenPasses->run(*TheModule);
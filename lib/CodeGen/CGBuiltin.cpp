@@ -384,6 +384,22 @@ RValue CodeGenFunction::EmitBuiltinExpr(const FunctionDecl *FD,
                                         "expval");
     return RValue::get(Result);
   }
+  case Builtin::BI__builtin_assume_aligned: {
+    Value *PtrValue = EmitScalarExpr(E->getArg(0));
+    Value *OffsetValue =
+      (E->getNumArgs() > 2) ? EmitScalarExpr(E->getArg(2)) : 0;
+
+    // Sema checked that the alignment is a constant power of two.
+    uint64_t Alignment =
+      E->getArg(1)->EvaluateKnownConstInt(getContext()).getZExtValue();
+
+    // The alignment was asked for explicitly, so state it even for a noalias
+    // pointer, such as a restrict parameter, although alias analysis then
+    // loses track of it.
+    return RValue::get(EmitAlignmentAssumption(PtrValue, Alignment,
+                                               OffsetValue,
+                                               /*EvenIfNoAlias=*/true));
+  }
   case Builtin::BI__builtin_bswap16:
   case Builtin::BI__builtin_bswap32:
   case Builtin::BI__builtin_bswap64: {
@@ -21,6 +21,7 @@
 #include "clang/AST/Decl.h"
 #include "clang/AST/DeclCXX.h"
 #include "clang/AST/DeclObjC.h"
+#include "clang/AST/RecordLayout.h"
 #include "clang/Basic/TargetInfo.h"
 #include "clang/Frontend/CodeGenOptions.h"
 #include "llvm/ADT/StringExtras.h"
@@ -1232,6 +1233,36 @@ static llvm::Value *emitArgumentDemotion(CodeGenFunction &CGF,
   return CGF.Builder.CreateFPCast(value, varType, "arg.unpromote");
 }
 
+/// isRestrictMemberAtOffset - Return true if the struct type Ty has a
+/// restrict-qualified pointer field, possibly in a nested struct, at the given
+/// byte offset.
+static bool isRestrictMemberAtOffset(ASTContext &Context, QualType Ty,
+                                     uint64_t Offset) {
+  const RecordType *RT = Ty->getAs<RecordType>();
+  if (!RT || RT->getDecl()->isUnion())
+    return false;
+
+  const RecordDecl *RD = RT->getDecl();
+  const ASTRecordLayout &Layout = Context.getASTRecordLayout(RD);
+  unsigned Idx = 0;
+  for (RecordDecl::field_iterator I = RD->field_begin(), E = RD->field_end();
+       I != E; ++I, ++Idx) {
+    if (I->isBitField())
+      continue;
+    QualType FieldTy = I->getType();
+    uint64_t FieldOffset =
+      Context.toCharUnitsFromBits(Layout.getFieldOffset(Idx)).getQuantity();
+    if (FieldOffset == Offset && FieldTy->isPointerType() &&
+        FieldTy.isRestrictQualified())
+      return true;
+    if (FieldTy->isRecordType() && Offset >= FieldOffset &&
+        Offset < FieldOffset +
+                 Context.getTypeSizeInChars(FieldTy).getQuantity())
+      return isRestrictMemberAtOffset(Context, FieldTy, Offset - FieldOffset);
+  }
+  return false;
+}
+
 void CodeGenFunction::EmitFunctionProlog(const CGFunctionInfo &FI,
                                          llvm::Function *Fn,
                                          const FunctionArgList &Args) {
@@ -1379,6 +1410,19 @@ void CodeGenFunction::EmitFunctionProlog(const CGFunctionInfo &FI,
       // and the optimizer generally likes scalar values better than FCAs.
       llvm::StructType *STy = dyn_cast<llvm::StructType>(ArgI.getCoerceToType());
       if (STy && STy->getNumElements() > 1) {
+        // A restrict-qualified member that is passed on its own is as good
+        // as a restrict-qualified parameter.
+        const llvm::StructLayout *SL = CGM.getDataLayout().getStructLayout(STy);
+        llvm::Function::arg_iterator EltAI = AI;
+        for (unsigned i = 0, e = STy->getNumElements(); i != e; ++i, ++EltAI) {
+          uint64_t Offset = ArgI.getDirectOffset() + SL->getElementOffset(i);
+          if (STy->getElementType(i)->isPointerTy() &&
+              isRestrictMemberAtOffset(getContext(), Ty, Offset))
+            EltAI->addAttr(llvm::AttributeSet::get(getLLVMContext(),
+                                                   EltAI->getArgNo() + 1,
+                                                   llvm::Attribute::NoAlias));
+        }
+
         uint64_t SrcSize = CGM.getDataLayout().getTypeAllocSize(STy);
         llvm::Type *DstTy =
           cast<llvm::PointerType>(Ptr->getType())->getElementType();
@@ -1412,6 +1456,11 @@ void CodeGenFunction::EmitFunctionProlog(const CGFunctionInfo &FI,
         // Simple case, just do a coerced store of the argument into the alloca.
         assert(AI != Fn->arg_end() && "Argument mismatch!");
         AI->setName(Arg->getName() + ".coerce");
+        if (AI->getType()->isPointerTy() &&
+            isRestrictMemberAtOffset(getContext(), Ty, ArgI.getDirectOffset()))
+          AI->addAttr(llvm::AttributeSet::get(getLLVMContext(),
+                                              AI->getArgNo() + 1,
+                                              llvm::Attribute::NoAlias));
         CreateCoercedStore(AI++, Ptr, /*DestIsVolatile=*/false, *this);
       }
 
@@ -2258,6 +2307,40 @@ void CodeGenFunction::ExpandTypeToArgs(QualType Ty, RValue RV,
 }
 
 
+/// emitReturnAlignmentAssumption - Apply the assume_aligned or alloc_align
+/// attribute of the called function to the pointer it returned.
+static llvm::Value *emitReturnAlignmentAssumption(CodeGenFunction &CGF,
+                                                  const Decl *TargetDecl,
+                                                  const CallArgList &CallArgs,
+                                                  llvm::Value *V) {
+  if (!TargetDecl || !V->getType()->isPointerTy())
+    return V;
+
+  if (const AssumeAlignedAttr *AA = TargetDecl->getAttr<AssumeAlignedAttr>())
+    return CGF.EmitAlignmentAssumption(
+        V, AA->getAlignment(),
+        llvm::ConstantInt::get(CGF.IntPtrTy, AA->getOffset()));
+
+  const AllocAlignAttr *AA = TargetDecl->getAttr<AllocAlignAttr>();
+  if (!AA || !isa<FunctionDecl>(TargetDecl))
+    return V;
+
+  // The parameter index does not count the implicit 'this' argument.
+  unsigned Idx = AA->getParamIndex();
+  if (const CXXMethodDecl *MD = dyn_cast<CXXMethodDecl>(TargetDecl))
+    if (MD->isInstance())
+      ++Idx;
+  if (Idx >= CallArgs.size() || !CallArgs[Idx].RV.isScalar())
+    return V;
+
+  // Only an alignment known at compile time tells the optimizer anything.
+  llvm::ConstantInt *CI =
+    dyn_cast<llvm::ConstantInt>(CallArgs[Idx].RV.getScalarVal());
+  if (!CI || !CI->getValue().isPowerOf2())
+    return V;
+  return CGF.EmitAlignmentAssumption(V, CI->getZExtValue());
+}
+
 RValue CodeGenFunction::EmitCall(const CGFunctionInfo &CallInfo,
                                  llvm::Value *Callee,
                                  ReturnValueSlot ReturnValue,
@@ -2282,8 +2365,10 @@ RValue CodeGenFunction::EmitCall(const CGFunctionInfo &CallInfo,
   // alloca to hold the result, unless one is given to us.
   if (CGM.ReturnTypeUsesSRet(CallInfo)) {
     llvm::Value *Value = ReturnValue.getValue();
-    if (!Value)
+    if (!Value) {
       Value = CreateMemTemp(RetTy);
+      EmitTemporaryLifetimeStart(Value, RetTy);
+    }
     Args.push_back(Value);
     checkArgMatches(Value, IRArgNo, IRFuncTy);
   }
@@ -2576,6 +2661,7 @@ RValue CodeGenFunction::EmitCall(const CGFunctionInfo &CallInfo,
 
         if (!DestPtr) {
           DestPtr = CreateMemTemp(RetTy, "agg.tmp");
+          EmitTemporaryLifetimeStart(DestPtr, RetTy);
           DestIsVolatile = false;
         }
         BuildAggStore(*this, CI, DestPtr, DestIsVolatile, false);
@@ -2587,6 +2673,7 @@ RValue CodeGenFunction::EmitCall(const CGFunctionInfo &CallInfo,
         llvm::Value *V = CI;
         if (V->getType() != RetIRTy)
           V = Builder.CreateBitCast(V, RetIRTy);
+        V = emitReturnAlignmentAssumption(*this, TargetDecl, CallArgs, V);
         return RValue::get(V);
       }
       }
@@ -1416,13 +1416,42 @@ llvm::DIType CGDebugInfo::getOrCreateInterfaceType(QualType D,
   return T;
 }
 
+/// isDescribedElsewhere - Return true if only a declaration of the given
+/// class is emitted in this unit, because its full description is left to
+/// the unit that emits its vtable or its explicit instantiation
+/// (-fno-emit-class-debug-always).
+bool CGDebugInfo::isDescribedElsewhere(const RecordDecl *RD) {
+  if (CGM.getCodeGenOpts().EmitClassDebugAlways ||
+      DebugKind != CodeGenOptions::LimitedDebugInfo)
+    return false;
+
+  const CXXRecordDecl *CXXDecl = dyn_cast<CXXRecordDecl>(RD);
+  if (!CXXDecl || !CXXDecl->hasDefinition())
+    return false;
+  CXXDecl = CXXDecl->getDefinition();
+  if (HomeClasses.count(CXXDecl))
+    return false;
+
+  // The vtable of a dynamic class is emitted in the unit that defines its
+  // key function, or in every unit that needs it if there is none.
+  if (CXXDecl->isDynamicClass())
+    return true;
+
+  if (const ClassTemplateSpecializationDecl *Spec =
+        dyn_cast<ClassTemplateSpecializationDecl>(CXXDecl))
+    return Spec->getSpecializationKind() ==
+           TSK_ExplicitInstantiationDeclaration;
+  return false;
+}
+
 /// CreateType - get structure or union type.
 llvm::DIType CGDebugInfo::CreateType(const RecordType *Ty, bool Declaration) {
   RecordDecl *RD = Ty->getDecl();
   // Limited debug info should only remove struct definitions that can
   // safely be replaced by a forward declaration in the source code.
-  if (DebugKind <= CodeGenOptions::LimitedDebugInfo && Declaration &&
-      !RD->isCompleteDefinitionRequired() && CGM.getLangOpts().CPlusPlus) {
+  if ((DebugKind <= CodeGenOptions::LimitedDebugInfo && Declaration &&
+       !RD->isCompleteDefinitionRequired() && CGM.getLangOpts().CPlusPlus) ||
+      isDescribedElsewhere(RD)) {
     // FIXME: This implementation is problematic; there are some test
     // cases where we violate the above principle, such as
     // test/CodeGen/debug-info-records.c .
@@ -1962,6 +1991,26 @@ void CGDebugInfo::completeFwdDecl(const RecordDecl &RD) {
     getOrCreateType(QTy, getOrCreateFile(RD.getLocation()));
 }
 
+void CGDebugInfo::completeClassData(const CXXRecordDecl *RD) {
+  if (CGM.getCodeGenOpts().EmitClassDebugAlways ||
+      DebugKind != CodeGenOptions::LimitedDebugInfo)
+    return;
+
+  // Describe the class here even if nothing else in this unit refers to it.
+  RD = RD->getDefinition();
+  if (!HomeClasses.insert(RD))
+    return;
+  QualType Ty = CGM.getContext().getRecordType(RD);
+  getOrCreateType(Ty, getOrCreateFile(RD->getLocation()));
+  RetainedTypes.push_back(Ty.getAsOpaquePtr());
+}
+
+void CGDebugInfo::completeTemplateDefinition(
+    const ClassTemplateSpecializationDecl &SD) {
+  if (SD.hasDefinition())
+    completeClassData(&SD);
+}
+
 /// getCachedInterfaceTypeOrNull - Get the type from the interface
 /// cache, unless it needs to regenerated. Otherwise return null.
 llvm::Value *CGDebugInfo::getCachedInterfaceTypeOrNull(QualType Ty) {
@@ -2197,9 +2246,9 @@ llvm::DIType CGDebugInfo::CreateLimitedType(const RecordType *Ty) {
   else
     RDContext = getContextDescriptor(cast<Decl>(RD->getDeclContext()));
 
-  // If this is just a forward declaration, construct an appropriately
-  // marked node and just return it.
-  if (!RD->getDefinition())
+  // If this is just a forward declaration, or the class is described in
+  // another unit, construct an appropriately marked node and just return it.
+  if (!RD->getDefinition() || isDescribedElsewhere(RD))
     return createRecordFwdDecl(RD, RDContext);
 
   uint64_t Size = CGM.getContext().getTypeSize(Ty);
@@ -20,6 +20,7 @@
 #include "clang/Basic/SourceLocation.h"
 #include "clang/Frontend/CodeGenOptions.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/DIBuilder.h"
 #include "llvm/DebugInfo.h"
 #include "llvm/Support/Allocator.h"
@@ -81,6 +82,11 @@ class CGDebugInfo {
   /// compilation.
   std::vector<std::pair<void *, llvm::WeakVH> >ReplaceMap;
 
+  /// HomeClasses - Classes that are normally only declared, because another
+  /// unit describes them, but whose vtable or explicit instantiation is
+  /// emitted in this unit.
+  llvm::SmallPtrSet<const RecordDecl *, 16> HomeClasses;
+
   // LexicalBlockStack - Keep track of our current nested lexical block.
   std::vector<llvm::TrackingVH<llvm::MDNode> > LexicalBlockStack;
   llvm::DenseMap<const Decl *, llvm::WeakVH> RegionMap;
@@ -115,6 +121,7 @@ class CGDebugInfo {
   llvm::DIType CreateType(const BlockPointerType *Ty, llvm::DIFile F);
   llvm::DIType CreateType(const FunctionType *Ty, llvm::DIFile F);
   llvm::DIType CreateType(const RecordType *Ty, bool Declaration);
+  bool isDescribedElsewhere(const RecordDecl *RD);
   llvm::DIType CreateLimitedType(const RecordType *Ty);
   llvm::DIType CreateType(const ObjCInterfaceType *Ty, llvm::DIFile F);
   llvm::DIType CreateType(const ObjCObjectType *Ty, llvm::DIFile F);
@@ -290,6 +297,14 @@ public:
 
   void completeFwdDecl(const RecordDecl &TD);
 
+  /// completeClassData - Emit the full description of a dynamic class whose
+  /// vtable is emitted in this unit.
+  void completeClassData(const CXXRecordDecl *RD);
+
+  /// completeTemplateDefinition - Emit the full description of a class
+  /// template specialization that is explicitly instantiated in this unit.
+  void completeTemplateDefinition(const ClassTemplateSpecializationDecl &SD);
+
 private:
   /// EmitDeclare - Emit call to llvm.dbg.declare for a variable declaration.
   void EmitDeclare(const VarDecl *decl, unsigned Tag, llvm::Value *AI,
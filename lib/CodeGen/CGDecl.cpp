@@ -19,6 +19,7 @@
 #include "clang/AST/CharUnits.h"
 #include "clang/AST/Decl.h"
 #include "clang/AST/DeclObjC.h"
+#include "clang/AST/StmtCXX.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/TargetInfo.h"
 #include "clang/Frontend/CodeGenOptions.h"
@@ -472,10 +473,7 @@ namespace {
       : Addr(addr), Size(size) {}
 
     void Emit(CodeGenFunction &CGF, Flags flags) {
-      llvm::Value *castAddr = CGF.Builder.CreateBitCast(Addr, CGF.Int8PtrTy);
-      CGF.Builder.CreateCall2(CGF.CGM.getLLVMLifetimeEndFn(),
-                              Size, castAddr)
-        ->setDoesNotThrow();
+      CGF.EmitLifetimeEnd(Size, Addr);
     }
   };
 }
@@ -793,9 +791,10 @@ static bool shouldUseMemSetPlusStoresToInitialize(llvm::Constant *Init,
          canEmitInitWithFewStoresAfterMemset(Init, StoreBudget);
 }
 
-/// Should we use the LLVM lifetime intrinsics for the given local variable?
-static bool shouldUseLifetimeMarkers(CodeGenFunction &CGF, const VarDecl &D,
-                                     unsigned Size) {
+/// Should we use the LLVM lifetime intrinsics for a local object of the given
+/// type and size?
+static bool shouldUseLifetimeMarkers(CodeGenFunction &CGF, QualType Ty,
+                                     uint64_t Size) {
   // Always emit lifetime markers in -fsanitize=use-after-scope mode.
   if (CGF.getLangOpts().Sanitize.UseAfterScope)
     return true;
@@ -803,11 +802,39 @@ static bool shouldUseLifetimeMarkers(CodeGenFunction &CGF, const VarDecl &D,
   if (CGF.CGM.getCodeGenOpts().OptimizationLevel == 0)
     return false;
 
-  // Limit the size of marked objects to 32 bytes. We don't want to increase
-  // compile time by marking tiny objects.
+  // Aggregates stay in memory, and the markers let them share stack slots
+  // with objects whose lifetimes do not overlap theirs. Scalars are usually
+  // promoted to registers, so only mark them if they are larger than 32
+  // bytes; we don't want to increase compile time by marking tiny objects.
   unsigned SizeThreshold = 32;
 
-  return Size > SizeThreshold;
+  return Size > SizeThreshold ||
+         (Size != 0 && CodeGenFunction::hasAggregateEvaluationKind(Ty));
+}
+
+/// Add to \p Vars the variables declared within \p S that a jump to a label
+/// or case can bypass: those declared directly in a scope that contains a
+/// label, or a case of a switch outside it. In C, the lifetime of such a
+/// variable even begins when its block is entered.
+static void findBypassedVars(const Stmt *S, bool ScopeHasJumpTarget,
+                             llvm::SmallPtrSet<const VarDecl *, 4> &Vars) {
+  if (!S)
+    return;
+
+  if (isa<CompoundStmt>(S) || isa<IfStmt>(S) || isa<SwitchStmt>(S) ||
+      isa<WhileStmt>(S) || isa<ForStmt>(S) || isa<CXXForRangeStmt>(S))
+    ScopeHasJumpTarget = CodeGenFunction::ContainsLabel(S);
+
+  if (const DeclStmt *DS = dyn_cast<DeclStmt>(S)) {
+    if (ScopeHasJumpTarget)
+      for (DeclStmt::const_decl_iterator I = DS->decl_begin(),
+                                         E = DS->decl_end(); I != E; ++I)
+        if (const VarDecl *VD = dyn_cast<VarDecl>(*I))
+          Vars.insert(VD);
+  }
+
+  for (Stmt::const_child_range I = S->children(); I; ++I)
+    findBypassedVars(*I, ScopeHasJumpTarget, Vars);
 }
 
 
@@ -913,17 +940,18 @@ CodeGenFunction::EmitAutoVarAlloca(const VarDecl &D) {
       DeclPtr = Alloc;
 
       // Emit a lifetime intrinsic if meaningful.  There's no point
-      // in doing this if we don't have a valid insertion point (?).
+      // in doing this if we don't have a valid insertion point (?).  A jump
+      // into the scope of the variable would bypass the marker, and the
+      // optimizer would take the variable to be dead where it is used.
       uint64_t size = CGM.getDataLayout().getTypeAllocSize(LTy);
-      if (HaveInsertPoint() && shouldUseLifetimeMarkers(*this, D, size)) {
-        llvm::Value *sizeV = llvm::ConstantInt::get(Int64Ty, size);
-
-        emission.SizeForLifetimeMarkers = sizeV;
-        llvm::Value *castAddr = Builder.CreateBitCast(Alloc, Int8PtrTy);
-        Builder.CreateCall2(CGM.getLLVMLifetimeStartFn(), sizeV, castAddr)
-          ->setDoesNotThrow();
-      } else {
-        assert(!emission.useLifetimeMarkers());
+      if (HaveInsertPoint() && shouldUseLifetimeMarkers(*this, Ty, size)) {
+        if (!BypassedVarsComputed) {
+          findBypassedVars(CurCodeDecl ? CurCodeDecl->getBody() : 0, false,
+                           BypassedVars);
+          BypassedVarsComputed = true;
+        }
+        if (!BypassedVars.count(&D))
+          emission.SizeForLifetimeMarkers = EmitLifetimeStart(size, Alloc);
       }
     }
   } else {
@@ -1563,6 +1591,34 @@ void CodeGenFunction::pushRegularPartialArrayCleanup(llvm::Value *arrayBegin,
                                                   elementType, destroyer);
 }
 
+llvm::Value *CodeGenFunction::EmitLifetimeStart(uint64_t Size,
+                                                llvm::Value *Addr) {
+  llvm::Value *SizeV = llvm::ConstantInt::get(Int64Ty, Size);
+  Addr = Builder.CreateBitCast(Addr, Int8PtrTy);
+  Builder.CreateCall2(CGM.getLLVMLifetimeStartFn(), SizeV, Addr)
+    ->setDoesNotThrow();
+  return SizeV;
+}
+
+void CodeGenFunction::EmitLifetimeEnd(llvm::Value *Size, llvm::Value *Addr) {
+  Addr = Builder.CreateBitCast(Addr, Int8PtrTy);
+  Builder.CreateCall2(CGM.getLLVMLifetimeEndFn(), Size, Addr)
+    ->setDoesNotThrow();
+}
+
+void CodeGenFunction::EmitTemporaryLifetimeStart(llvm::Value *Addr,
+                                                 QualType Ty) {
+  // A temporary in a conditionally-evaluated part of the expression is not
+  // created on every path to the end of the full-expression.
+  if (!HaveInsertPoint() || isInConditionalBranch())
+    return;
+  uint64_t Size = getContext().getTypeSizeInChars(Ty).getQuantity();
+  if (!shouldUseLifetimeMarkers(*this, Ty, Size))
+    return;
+  EHStack.pushCleanup<CallLifetimeEnd>(NormalCleanup, Addr,
+                                       EmitLifetimeStart(Size, Addr));
+}
+
 /// Lazily declare the @llvm.lifetime.start intrinsic.
 llvm::Constant *CodeGenModule::getLLVMLifetimeStartFn() {
   if (LifetimeStartFn) return LifetimeStartFn;
@@ -132,6 +132,10 @@ static void EmitDeclInvariant(CodeGenFunction &CGF, const VarDecl &D,
 void CodeGenFunction::EmitCXXGlobalVarDeclInit(const VarDecl &D,
                                                llvm::Constant *DeclPtr,
                                                bool PerformInit) {
+  // The temporaries of the initializer are done with before any cleanup the
+  // caller pushed around the initialization, such as a guard abort, is
+  // popped.
+  RunCleanupsScope Scope(*this);
 
   const Expr *Init = D.getInit();
   QualType T = D.getType();
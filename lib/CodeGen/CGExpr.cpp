@@ -129,12 +129,15 @@ RValue CodeGenFunction::EmitAnyExpr(const Expr *E,
 }
 
 /// EmitAnyExprToTemp - Similary to EmitAnyExpr(), however, the result will
-/// always be accessible even if no aggregate location is provided.
+/// always be accessible even if no aggregate location is provided.  The
+/// temporary lives until the end of the full-expression.
 RValue CodeGenFunction::EmitAnyExprToTemp(const Expr *E) {
   AggValueSlot AggSlot = AggValueSlot::ignored();
 
-  if (hasAggregateEvaluationKind(E->getType()))
+  if (hasAggregateEvaluationKind(E->getType())) {
     AggSlot = CreateAggTemp(E->getType(), "agg.tmp");
+    EmitTemporaryLifetimeStart(AggSlot.getAddr(), E->getType());
+  }
   return EmitAnyExpr(E, AggSlot);
 }
 
@@ -358,6 +361,8 @@ LValue CodeGenFunction::EmitMaterializeTemporaryExpr(
       EmitAnyExprToMem(E, Object, Qualifiers(), /*IsInit*/true);
     }
   } else {
+    if (M->getStorageDuration() == SD_FullExpression)
+      EmitTemporaryLifetimeStart(Object, E->getType());
     EmitAnyExprToMem(E, Object, Qualifiers(), /*IsInit*/true);
   }
   pushTemporaryCleanup(*this, M, E, Object);
@@ -1754,8 +1759,10 @@ LValue CodeGenFunction::EmitDeclRefLValue(const DeclRefExpr *E) {
   }
 
   if (const VarDecl *VD = dyn_cast<VarDecl>(ND)) {
-    // Check if this is a global variable.
-    if (VD->hasLinkage() || VD->isStaticDataMember()) {
+    // Check if this is a global variable. Globals that are private to an
+    // OpenMP region have a local copy in LocalDeclMap.
+    if ((VD->hasLinkage() || VD->isStaticDataMember()) &&
+        !LocalDeclMap.count(VD)) {
       // If it's thread_local, emit a call to its wrapper function instead.
       if (VD->getTLSKind() == VarDecl::TLS_Dynamic)
         return CGM.getCXXABI().EmitThreadLocalDeclRefExpr(*this, E);
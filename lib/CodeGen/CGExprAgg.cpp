@@ -53,11 +53,13 @@ class AggExprEmitter : public StmtVisitor<AggExprEmitter> {
 
   AggValueSlot EnsureSlot(QualType T) {
     if (!Dest.isIgnored()) return Dest;
-    return CGF.CreateAggTemp(T, "agg.tmp.ensured");
+    AggValueSlot Slot = CGF.CreateAggTemp(T, "agg.tmp.ensured");
+    CGF.EmitTemporaryLifetimeStart(Slot.getAddr(), T);
+    return Slot;
   }
   void EnsureDest(QualType T) {
     if (!Dest.isIgnored()) return;
-    Dest = CGF.CreateAggTemp(T, "agg.tmp.ensured");
+    Dest = EnsureSlot(T);
   }
 
 public:
@@ -892,7 +894,11 @@ VisitAbstractConditionalOperator(const AbstractConditionalOperator *E) {
   CodeGenFunction::OpaqueValueMapping binding(CGF, E);
 
   CodeGenFunction::ConditionalEvaluation eval(CGF);
-  CGF.EmitBranchOnBoolExpr(E->getCond(), LHSBlock, RHSBlock);
+  CGF.EmitBranchOnBoolExpr(E->getCond(),
+                           CGF.PGO.getCountingBlock(E, 0, LHSBlock),
+                           CGF.PGO.getCountingBlock(E, 1, RHSBlock),
+                           CGF.PGO.getRegionCount(E, 0),
+                           CGF.PGO.getRegionCount(E, 1));
 
   // Save whether the destination's lifetime is externally managed.
   bool isExternallyDestructed = Dest.isExternallyDestructed();
@@ -1358,6 +1364,7 @@ void CodeGenFunction::EmitAggExpr(const Expr *E, AggValueSlot Slot) {
 LValue CodeGenFunction::EmitAggExprToLValue(const Expr *E) {
   assert(hasAggregateEvaluationKind(E->getType()) && "Invalid argument!");
   llvm::Value *Temp = CreateMemTemp(E->getType());
+  EmitTemporaryLifetimeStart(Temp, E->getType());
   LValue LV = MakeAddrLValue(Temp, E->getType());
   EmitAggExpr(E, AggValueSlot::forLValue(LV, AggValueSlot::IsNotDestructed,
                                          AggValueSlot::DoesNotNeedGCBarriers,
@@ -748,7 +748,11 @@ VisitAbstractConditionalOperator(const AbstractConditionalOperator *E) {
   CodeGenFunction::OpaqueValueMapping binding(CGF, E);
 
   CodeGenFunction::ConditionalEvaluation eval(CGF);
-  CGF.EmitBranchOnBoolExpr(E->getCond(), LHSBlock, RHSBlock);
+  CGF.EmitBranchOnBoolExpr(E->getCond(),
+                           CGF.PGO.getCountingBlock(E, 0, LHSBlock),
+                           CGF.PGO.getCountingBlock(E, 1, RHSBlock),
+                           CGF.PGO.getRegionCount(E, 0),
+                           CGF.PGO.getRegionCount(E, 1));
 
   eval.begin(CGF);
   CGF.EmitBlock(LHSBlock);
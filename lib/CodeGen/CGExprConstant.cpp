@@ -570,6 +570,297 @@ llvm::Constant *ConstStructBuilder::BuildStruct(CodeGenModule &CGM,
 }
 
 
+//===----------------------------------------------------------------------===//
+//                          ConstDataArrayBuilder
+//===----------------------------------------------------------------------===//
+
+/// Emits arrays of integer and floating-point values, such as large generated
+/// tables, as a single llvm::ConstantDataArray.  The elements are appended in
+/// their in-memory representation, so no llvm::Constant is created for each
+/// of them; when the initializer consists of literals, it is not evaluated to
+/// an APValue either.
+class ConstDataArrayBuilder {
+  CodeGenModule &CGM;
+  llvm::Type *EltTy;
+  unsigned EltBits;
+  bool AllZero;
+
+  SmallVector<uint8_t, 0> Elts8;
+  SmallVector<uint16_t, 0> Elts16;
+  SmallVector<uint32_t, 0> Elts32;
+  SmallVector<uint64_t, 0> Elts64;
+  SmallVector<float, 0> Floats;
+  SmallVector<double, 0> Doubles;
+
+  ConstDataArrayBuilder(CodeGenModule &CGM, llvm::Type *EltTy)
+    : CGM(CGM), EltTy(EltTy), EltBits(EltTy->getPrimitiveSizeInBits()),
+      AllZero(true) { }
+
+  static llvm::Type *getElementType(CodeGenModule &CGM, QualType EltType);
+  static bool EvaluateLiteral(ASTContext &Context, const Expr *E,
+                              APValue &Result);
+
+  void AppendBits(const llvm::APInt &Bits);
+  bool AppendValue(const APValue &Value);
+  bool AppendLiteral(const Expr *E);
+  llvm::Constant *Finish(uint64_t NumElements);
+
+public:
+  /// \brief Emit the string literal or array initializer list \p Init, whose
+  /// elements are (arrays of) integer or floating-point literals.  Returns
+  /// null if the initializer has any other form.
+  static llvm::Constant *BuildArray(CodeGenModule &CGM, const Expr *Init);
+
+  /// \brief Emit the evaluated array \p Value, whose elements are integers or
+  /// floating-point values.  Returns null if it has any other elements.
+  static llvm::Constant *BuildArray(CodeGenModule &CGM, const APValue &Value,
+                                    QualType DestType);
+};
+
+/// Returns the in-memory type of the elements of type \p EltType, or null if
+/// they cannot be collected into a ConstantDataArray.
+llvm::Type *ConstDataArrayBuilder::getElementType(CodeGenModule &CGM,
+                                                  QualType EltType) {
+  if (!EltType->isIntegerType() && !EltType->isRealFloatingType())
+    return 0;
+  llvm::Type *EltTy = CGM.getTypes().ConvertTypeForMem(EltType);
+  if (EltTy->isIntegerTy(8) || EltTy->isIntegerTy(16) ||
+      EltTy->isIntegerTy(32) || EltTy->isIntegerTy(64) ||
+      EltTy->isFloatTy() || EltTy->isDoubleTy())
+    return EltTy;
+  return 0;
+}
+
+/// Evaluates an integer, character or floating-point literal, possibly
+/// negated and converted by implicit arithmetic conversions, following the
+/// rules of the constant evaluator.  Returns false for any other expression.
+bool ConstDataArrayBuilder::EvaluateLiteral(ASTContext &Context, const Expr *E,
+                                            APValue &Result) {
+  E = E->IgnoreParens();
+  if (const IntegerLiteral *IL = dyn_cast<IntegerLiteral>(E)) {
+    Result = APValue(llvm::APSInt(IL->getValue(),
+                     E->getType()->isUnsignedIntegerOrEnumerationType()));
+    return true;
+  }
+  if (const CharacterLiteral *CL = dyn_cast<CharacterLiteral>(E)) {
+    Result = APValue(Context.MakeIntValue(CL->getValue(), E->getType()));
+    return true;
+  }
+  if (const FloatingLiteral *FL = dyn_cast<FloatingLiteral>(E)) {
+    Result = APValue(FL->getValue());
+    return true;
+  }
+
+  if (const UnaryOperator *UO = dyn_cast<UnaryOperator>(E)) {
+    if (UO->getOpcode() != UO_Plus && UO->getOpcode() != UO_Minus)
+      return false;
+    if (!EvaluateLiteral(Context, UO->getSubExpr(), Result))
+      return false;
+    if (UO->getOpcode() == UO_Minus) {
+      if (Result.isInt())
+        Result.getInt() = -Result.getInt();
+      else
+        Result.getFloat().changeSign();
+    }
+    return true;
+  }
+
+  const ImplicitCastExpr *ICE = dyn_cast<ImplicitCastExpr>(E);
+  if (!ICE || !EvaluateLiteral(Context, ICE->getSubExpr(), Result))
+    return false;
+
+  QualType DestType = ICE->getType();
+  switch (ICE->getCastKind()) {
+  case CK_NoOp:
+    return true;
+
+  case CK_IntegralCast: {
+    if (!Result.isInt() || DestType->isBooleanType())
+      return false;
+    llvm::APSInt Value =
+      Result.getInt().extOrTrunc(Context.getIntWidth(DestType));
+    Value.setIsUnsigned(DestType->isUnsignedIntegerOrEnumerationType());
+    Result = APValue(Value);
+    return true;
+  }
+
+  case CK_IntegralToFloating: {
+    if (!Result.isInt())
+      return false;
+    llvm::APFloat Value(Context.getFloatTypeSemantics(DestType), 1);
+    Value.convertFromAPInt(Result.getInt(), Result.getInt().isSigned(),
+                           llvm::APFloat::rmNearestTiesToEven);
+    Result = APValue(Value);
+    return true;
+  }
+
+  case CK_FloatingCast: {
+    if (!Result.isFloat())
+      return false;
+    bool Ignored;
+    Result.getFloat().convert(Context.getFloatTypeSemantics(DestType),
+                              llvm::APFloat::rmNearestTiesToEven, &Ignored);
+    return true;
+  }
+
+  default:
+    return false;
+  }
+}
+
+void ConstDataArrayBuilder::AppendBits(const llvm::APInt &Bits) {
+  assert(Bits.getBitWidth() == EltBits && "element has the wrong width");
+  if (Bits.getBoolValue())
+    AllZero = false;
+
+  if (EltTy->isFloatTy())
+    Floats.push_back(Bits.bitsToFloat());
+  else if (EltTy->isDoubleTy())
+    Doubles.push_back(Bits.bitsToDouble());
+  else if (EltBits == 8)
+    Elts8.push_back(Bits.getZExtValue());
+  else if (EltBits == 16)
+    Elts16.push_back(Bits.getZExtValue());
+  else if (EltBits == 32)
+    Elts32.push_back(Bits.getZExtValue());
+  else
+    Elts64.push_back(Bits.getZExtValue());
+}
+
+bool ConstDataArrayBuilder::AppendValue(const APValue &Value) {
+  if (Value.isInt() && EltTy->isIntegerTy()) {
+    AppendBits(Value.getInt().extOrTrunc(EltBits));
+    return true;
+  }
+  if (Value.isFloat()) {
+    llvm::APInt Bits = Value.getFloat().bitcastToAPInt();
+    if (Bits.getBitWidth() != EltBits)
+      return false;
+    AppendBits(Bits);
+    return true;
+  }
+  return false;
+}
+
+bool ConstDataArrayBuilder::AppendLiteral(const Expr *E) {
+  if (isa<ImplicitValueInitExpr>(E)) {
+    AppendBits(llvm::APInt(EltBits, 0));
+    return true;
+  }
+
+  APValue Value;
+  return EvaluateLiteral(CGM.getContext(), E, Value) && AppendValue(Value);
+}
+
+template <typename T>
+static llvm::Constant *GetDataArray(llvm::LLVMContext &VMContext,
+                                    SmallVectorImpl<T> &Elts,
+                                    uint64_t NumElements) {
+  Elts.resize(NumElements);
+  return llvm::ConstantDataArray::get(VMContext, Elts);
+}
+
+llvm::Constant *ConstDataArrayBuilder::Finish(uint64_t NumElements) {
+  // Elements that were not appended are zero-initialized.
+  if (AllZero)
+    return llvm::ConstantAggregateZero::get(
+        llvm::ArrayType::get(EltTy, NumElements));
+
+  llvm::LLVMContext &VMContext = CGM.getLLVMContext();
+  if (EltTy->isFloatTy())
+    return GetDataArray(VMContext, Floats, NumElements);
+  if (EltTy->isDoubleTy())
+    return GetDataArray(VMContext, Doubles, NumElements);
+  switch (EltBits) {
+  case 8:  return GetDataArray(VMContext, Elts8, NumElements);
+  case 16: return GetDataArray(VMContext, Elts16, NumElements);
+  case 32: return GetDataArray(VMContext, Elts32, NumElements);
+  default: return GetDataArray(VMContext, Elts64, NumElements);
+  }
+}
+
+llvm::Constant *ConstDataArrayBuilder::BuildArray(CodeGenModule &CGM,
+                                                  const Expr *Init) {
+  Init = Init->IgnoreParens();
+  if (const StringLiteral *SL = dyn_cast<StringLiteral>(Init))
+    return CGM.GetConstantArrayFromStringLiteral(SL);
+
+  const InitListExpr *ILE = dyn_cast<InitListExpr>(Init);
+  if (!ILE)
+    return 0;
+  const ConstantArrayType *CAT =
+    CGM.getContext().getAsConstantArrayType(ILE->getType());
+  if (!CAT)
+    return 0;
+  if (ILE->isStringLiteralInit())
+    return BuildArray(CGM, ILE->getInit(0));
+
+  // Elements that are not explicitly initialized must be zero.
+  const Expr *Filler = ILE->getArrayFiller();
+  if (Filler && !isa<ImplicitValueInitExpr>(Filler))
+    return 0;
+
+  QualType EltType = CAT->getElementType();
+  uint64_t NumElements = CAT->getSize().getZExtValue();
+  uint64_t NumInits = std::min<uint64_t>(ILE->getNumInits(), NumElements);
+
+  // Emit each row of a multidimensional array on its own.
+  if (CGM.getContext().getAsConstantArrayType(EltType)) {
+    llvm::ArrayType *AType =
+      cast<llvm::ArrayType>(CGM.getTypes().ConvertTypeForMem(ILE->getType()));
+    std::vector<llvm::Constant*> Rows;
+    Rows.reserve(NumElements);
+    for (uint64_t I = 0; I != NumInits; ++I) {
+      const Expr *Row = ILE->getInit(I);
+      llvm::Constant *C = isa<ImplicitValueInitExpr>(Row) ?
+        CGM.EmitNullConstant(EltType) : BuildArray(CGM, Row);
+      if (!C || C->getType() != AType->getElementType())
+        return 0;
+      Rows.push_back(C);
+    }
+    Rows.resize(NumElements,
+                llvm::Constant::getNullValue(AType->getElementType()));
+    return llvm::ConstantArray::get(AType, Rows);
+  }
+
+  llvm::Type *EltTy = getElementType(CGM, EltType);
+  if (!EltTy)
+    return 0;
+
+  ConstDataArrayBuilder Builder(CGM, EltTy);
+  for (uint64_t I = 0; I != NumInits; ++I)
+    if (!Builder.AppendLiteral(ILE->getInit(I)))
+      return 0;
+  return Builder.Finish(NumElements);
+}
+
+llvm::Constant *ConstDataArrayBuilder::BuildArray(CodeGenModule &CGM,
+                                                  const APValue &Value,
+                                                  QualType DestType) {
+  const ConstantArrayType *CAT =
+    CGM.getContext().getAsConstantArrayType(DestType);
+  if (!CAT)
+    return 0;
+  llvm::Type *EltTy = getElementType(CGM, CAT->getElementType());
+  if (!EltTy)
+    return 0;
+
+  ConstDataArrayBuilder Builder(CGM, EltTy);
+  unsigned NumElements = Value.getArraySize();
+  unsigned NumInitElts = Value.getArrayInitializedElts();
+  for (unsigned I = 0; I != NumInitElts; ++I)
+    if (!Builder.AppendValue(Value.getArrayInitializedElt(I)))
+      return 0;
+
+  if (Value.hasArrayFiller()) {
+    const APValue &Filler = Value.getArrayFiller();
+    for (unsigned I = NumInitElts; I != NumElements; ++I)
+      if (!Builder.AppendValue(Filler))
+        return 0;
+  }
+  return Builder.Finish(NumElements);
+}
+
 //===----------------------------------------------------------------------===//
 //                             ConstExprEmitter
 //===----------------------------------------------------------------------===//
@@ -742,6 +1033,9 @@ public:
     if (ILE->isStringLiteralInit())
       return Visit(ILE->getInit(0));
 
+    if (llvm::Constant *C = ConstDataArrayBuilder::BuildArray(CGM, ILE))
+      return C;
+
     llvm::ArrayType *AType =
         cast<llvm::ArrayType>(ConvertType(ILE->getType()));
     llvm::Type *ElemTy = AType->getElementType();
@@ -1008,7 +1302,15 @@ llvm::Constant *CodeGenModule::EmitConstantInit(const VarDecl &D,
           return EmitNullConstant(D.getType());
       }
   }
-  
+
+  // Tables of literals are emitted directly, without evaluating the
+  // initializer to an APValue and creating a constant for each element.
+  if (D.getInit() && !D.getEvaluatedValue() &&
+      D.getType()->isConstantArrayType())
+    if (llvm::Constant *C = ConstDataArrayBuilder::BuildArray(*this,
+                                                              D.getInit()))
+      return C;
+
   if (const APValue *Value = D.evaluateValue())
     return EmitConstantValueForMemory(*Value, D.getType(), CGF);
 
@@ -1179,6 +1481,10 @@ llvm::Constant *CodeGenModule::EmitConstantValue(const APValue &Value,
   case APValue::Union:
     return ConstStructBuilder::BuildStruct(*this, CGF, Value, DestType);
   case APValue::Array: {
+    if (llvm::Constant *C =
+          ConstDataArrayBuilder::BuildArray(*this, Value, DestType))
+      return C;
+
     const ArrayType *CAT = Context.getAsArrayType(DestType);
     unsigned NumElements = Value.getArraySize();
     unsigned NumInitElts = Value.getArrayInitializedElts();
@@ -2821,7 +2821,11 @@ Value *ScalarExprEmitter::VisitBinLAnd(const BinaryOperator *E) {
   CodeGenFunction::ConditionalEvaluation eval(CGF);
 
   // Branch on the LHS first.  If it is false, go to the failure (cont) block.
-  CGF.EmitBranchOnBoolExpr(E->getLHS(), RHSBlock, ContBlock);
+  CGF.EmitBranchOnBoolExpr(E->getLHS(),
+                           CGF.PGO.getCountingBlock(E, 0, RHSBlock),
+                           CGF.PGO.getCountingBlock(E, 1, ContBlock),
+                           CGF.PGO.getRegionCount(E, 0),
+                           CGF.PGO.getRegionCount(E, 1));
 
   // Any edges into the ContBlock are now from an (indeterminate number of)
   // edges from this first condition.  All of these values will be false.  Start
@@ -2892,7 +2896,11 @@ Value *ScalarExprEmitter::VisitBinLOr(const BinaryOperator *E) {
   CodeGenFunction::ConditionalEvaluation eval(CGF);
 
   // Branch on the LHS first.  If it is true, go to the success (cont) block.
-  CGF.EmitBranchOnBoolExpr(E->getLHS(), ContBlock, RHSBlock);
+  CGF.EmitBranchOnBoolExpr(E->getLHS(),
+                           CGF.PGO.getCountingBlock(E, 1, ContBlock),
+                           CGF.PGO.getCountingBlock(E, 0, RHSBlock),
+                           CGF.PGO.getRegionCount(E, 1),
+                           CGF.PGO.getRegionCount(E, 0));
 
   // Any edges into the ContBlock are now from an (indeterminate number of)
   // edges from this first condition.  All of these values will be true.  Start
@@ -3053,7 +3061,10 @@ VisitAbstractConditionalOperator(const AbstractConditionalOperator *E) {
   llvm::BasicBlock *ContBlock = CGF.createBasicBlock("cond.end");
 
   CodeGenFunction::ConditionalEvaluation eval(CGF);
-  CGF.EmitBranchOnBoolExpr(condExpr, LHSBlock, RHSBlock);
+  CGF.EmitBranchOnBoolExpr(condExpr, CGF.PGO.getCountingBlock(E, 0, LHSBlock),
+                           CGF.PGO.getCountingBlock(E, 1, RHSBlock),
+                           CGF.PGO.getRegionCount(E, 0),
+                           CGF.PGO.getRegionCount(E, 1));
 
   CGF.EmitBlock(LHSBlock);
   eval.begin(CGF);
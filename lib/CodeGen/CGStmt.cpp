@@ -75,7 +75,6 @@ void CodeGenFunction::EmitStmt(const Stmt *S) {
   case Stmt::SEHExceptStmtClass:
   case Stmt::SEHFinallyStmtClass:
   case Stmt::MSDependentExistsStmtClass:
-  case Stmt::OMPParallelDirectiveClass:
     llvm_unreachable("invalid statement class to emit generically");
   case Stmt::NullStmtClass:
   case Stmt::CompoundStmtClass:
@@ -99,7 +98,12 @@ void CodeGenFunction::EmitStmt(const Stmt *S) {
     llvm::BasicBlock *incoming = Builder.GetInsertBlock();
     assert(incoming && "expression emission must have an insertion point");
 
-    EmitIgnoredExpr(cast<Expr>(S));
+    {
+      // The temporaries of the expression live until the end of the
+      // statement, even in C, where there is no ExprWithCleanups.
+      RunCleanupsScope Scope(*this);
+      EmitIgnoredExpr(cast<Expr>(S));
+    }
 
     llvm::BasicBlock *outgoing = Builder.GetInsertBlock();
     assert(outgoing && "expression emission cleared block!");
@@ -139,6 +143,12 @@ void CodeGenFunction::EmitStmt(const Stmt *S) {
   case Stmt::CapturedStmtClass:
     EmitCapturedStmt(cast<CapturedStmt>(*S), CR_Default);
     break;
+  case Stmt::OMPParallelDirectiveClass:
+    EmitOMPParallelDirective(cast<OMPParallelDirective>(*S));
+    break;
+  case Stmt::OMPParallelForDirectiveClass:
+    EmitOMPParallelForDirective(cast<OMPParallelForDirective>(*S));
+    break;
   case Stmt::ObjCAtTryStmtClass:
     EmitObjCAtTryStmt(cast<ObjCAtTryStmt>(*S));
     break;
@@ -388,7 +398,25 @@ void CodeGenFunction::EmitLabelStmt(const LabelStmt &S) {
 }
 
 void CodeGenFunction::EmitAttributedStmt(const AttributedStmt &S) {
-  EmitStmt(S.getSubStmt());
+  // Loops need their attributes, which may carry '#pragma clang loop' hints.
+  const Stmt *SubStmt = S.getSubStmt();
+  switch (SubStmt->getStmtClass()) {
+  case Stmt::WhileStmtClass:
+    EmitWhileStmt(cast<WhileStmt>(*SubStmt), S.getAttrs());
+    break;
+  case Stmt::DoStmtClass:
+    EmitDoStmt(cast<DoStmt>(*SubStmt), S.getAttrs());
+    break;
+  case Stmt::ForStmtClass:
+    EmitForStmt(cast<ForStmt>(*SubStmt), S.getAttrs());
+    break;
+  case Stmt::CXXForRangeStmtClass:
+    EmitCXXForRangeStmt(cast<CXXForRangeStmt>(*SubStmt), S.getAttrs());
+    break;
+  default:
+    EmitStmt(SubStmt);
+    break;
+  }
 }
 
 void CodeGenFunction::EmitGotoStmt(const GotoStmt &S) {
@@ -459,7 +487,9 @@ void CodeGenFunction::EmitIfStmt(const IfStmt &S) {
   llvm::BasicBlock *ElseBlock = ContBlock;
   if (S.getElse())
     ElseBlock = createBasicBlock("if.else");
-  EmitBranchOnBoolExpr(S.getCond(), ThenBlock, ElseBlock);
+  EmitBranchOnBoolExpr(S.getCond(), PGO.getCountingBlock(&S, 0, ThenBlock),
+                       PGO.getCountingBlock(&S, 1, ElseBlock),
+                       PGO.getRegionCount(&S, 0), PGO.getRegionCount(&S, 1));
 
   // Emit the 'then' code.
   EmitBlock(ThenBlock); 
@@ -489,7 +519,82 @@ void CodeGenFunction::EmitIfStmt(const IfStmt &S) {
   EmitBlock(ContBlock, true);
 }
 
-void CodeGenFunction::EmitWhileStmt(const WhileStmt &S) {
+void CodeGenFunction::EmitLoopHints(llvm::BranchInst *BackEdge,
+                                    ArrayRef<const Attr *> Attrs) {
+  // The first operand of the loop ID is a reference to the ID itself, which
+  // keeps the IDs of different loops distinct. The parsed attributes of a
+  // statement are listed last to first, so walk them backwards to write the
+  // hints in the order of the source.
+  SmallVector<llvm::Value *, 4> Metadata(1);
+  for (unsigned I = Attrs.size(); I != 0; --I) {
+    const LoopHintAttr *LH = dyn_cast<LoopHintAttr>(Attrs[I - 1]);
+    if (!LH)
+      continue;
+
+    // Disabling vectorization or interleaving is expressed as a width or
+    // interleave count of one. The vectorizer calls interleaving unrolling.
+    unsigned ValueInt = LH->getValue();
+    const char *Name = 0;
+    llvm::Value *Value = 0;
+    switch (LH->getOption()) {
+    case LoopHintAttr::Vectorize:
+    case LoopHintAttr::Interleave:
+      if (ValueInt) {
+        Name = "llvm.vectorizer.enable";
+        Value = Builder.getTrue();
+        break;
+      }
+      ValueInt = 1;
+      Name = LH->getOption() == LoopHintAttr::Vectorize
+               ? "llvm.vectorizer.width" : "llvm.vectorizer.unroll";
+      Value = Builder.getInt32(ValueInt);
+      break;
+    case LoopHintAttr::VectorizeWidth:
+      Name = "llvm.vectorizer.width";
+      Value = Builder.getInt32(ValueInt);
+      break;
+    case LoopHintAttr::InterleaveCount:
+      Name = "llvm.vectorizer.unroll";
+      Value = Builder.getInt32(ValueInt);
+      break;
+    case LoopHintAttr::Unroll:
+      Name = "llvm.loop.unroll.enable";
+      Value = Builder.getInt1(ValueInt != 0);
+      break;
+    case LoopHintAttr::UnrollCount:
+      Name = "llvm.loop.unroll.count";
+      Value = Builder.getInt32(ValueInt);
+      break;
+    }
+
+    llvm::Value *Op[] = { llvm::MDString::get(getLLVMContext(), Name), Value };
+    Metadata.push_back(llvm::MDNode::get(getLLVMContext(), Op));
+  }
+
+  if (Metadata.size() == 1)
+    return;
+
+  llvm::MDNode *LoopID = llvm::MDNode::get(getLLVMContext(), Metadata);
+  LoopID->replaceOperandWith(0, LoopID);
+  BackEdge->setMetadata("llvm.loop", LoopID);
+}
+
+void CodeGenFunction::EmitLoopBackEdge(llvm::BasicBlock *Header,
+                                       ArrayRef<const Attr *> Attrs) {
+  llvm::BasicBlock *CurBB = Builder.GetInsertBlock();
+  EmitBranch(Header);
+  if (!CurBB || Attrs.empty())
+    return;
+
+  // A 'continue' at the end of the body may already have branched back.
+  if (llvm::BranchInst *BackEdge =
+        dyn_cast_or_null<llvm::BranchInst>(CurBB->getTerminator()))
+    if (BackEdge->isUnconditional() && BackEdge->getSuccessor(0) == Header)
+      EmitLoopHints(BackEdge, Attrs);
+}
+
+void CodeGenFunction::EmitWhileStmt(const WhileStmt &S,
+                                    ArrayRef<const Attr *> Attrs) {
   // Emit the header for the loop, which will also become
   // the continue target.
   JumpDest LoopHeader = getJumpDestInCurrentScope("while.cond");
@@ -533,7 +638,9 @@ void CodeGenFunction::EmitWhileStmt(const WhileStmt &S) {
     if (ConditionScope.requiresCleanups())
       ExitBlock = createBasicBlock("while.exit");
 
-    Builder.CreateCondBr(BoolCondVal, LoopBody, ExitBlock);
+    Builder.CreateCondBr(BoolCondVal, PGO.getCountingBlock(&S, 0, LoopBody),
+                         PGO.getCountingBlock(&S, 1, ExitBlock),
+                         PGO.getBranchWeights(&S));
 
     if (ExitBlock != LoopExit.getBlock()) {
       EmitBlock(ExitBlock);
@@ -555,7 +662,7 @@ void CodeGenFunction::EmitWhileStmt(const WhileStmt &S) {
   ConditionScope.ForceCleanup();
 
   // Branch to the loop header again.
-  EmitBranch(LoopHeader.getBlock());
+  EmitLoopBackEdge(LoopHeader.getBlock(), Attrs);
 
   // Emit the exit block.
   EmitBlock(LoopExit.getBlock(), true);
@@ -566,7 +673,8 @@ void CodeGenFunction::EmitWhileStmt(const WhileStmt &S) {
     SimplifyForwardingBlocks(LoopHeader.getBlock());
 }
 
-void CodeGenFunction::EmitDoStmt(const DoStmt &S) {
+void CodeGenFunction::EmitDoStmt(const DoStmt &S,
+                                 ArrayRef<const Attr *> Attrs) {
   JumpDest LoopExit = getJumpDestInCurrentScope("do.end");
   JumpDest LoopCond = getJumpDestInCurrentScope("do.cond");
 
@@ -601,8 +709,14 @@ void CodeGenFunction::EmitDoStmt(const DoStmt &S) {
       EmitBoolCondBranch = false;
 
   // As long as the condition is true, iterate the loop.
-  if (EmitBoolCondBranch)
-    Builder.CreateCondBr(BoolCondVal, LoopBody, LoopExit.getBlock());
+  if (EmitBoolCondBranch) {
+    llvm::BranchInst *CondBr =
+      Builder.CreateCondBr(BoolCondVal, PGO.getCountingBlock(&S, 0, LoopBody),
+                           PGO.getCountingBlock(&S, 1, LoopExit.getBlock()),
+                           PGO.getBranchWeights(&S));
+    if (!Attrs.empty())
+      EmitLoopHints(CondBr, Attrs);
+  }
 
   // Emit the exit block.
   EmitBlock(LoopExit.getBlock());
@@ -613,7 +727,8 @@ void CodeGenFunction::EmitDoStmt(const DoStmt &S) {
     SimplifyForwardingBlocks(LoopCond.getBlock());
 }
 
-void CodeGenFunction::EmitForStmt(const ForStmt &S) {
+void CodeGenFunction::EmitForStmt(const ForStmt &S,
+                                  ArrayRef<const Attr *> Attrs) {
   JumpDest LoopExit = getJumpDestInCurrentScope("for.end");
 
   RunCleanupsScope ForScope(*this);
@@ -656,7 +771,9 @@ void CodeGenFunction::EmitForStmt(const ForStmt &S) {
     // C99 6.8.5p2/p4: The first substatement is executed if the expression
     // compares unequal to 0.  The condition must be a scalar type.
     BoolCondVal = EvaluateExprAsBool(S.getCond());
-    Builder.CreateCondBr(BoolCondVal, ForBody, ExitBlock);
+    Builder.CreateCondBr(BoolCondVal, PGO.getCountingBlock(&S, 0, ForBody),
+                         PGO.getCountingBlock(&S, 1, ExitBlock),
+                         PGO.getBranchWeights(&S));
 
     if (ExitBlock != LoopExit.getBlock()) {
       EmitBlock(ExitBlock);
@@ -695,7 +812,7 @@ void CodeGenFunction::EmitForStmt(const ForStmt &S) {
   BreakContinueStack.pop_back();
 
   ConditionScope.ForceCleanup();
-  EmitBranch(CondBlock);
+  EmitLoopBackEdge(CondBlock, Attrs);
 
   ForScope.ForceCleanup();
 
@@ -706,7 +823,8 @@ void CodeGenFunction::EmitForStmt(const ForStmt &S) {
   EmitBlock(LoopExit.getBlock(), true);
 }
 
-void CodeGenFunction::EmitCXXForRangeStmt(const CXXForRangeStmt &S) {
+void CodeGenFunction::EmitCXXForRangeStmt(const CXXForRangeStmt &S,
+                                          ArrayRef<const Attr *> Attrs) {
   JumpDest LoopExit = getJumpDestInCurrentScope("for.end");
 
   RunCleanupsScope ForScope(*this);
@@ -737,7 +855,9 @@ void CodeGenFunction::EmitCXXForRangeStmt(const CXXForRangeStmt &S) {
   // The body is executed if the expression, contextually converted
   // to bool, is true.
   llvm::Value *BoolCondVal = EvaluateExprAsBool(S.getCond());
-  Builder.CreateCondBr(BoolCondVal, ForBody, ExitBlock);
+  Builder.CreateCondBr(BoolCondVal, PGO.getCountingBlock(&S, 0, ForBody),
+                       PGO.getCountingBlock(&S, 1, ExitBlock),
+                       PGO.getBranchWeights(&S));
 
   if (ExitBlock != LoopExit.getBlock()) {
     EmitBlock(ExitBlock);
@@ -765,7 +885,7 @@ void CodeGenFunction::EmitCXXForRangeStmt(const CXXForRangeStmt &S) {
 
   BreakContinueStack.pop_back();
 
-  EmitBranch(CondBlock);
+  EmitLoopBackEdge(CondBlock, Attrs);
 
   ForScope.ForceCleanup();
 
@@ -921,8 +1041,13 @@ void CodeGenFunction::EmitCaseStmtRange(const CaseStmt &S) {
   // FIXME: parameters such as this should not be hardcoded.
   if (Range.ult(llvm::APInt(Range.getBitWidth(), 64))) {
     // Range is small enough to add multiple switch instruction cases.
-    for (unsigned i = 0, e = Range.getZExtValue() + 1; i != e; ++i) {
-      SwitchInsn->addCase(Builder.getInt(LHS), CaseDest);
+    unsigned NumCases = Range.getZExtValue() + 1;
+    llvm::BasicBlock *CountedDest = PGO.getCountingBlock(&S, 0, CaseDest);
+    for (unsigned i = 0; i != NumCases; ++i) {
+      SwitchInsn->addCase(Builder.getInt(LHS), CountedDest);
+      // Spread the count of the range evenly over its values.
+      if (SwitchWeights)
+        SwitchWeights->push_back(PGO.getRegionCount(&S, 0) / NumCases);
       LHS++;
     }
     return;
@@ -946,7 +1071,7 @@ void CodeGenFunction::EmitCaseStmtRange(const CaseStmt &S) {
     Builder.CreateSub(SwitchInsn->getCondition(), Builder.getInt(LHS));
   llvm::Value *Cond =
     Builder.CreateICmpULE(Diff, Builder.getInt(Range), "inbounds");
-  Builder.CreateCondBr(Cond, CaseDest, FalseDest);
+  Builder.CreateCondBr(Cond, PGO.getCountingBlock(&S, 0, CaseDest), FalseDest);
 
   // Restore the appropriate insertion point.
   if (RestoreBB)
@@ -983,7 +1108,10 @@ void CodeGenFunction::EmitCaseStmt(const CaseStmt &S) {
 
     // Only do this optimization if there are no cleanups that need emitting.
     if (isObviouslyBranchWithoutCleanups(Block)) {
-      SwitchInsn->addCase(CaseVal, Block.getBlock());
+      SwitchInsn->addCase(CaseVal,
+                          PGO.getCountingBlock(&S, 0, Block.getBlock()));
+      if (SwitchWeights)
+        SwitchWeights->push_back(PGO.getRegionCount(&S, 0));
 
       // If there was a fallthrough into this case, make sure to redirect it to
       // the end of the switch as well.
@@ -997,7 +1125,9 @@ void CodeGenFunction::EmitCaseStmt(const CaseStmt &S) {
 
   EmitBlock(createBasicBlock("sw.bb"));
   llvm::BasicBlock *CaseDest = Builder.GetInsertBlock();
-  SwitchInsn->addCase(CaseVal, CaseDest);
+  SwitchInsn->addCase(CaseVal, PGO.getCountingBlock(&S, 0, CaseDest));
+  if (SwitchWeights)
+    SwitchWeights->push_back(PGO.getRegionCount(&S, 0));
 
   // Recursively emitting the statement is acceptable, but is not wonderful for
   // code where we have many case statements nested together, i.e.:
@@ -1016,7 +1146,9 @@ void CodeGenFunction::EmitCaseStmt(const CaseStmt &S) {
     CurCase = NextCase;
     llvm::ConstantInt *CaseVal = 
       Builder.getInt(CurCase->getLHS()->EvaluateKnownConstInt(getContext()));
-    SwitchInsn->addCase(CaseVal, CaseDest);
+    SwitchInsn->addCase(CaseVal, PGO.getCountingBlock(CurCase, 0, CaseDest));
+    if (SwitchWeights)
+      SwitchWeights->push_back(PGO.getRegionCount(CurCase, 0));
     NextCase = dyn_cast<CaseStmt>(CurCase->getSubStmt());
   }
 
@@ -1243,6 +1375,7 @@ void CodeGenFunction::EmitSwitchStmt(const SwitchStmt &S) {
 
   // Handle nested switch statements.
   llvm::SwitchInst *SavedSwitchInsn = SwitchInsn;
+  SmallVector<uint64_t, 16> *SavedSwitchWeights = SwitchWeights;
   llvm::BasicBlock *SavedCRBlock = CaseRangeBlock;
 
   // See if we can constant fold the condition of the switch and therefore only
@@ -1282,6 +1415,14 @@ void CodeGenFunction::EmitSwitchStmt(const SwitchStmt &S) {
   SwitchInsn = Builder.CreateSwitch(CondV, DefaultBlock);
   CaseRangeBlock = DefaultBlock;
 
+  // Collect the profiled counts of the cases as they are added.
+  SmallVector<uint64_t, 16> CaseWeights;
+  SwitchWeights = 0;
+  if (PGO.haveRegionCounts()) {
+    CaseWeights.push_back(PGO.getRegionCount(&S, 0));
+    SwitchWeights = &CaseWeights;
+  }
+
   // Clear the insertion point to indicate we are in unreachable code.
   Builder.ClearInsertionPoint();
 
@@ -1300,7 +1441,14 @@ void CodeGenFunction::EmitSwitchStmt(const SwitchStmt &S) {
 
   // Update the default block in case explicit case range tests have
   // been chained on top.
-  SwitchInsn->setDefaultDest(CaseRangeBlock);
+  SwitchInsn->setDefaultDest(PGO.getCountingBlock(&S, 0, CaseRangeBlock));
+
+  if (SwitchWeights) {
+    assert(SwitchWeights->size() == 1 + SwitchInsn->getNumCases() &&
+           "switch weights do not match the switch cases");
+    if (llvm::MDNode *Weights = PGO.createBranchWeights(*SwitchWeights))
+      SwitchInsn->setMetadata(llvm::LLVMContext::MD_prof, Weights);
+  }
 
   // If a default was never emitted:
   if (!DefaultBlock->getParent()) {
@@ -1322,6 +1470,7 @@ void CodeGenFunction::EmitSwitchStmt(const SwitchStmt &S) {
   EmitBlock(SwitchExit.getBlock(), true);
 
   SwitchInsn = SavedSwitchInsn;
+  SwitchWeights = SavedSwitchWeights;
   CaseRangeBlock = SavedCRBlock;
 }
 
@@ -1769,20 +1918,24 @@ void CodeGenFunction::EmitAsmStmt(const AsmStmt &S) {
   }
 }
 
-static LValue InitCapturedStruct(CodeGenFunction &CGF, const CapturedStmt &S) {
+/// Create the captured struct of a CapturedStmt and store the captured
+/// variables into it.
+LValue CodeGenFunction::InitCapturedStruct(const CapturedStmt &S,
+                                           llvm::Value *Slot) {
   const RecordDecl *RD = S.getCapturedRecordDecl();
-  QualType RecordTy = CGF.getContext().getRecordType(RD);
+  QualType RecordTy = getContext().getRecordType(RD);
 
   // Initialize the captured struct.
-  LValue SlotLV = CGF.MakeNaturalAlignAddrLValue(
-                    CGF.CreateMemTemp(RecordTy, "agg.captured"), RecordTy);
+  if (!Slot)
+    Slot = CreateMemTemp(RecordTy, "agg.captured");
+  LValue SlotLV = MakeNaturalAlignAddrLValue(Slot, RecordTy);
 
   RecordDecl::field_iterator CurField = RD->field_begin();
   for (CapturedStmt::capture_init_iterator I = S.capture_init_begin(),
                                            E = S.capture_init_end();
        I != E; ++I, ++CurField) {
-    LValue LV = CGF.EmitLValueForFieldInitialization(SlotLV, *CurField);
-    CGF.EmitInitializerForField(*CurField, LV, *I, ArrayRef<VarDecl *>());
+    LValue LV = EmitLValueForFieldInitialization(SlotLV, *CurField);
+    EmitInitializerForField(*CurField, LV, *I, ArrayRef<VarDecl *>());
   }
 
   return SlotLV;
@@ -1796,7 +1949,7 @@ CodeGenFunction::EmitCapturedStmt(const CapturedStmt &S, CapturedRegionKind K) {
   const RecordDecl *RD = S.getCapturedRecordDecl();
   assert(CD->hasBody() && "missing CapturedDecl body");
 
-  LValue CapStruct = InitCapturedStruct(*this, S);
+  LValue CapStruct = InitCapturedStruct(S);
 
   // Emit the CapturedDecl
   CodeGenFunction CGF(CGM, true);
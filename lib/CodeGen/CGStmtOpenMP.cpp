@@ -0,0 +1,405 @@
+//===--- CGStmtOpenMP.cpp - Emit LLVM Code from OpenMP Statements ---------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// This contains code to emit OpenMP nodes as LLVM code, as calls into the GNU
+// OpenMP runtime library (libgomp).
+//
+// The associated statement of a parallel directive is outlined into a helper
+// function that takes the captured struct of the region, like any other
+// CapturedStmt. The region is then run by a team of threads:
+//
+//   GOMP_parallel_start(helper, &captured, 0);
+//   helper(&captured);
+//   GOMP_parallel_end();
+//
+// The iterations of the loop of a 'parallel for' are handed out to the
+// threads of the team in chunks by the GOMP_loop_<schedule>_start and
+// GOMP_loop_<schedule>_next entry points.
+//
+//===----------------------------------------------------------------------===//
+
+#include "CodeGenFunction.h"
+#include "CodeGenModule.h"
+#include "clang/AST/StmtOpenMP.h"
+#include "llvm/ADT/SmallString.h"
+using namespace clang;
+using namespace CodeGen;
+
+/// \brief Find the schedule clause of \p D, if any.
+static const OMPScheduleClause *
+getOMPScheduleClause(const OMPExecutableDirective &D) {
+  ArrayRef<OMPClause *> Clauses = D.clauses();
+  for (ArrayRef<OMPClause *>::iterator I = Clauses.begin(),
+                                       E = Clauses.end(); I != E; ++I)
+    if (const OMPScheduleClause *C = dyn_cast_or_null<OMPScheduleClause>(*I))
+      return C;
+  return 0;
+}
+
+namespace {
+/// \brief The outlined function of an OpenMP region.
+class CGOpenMPRegionInfo : public CodeGenFunction::CGCapturedStmtInfo {
+  const OMPExecutableDirective &D;
+
+  /// \brief The type of the context passed to the outlined function when the
+  /// chunk size of the schedule is not a constant: the captured struct,
+  /// followed by the value of the chunk size. Null otherwise.
+  llvm::StructType *ContextTy;
+
+public:
+  CGOpenMPRegionInfo(const OMPExecutableDirective &D, const CapturedStmt &CS,
+                     llvm::StructType *ContextTy)
+    : CGCapturedStmtInfo(CS, CR_OpenMP), D(D), ContextTy(ContextTy) {}
+
+  virtual void EmitBody(CodeGenFunction &CGF, Stmt *S) {
+    CodeGenFunction::RunCleanupsScope Scope(CGF);
+
+    ArrayRef<OMPClause *> Clauses = D.clauses();
+    for (ArrayRef<OMPClause *>::iterator I = Clauses.begin(),
+                                         E = Clauses.end(); I != E; ++I)
+      if (const OMPPrivateClause *C = dyn_cast_or_null<OMPPrivateClause>(*I))
+        CGF.EmitOMPPrivateClause(*C);
+
+    if (!isa<OMPParallelForDirective>(D)) {
+      CGF.EmitStmt(S);
+      return;
+    }
+
+    // The variables the chunk size refers to are not captured, so it is
+    // either folded here or evaluated before the region.
+    const OMPScheduleClause *Schedule = getOMPScheduleClause(D);
+    llvm::Value *Chunk = 0;
+    if (const Expr *ChunkSize = Schedule ? Schedule->getChunkSize() : 0) {
+      llvm::APSInt Value;
+      if (ContextTy) {
+        llvm::Value *Addr = CGF.Builder.CreateStructGEP(
+          CGF.Builder.CreateBitCast(getContextValue(),
+                                    ContextTy->getPointerTo()),
+          1, "omp.chunk.addr");
+        Chunk = CGF.EmitLoadOfScalar(
+          CGF.MakeNaturalAlignAddrLValue(Addr, ChunkSize->getType()));
+      } else {
+        bool Folded = ChunkSize->EvaluateAsInt(Value, CGF.getContext());
+        assert(Folded && "chunk size not passed to the outlined function");
+        (void)Folded;
+        Chunk = llvm::ConstantInt::get(CGF.getLLVMContext(), Value);
+      }
+    }
+    CGF.EmitOMPWorksharingLoop(cast<ForStmt>(*S), Schedule, Chunk);
+  }
+
+  virtual StringRef getHelperName() const { return ".omp_outlined."; }
+};
+}
+
+/// Outline the associated statement of \p S and run it in a team of threads.
+static void EmitOMPParallelRegion(CodeGenFunction &CGF,
+                                  const OMPExecutableDirective &S) {
+  CodeGenModule &CGM = CGF.CGM;
+  const CapturedStmt &CS = *cast<CapturedStmt>(S.getAssociatedStmt());
+
+  // A chunk size that is not a constant is evaluated once, before the
+  // region, and passed to the outlined function after the captured struct,
+  // so that the context still points to the captured struct.
+  const OMPScheduleClause *Schedule = getOMPScheduleClause(S);
+  const Expr *ChunkSize = Schedule ? Schedule->getChunkSize() : 0;
+  llvm::StructType *ContextTy = 0;
+  llvm::Value *Context;
+  if (ChunkSize && !ChunkSize->isEvaluatable(CGF.getContext())) {
+    QualType RecordTy =
+      CGF.getContext().getRecordType(CS.getCapturedRecordDecl());
+    ContextTy = llvm::StructType::get(
+      CGF.ConvertTypeForMem(RecordTy),
+      CGF.ConvertTypeForMem(ChunkSize->getType()), NULL);
+    llvm::Value *Slot = CGF.CreateTempAlloca(ContextTy, "agg.captured");
+    Context = CGF.InitCapturedStruct(CS, CGF.Builder.CreateStructGEP(Slot, 0))
+                .getAddress();
+    CGF.EmitStoreOfScalar(CGF.EmitScalarExpr(ChunkSize),
+                          CGF.MakeNaturalAlignAddrLValue(
+                            CGF.Builder.CreateStructGEP(Slot, 1),
+                            ChunkSize->getType()));
+  } else {
+    Context = CGF.InitCapturedStruct(CS).getAddress();
+  }
+
+  llvm::Function *Fn;
+  {
+    CodeGenFunction OutlinedCGF(CGM, true);
+    CGOpenMPRegionInfo RegionInfo(S, CS, ContextTy);
+    OutlinedCGF.CapturedStmtInfo = &RegionInfo;
+    Fn = OutlinedCGF.GenerateCapturedStmtFunction(CS.getCapturedDecl(),
+                                                  CS.getCapturedRecordDecl());
+  }
+
+  // void GOMP_parallel_start(void (*fn)(void *), void *data,
+  //                          unsigned num_threads);
+  llvm::Type *FnArgTys[] = { CGF.Int8PtrTy };
+  llvm::Type *FnPtrTy =
+    llvm::FunctionType::get(CGF.VoidTy, FnArgTys, false)->getPointerTo();
+  llvm::Type *StartArgTys[] = { FnPtrTy, CGF.Int8PtrTy, CGF.Int32Ty };
+  llvm::Constant *StartFn = CGM.CreateRuntimeFunction(
+    llvm::FunctionType::get(CGF.VoidTy, StartArgTys, false),
+    "GOMP_parallel_start");
+  llvm::Constant *EndFn = CGM.CreateRuntimeFunction(
+    llvm::FunctionType::get(CGF.VoidTy, false), "GOMP_parallel_end");
+
+  // Start the other threads of the team, with the default number of threads,
+  // run the region on this thread, and wait for the team to finish.
+  llvm::Value *StartArgs[] = {
+    CGF.Builder.CreateBitCast(Fn, FnPtrTy),
+    CGF.Builder.CreateBitCast(Context, CGF.Int8PtrTy),
+    CGF.Builder.getInt32(0)
+  };
+  CGF.EmitNounwindRuntimeCall(StartFn, StartArgs);
+  CGF.EmitCallOrInvoke(Fn, Context);
+  CGF.EmitNounwindRuntimeCall(EndFn);
+}
+
+void CodeGenFunction::EmitOMPPrivateClause(const OMPPrivateClause &C) {
+  for (OMPPrivateClause::varlist_const_iterator I = C.varlist_begin(),
+                                                E = C.varlist_end();
+       I != E; ++I) {
+    const VarDecl *VD = cast<VarDecl>(cast<DeclRefExpr>(*I)->getDecl());
+    QualType Ty = VD->getType();
+    if (Ty->isVariablyModifiedType()) {
+      CGM.ErrorUnsupported(*I, "private variable of variably modified type");
+      continue;
+    }
+    llvm::Value *Addr = CreateMemTemp(Ty, VD->getName() + ".private");
+
+    // Private variables of class type are default constructed.
+    QualType ElementTy = getContext().getBaseElementType(Ty);
+    if (const CXXRecordDecl *RD = ElementTy->getAsCXXRecordDecl()) {
+      const CXXConstructorDecl *Ctor = 0;
+      for (CXXRecordDecl::ctor_iterator CI = RD->ctor_begin(),
+                                        CE = RD->ctor_end(); CI != CE; ++CI)
+        if (CI->isDefaultConstructor()) {
+          Ctor = *CI;
+          break;
+        }
+      if (Ctor && !Ctor->isTrivial()) {
+        if (Ctor->getNumParams()) {
+          CGM.ErrorUnsupported(VD, "private variable whose default "
+                                   "constructor has default arguments");
+        } else if (const ConstantArrayType *ArrayTy =
+                     getContext().getAsConstantArrayType(Ty)) {
+          EmitCXXAggrConstructorCall(Ctor, ArrayTy, Addr,
+                                     CallExpr::const_arg_iterator(),
+                                     CallExpr::const_arg_iterator());
+        } else {
+          EmitCXXConstructorCall(Ctor, Ctor_Complete, /*ForVirtualBase=*/false,
+                                 /*Delegating=*/false, Addr,
+                                 CallExpr::const_arg_iterator(),
+                                 CallExpr::const_arg_iterator());
+        }
+      }
+    }
+    if (QualType::DestructionKind DtorKind = Ty.isDestructedType())
+      pushDestroy(DtorKind, Addr, Ty);
+
+    LocalDeclMap[VD] = Addr;
+  }
+}
+
+void CodeGenFunction::EmitOMPParallelDirective(const OMPParallelDirective &S) {
+  EmitOMPParallelRegion(*this, S);
+}
+
+void
+CodeGenFunction::EmitOMPParallelForDirective(const OMPParallelForDirective &S) {
+  EmitOMPParallelRegion(*this, S);
+}
+
+void
+CodeGenFunction::EmitOMPWorksharingLoop(const ForStmt &S,
+                                        const OMPScheduleClause *Schedule,
+                                        llvm::Value *Chunk) {
+  OMPCanonicalLoop Loop;
+  OMPCanonicalLoop::Form Form = Loop.analyze(&S);
+  assert(Form == OMPCanonicalLoop::Canonical && "loop not checked by Sema");
+  (void)Form;
+
+  RunCleanupsScope ForScope(*this);
+
+  // The loop iteration variable is private to each thread.
+  const VarDecl *Var = Loop.Var;
+  QualType VarTy = Var->getType();
+  if (isa<DeclStmt>(S.getInit()))
+    EmitAutoVarCleanups(EmitAutoVarAlloca(*Var));
+  else
+    LocalDeclMap[Var] = CreateMemTemp(VarTy, Var->getName() + ".private");
+
+  // Signed loops whose variable fits in a 'long' use the runtime entry points
+  // with 'long' iteration values. Other loops, such as 'long long' ones on
+  // 32-bit targets, use the ones with 'unsigned long long' values; the values
+  // of signed loops are then biased by the minimum signed value, so that the
+  // unsigned comparisons of the runtime keep their order.
+  ASTContext &Ctx = getContext();
+  bool IsSigned = VarTy->hasSignedIntegerRepresentation();
+  bool IsLong = IsSigned &&
+                Ctx.getTypeSize(VarTy) <= Ctx.getTypeSize(Ctx.LongTy);
+  QualType IterTy = IsLong ? Ctx.LongTy : Ctx.UnsignedLongLongTy;
+  llvm::Type *IterLLVMTy = ConvertType(IterTy);
+  llvm::Value *Bias = 0;
+  if (IsSigned && !IsLong)
+    Bias = llvm::ConstantInt::get(getLLVMContext(),
+             llvm::APInt::getSignedMinValue(Ctx.getTypeSize(IterTy)));
+
+  // The runtime takes the iteration space as a half-open range and a step.
+  llvm::Value *Start = EmitScalarConversion(EmitScalarExpr(Loop.LowerBound),
+                                            Loop.LowerBound->getType(),
+                                            IterTy);
+  llvm::Value *End = EmitScalarConversion(EmitScalarExpr(Loop.TestBound),
+                                          Loop.TestBound->getType(), IterTy);
+  if (Bias) {
+    Start = Builder.CreateAdd(Start, Bias);
+    End = Builder.CreateAdd(End, Bias);
+  }
+  llvm::Value *One = llvm::ConstantInt::get(IterLLVMTy, 1);
+  if (Loop.TestOp == BO_LE)
+    End = Builder.CreateAdd(End, One);
+  else if (Loop.TestOp == BO_GE)
+    End = Builder.CreateSub(End, One);
+  llvm::Value *Incr = One;
+  if (Loop.Step)
+    Incr = EmitScalarConversion(EmitScalarExpr(Loop.Step),
+                                Loop.Step->getType(), IterTy);
+  if (Loop.IsDecrement)
+    Incr = Builder.CreateNeg(Incr);
+
+  OpenMPScheduleClauseKind Kind =
+    Schedule ? Schedule->getScheduleKind() : OMPC_SCHEDULE_static;
+  if (Chunk) {
+    Chunk = EmitScalarConversion(Chunk, Schedule->getChunkSize()->getType(),
+                                 IterTy);
+  } else if (Kind == OMPC_SCHEDULE_dynamic || Kind == OMPC_SCHEDULE_guided) {
+    Chunk = One;
+  } else {
+    // A static schedule without a chunk size divides the iterations into
+    // one chunk per thread.
+    Chunk = llvm::ConstantInt::get(IterLLVMTy, 0);
+  }
+
+  // The runtime leaves the schedule of 'auto' loops to the implementation;
+  // they are scheduled like static ones.
+  const char *KindName = "static";
+  switch (Kind) {
+  case OMPC_SCHEDULE_dynamic: KindName = "dynamic"; break;
+  case OMPC_SCHEDULE_guided:  KindName = "guided";  break;
+  case OMPC_SCHEDULE_runtime: KindName = "runtime"; break;
+  case OMPC_SCHEDULE_static:
+  case OMPC_SCHEDULE_auto:
+  case OMPC_SCHEDULE_unknown:
+  case NUM_OPENMP_SCHEDULE_KINDS:
+    break;
+  }
+  SmallString<32> StartName(IsLong ? "GOMP_loop_" : "GOMP_loop_ull_");
+  StartName += KindName;
+  SmallString<32> NextName(StartName);
+  StartName += "_start";
+  NextName += "_next";
+
+  // bool GOMP_loop_<kind>_start([bool up,] start, end, incr, [chunk,]
+  //                             *istart, *iend);
+  // bool GOMP_loop_<kind>_next(*istart, *iend);
+  llvm::Value *IStart = CreateMemTemp(IterTy, "omp.istart");
+  llvm::Value *IEnd = CreateMemTemp(IterTy, "omp.iend");
+  SmallVector<llvm::Value *, 7> StartArgs;
+  if (!IsLong)
+    StartArgs.push_back(Builder.getInt8(Loop.isIncreasing()));
+  StartArgs.push_back(Start);
+  StartArgs.push_back(End);
+  StartArgs.push_back(Incr);
+  if (Kind != OMPC_SCHEDULE_runtime)
+    StartArgs.push_back(Chunk);
+  StartArgs.push_back(IStart);
+  StartArgs.push_back(IEnd);
+  SmallVector<llvm::Type *, 7> StartArgTys;
+  for (unsigned I = 0, N = StartArgs.size(); I != N; ++I)
+    StartArgTys.push_back(StartArgs[I]->getType());
+  llvm::Constant *StartFn = CGM.CreateRuntimeFunction(
+    llvm::FunctionType::get(Int8Ty, StartArgTys, false), StartName);
+  llvm::Type *NextArgTys[] = { IStart->getType(), IEnd->getType() };
+  llvm::Constant *NextFn = CGM.CreateRuntimeFunction(
+    llvm::FunctionType::get(Int8Ty, NextArgTys, false), NextName);
+  llvm::Constant *EndFn = CGM.CreateRuntimeFunction(
+    llvm::FunctionType::get(VoidTy, false), "GOMP_loop_end");
+
+  // if (GOMP_loop_<kind>_start(..., &istart, &iend)) {
+  //   do {
+  //     for (iv = istart; iv < iend; iv += incr) {
+  //       var = iv;
+  //       body;
+  //     }
+  //   } while (GOMP_loop_<kind>_next(&istart, &iend));
+  // }
+  // GOMP_loop_end();
+  JumpDest LoopExit = getJumpDestInCurrentScope("omp.loop.end");
+  llvm::BasicBlock *ChunkBlock = createBasicBlock("omp.loop.chunk");
+  llvm::BasicBlock *CondBlock = createBasicBlock("omp.loop.cond");
+  llvm::BasicBlock *BodyBlock = createBasicBlock("omp.loop.body");
+  llvm::BasicBlock *NextBlock = createBasicBlock("omp.loop.next");
+  JumpDest Continue = getJumpDestInCurrentScope("omp.loop.inc");
+  llvm::Value *IV = CreateMemTemp(IterTy, "omp.iv");
+
+  llvm::CallInst *HasWork = EmitNounwindRuntimeCall(StartFn, StartArgs);
+  if (!IsLong) {
+    // 'up' is a C 'bool'.
+    if (llvm::Function *F = dyn_cast<llvm::Function>(StartFn))
+      F->addAttribute(1, llvm::Attribute::ZExt);
+    HasWork->addAttribute(1, llvm::Attribute::ZExt);
+  }
+  Builder.CreateCondBr(Builder.CreateIsNotNull(HasWork), ChunkBlock,
+                       LoopExit.getBlock());
+
+  // Run the iterations of the chunk [istart, iend) the runtime handed out.
+  EmitBlock(ChunkBlock);
+  Builder.CreateStore(Builder.CreateLoad(IStart), IV);
+
+  EmitBlock(CondBlock);
+  llvm::Value *Cur = Builder.CreateLoad(IV, "omp.iv.cur");
+  llvm::Value *ChunkEnd = Builder.CreateLoad(IEnd);
+  llvm::Value *InChunk;
+  if (Loop.isIncreasing())
+    InChunk = IsLong ? Builder.CreateICmpSLT(Cur, ChunkEnd)
+                     : Builder.CreateICmpULT(Cur, ChunkEnd);
+  else
+    InChunk = IsLong ? Builder.CreateICmpSGT(Cur, ChunkEnd)
+                     : Builder.CreateICmpUGT(Cur, ChunkEnd);
+  Builder.CreateCondBr(InChunk, BodyBlock, NextBlock);
+
+  EmitBlock(BodyBlock);
+  if (Bias)
+    Cur = Builder.CreateSub(Cur, Bias);
+  EmitStoreOfScalar(EmitScalarConversion(Cur, IterTy, VarTy),
+                    MakeAddrLValue(LocalDeclMap[Var], VarTy,
+                                   getContext().getDeclAlign(Var)));
+  {
+    // 'break' is diagnosed by Sema; 'continue' goes on to the next iteration.
+    BreakContinueStack.push_back(BreakContinue(LoopExit, Continue));
+    RunCleanupsScope BodyScope(*this);
+    EmitStmt(S.getBody());
+    BreakContinueStack.pop_back();
+  }
+
+  EmitBlock(Continue.getBlock());
+  Builder.CreateStore(Builder.CreateAdd(Builder.CreateLoad(IV), Incr), IV);
+  EmitBranch(CondBlock);
+
+  // Ask the runtime for the next chunk.
+  EmitBlock(NextBlock);
+  llvm::Value *NextArgs[] = { IStart, IEnd };
+  llvm::Value *HasMoreWork = EmitNounwindRuntimeCall(NextFn, NextArgs);
+  Builder.CreateCondBr(Builder.CreateIsNotNull(HasMoreWork), ChunkBlock,
+                       LoopExit.getBlock());
+
+  // Wait for the rest of the team at the end of the loop.
+  EmitBlock(LoopExit.getBlock(), true);
+  EmitNounwindRuntimeCall(EndFn);
+}
@@ -13,6 +13,7 @@
 
 #include "CodeGenFunction.h"
 #include "CGCXXABI.h"
+#include "CGDebugInfo.h"
 #include "CodeGenModule.h"
 #include "clang/AST/CXXInheritance.h"
 #include "clang/AST/RecordLayout.h"
@@ -837,6 +838,10 @@ CodeGenVTables::GenerateClassData(const CXXRecordDecl *RD) {
   llvm::GlobalVariable::LinkageTypes Linkage = CGM.getVTableLinkage(RD);
   EmitVTableDefinition(VTable, Linkage, RD);
 
+  // The debug info for the class goes along with its vtable.
+  if (CGDebugInfo *DI = CGM.getModuleDebugInfo())
+    DI->completeClassData(RD);
+
   if (RD->getNumVBases())
     CGM.getCXXABI().EmitVirtualInheritanceTables(Linkage, RD);
 
@@ -27,12 +27,13 @@
 #include "llvm/IR/Intrinsics.h"
 #include "llvm/IR/MDBuilder.h"
 #include "llvm/IR/Operator.h"
+#include "llvm/Support/CallSite.h"
 using namespace clang;
 using namespace CodeGen;
 
 CodeGenFunction::CodeGenFunction(CodeGenModule &cgm, bool suppressNewContext)
   : CodeGenTypeCache(cgm), CGM(cgm), Target(cgm.getTarget()),
-    Builder(cgm.getModule().getContext()),
+    Builder(cgm.getModule().getContext()), PGO(cgm),
     CapturedStmtInfo(0),
     SanitizePerformTypeCheck(CGM.getSanOpts().Null |
                              CGM.getSanOpts().Alignment |
@@ -43,7 +44,8 @@ CodeGenFunction::CodeGenFunction(CodeGenModule &cgm, bool suppressNewContext)
     LambdaThisCaptureField(0), NormalCleanupDest(0), NextCleanupDestIndex(1),
     FirstBlockInfo(0), EHResumeBlock(0), ExceptionSlot(0), EHSelectorSlot(0),
     DebugInfo(0), DisableDebugInfo(false), DidCallStackSave(false),
-    IndirectBranch(0), SwitchInsn(0), CaseRangeBlock(0), UnreachableBlock(0),
+    BypassedVarsComputed(false), IndirectBranch(0), SwitchInsn(0),
+    SwitchWeights(0), CaseRangeBlock(0), UnreachableBlock(0),
     NumReturnExprs(0), NumSimpleReturnExprs(0),
     CXXABIThisDecl(0), CXXABIThisValue(0), CXXThisValue(0),
     CXXDefaultInitExprThis(0),
@@ -684,6 +686,10 @@ void CodeGenFunction::GenerateCode(GlobalDecl GD, llvm::Function *Fn,
   // Emit the standard function prologue.
   StartFunction(GD, ResTy, Fn, FnInfo, Args, BodyRange.getBegin());
 
+  // Assign profile counters to the body of the function, and count the entry.
+  PGO.assignRegionCounters(FD, Fn);
+  PGO.emitEntryCounterIncrement(Builder);
+
   // Generate the body of the function.
   if (isa<CXXDestructorDecl>(FD))
     EmitDestructorBody(Args);
@@ -835,7 +841,9 @@ ConstantFoldsToSimpleInteger(const Expr *Cond, llvm::APSInt &ResultInt) {
 ///
 void CodeGenFunction::EmitBranchOnBoolExpr(const Expr *Cond,
                                            llvm::BasicBlock *TrueBlock,
-                                           llvm::BasicBlock *FalseBlock) {
+                                           llvm::BasicBlock *FalseBlock,
+                                           uint64_t TrueCount,
+                                           uint64_t FalseCount) {
   Cond = Cond->IgnoreParens();
 
   if (const BinaryOperator *CondBOp = dyn_cast<BinaryOperator>(Cond)) {
@@ -847,7 +855,8 @@ void CodeGenFunction::EmitBranchOnBoolExpr(const Expr *Cond,
       if (ConstantFoldsToSimpleInteger(CondBOp->getLHS(), ConstantBool) &&
           ConstantBool) {
         // br(1 && X) -> br(X).
-        return EmitBranchOnBoolExpr(CondBOp->getRHS(), TrueBlock, FalseBlock);
+        return EmitBranchOnBoolExpr(CondBOp->getRHS(), TrueBlock, FalseBlock,
+                                    TrueCount, FalseCount);
       }
 
       // If we have "X && 1", simplify the code to use an uncond branch.
@@ -855,20 +864,31 @@ void CodeGenFunction::EmitBranchOnBoolExpr(const Expr *Cond,
       if (ConstantFoldsToSimpleInteger(CondBOp->getRHS(), ConstantBool) &&
           ConstantBool) {
         // br(X && 1) -> br(X).
-        return EmitBranchOnBoolExpr(CondBOp->getLHS(), TrueBlock, FalseBlock);
+        return EmitBranchOnBoolExpr(CondBOp->getLHS(), TrueBlock, FalseBlock,
+                                    TrueCount, FalseCount);
       }
 
       // Emit the LHS as a conditional.  If the LHS conditional is false, we
       // want to jump to the FalseBlock.
       llvm::BasicBlock *LHSTrue = createBasicBlock("land.lhs.true");
 
+      // The RHS only sees the executions that did not short-circuit.
+      uint64_t RHSCount = PGO.getRegionCount(CondBOp, 0);
+      uint64_t ShortCircuitCount = PGO.getRegionCount(CondBOp, 1);
+
       ConditionalEvaluation eval(*this);
-      EmitBranchOnBoolExpr(CondBOp->getLHS(), LHSTrue, FalseBlock);
+      EmitBranchOnBoolExpr(CondBOp->getLHS(),
+                           PGO.getCountingBlock(CondBOp, 0, LHSTrue),
+                           PGO.getCountingBlock(CondBOp, 1, FalseBlock),
+                           RHSCount, ShortCircuitCount);
       EmitBlock(LHSTrue);
 
       // Any temporaries created here are conditional.
       eval.begin(*this);
-      EmitBranchOnBoolExpr(CondBOp->getRHS(), TrueBlock, FalseBlock);
+      EmitBranchOnBoolExpr(CondBOp->getRHS(), TrueBlock, FalseBlock,
+                           TrueCount,
+                           FalseCount > ShortCircuitCount ?
+                             FalseCount - ShortCircuitCount : 0);
       eval.end(*this);
 
       return;
@@ -881,7 +901,8 @@ void CodeGenFunction::EmitBranchOnBoolExpr(const Expr *Cond,
       if (ConstantFoldsToSimpleInteger(CondBOp->getLHS(), ConstantBool) &&
           !ConstantBool) {
         // br(0 || X) -> br(X).
-        return EmitBranchOnBoolExpr(CondBOp->getRHS(), TrueBlock, FalseBlock);
+        return EmitBranchOnBoolExpr(CondBOp->getRHS(), TrueBlock, FalseBlock,
+                                    TrueCount, FalseCount);
       }
 
       // If we have "X || 0", simplify the code to use an uncond branch.
@@ -889,20 +910,31 @@ void CodeGenFunction::EmitBranchOnBoolExpr(const Expr *Cond,
       if (ConstantFoldsToSimpleInteger(CondBOp->getRHS(), ConstantBool) &&
           !ConstantBool) {
         // br(X || 0) -> br(X).
-        return EmitBranchOnBoolExpr(CondBOp->getLHS(), TrueBlock, FalseBlock);
+        return EmitBranchOnBoolExpr(CondBOp->getLHS(), TrueBlock, FalseBlock,
+                                    TrueCount, FalseCount);
       }
 
       // Emit the LHS as a conditional.  If the LHS conditional is true, we
       // want to jump to the TrueBlock.
       llvm::BasicBlock *LHSFalse = createBasicBlock("lor.lhs.false");
 
+      // The RHS only sees the executions that did not short-circuit.
+      uint64_t RHSCount = PGO.getRegionCount(CondBOp, 0);
+      uint64_t ShortCircuitCount = PGO.getRegionCount(CondBOp, 1);
+
       ConditionalEvaluation eval(*this);
-      EmitBranchOnBoolExpr(CondBOp->getLHS(), TrueBlock, LHSFalse);
+      EmitBranchOnBoolExpr(CondBOp->getLHS(),
+                           PGO.getCountingBlock(CondBOp, 1, TrueBlock),
+                           PGO.getCountingBlock(CondBOp, 0, LHSFalse),
+                           ShortCircuitCount, RHSCount);
       EmitBlock(LHSFalse);
 
       // Any temporaries created here are conditional.
       eval.begin(*this);
-      EmitBranchOnBoolExpr(CondBOp->getRHS(), TrueBlock, FalseBlock);
+      EmitBranchOnBoolExpr(CondBOp->getRHS(), TrueBlock, FalseBlock,
+                           TrueCount > ShortCircuitCount ?
+                             TrueCount - ShortCircuitCount : 0,
+                           FalseCount);
       eval.end(*this);
 
       return;
@@ -912,7 +944,8 @@ void CodeGenFunction::EmitBranchOnBoolExpr(const Expr *Cond,
   if (const UnaryOperator *CondUOp = dyn_cast<UnaryOperator>(Cond)) {
     // br(!x, t, f) -> br(x, f, t)
     if (CondUOp->getOpcode() == UO_LNot)
-      return EmitBranchOnBoolExpr(CondUOp->getSubExpr(), FalseBlock, TrueBlock);
+      return EmitBranchOnBoolExpr(CondUOp->getSubExpr(), FalseBlock, TrueBlock,
+                                  FalseCount, TrueCount);
   }
 
   if (const ConditionalOperator *CondOp = dyn_cast<ConditionalOperator>(Cond)) {
@@ -921,7 +954,11 @@ void CodeGenFunction::EmitBranchOnBoolExpr(const Expr *Cond,
     llvm::BasicBlock *RHSBlock = createBasicBlock("cond.false");
 
     ConditionalEvaluation cond(*this);
-    EmitBranchOnBoolExpr(CondOp->getCond(), LHSBlock, RHSBlock);
+    EmitBranchOnBoolExpr(CondOp->getCond(),
+                         PGO.getCountingBlock(CondOp, 0, LHSBlock),
+                         PGO.getCountingBlock(CondOp, 1, RHSBlock),
+                         PGO.getRegionCount(CondOp, 0),
+                         PGO.getRegionCount(CondOp, 1));
 
     cond.begin(*this);
     EmitBlock(LHSBlock);
@@ -948,7 +985,8 @@ void CodeGenFunction::EmitBranchOnBoolExpr(const Expr *Cond,
 
   // Emit the code with the fully general case.
   llvm::Value *CondV = EvaluateExprAsBool(Cond);
-  Builder.CreateCondBr(CondV, TrueBlock, FalseBlock);
+  Builder.CreateCondBr(CondV, TrueBlock, FalseBlock,
+                       PGO.createBranchWeights(TrueCount, FalseCount));
 }
 
 /// ErrorUnsupported - Print out an error that codegen doesn't support the
@@ -1461,4 +1499,47 @@ llvm::Value *CodeGenFunction::EmitFieldAnnotations(const FieldDecl *D,
   return V;
 }
 
+/// Whether alias analysis knows that \p V does not alias other pointers,
+/// because it is a noalias argument or the noalias result of a call.
+static bool isNoAliasPointer(llvm::Value *V) {
+  V = V->stripPointerCasts();
+  if (const llvm::Argument *Arg = dyn_cast<llvm::Argument>(V))
+    return Arg->hasNoAliasAttr();
+  llvm::ImmutableCallSite CS(V);
+  return CS && CS.paramHasAttr(0, llvm::Attribute::NoAlias);
+}
+
+llvm::Value *
+CodeGenFunction::EmitAlignmentAssumption(llvm::Value *PtrValue,
+                                         uint64_t Alignment,
+                                         llvm::Value *OffsetValue,
+                                         bool EvenIfNoAlias) {
+  if (Alignment <= 1 || (!EvenIfNoAlias && isNoAliasPointer(PtrValue)))
+    return PtrValue;
+  if (llvm::ConstantInt *CI = dyn_cast_or_null<llvm::ConstantInt>(OffsetValue))
+    if (CI->isZero())
+      OffsetValue = 0;
+
+  // There is no way to state an assumption about a value in the IR, so clear
+  // the low bits of the pointer instead. If the assumption holds this does
+  // not change the pointer, and value tracking sees the bits as known zero,
+  // which lets instcombine raise the alignment of the loads and stores
+  // through it. Alias analysis cannot see through the integer operations,
+  // though, so noalias pointers, whose accesses it knows most about, are
+  // left alone.
+  llvm::Value *PtrIntValue =
+    Builder.CreatePtrToInt(PtrValue, IntPtrTy, "ptrint");
+  if (OffsetValue) {
+    OffsetValue = Builder.CreateIntCast(OffsetValue, IntPtrTy,
+                                        /*isSigned*/false);
+    PtrIntValue = Builder.CreateSub(PtrIntValue, OffsetValue, "offsetptr");
+  }
+  llvm::Value *Mask = llvm::ConstantInt::get(IntPtrTy, ~(Alignment - 1));
+  llvm::Value *AlignedValue = Builder.CreateAnd(PtrIntValue, Mask, "maskedptr");
+  if (OffsetValue)
+    AlignedValue = Builder.CreateAdd(AlignedValue, OffsetValue);
+  return Builder.CreateIntToPtr(AlignedValue, PtrValue->getType(),
+                                "alignedptr");
+}
+
 CodeGenFunction::CGCapturedStmtInfo::~CGCapturedStmtInfo() { }
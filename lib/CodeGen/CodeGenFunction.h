@@ -19,6 +19,7 @@
 #include "CGValue.h"
 #include "EHScopeStack.h"
 #include "CodeGenModule.h"
+#include "CodeGenPGO.h"
 #include "clang/AST/CharUnits.h"
 #include "clang/AST/ExprCXX.h"
 #include "clang/AST/ExprObjC.h"
@@ -70,6 +71,10 @@ namespace clang {
   class ObjCAtThrowStmt;
   class ObjCAtSynchronizedStmt;
   class ObjCAutoreleasePoolStmt;
+  class OMPParallelDirective;
+  class OMPParallelForDirective;
+  class OMPPrivateClause;
+  class OMPScheduleClause;
 
 namespace CodeGen {
   class CodeGenTypes;
@@ -157,6 +162,10 @@ public:
   /// we prefer to insert allocas.
   llvm::AssertingVH<llvm::Instruction> AllocaInsertPt;
 
+  /// PGO - The region counters of the current function, for
+  /// instrumentation-based profile-guided optimization.
+  CodeGenPGO PGO;
+
   /// \brief API for captured statement code generation.
   class CGCapturedStmtInfo {
   public:
@@ -802,6 +811,13 @@ private:
   /// calling llvm.stacksave for multiple VLAs in the same scope.
   bool DidCallStackSave;
 
+  /// BypassedVars - The local variables whose scope contains a label or a
+  /// case that a jump from outside the scope can reach, and so can be entered
+  /// without passing their declaration. These do not get lifetime markers.
+  /// Computed the first time a variable would get them.
+  llvm::SmallPtrSet<const VarDecl *, 4> BypassedVars;
+  bool BypassedVarsComputed;
+
   /// IndirectBranch - The first time an indirect goto is seen we create a block
   /// with an indirect branch.  Every time we see the address of a label taken,
   /// we add the label to the indirect goto.  Every subsequent indirect goto is
@@ -831,6 +847,10 @@ private:
   /// current context is not in a switch.
   llvm::SwitchInst *SwitchInsn;
 
+  /// SwitchWeights - The profiled counts of the default and of each case of
+  /// the current switch instruction, in order, if profile data is available.
+  SmallVector<uint64_t, 16> *SwitchWeights;
+
   /// CaseRangeBlock - This block holds if condition check for last case
   /// statement range in current switch instruction.
   llvm::BasicBlock *CaseRangeBlock;
@@ -1761,6 +1781,16 @@ public:
   void emitAutoVarTypeCleanup(const AutoVarEmission &emission,
                               QualType::DestructionKind dtorKind);
 
+  /// EmitLifetimeStart - Emit a lifetime.start marker for the \p Size bytes
+  /// at \p Addr, and return the size operand to pass to EmitLifetimeEnd.
+  llvm::Value *EmitLifetimeStart(uint64_t Size, llvm::Value *Addr);
+  void EmitLifetimeEnd(llvm::Value *Size, llvm::Value *Addr);
+
+  /// EmitTemporaryLifetimeStart - Mark the temporary of type \p Ty at \p Addr
+  /// as live from here to the end of the innermost cleanup scope, which is
+  /// that of the full-expression, if lifetime markers are used for it.
+  void EmitTemporaryLifetimeStart(llvm::Value *Addr, QualType Ty);
+
   void EmitStaticVarDecl(const VarDecl &D,
                          llvm::GlobalValue::LinkageTypes Linkage);
 
@@ -1818,9 +1848,11 @@ public:
   void EmitGotoStmt(const GotoStmt &S);
   void EmitIndirectGotoStmt(const IndirectGotoStmt &S);
   void EmitIfStmt(const IfStmt &S);
-  void EmitWhileStmt(const WhileStmt &S);
-  void EmitDoStmt(const DoStmt &S);
-  void EmitForStmt(const ForStmt &S);
+  void EmitWhileStmt(const WhileStmt &S,
+                     ArrayRef<const Attr *> Attrs = None);
+  void EmitDoStmt(const DoStmt &S, ArrayRef<const Attr *> Attrs = None);
+  void EmitForStmt(const ForStmt &S,
+                   ArrayRef<const Attr *> Attrs = None);
   void EmitReturnStmt(const ReturnStmt &S);
   void EmitDeclStmt(const DeclStmt &S);
   void EmitBreakStmt(const BreakStmt &S);
@@ -1843,12 +1875,43 @@ public:
   void ExitCXXTryStmt(const CXXTryStmt &S, bool IsFnTryBlock = false);
 
   void EmitCXXTryStmt(const CXXTryStmt &S);
-  void EmitCXXForRangeStmt(const CXXForRangeStmt &S);
-
+  void EmitCXXForRangeStmt(const CXXForRangeStmt &S,
+                           ArrayRef<const Attr *> Attrs = None);
+
+  /// EmitLoopHints - Attach the '#pragma clang loop' hints among \p Attrs to
+  /// the branch \p BackEdge that closes the loop, as llvm.loop metadata.
+  void EmitLoopHints(llvm::BranchInst *BackEdge,
+                     ArrayRef<const Attr *> Attrs);
+
+  /// EmitLoopBackEdge - Branch from the current block to the loop header
+  /// \p Header, as EmitBranch does, and attach the loop hints among \p Attrs
+  /// to the branch.
+  void EmitLoopBackEdge(llvm::BasicBlock *Header,
+                        ArrayRef<const Attr *> Attrs);
+
+  /// InitCapturedStruct - Store the captured variables of \p S into a new
+  /// captured struct, or into \p Slot if it is not null.
+  LValue InitCapturedStruct(const CapturedStmt &S, llvm::Value *Slot = 0);
   llvm::Function *EmitCapturedStmt(const CapturedStmt &S, CapturedRegionKind K);
   llvm::Function *GenerateCapturedStmtFunction(const CapturedDecl *CD,
                                                const RecordDecl *RD);
 
+  void EmitOMPParallelDirective(const OMPParallelDirective &S);
+  void EmitOMPParallelForDirective(const OMPParallelForDirective &S);
+
+  /// EmitOMPPrivateClause - Allocate a private copy of each variable in
+  /// \p C and make the references to the variable in the current OpenMP
+  /// region use it.
+  void EmitOMPPrivateClause(const OMPPrivateClause &C);
+
+  /// EmitOMPWorksharingLoop - Emit the loop \p S of an OpenMP loop directive
+  /// so that its iterations are divided among the threads of the current
+  /// team, as \p Schedule requests. \p Chunk is the value of the chunk size
+  /// of \p Schedule, if it has one.
+  void EmitOMPWorksharingLoop(const ForStmt &S,
+                              const OMPScheduleClause *Schedule,
+                              llvm::Value *Chunk);
+
   //===--------------------------------------------------------------------===//
   //                         LValue Expression Emission
   //===--------------------------------------------------------------------===//
@@ -2373,6 +2436,16 @@ public:
   /// annotation result.
   llvm::Value *EmitFieldAnnotations(const FieldDecl *D, llvm::Value *V);
 
+  /// EmitAlignmentAssumption - Return a pointer equal to PtrValue from which
+  /// the optimizer can tell that PtrValue minus OffsetValue, if given, is a
+  /// multiple of Alignment, which must be a power of two. Unless EvenIfNoAlias
+  /// is set, PtrValue is returned as is if it is a noalias argument or call
+  /// result, whose aliasing information the assumption would hide.
+  llvm::Value *EmitAlignmentAssumption(llvm::Value *PtrValue,
+                                       uint64_t Alignment,
+                                       llvm::Value *OffsetValue = 0,
+                                       bool EvenIfNoAlias = false);
+
   //===--------------------------------------------------------------------===//
   //                             Internal Helpers
   //===--------------------------------------------------------------------===//
@@ -2400,8 +2473,11 @@ public:
   /// EmitBranchOnBoolExpr - Emit a branch on a boolean condition (e.g. for an
   /// if statement) to the specified blocks.  Based on the condition, this might
   /// try to simplify the codegen of the conditional based on the branch.
+  /// TrueCount and FalseCount are the profiled counts of the two edges, if
+  /// profile data is available.
   void EmitBranchOnBoolExpr(const Expr *Cond, llvm::BasicBlock *TrueBlock,
-                            llvm::BasicBlock *FalseBlock);
+                            llvm::BasicBlock *FalseBlock,
+                            uint64_t TrueCount = 0, uint64_t FalseCount = 0);
 
   /// \brief Emit a description of a type in a format suitable for passing to
   /// a runtime sanitizer handler.
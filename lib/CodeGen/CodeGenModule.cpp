@@ -19,6 +19,7 @@
 #include "CGObjCRuntime.h"
 #include "CGOpenCLRuntime.h"
 #include "CodeGenFunction.h"
+#include "CodeGenPGO.h"
 #include "CodeGenTBAA.h"
 #include "TargetInfo.h"
 #include "clang/AST/ASTContext.h"
@@ -36,6 +37,7 @@
 #include "clang/Basic/SourceManager.h"
 #include "clang/Basic/TargetInfo.h"
 #include "clang/Frontend/CodeGenOptions.h"
+#include "clang/Frontend/FrontendDiagnostic.h"
 #include "llvm/ADT/APSInt.h"
 #include "llvm/ADT/Triple.h"
 #include "llvm/IR/CallingConv.h"
@@ -46,6 +48,7 @@
 #include "llvm/Support/CallSite.h"
 #include "llvm/Support/ConvertUTF.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/raw_ostream.h"
 #include "llvm/Target/Mangler.h"
 
 using namespace clang;
@@ -77,7 +80,8 @@ CodeGenModule::CodeGenModule(ASTContext &C, const CodeGenOptions &CGO,
     TheTargetCodeGenInfo(0), Types(*this), VTables(*this),
     ObjCRuntime(0), OpenCLRuntime(0), CUDARuntime(0),
     DebugInfo(0), ARCData(0), NoObjCARCExceptionsMetadata(0),
-    RRData(0), CFConstantStringClassRef(0),
+    RRData(0), PGOData(0), NumPGOFunctions(0), NumPGOMismatchedFunctions(0),
+    CFConstantStringClassRef(0),
     ConstantStringClassRef(0), NSConstantStringType(0),
     NSConcreteGlobalBlock(0), NSConcreteStackBlock(0),
     BlockObjectAssign(0), BlockObjectDispose(0),
@@ -131,6 +135,14 @@ CodeGenModule::CodeGenModule(ASTContext &C, const CodeGenOptions &CGO,
   if (C.getLangOpts().ObjCAutoRefCount)
     ARCData = new ARCEntrypoints();
   RRData = new RREntrypoints();
+
+  if (!CodeGenOpts.InstrProfileInput.empty()) {
+    std::string ErrorStr;
+    PGOData = PGOProfileData::create(CodeGenOpts.InstrProfileInput, ErrorStr);
+    if (!PGOData)
+      Diags.Report(diag::err_fe_profile_data_unreadable)
+        << CodeGenOpts.InstrProfileInput << ErrorStr;
+  }
 }
 
 CodeGenModule::~CodeGenModule() {
@@ -143,6 +155,7 @@ CodeGenModule::~CodeGenModule() {
   delete DebugInfo;
   delete ARCData;
   delete RRData;
+  delete PGOData;
 }
 
 void CodeGenModule::createObjCRuntime() {
@@ -180,10 +193,12 @@ void CodeGenModule::Release() {
   if (ObjCRuntime)
     if (llvm::Function *ObjCInitFunction = ObjCRuntime->ModuleInitFunction())
       AddGlobalCtor(ObjCInitFunction);
+  EmitInstrProfRegistration();
   EmitCtorList(GlobalCtors, "llvm.global_ctors");
   EmitCtorList(GlobalDtors, "llvm.global_dtors");
   EmitGlobalAnnotations();
   EmitStaticExternCAliases();
+  EmitIndirectFunctions();
   EmitLLVMUsed();
 
   if (CodeGenOpts.Autolink &&
@@ -204,6 +219,10 @@ void CodeGenModule::Release() {
   if (getCodeGenOpts().EmitGcovArcs || getCodeGenOpts().EmitGcovNotes)
     EmitCoverageFile();
 
+  if (PGOData && NumPGOMismatchedFunctions)
+    getDiags().Report(diag::warn_profile_data_out_of_date)
+      << NumPGOFunctions << NumPGOMismatchedFunctions;
+
   if (DebugInfo)
     DebugInfo->finalize();
 }
@@ -414,37 +433,13 @@ void CodeGenModule::setTypeVisibility(llvm::GlobalValue *GV,
 }
 
 StringRef CodeGenModule::getMangledName(GlobalDecl GD) {
-  const NamedDecl *ND = cast<NamedDecl>(GD.getDecl());
-
   StringRef &Str = MangledDeclNames[GD.getCanonicalDecl()];
   if (!Str.empty())
     return Str;
 
-  if (!getCXXABI().getMangleContext().shouldMangleDeclName(ND)) {
-    IdentifierInfo *II = ND->getIdentifier();
-    assert(II && "Attempt to mangle unnamed decl.");
-
-    Str = II->getName();
-    return Str;
-  }
-  
-  SmallString<256> Buffer;
-  llvm::raw_svector_ostream Out(Buffer);
-  if (const CXXConstructorDecl *D = dyn_cast<CXXConstructorDecl>(ND))
-    getCXXABI().getMangleContext().mangleCXXCtor(D, GD.getCtorType(), Out);
-  else if (const CXXDestructorDecl *D = dyn_cast<CXXDestructorDecl>(ND))
-    getCXXABI().getMangleContext().mangleCXXDtor(D, GD.getDtorType(), Out);
-  else
-    getCXXABI().getMangleContext().mangleName(ND, Out);
-
-  // Allocate space for the mangled name.
-  Out.flush();
-  size_t Length = Buffer.size();
-  char *Name = MangledNamesAllocator.Allocate<char>(Length);
-  std::copy(Buffer.begin(), Buffer.end(), Name);
-  
-  Str = StringRef(Name, Length);
-  
+  // The ASTContext caches mangled names, so that they are shared with any
+  // other client mangling the same declarations.
+  Str = getCXXABI().getMangleContext().getMangledName(GD);
   return Str;
 }
 
@@ -583,6 +578,53 @@ void CodeGenModule::SetLLVMFunctionAttributes(const Decl *D,
   ConstructAttributeList(Info, D, AttributeList, CallingConv, false);
   F->setAttributes(llvm::AttributeSet::get(getLLVMContext(), AttributeList));
   F->setCallingConv(static_cast<llvm::CallingConv::ID>(CallingConv));
+
+  if (const TargetAttr *TA = D ? D->getAttr<TargetAttr>() : 0)
+    AddTargetFeatures(F, TA->getFeatures());
+}
+
+void CodeGenModule::AddTargetFeatures(llvm::Function *F, StringRef Features) {
+  const TargetInfo &Target = getTarget();
+  const std::vector<std::string> &TUFeatures = Target.getTargetOpts().Features;
+
+  llvm::StringMap<bool> Enabled;
+  for (unsigned I = 0, E = TUFeatures.size(); I != E; ++I)
+    Enabled[StringRef(TUFeatures[I]).substr(1)] = TUFeatures[I][0] == '+';
+
+  SmallVector<StringRef, 4> Names;
+  if (!Features.empty())
+    Features.split(Names, ",");
+  for (unsigned I = 0, E = Names.size(); I != E; ++I) {
+    StringRef Name = Names[I].trim();
+    bool Enable = !Name.startswith("no-");
+    if (!Enable)
+      Name = Name.substr(3);
+    Target.setFeatureEnabled(Enabled, Name, Enable);
+  }
+
+  // List the features in the order the translation unit does, so that a
+  // function compiled for the same features gets the same string as the
+  // module.
+  std::string List;
+  for (unsigned I = 0, E = TUFeatures.size(); I != E; ++I) {
+    StringRef Name = StringRef(TUFeatures[I]).substr(1);
+    List += List.empty() ? "" : ",";
+    List += Enabled[Name] ? '+' : '-';
+    List += Name;
+    Enabled.erase(Name);
+  }
+  for (llvm::StringMap<bool>::const_iterator I = Enabled.begin(),
+                                             E = Enabled.end(); I != E; ++I) {
+    List += List.empty() ? "" : ",";
+    List += I->second ? '+' : '-';
+    List += I->first();
+  }
+
+  llvm::AttrBuilder B;
+  B.addAttribute("target-features", List);
+  F->addAttributes(llvm::AttributeSet::FunctionIndex,
+                   llvm::AttributeSet::get(
+                       F->getContext(), llvm::AttributeSet::FunctionIndex, B));
 }
 
 /// Determines whether the language options require us to model
@@ -619,7 +661,9 @@ void CodeGenModule::SetLLVMFunctionAttributesForDefinition(const Decl *D,
     // Naked implies noinline: we should not be inlining such functions.
     B.addAttribute(llvm::Attribute::Naked);
     B.addAttribute(llvm::Attribute::NoInline);
-  } else if (D->hasAttr<NoInlineAttr>()) {
+  } else if (D->hasAttr<NoInlineAttr>() || D->hasAttr<TargetAttr>()) {
+    // A function compiled for other target features than its callers cannot
+    // be inlined into them.
     B.addAttribute(llvm::Attribute::NoInline);
   } else if ((D->hasAttr<AlwaysInlineAttr>() ||
               D->hasAttr<ForceInlineAttr>()) &&
@@ -2083,6 +2127,9 @@ void CodeGenModule::EmitGlobalFunctionDefinition(GlobalDecl GD) {
   // want to propagate this information down (e.g. to local static
   // declarations).
   llvm::Function *Fn = cast<llvm::Function>(Entry);
+  if (D->hasAttr<TargetClonesAttr>())
+    return EmitTargetClonesDefinition(GD, Fn, FI);
+
   setFunctionLinkage(GD, Fn);
 
   // FIXME: this is redundant with part of SetFunctionDefinitionAttributes
@@ -2103,6 +2150,159 @@ void CodeGenModule::EmitGlobalFunctionDefinition(GlobalDecl GD) {
     AddGlobalAnnotations(D, Fn);
 }
 
+namespace {
+/// \brief A copy of a function with a target_clones attribute.
+struct TargetClone {
+  StringRef Version;
+  llvm::Function *Fn;
+  /// The features the processor needs for this copy, beyond those of the
+  /// translation unit.
+  std::vector<std::string> Required;
+  /// Try the copies that need the most features first.
+  bool operator<(const TargetClone &RHS) const {
+    return Required.size() > RHS.Required.size();
+  }
+};
+}
+
+/// Emit the definition of a function with a target_clones attribute: a copy
+/// of the function for each version, compiled for the features of the
+/// version, and an ELF indirect function that makes the symbol of the
+/// function refer to the best copy the processor supports once the program is
+/// loaded.
+void CodeGenModule::EmitTargetClonesDefinition(GlobalDecl GD,
+                                               llvm::Function *Fn,
+                                               const CGFunctionInfo &FI) {
+  const FunctionDecl *D = cast<FunctionDecl>(GD.getDecl());
+  llvm::GlobalValue::LinkageTypes Linkage = getFunctionLinkage(GD);
+  if (Linkage == llvm::GlobalValue::AvailableExternallyLinkage)
+    return;
+
+  // The symbol of the function stays a declaration, so EmitDeferred cannot
+  // tell that a definition queued more than once has already been emitted.
+  if (!EmittedTargetClones.insert(GD.getCanonicalDecl()).second)
+    return;
+
+  const TargetInfo &Target = getTarget();
+  llvm::StringMap<bool> TUFeatures;
+  const std::vector<std::string> &Features = Target.getTargetOpts().Features;
+  for (unsigned I = 0, E = Features.size(); I != E; ++I)
+    TUFeatures[StringRef(Features[I]).substr(1)] = Features[I][0] == '+';
+
+  SmallVector<StringRef, 4> Versions;
+  D->getAttr<TargetClonesAttr>()->getVersions().split(Versions, ",");
+  std::vector<TargetClone> Clones;
+  llvm::Function *Default = 0;
+  for (unsigned I = 0, E = Versions.size(); I != E; ++I) {
+    StringRef Version = Versions[I];
+    llvm::Function *Clone =
+      llvm::Function::Create(Fn->getFunctionType(),
+                             llvm::Function::InternalLinkage,
+                             Fn->getName() + "." + Version, &getModule());
+    SetLLVMFunctionAttributes(D, FI, Clone);
+    AddTargetFeatures(Clone, Version == "default" ? StringRef() : Version);
+    CodeGenFunction(*this).GenerateCode(GD, Clone, FI);
+    SetFunctionDefinitionAttributes(D, Clone);
+    SetLLVMFunctionAttributesForDefinition(D, Clone);
+    Clone->setVisibility(llvm::GlobalValue::DefaultVisibility);
+
+    if (Version == "default") {
+      Default = Clone;
+      continue;
+    }
+    TargetClone TC;
+    TC.Version = Version;
+    TC.Fn = Clone;
+    llvm::StringMap<bool> VersionFeatures = TUFeatures;
+    bool Enable = !Version.startswith("no-");
+    Target.setFeatureEnabled(VersionFeatures, Enable ? Version
+                                                     : Version.substr(3),
+                             Enable);
+    for (llvm::StringMap<bool>::const_iterator F = VersionFeatures.begin(),
+                                               FE = VersionFeatures.end();
+         F != FE; ++F)
+      if (F->second && !TUFeatures.lookup(F->first()))
+        TC.Required.push_back(F->first().str());
+    Clones.push_back(TC);
+  }
+  std::stable_sort(Clones.begin(), Clones.end());
+
+  // The resolver returns the address of the copy to use. Each test selects
+  // its copy over the ones of the tests before it, so the tests run from the
+  // least to the most demanding version. It is named by
+  // EmitIndirectFunctions, so that a declaration emitted later cannot claim
+  // its name.
+  CodeGenFunction CGF(*this);
+  const CGFunctionInfo &ResolverFI =
+    getTypes().arrangeFunctionDeclaration(getContext().VoidPtrTy,
+                                          FunctionArgList(),
+                                          FunctionType::ExtInfo(), false);
+  llvm::Function *Resolver =
+    llvm::Function::Create(getTypes().GetFunctionType(ResolverFI),
+                           llvm::Function::InternalLinkage, "",
+                           &getModule());
+  CGF.StartFunction(GlobalDecl(), getContext().VoidPtrTy, Resolver,
+                    ResolverFI, FunctionArgList(), SourceLocation());
+  llvm::Value *Selected = CGF.Builder.CreateBitCast(Default, Int8PtrTy);
+  for (unsigned I = Clones.size(); I != 0; --I) {
+    const TargetClone &TC = Clones[I - 1];
+    SmallVector<StringRef, 8> Required(TC.Required.begin(),
+                                       TC.Required.end());
+    llvm::Value *Supported =
+      getTargetCodeGenInfo().emitCPUSupports(CGF, Required);
+    if (!Supported) {
+      Error(D->getLocation(), "cannot check at run time whether the processor "
+                              "supports the target_clones version '" +
+                              TC.Version.str() + "'");
+      continue;
+    }
+    Selected = CGF.Builder.CreateSelect(
+        Supported, CGF.Builder.CreateBitCast(TC.Fn, Int8PtrTy), Selected);
+  }
+  CGF.Builder.CreateStore(Selected, CGF.ReturnValue);
+  CGF.FinishFunction();
+  AddUsedGlobal(Resolver);
+
+  // Uses of the function in this module refer to its symbol by name, like
+  // uses of a function defined in another one.
+  setGlobalVisibility(Fn, D);
+  IndirectFunction IFunc;
+  IFunc.Symbol = Fn->getName();
+  IFunc.Linkage = Linkage;
+  IFunc.Visibility = Fn->getVisibility();
+  IFunc.Resolver = Resolver;
+  IndirectFunctions.push_back(IFunc);
+}
+
+/// LLVM IR cannot define an indirect function, so the symbols of the
+/// functions with a target_clones attribute are defined in module-level
+/// assembly. Only objects and assembly generated from the module define them;
+/// the backend rejects other outputs of modules with such functions.
+void CodeGenModule::EmitIndirectFunctions() {
+  for (unsigned I = 0, N = IndirectFunctions.size(); I != N; ++I) {
+    const IndirectFunction &IFunc = IndirectFunctions[I];
+    llvm::Function *Resolver =
+      cast_or_null<llvm::Function>(&*IFunc.Resolver);
+    if (!Resolver)
+      continue;
+    Resolver->setName(IFunc.Symbol + ".resolver");
+
+    std::string Asm;
+    llvm::raw_string_ostream OS(Asm);
+    if (llvm::GlobalValue::isWeakForLinker(IFunc.Linkage))
+      OS << "\t.weak\t" << IFunc.Symbol << '\n';
+    else if (!llvm::GlobalValue::isLocalLinkage(IFunc.Linkage))
+      OS << "\t.globl\t" << IFunc.Symbol << '\n';
+    if (IFunc.Visibility == llvm::GlobalValue::HiddenVisibility)
+      OS << "\t.hidden\t" << IFunc.Symbol << '\n';
+    else if (IFunc.Visibility == llvm::GlobalValue::ProtectedVisibility)
+      OS << "\t.protected\t" << IFunc.Symbol << '\n';
+    OS << "\t.type\t" << IFunc.Symbol << ",@gnu_indirect_function\n";
+    OS << "\t.set\t" << IFunc.Symbol << "," << Resolver->getName();
+    getModule().appendModuleInlineAsm(OS.str());
+  }
+}
+
 void CodeGenModule::EmitAliasDefinition(GlobalDecl GD) {
   const ValueDecl *D = cast<ValueDecl>(GD.getDecl());
   const AliasAttr *AA = D->getAttr<AliasAttr>();
@@ -2971,6 +3171,15 @@ void CodeGenModule::EmitTopLevelDecl(Decl *D) {
     break;
  }
 
+  case Decl::ClassTemplateSpecialization: {
+    const ClassTemplateSpecializationDecl *Spec =
+        cast<ClassTemplateSpecializationDecl>(D);
+    if (CGDebugInfo *DI = getModuleDebugInfo())
+      if (Spec->getSpecializationKind() == TSK_ExplicitInstantiationDefinition)
+        DI->completeTemplateDefinition(*Spec);
+    break;
+  }
+
   default:
     // Make sure we handled everything we should, every other kind is a
     // non-top-level decl.  FIXME: Would be nice to have an isTopLevelDeclKind
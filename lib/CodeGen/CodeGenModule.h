@@ -25,6 +25,7 @@
 #include "clang/Basic/LangOptions.h"
 #include "clang/Basic/Module.h"
 #include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/DenseSet.h"
 #include "llvm/ADT/SetVector.h"
 #include "llvm/ADT/SmallPtrSet.h"
 #include "llvm/ADT/StringMap.h"
@@ -85,6 +86,7 @@ namespace CodeGen {
   class CGCUDARuntime;
   class BlockFieldFlags;
   class FunctionArgList;
+  class PGOProfileData;
   
   struct OrderGlobalInits {
     unsigned int priority;
@@ -260,6 +262,27 @@ class CodeGenModule : public CodeGenTypeCache {
   llvm::MDNode *NoObjCARCExceptionsMetadata;
   RREntrypoints *RRData;
 
+  /// PGOData - The profile read for -fprofile-instr-use, if any.
+  PGOProfileData *PGOData;
+
+  /// NumPGOFunctions - The number of functions found in PGOData, and how many
+  /// of them had counts that no longer match the function.
+  unsigned NumPGOFunctions, NumPGOMismatchedFunctions;
+
+  /// \brief A function instrumented by -fprofile-instr-generate.
+  struct InstrumentedFunction {
+    /// The name the function's counts are recorded under.
+    std::string Name;
+    /// The structural hash of the function's region counters.
+    uint64_t Hash;
+    llvm::GlobalVariable *Counters;
+  };
+
+  /// InstrumentedFunctions - The functions instrumented by
+  /// -fprofile-instr-generate, whose counters are registered with the
+  /// profile runtime.
+  std::vector<InstrumentedFunction> InstrumentedFunctions;
+
   // WeakRefReferences - A set of references that have only been seen via
   // a weakref so far. This is used to remove the weak of the reference if we
   // ever see a direct reference or a definition.
@@ -276,6 +299,25 @@ class CodeGenModule : public CodeGenTypeCache {
   /// is done.
   std::vector<GlobalDecl> DeferredDeclsToEmit;
 
+  /// EmittedTargetClones - The canonical decls of the functions with a
+  /// target_clones attribute whose copies have been emitted.
+  llvm::DenseSet<GlobalDecl> EmittedTargetClones;
+
+  /// \brief The symbol of a function with a target_clones attribute, which is
+  /// defined as an indirect function in module-level assembly.
+  struct IndirectFunction {
+    std::string Symbol;
+    llvm::GlobalValue::LinkageTypes Linkage;
+    llvm::GlobalValue::VisibilityTypes Visibility;
+    /// The resolver, which is only named once the module is complete, so
+    /// that the assembly refers to its final name.
+    llvm::WeakVH Resolver;
+  };
+
+  /// IndirectFunctions - The indirect functions to define once the module
+  /// is complete.
+  std::vector<IndirectFunction> IndirectFunctions;
+
   /// DeferredVTables - A queue of (optional) vtables to consider emitting.
   std::vector<const CXXRecordDecl*> DeferredVTables;
 
@@ -293,10 +335,10 @@ class CodeGenModule : public CodeGenTypeCache {
   /// priorities to be emitted when the translation unit is complete.
   CtorList GlobalDtors;
 
-  /// MangledDeclNames - A map of canonical GlobalDecls to their mangled names.
+  /// MangledDeclNames - A map of canonical GlobalDecls to their mangled names,
+  /// which are owned by the ASTContext. EmitDeclMetadata walks it.
   llvm::DenseMap<GlobalDecl, StringRef> MangledDeclNames;
-  llvm::BumpPtrAllocator MangledNamesAllocator;
-  
+
   /// Global annotations.
   std::vector<llvm::Constant*> Annotations;
 
@@ -494,6 +536,28 @@ public:
 
   CGDebugInfo *getModuleDebugInfo() { return DebugInfo; }
 
+  PGOProfileData *getPGOData() const { return PGOData; }
+
+  /// \brief Record that a function was found in the profile data, and whether
+  /// its counts were ignored because they no longer match the function.
+  void notePGOFunction(bool Mismatched) {
+    ++NumPGOFunctions;
+    if (Mismatched)
+      ++NumPGOMismatchedFunctions;
+  }
+
+  /// \brief Record that the function whose profile name is \p Name and whose
+  /// counters have the structural hash \p Hash counts into \p Counters, so
+  /// that the counters get registered with the profile runtime.
+  void addInstrumentedFunction(StringRef Name, uint64_t Hash,
+                               llvm::GlobalVariable *Counters) {
+    InstrumentedFunction F;
+    F.Name = Name;
+    F.Hash = Hash;
+    F.Counters = Counters;
+    InstrumentedFunctions.push_back(F);
+  }
+
   llvm::MDNode *getNoObjCARCExceptionsMetadata() {
     if (!NoObjCARCExceptionsMetadata)
       NoObjCARCExceptionsMetadata =
@@ -881,6 +945,12 @@ public:
   /// which only apply to a function definintion.
   void SetLLVMFunctionAttributesForDefinition(const Decl *D, llvm::Function *F);
 
+  /// AddTargetFeatures - Add to the function the "target-features" attribute
+  /// for the features of the translation unit as changed by \p Features, a
+  /// comma-separated list of features as written in a target attribute, which
+  /// may be empty.
+  void AddTargetFeatures(llvm::Function *F, StringRef Features);
+
   /// ReturnTypeUsesSRet - Return true iff the given type uses 'sret' when used
   /// as a return type.
   bool ReturnTypeUsesSRet(const CGFunctionInfo &FI);
@@ -1019,6 +1089,8 @@ private:
   void EmitGlobalDefinition(GlobalDecl D);
 
   void EmitGlobalFunctionDefinition(GlobalDecl GD);
+  void EmitTargetClonesDefinition(GlobalDecl GD, llvm::Function *Fn,
+                                  const CGFunctionInfo &FI);
   void EmitGlobalVarDefinition(const VarDecl *D);
   void EmitAliasDefinition(GlobalDecl GD);
   void EmitObjCPropertyImplementations(const ObjCImplementationDecl *D);
@@ -1092,12 +1164,21 @@ private:
   /// linkage specifications, giving them the "expected" name where possible.
   void EmitStaticExternCAliases();
 
+  /// EmitIndirectFunctions - Name the resolvers of the functions with a
+  /// target_clones attribute, and define their symbols as indirect functions
+  /// in module-level assembly.
+  void EmitIndirectFunctions();
+
   void EmitDeclMetadata();
 
   /// EmitCoverageFile - Emit the llvm.gcov metadata used to tell LLVM where
   /// to emit the .gcno and .gcda files in a way that persists in .bc files.
   void EmitCoverageFile();
 
+  /// EmitInstrProfRegistration - Emit a global constructor that registers the
+  /// counters of each instrumented function with the profile runtime.
+  void EmitInstrProfRegistration();
+
   /// Emits the initializer for a uuidof string.
   llvm::Constant *EmitUuidofInitializer(StringRef uuidstr, QualType IIDType);
 
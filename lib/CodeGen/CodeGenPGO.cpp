@@ -0,0 +1,427 @@
+//===--- CodeGenPGO.cpp - PGO Instrumentation for LLVM CodeGen --*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Instrumentation-based profile-guided optimization
+//
+//===----------------------------------------------------------------------===//
+
+#include "CodeGenPGO.h"
+#include "CodeGenModule.h"
+#include "clang/AST/Attr.h"
+#include "clang/AST/DeclCXX.h"
+#include "clang/AST/DeclObjC.h"
+#include "clang/AST/RecursiveASTVisitor.h"
+#include "clang/AST/StmtCXX.h"
+#include "clang/Basic/SourceManager.h"
+#include "clang/Frontend/CodeGenOptions.h"
+#include "llvm/ADT/OwningPtr.h"
+#include "llvm/ADT/STLExtras.h"
+#include "llvm/ADT/StringExtras.h"
+#include "llvm/IR/Constants.h"
+#include "llvm/IR/DerivedTypes.h"
+#include "llvm/IR/Function.h"
+#include "llvm/IR/GlobalVariable.h"
+#include "llvm/IR/MDBuilder.h"
+#include "llvm/Support/MD5.h"
+#include "llvm/Support/MemoryBuffer.h"
+#include "llvm/Support/system_error.h"
+#include <algorithm>
+using namespace clang;
+using namespace CodeGen;
+
+/// \brief Split the first line off \p Buffer into \p Line. Returns false if
+/// there is nothing left to read.
+static bool readLine(StringRef &Buffer, StringRef &Line, unsigned &LineNo) {
+  if (Buffer.empty())
+    return false;
+  llvm::tie(Line, Buffer) = Buffer.split('\n');
+  Line = Line.rtrim("\r");
+  ++LineNo;
+  return true;
+}
+
+static void setMalformed(std::string &ErrorStr, unsigned LineNo) {
+  ErrorStr = "malformed data at line " + llvm::utostr(LineNo);
+}
+
+PGOProfileData *PGOProfileData::create(StringRef Path,
+                                       std::string &ErrorStr) {
+  OwningPtr<llvm::MemoryBuffer> File;
+  if (llvm::error_code EC = llvm::MemoryBuffer::getFile(Path, File)) {
+    ErrorStr = EC.message();
+    return 0;
+  }
+
+  OwningPtr<PGOProfileData> Data(new PGOProfileData());
+  StringRef Buffer = File->getBuffer();
+  StringRef FuncName;
+  unsigned LineNo = 0;
+  while (readLine(Buffer, FuncName, LineNo)) {
+    // Records are separated by blank lines.
+    if (FuncName.empty())
+      continue;
+
+    StringRef Line;
+    FunctionRecord Record;
+    uint64_t NumCounters;
+    if (!readLine(Buffer, Line, LineNo) || Line.getAsInteger(10, Record.Hash) ||
+        !readLine(Buffer, Line, LineNo) || Line.getAsInteger(10, NumCounters) ||
+        NumCounters == 0) {
+      setMalformed(ErrorStr, LineNo);
+      return 0;
+    }
+
+    Record.Counts.reserve(NumCounters);
+    for (uint64_t I = 0; I != NumCounters; ++I) {
+      uint64_t Count;
+      if (!readLine(Buffer, Line, LineNo) || Line.getAsInteger(10, Count)) {
+        setMalformed(ErrorStr, LineNo);
+        return 0;
+      }
+      Record.Counts.push_back(Count);
+    }
+
+    // The runtime and merge-instr-profiles.py write each version of a
+    // function once, so a second record for it is an error.
+    std::vector<FunctionRecord> &Records = Data->Functions[FuncName];
+    for (unsigned I = 0, E = Records.size(); I != E; ++I) {
+      if (Records[I].Hash == Record.Hash) {
+        ErrorStr = "duplicate function '" + FuncName.str() + "'";
+        return 0;
+      }
+    }
+    if (Record.Counts[0] > Data->MaxFunctionCount)
+      Data->MaxFunctionCount = Record.Counts[0];
+    Records.push_back(Record);
+  }
+
+  return Data.take();
+}
+
+const std::vector<PGOProfileData::FunctionRecord> *
+PGOProfileData::getFunctionRecords(StringRef FuncName) const {
+  llvm::StringMap<std::vector<FunctionRecord> >::const_iterator I =
+    Functions.find(FuncName);
+  if (I == Functions.end())
+    return 0;
+  return &I->getValue();
+}
+
+namespace {
+  /// \brief A RecursiveASTVisitor that assigns region counters to the
+  /// statements of a function body, in the order they are visited.
+  struct MapRegionCounters : public RecursiveASTVisitor<MapRegionCounters> {
+    /// \brief The kinds of statements that own region counters, as they are
+    /// recorded in the structural hash. These values are part of the profile
+    /// format and must not change.
+    enum HashKind {
+      HashIf = 1,
+      HashWhile,
+      HashDo,
+      HashFor,
+      HashForRange,
+      HashConditional,
+      HashBinaryConditional,
+      HashLogicalAnd,
+      HashLogicalOr,
+      HashSwitch,
+      HashCase
+    };
+
+    unsigned NextCounter;
+    llvm::DenseMap<const Stmt *, unsigned> &CounterMap;
+    llvm::MD5 Hash;
+
+    MapRegionCounters(llvm::DenseMap<const Stmt *, unsigned> &CounterMap)
+      : NextCounter(1), CounterMap(CounterMap) {}
+
+    // Nested functions, blocks and classes are emitted as functions of their
+    // own, and get their own counters.
+    bool TraverseDecl(Decl *D) {
+      if (D && (isa<FunctionDecl>(D) || isa<BlockDecl>(D) ||
+                isa<CapturedDecl>(D) || isa<ObjCMethodDecl>(D) ||
+                isa<RecordDecl>(D)))
+        return true;
+      return RecursiveASTVisitor<MapRegionCounters>::TraverseDecl(D);
+    }
+    bool TraverseLambdaBody(LambdaExpr *LE) { return true; }
+
+    void assignCounters(const Stmt *S, unsigned NumCounters, HashKind Kind) {
+      CounterMap[S] = NextCounter;
+      NextCounter += NumCounters;
+      uint8_t Byte = Kind;
+      Hash.update(Byte);
+    }
+
+    bool VisitStmt(const Stmt *S) {
+      switch (S->getStmtClass()) {
+      default:
+        break;
+      case Stmt::IfStmtClass:
+        assignCounters(S, 2, HashIf);
+        break;
+      case Stmt::WhileStmtClass:
+        assignCounters(S, 2, HashWhile);
+        break;
+      case Stmt::DoStmtClass:
+        assignCounters(S, 2, HashDo);
+        break;
+      case Stmt::ForStmtClass:
+        assignCounters(S, 2, HashFor);
+        break;
+      case Stmt::CXXForRangeStmtClass:
+        assignCounters(S, 2, HashForRange);
+        break;
+      case Stmt::ConditionalOperatorClass:
+        assignCounters(S, 2, HashConditional);
+        break;
+      case Stmt::BinaryConditionalOperatorClass:
+        assignCounters(S, 2, HashBinaryConditional);
+        break;
+      case Stmt::BinaryOperatorClass: {
+        const BinaryOperator *BO = cast<BinaryOperator>(S);
+        if (BO->getOpcode() == BO_LAnd)
+          assignCounters(S, 2, HashLogicalAnd);
+        else if (BO->getOpcode() == BO_LOr)
+          assignCounters(S, 2, HashLogicalOr);
+        break;
+      }
+      case Stmt::SwitchStmtClass:
+        assignCounters(S, 1, HashSwitch);
+        break;
+      case Stmt::CaseStmtClass:
+        assignCounters(S, 1, HashCase);
+        break;
+      }
+      return true;
+    }
+
+    /// \brief Return the structural hash of the statements visited so far:
+    /// the first eight bytes of the MD5 of their kinds, read as a
+    /// little-endian number.
+    uint64_t getHash() {
+      llvm::MD5::MD5Result Result;
+      Hash.final(Result);
+      uint64_t Value = 0;
+      for (unsigned I = 0; I != 8; ++I)
+        Value |= uint64_t(Result[I]) << (8 * I);
+      return Value;
+    }
+  };
+}
+
+void CodeGenPGO::setFuncName(llvm::Function *Fn) {
+  FuncName = Fn->getName();
+
+  // Functions with local linkage may share their names with functions in
+  // other translation units, so qualify them with the path of the main file
+  // as it was given to the compiler. -main-file-name only names the file, and
+  // sources of the same name in other directories would collide.
+  if (Fn->hasLocalLinkage()) {
+    const SourceManager &SM = CGM.getContext().getSourceManager();
+    const FileEntry *MainFile = SM.getFileEntryForID(SM.getMainFileID());
+    StringRef MainPath = MainFile ? MainFile->getName() : "<unknown>";
+    FuncName = MainPath.str() + ":" + FuncName;
+  }
+}
+
+void CodeGenPGO::mapRegionCounters(const Decl *D) {
+  MapRegionCounters Walker(RegionCounterMap);
+  if (const CXXConstructorDecl *CD = dyn_cast<CXXConstructorDecl>(D))
+    for (CXXConstructorDecl::init_const_iterator I = CD->init_begin(),
+                                                 E = CD->init_end();
+         I != E; ++I)
+      Walker.TraverseStmt((*I)->getInit());
+  Walker.TraverseStmt(D->getBody());
+  NumRegionCounters = Walker.NextCounter;
+  FunctionHash = Walker.getHash();
+}
+
+void CodeGenPGO::emitRegionCounters() {
+  // The counters of a function that may be emitted in several translation
+  // units are merged along with the function, so that each copy counts into
+  // the same place.
+  llvm::GlobalValue::LinkageTypes Linkage = Fn->getLinkage();
+  if (Linkage == llvm::GlobalValue::ExternalLinkage ||
+      Fn->hasLocalLinkage())
+    Linkage = llvm::GlobalValue::InternalLinkage;
+
+  llvm::ArrayType *CounterTy =
+    llvm::ArrayType::get(CGM.Int64Ty, NumRegionCounters);
+  RegionCounters =
+    new llvm::GlobalVariable(CGM.getModule(), CounterTy, false, Linkage,
+                             llvm::Constant::getNullValue(CounterTy),
+                             "__llvm_profile_counters_" + Fn->getName());
+  CGM.addInstrumentedFunction(FuncName, FunctionHash, RegionCounters);
+}
+
+void CodeGenPGO::loadRegionCounts(const Decl *D, PGOProfileData *PGOData) {
+  const std::vector<PGOProfileData::FunctionRecord> *Records =
+    PGOData->getFunctionRecords(FuncName);
+  if (!Records)
+    return;
+
+  // If the function changed since the profile was collected, its counters no
+  // longer line up with the profile, so ignore them.
+  const std::vector<uint64_t> *Counts = 0;
+  for (unsigned I = 0, E = Records->size(); I != E; ++I) {
+    const PGOProfileData::FunctionRecord &Record = (*Records)[I];
+    if (Record.Hash == FunctionHash &&
+        Record.Counts.size() == NumRegionCounters) {
+      Counts = &Record.Counts;
+      break;
+    }
+  }
+  CGM.notePGOFunction(!Counts);
+  if (!Counts)
+    return;
+  RegionCounts = Counts;
+
+  // Without entry-count metadata, tell the inliner and the code generator
+  // about hot and cold functions through attributes.
+  uint64_t EntryCount = (*Counts)[0];
+  uint64_t MaxCount = PGOData->getMaximumFunctionCount();
+  if (!MaxCount)
+    return;
+  if (EntryCount * 10 >= MaxCount * 3) {
+    if (!D->hasAttr<NoInlineAttr>() && !D->hasAttr<NakedAttr>())
+      Fn->addFnAttr(llvm::Attribute::InlineHint);
+  } else if (EntryCount * 100 <= MaxCount) {
+    Fn->addFnAttr(llvm::Attribute::Cold);
+  }
+}
+
+void CodeGenPGO::assignRegionCounters(const Decl *D, llvm::Function *Fn) {
+  bool InstrumentRegions = CGM.getCodeGenOpts().ProfileInstrGenerate &&
+                           !Fn->hasAvailableExternallyLinkage();
+  PGOProfileData *PGOData = CGM.getPGOData();
+  if (!InstrumentRegions && !PGOData)
+    return;
+  if (!D)
+    return;
+
+  this->Fn = Fn;
+  setFuncName(Fn);
+  mapRegionCounters(D);
+  if (InstrumentRegions)
+    emitRegionCounters();
+  if (PGOData)
+    loadRegionCounts(D, PGOData);
+}
+
+void CodeGenPGO::emitCounterIncrement(CGBuilderTy &Builder, unsigned Counter) {
+  llvm::Value *Addr =
+    Builder.CreateConstInBoundsGEP2_64(RegionCounters, 0, Counter);
+  llvm::Value *Count = Builder.CreateLoad(Addr, "pgocount");
+  Count = Builder.CreateAdd(Count, Builder.getInt64(1));
+  Builder.CreateStore(Count, Addr);
+}
+
+void CodeGenPGO::emitEntryCounterIncrement(CGBuilderTy &Builder) {
+  if (RegionCounters)
+    emitCounterIncrement(Builder, 0);
+}
+
+llvm::BasicBlock *CodeGenPGO::getCountingBlock(const Stmt *S, unsigned Edge,
+                                               llvm::BasicBlock *Dest) {
+  if (!RegionCounters)
+    return Dest;
+  llvm::DenseMap<const Stmt *, unsigned>::const_iterator I =
+    RegionCounterMap.find(S);
+  if (I == RegionCounterMap.end())
+    return Dest;
+
+  llvm::BasicBlock *BB =
+    llvm::BasicBlock::Create(CGM.getLLVMContext(), "pgo.count", Fn);
+  CGBuilderTy Builder(BB);
+  emitCounterIncrement(Builder, I->second + Edge);
+  Builder.CreateBr(Dest);
+  return BB;
+}
+
+uint64_t CodeGenPGO::getRegionCount(const Stmt *S, unsigned Edge) const {
+  if (!RegionCounts)
+    return 0;
+  llvm::DenseMap<const Stmt *, unsigned>::const_iterator I =
+    RegionCounterMap.find(S);
+  if (I == RegionCounterMap.end())
+    return 0;
+  return (*RegionCounts)[I->second + Edge];
+}
+
+llvm::MDNode *CodeGenPGO::getBranchWeights(const Stmt *S) const {
+  return createBranchWeights(getRegionCount(S, 0), getRegionCount(S, 1));
+}
+
+llvm::MDNode *CodeGenPGO::createBranchWeights(uint64_t TrueCount,
+                                              uint64_t FalseCount) const {
+  uint64_t Weights[] = { TrueCount, FalseCount };
+  return createBranchWeights(Weights);
+}
+
+llvm::MDNode *
+CodeGenPGO::createBranchWeights(ArrayRef<uint64_t> Weights) const {
+  uint64_t MaxWeight = 0;
+  for (unsigned I = 0, E = Weights.size(); I != E; ++I)
+    MaxWeight = std::max(MaxWeight, Weights[I]);
+  if (!MaxWeight)
+    return 0;
+
+  // Branch weights are 32 bits wide, so scale the counts down to fit. Adding
+  // one keeps edges that were never taken from looking impossible.
+  uint64_t Scale = MaxWeight / UINT32_MAX + 1;
+  SmallVector<uint32_t, 16> ScaledWeights;
+  ScaledWeights.reserve(Weights.size());
+  for (unsigned I = 0, E = Weights.size(); I != E; ++I)
+    ScaledWeights.push_back(Weights[I] / Scale + 1);
+
+  llvm::MDBuilder MDHelper(CGM.getLLVMContext());
+  return MDHelper.createBranchWeights(ScaledWeights);
+}
+
+void CodeGenModule::EmitInstrProfRegistration() {
+  if (InstrumentedFunctions.empty())
+    return;
+
+  // void __llvm_profile_register_function(const char *Name, uint64_t Hash,
+  //                                       uint32_t NumCounters,
+  //                                       uint64_t *Counters);
+  llvm::Type *ArgTys[] = { Int8PtrTy, Int64Ty, Int32Ty,
+                           Int64Ty->getPointerTo() };
+  llvm::Constant *RegisterFn =
+    CreateRuntimeFunction(llvm::FunctionType::get(VoidTy, ArgTys, false),
+                          "__llvm_profile_register_function");
+
+  llvm::Function *RegisterFns =
+    llvm::Function::Create(llvm::FunctionType::get(VoidTy, false),
+                           llvm::GlobalValue::InternalLinkage,
+                           "__llvm_profile_register_functions",
+                           &getModule());
+  RegisterFns->setUnnamedAddr(true);
+  if (CodeGenOpts.DisableRedZone)
+    RegisterFns->addFnAttr(llvm::Attribute::NoRedZone);
+
+  CGBuilderTy Builder(llvm::BasicBlock::Create(VMContext, "", RegisterFns));
+  for (unsigned I = 0, E = InstrumentedFunctions.size(); I != E; ++I) {
+    const InstrumentedFunction &F = InstrumentedFunctions[I];
+    llvm::ArrayType *CounterTy =
+      cast<llvm::ArrayType>(F.Counters->getType()->getElementType());
+    llvm::Value *Args[] = {
+      llvm::ConstantExpr::getBitCast(GetAddrOfConstantCString(F.Name),
+                                     Int8PtrTy),
+      Builder.getInt64(F.Hash),
+      Builder.getInt32(CounterTy->getNumElements()),
+      Builder.CreateConstInBoundsGEP2_32(F.Counters, 0, 0)
+    };
+    Builder.CreateCall(RegisterFn, Args);
+  }
+  Builder.CreateRetVoid();
+
+  AddGlobalCtor(RegisterFns);
+}
@@ -0,0 +1,172 @@
+//===--- CodeGenPGO.h - PGO Instrumentation for LLVM CodeGen ----*- C++ -*-===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Instrumentation-based profile-guided optimization
+//
+//===----------------------------------------------------------------------===//
+
+#ifndef CLANG_CODEGEN_CODEGENPGO_H
+#define CLANG_CODEGEN_CODEGENPGO_H
+
+#include "CGBuilder.h"
+#include "clang/Basic/LLVM.h"
+#include "llvm/ADT/ArrayRef.h"
+#include "llvm/ADT/DenseMap.h"
+#include "llvm/ADT/StringMap.h"
+#include <string>
+#include <vector>
+
+namespace llvm {
+  class BasicBlock;
+  class Function;
+  class GlobalVariable;
+  class MDNode;
+}
+
+namespace clang {
+  class Decl;
+  class Stmt;
+
+namespace CodeGen {
+  class CodeGenModule;
+
+/// \brief The execution counts read from a profile that was written by a
+/// program built with -fprofile-instr-generate.
+///
+/// The profile is a text file with one record per function: the name of the
+/// function, the structural hash of its counters, the number of counters, and
+/// then one count per line, followed by a blank line. The first counter of
+/// each function is its entry count.
+class PGOProfileData {
+public:
+  /// \brief The counts recorded for one version of a function.
+  struct FunctionRecord {
+    uint64_t Hash;
+    std::vector<uint64_t> Counts;
+  };
+
+private:
+  /// \brief The records of each function in the profile, keyed by name. A
+  /// function has several records if the profile was merged from runs of
+  /// programs built from different versions of it.
+  llvm::StringMap<std::vector<FunctionRecord> > Functions;
+
+  /// \brief The largest entry count of any function in the profile.
+  uint64_t MaxFunctionCount;
+
+  PGOProfileData() : MaxFunctionCount(0) {}
+
+public:
+  /// \brief Read the profile in \p Path. Returns null and sets \p ErrorStr if
+  /// the file cannot be read or is malformed.
+  static PGOProfileData *create(StringRef Path, std::string &ErrorStr);
+
+  /// \brief Return the records of \p FuncName, or null if the function is not
+  /// in the profile.
+  const std::vector<FunctionRecord> *
+  getFunctionRecords(StringRef FuncName) const;
+
+  /// \brief Return the largest entry count of any function in the profile.
+  uint64_t getMaximumFunctionCount() const { return MaxFunctionCount; }
+};
+
+/// \brief Per-function state for instrumentation-based profiling.
+///
+/// Every statement or expression that splits control flow owns a group of
+/// region counters, one for each edge out of its branch:
+///
+///  - if, while, do, for, range-based for and ?: have a counter for the edge
+///    taken when the condition is true, followed by one for the false edge.
+///  - && and || have a counter for the edge that goes on to evaluate the RHS,
+///    followed by one for the edge that short-circuits it.
+///  - switch has a counter for its default edge, and each case has a counter
+///    for the edge from the switch to its label.
+///
+/// Counter 0 of each function counts its entries. With -fprofile-instr-generate
+/// the edges are instrumented to increment the counters; with
+/// -fprofile-instr-use the counts from the profile become branch weights.
+class CodeGenPGO {
+  CodeGenModule &CGM;
+
+  /// \brief The name the function's counters are recorded under.
+  std::string FuncName;
+
+  /// \brief A hash of the kinds of statements that own the function's region
+  /// counters, in the order the counters are assigned. A profile record only
+  /// applies to the function if it has the same hash.
+  uint64_t FunctionHash;
+
+  /// \brief The function being emitted.
+  llvm::Function *Fn;
+
+  /// \brief The number of region counters of the function, including the
+  /// entry counter.
+  unsigned NumRegionCounters;
+
+  /// \brief The index of the first region counter of each statement.
+  llvm::DenseMap<const Stmt *, unsigned> RegionCounterMap;
+
+  /// \brief The counters incremented by the instrumented function, if the
+  /// function is being instrumented.
+  llvm::GlobalVariable *RegionCounters;
+
+  /// \brief The counts read from the profile, if the function is in it and
+  /// its counts match the function.
+  const std::vector<uint64_t> *RegionCounts;
+
+  void setFuncName(llvm::Function *Fn);
+  void mapRegionCounters(const Decl *D);
+  void emitRegionCounters();
+  void loadRegionCounts(const Decl *D, PGOProfileData *PGOData);
+  void emitCounterIncrement(CGBuilderTy &Builder, unsigned Counter);
+
+public:
+  explicit CodeGenPGO(CodeGenModule &CGM)
+    : CGM(CGM), FunctionHash(0), Fn(0), NumRegionCounters(0),
+      RegionCounters(0), RegionCounts(0) {}
+
+  /// \brief Assign region counters to the body of \p D, which is about to be
+  /// emitted into \p Fn, and set up instrumentation or read its counts from
+  /// the profile, as requested by the code generation options.
+  void assignRegionCounters(const Decl *D, llvm::Function *Fn);
+
+  /// \brief Emit code to count an entry into the function at the insertion
+  /// point of \p Builder.
+  void emitEntryCounterIncrement(CGBuilderTy &Builder);
+
+  /// \brief Return a block to branch to instead of \p Dest along edge
+  /// \p Edge of statement \p S. When instrumenting, this is a new block that
+  /// increments the edge's counter and branches to \p Dest; otherwise it is
+  /// \p Dest itself.
+  llvm::BasicBlock *getCountingBlock(const Stmt *S, unsigned Edge,
+                                     llvm::BasicBlock *Dest);
+
+  /// \brief Return whether counts from the profile are available for the
+  /// function.
+  bool haveRegionCounts() const { return RegionCounts != 0; }
+
+  /// \brief Return the profiled count of edge \p Edge of statement \p S, or 0
+  /// if no count is available.
+  uint64_t getRegionCount(const Stmt *S, unsigned Edge) const;
+
+  /// \brief Return branch weights for the two-way branch of statement \p S,
+  /// or null if there is no profile data for it.
+  llvm::MDNode *getBranchWeights(const Stmt *S) const;
+
+  /// \brief Return branch weights for a branch with the given counts, or null
+  /// if they are all zero.
+  llvm::MDNode *createBranchWeights(uint64_t TrueCount,
+                                    uint64_t FalseCount) const;
+  llvm::MDNode *createBranchWeights(ArrayRef<uint64_t> Weights) const;
+};
+
+}  // end namespace CodeGen
+}  // end namespace clang
+
+#endif
@@ -18,8 +18,10 @@
 #include "CodeGenFunction.h"
 #include "clang/AST/RecordLayout.h"
 #include "clang/Frontend/CodeGenOptions.h"
+#include "llvm/ADT/StringSwitch.h"
 #include "llvm/ADT/Triple.h"
 #include "llvm/IR/DataLayout.h"
+#include "llvm/IR/InlineAsm.h"
 #include "llvm/IR/Type.h"
 #include "llvm/Support/raw_ostream.h"
 using namespace clang;
@@ -516,6 +518,177 @@ static llvm::Type* X86AdjustInlineAsmType(CodeGen::CodeGenFunction &CGF,
   return Ty;
 }
 
+namespace {
+/// The CPUID results that report the presence of a feature.
+enum X86CPUIDWord {
+  CPUID1_ECX,
+  CPUID1_EDX,
+  CPUID7_EBX,
+  CPUIDExt1_ECX,
+  CPUIDExt1_EDX,
+  NumCPUIDWords
+};
+
+struct X86FeatureBit {
+  const char *Name;
+  X86CPUIDWord Word;
+  unsigned Bit;
+};
+}
+
+/// Where CPUID reports each of the features X86TargetInfo knows about; see
+/// lib/Headers/cpuid.h.
+static const X86FeatureBit X86FeatureBits[] = {
+  { "mmx",    CPUID1_EDX, 23 },
+  { "sse",    CPUID1_EDX, 25 },
+  { "sse2",   CPUID1_EDX, 26 },
+  { "sse3",   CPUID1_ECX, 0 },
+  { "pclmul", CPUID1_ECX, 1 },
+  { "ssse3",  CPUID1_ECX, 9 },
+  { "fma",    CPUID1_ECX, 12 },
+  { "sse41",  CPUID1_ECX, 19 },
+  { "sse42",  CPUID1_ECX, 20 },
+  { "popcnt", CPUID1_ECX, 23 },
+  { "aes",    CPUID1_ECX, 25 },
+  { "avx",    CPUID1_ECX, 28 },
+  { "f16c",   CPUID1_ECX, 29 },
+  { "rdrand", CPUID1_ECX, 30 },
+  { "bmi",    CPUID7_EBX, 3 },
+  { "avx2",   CPUID7_EBX, 5 },
+  { "bmi2",   CPUID7_EBX, 8 },
+  { "rtm",    CPUID7_EBX, 11 },
+  { "rdseed", CPUID7_EBX, 18 },
+  { "lzcnt",  CPUIDExt1_ECX, 5 },
+  { "sse4a",  CPUIDExt1_ECX, 6 },
+  { "prfchw", CPUIDExt1_ECX, 8 },
+  { "xop",    CPUIDExt1_ECX, 11 },
+  { "fma4",   CPUIDExt1_ECX, 16 },
+  { "3dnowa", CPUIDExt1_EDX, 30 },
+  { "3dnow",  CPUIDExt1_EDX, 31 }
+};
+
+/// Emit a CPUID instruction for \p Leaf, returning EAX, EBX, ECX and EDX.
+static llvm::Value *EmitX86CPUID(CodeGen::CodeGenFunction &CGF,
+                                 uint32_t Leaf, bool Is64Bit) {
+  llvm::Type *Int32Ty = CGF.Int32Ty;
+  llvm::Type *Results[] = { Int32Ty, Int32Ty, Int32Ty, Int32Ty };
+  llvm::Type *Args[] = { Int32Ty, Int32Ty };
+  llvm::FunctionType *FTy =
+    llvm::FunctionType::get(llvm::StructType::get(CGF.getLLVMContext(),
+                                                  Results),
+                            Args, false);
+  // EBX may hold the GOT pointer on i386; borrow ESI for the result, as
+  // cpuid.h does.
+  llvm::InlineAsm *CPUID =
+    Is64Bit ? llvm::InlineAsm::get(FTy, "cpuid",
+                                   "={ax},={bx},={cx},={dx},0,2", false)
+            : llvm::InlineAsm::get(FTy, "xchgl %ebx, %esi\n\t"
+                                        "cpuid\n\t"
+                                        "xchgl %ebx, %esi",
+                                   "={ax},={si},={cx},={dx},0,2", false);
+  llvm::Value *Ops[] = { llvm::ConstantInt::get(Int32Ty, Leaf),
+                         llvm::ConstantInt::get(Int32Ty, 0) };
+  return CGF.Builder.CreateCall(CPUID, Ops);
+}
+
+/// Emit a check that the processor supports \p Features, using CPUID and,
+/// for the features that use the AVX registers, XGETBV to see that the
+/// operating system saves them.
+static llvm::Value *EmitX86CPUSupports(CodeGen::CodeGenFunction &CGF,
+                                       ArrayRef<StringRef> Features,
+                                       bool Is64Bit) {
+  uint32_t Masks[NumCPUIDWords] = { 0 };
+  bool NeedsAVXState = false;
+  for (unsigned I = 0, E = Features.size(); I != E; ++I) {
+    const X86FeatureBit *Bit = 0;
+    for (unsigned J = 0; J != llvm::array_lengthof(X86FeatureBits); ++J)
+      if (Features[I] == X86FeatureBits[J].Name)
+        Bit = &X86FeatureBits[J];
+    if (!Bit)
+      return 0;
+    Masks[Bit->Word] |= 1u << Bit->Bit;
+    NeedsAVXState |= llvm::StringSwitch<bool>(Features[I])
+      .Cases("avx", "avx2", "fma", "fma4", "xop", true)
+      .Case("f16c", true)
+      .Default(false);
+  }
+  if (NeedsAVXState)
+    Masks[CPUID1_ECX] |= 1u << 27; // OSXSAVE
+
+  CGBuilderTy &Builder = CGF.Builder;
+  llvm::Value *Words[NumCPUIDWords] = { 0 };
+  if (Masks[CPUID1_ECX] || Masks[CPUID1_EDX]) {
+    llvm::Value *Regs = EmitX86CPUID(CGF, 1, Is64Bit);
+    Words[CPUID1_ECX] = Builder.CreateExtractValue(Regs, 2);
+    Words[CPUID1_EDX] = Builder.CreateExtractValue(Regs, 3);
+  }
+  // Leaves beyond the highest one the processor reports return garbage
+  // rather than trapping, so check the highest leaf afterwards.
+  if (Masks[CPUID7_EBX]) {
+    llvm::Value *Max =
+      Builder.CreateExtractValue(EmitX86CPUID(CGF, 0, Is64Bit), 0);
+    llvm::Value *EBX =
+      Builder.CreateExtractValue(EmitX86CPUID(CGF, 7, Is64Bit), 1);
+    Words[CPUID7_EBX] =
+      Builder.CreateSelect(Builder.CreateICmpUGE(Max, Builder.getInt32(7)),
+                           EBX, Builder.getInt32(0));
+  }
+  if (Masks[CPUIDExt1_ECX] || Masks[CPUIDExt1_EDX]) {
+    llvm::Value *Max =
+      Builder.CreateExtractValue(EmitX86CPUID(CGF, 0x80000000, Is64Bit), 0);
+    llvm::Value *Regs = EmitX86CPUID(CGF, 0x80000001, Is64Bit);
+    llvm::Value *HasLeaf =
+      Builder.CreateICmpUGE(Max, Builder.getInt32(0x80000001));
+    Words[CPUIDExt1_ECX] =
+      Builder.CreateSelect(HasLeaf, Builder.CreateExtractValue(Regs, 2),
+                           Builder.getInt32(0));
+    Words[CPUIDExt1_EDX] =
+      Builder.CreateSelect(HasLeaf, Builder.CreateExtractValue(Regs, 3),
+                           Builder.getInt32(0));
+  }
+
+  llvm::Value *Supported = Builder.getTrue();
+  for (unsigned I = 0; I != NumCPUIDWords; ++I) {
+    if (!Masks[I])
+      continue;
+    llvm::Value *Mask = Builder.getInt32(Masks[I]);
+    Supported = Builder.CreateAnd(
+        Supported, Builder.CreateICmpEQ(Builder.CreateAnd(Words[I], Mask),
+                                        Mask));
+  }
+  if (!NeedsAVXState)
+    return Supported;
+
+  // XGETBV traps unless OSXSAVE is set; then XCR0 tells whether the
+  // operating system saves the XMM and YMM registers.
+  llvm::BasicBlock *CPUIDBlock = Builder.GetInsertBlock();
+  llvm::BasicBlock *XGetBVBlock = CGF.createBasicBlock("xgetbv");
+  llvm::BasicBlock *DoneBlock = CGF.createBasicBlock("cpu_supports.end");
+  Builder.CreateCondBr(Supported, XGetBVBlock, DoneBlock);
+
+  CGF.EmitBlock(XGetBVBlock);
+  llvm::Type *Int32Ty = CGF.Int32Ty;
+  llvm::Type *Results[] = { Int32Ty, Int32Ty };
+  llvm::FunctionType *FTy =
+    llvm::FunctionType::get(llvm::StructType::get(CGF.getLLVMContext(),
+                                                  Results),
+                            Int32Ty, false);
+  llvm::InlineAsm *XGetBV =
+    llvm::InlineAsm::get(FTy, "xgetbv", "={ax},={dx},{cx}", false);
+  llvm::Value *XCR0 = Builder.CreateExtractValue(
+      Builder.CreateCall(XGetBV, Builder.getInt32(0)), 0);
+  llvm::Value *SavesAVX =
+    Builder.CreateICmpEQ(Builder.CreateAnd(XCR0, Builder.getInt32(6)),
+                         Builder.getInt32(6));
+  XGetBVBlock = Builder.GetInsertBlock();
+
+  CGF.EmitBlock(DoneBlock);
+  llvm::PHINode *Result = Builder.CreatePHI(Builder.getInt1Ty(), 2);
+  Result->addIncoming(Builder.getFalse(), CPUIDBlock);
+  Result->addIncoming(SavesAVX, XGetBVBlock);
+  return Result;
+}
+
 //===----------------------------------------------------------------------===//
 // X86-32 ABI Implementation
 //===----------------------------------------------------------------------===//
@@ -596,6 +769,11 @@ public:
     return X86AdjustInlineAsmType(CGF, Constraint, Ty);
   }
 
+  llvm::Value *emitCPUSupports(CodeGen::CodeGenFunction &CGF,
+                               ArrayRef<StringRef> Features) const {
+    return EmitX86CPUSupports(CGF, Features, /*Is64Bit=*/false);
+  }
+
 };
 
 }
@@ -1254,6 +1432,11 @@ public:
     return X86AdjustInlineAsmType(CGF, Constraint, Ty);
   }
 
+  llvm::Value *emitCPUSupports(CodeGen::CodeGenFunction &CGF,
+                               ArrayRef<StringRef> Features) const {
+    return EmitX86CPUSupports(CGF, Features, /*Is64Bit=*/true);
+  }
+
   bool isNoProtoCallVariadic(const CallArgList &args,
                              const FunctionNoProtoType *fnType) const {
     // The default CC on x86-64 sets %al to the number of SSA
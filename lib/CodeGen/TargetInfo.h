@@ -122,6 +122,17 @@ namespace clang {
       return Ty;
     }
 
+    /// Emit code that checks whether the processor the program runs on
+    /// supports all of the given target features, named as in the
+    /// -target-feature option.
+    ///
+    /// \returns an i1 that is true if it does, or 0 if the target cannot
+    /// check for one of the features at run time.
+    virtual llvm::Value *emitCPUSupports(CodeGen::CodeGenFunction &CGF,
+                                         ArrayRef<StringRef> Features) const {
+      return 0;
+    }
+
     /// Retrieve the address of a function to call immediately before
     /// calling objc_retainAutoreleasedReturnValue.  The
     /// implementation of objc_autoreleaseReturnValue sniffs the
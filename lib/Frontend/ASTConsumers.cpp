@@ -18,10 +18,12 @@
 #include "clang/AST/PrettyPrinter.h"
 #include "clang/AST/RecordLayout.h"
 #include "clang/AST/RecursiveASTVisitor.h"
+#include "clang/AST/StructuralHash.h"
 #include "clang/Basic/Diagnostic.h"
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/SourceManager.h"
 #include "llvm/IR/Module.h"
+#include "llvm/Support/Format.h"
 #include "llvm/Support/Path.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
@@ -500,3 +502,73 @@ public:
 ASTConsumer *clang::CreateASTDumperXML(raw_ostream &OS) {
   return new ASTDumpXML(OS);
 }
+
+//===----------------------------------------------------------------------===//
+/// ASTHashTimer - Timing of structural hashes against statement profiles
+
+namespace {
+class ASTHashTimer : public ASTConsumer,
+                     public RecursiveASTVisitor<ASTHashTimer> {
+  std::vector<const Stmt *> Bodies;
+
+public:
+  bool shouldVisitTemplateInstantiations() const { return true; }
+  bool shouldWalkTypesOfTypeLocs() const { return false; }
+
+  bool VisitFunctionDecl(FunctionDecl *D) {
+    if (D->doesThisDeclarationHaveABody())
+      if (const Stmt *Body = D->getBody())
+        Bodies.push_back(Body);
+    return true;
+  }
+
+  void HandleTranslationUnit(ASTContext &C);
+};
+}
+
+/// Hash every function body in the translation unit with StructuralHasher,
+/// then profile each into a FoldingSetNodeID and hash that, as a FoldingSet
+/// would. Reports the time each took and how many distinct bodies each found.
+void ASTHashTimer::HandleTranslationUnit(ASTContext &C) {
+  TraverseDecl(C.getTranslationUnitDecl());
+  unsigned N = Bodies.size();
+
+  std::vector<StructuralHash> Hashes(N);
+  llvm::TimeRecord Start = llvm::TimeRecord::getCurrentTime(true);
+  {
+    StructuralHasher Hasher(C);
+    for (unsigned I = 0; I != N; ++I)
+      Hashes[I] = Hasher.hash(Bodies[I]);
+  }
+  llvm::TimeRecord HashTime = llvm::TimeRecord::getCurrentTime(false);
+  HashTime -= Start;
+
+  std::vector<unsigned> Profiles(N);
+  Start = llvm::TimeRecord::getCurrentTime(true);
+  for (unsigned I = 0; I != N; ++I) {
+    llvm::FoldingSetNodeID ID;
+    Bodies[I]->Profile(ID, C, /*Canonical=*/true);
+    Profiles[I] = ID.ComputeHash();
+  }
+  llvm::TimeRecord ProfileTime = llvm::TimeRecord::getCurrentTime(false);
+  ProfileTime -= Start;
+
+  std::sort(Hashes.begin(), Hashes.end());
+  std::sort(Profiles.begin(), Profiles.end());
+  unsigned DistinctHashes =
+    std::unique(Hashes.begin(), Hashes.end()) - Hashes.begin();
+  unsigned DistinctProfiles =
+    std::unique(Profiles.begin(), Profiles.end()) - Profiles.begin();
+
+  raw_ostream &OS = llvm::errs();
+  OS << "*** Function body hashing:\n";
+  OS << "  " << N << " function bodies\n";
+  OS << "  " << llvm::format("%.4f", HashTime.getWallTime())
+     << "s with StructuralHasher, " << DistinctHashes << " distinct\n";
+  OS << "  " << llvm::format("%.4f", ProfileTime.getWallTime())
+     << "s with Stmt::Profile, " << DistinctProfiles << " distinct\n";
+}
+
+ASTConsumer *clang::CreateASTHashTimer() {
+  return new ASTHashTimer();
+}
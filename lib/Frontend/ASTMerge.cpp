@@ -11,8 +11,10 @@
 #include "clang/AST/ASTDiagnostic.h"
 #include "clang/AST/ASTImporter.h"
 #include "clang/Basic/Diagnostic.h"
+#include "clang/Basic/ThreadGroup.h"
 #include "clang/Frontend/CompilerInstance.h"
 #include "clang/Frontend/FrontendActions.h"
+#include "llvm/Support/Mutex.h"
 
 using namespace clang;
 
@@ -31,6 +33,111 @@ bool ASTMergeAction::BeginSourceFileAction(CompilerInstance &CI,
   return AdaptedAction->BeginSourceFileAction(CI, Filename);
 }
 
+namespace {
+  /// \brief An AST file to be merged, which may be loaded ahead of time on a
+  /// thread of its own.
+  struct PendingASTFile {
+    std::string Filename;
+    IntrusiveRefCntPtr<DiagnosticsEngine> Diags;
+    ASTUnit *Unit;
+
+    /// \brief Diagnostics produced while loading the AST file ahead of time,
+    /// to be reported in order once the file is merged.
+    SmallVector<StoredDiagnostic, 4> LoadDiags;
+
+    PendingASTFile() : Unit(0) { }
+  };
+
+  /// \brief Records the diagnostics produced while loading an AST file
+  /// ahead of time, so that they can be reported when the file is merged.
+  class LoadDiagnosticBuffer : public DiagnosticConsumer {
+    SmallVectorImpl<StoredDiagnostic> &Diags;
+
+  public:
+    explicit LoadDiagnosticBuffer(SmallVectorImpl<StoredDiagnostic> &Diags)
+      : Diags(Diags) { }
+
+    virtual void HandleDiagnostic(DiagnosticsEngine::Level Level,
+                                  const Diagnostic &Info) {
+      DiagnosticConsumer::HandleDiagnostic(Level, Info);
+      Diags.push_back(StoredDiagnostic(Level, Info));
+    }
+  };
+
+  /// \brief The AST files to load ahead of time, which each loading thread
+  /// takes the next of until none is left.
+  class ASTFileLoadQueue {
+    std::vector<PendingASTFile> &Files;
+    const FileSystemOptions &FileSystemOpts;
+    llvm::sys::Mutex Lock;
+    unsigned Next;
+
+  public:
+    ASTFileLoadQueue(std::vector<PendingASTFile> &Files,
+                     const FileSystemOptions &FileSystemOpts)
+      : Files(Files), FileSystemOpts(FileSystemOpts), Next(0) { }
+
+    /// \brief Load files from the queue until it is empty.
+    void run();
+  };
+}
+
+/// \brief Deserialize every declaration in the given context, along with
+/// function bodies, so that importing from it later does not have to.
+static void loadAllDecls(DeclContext *DC) {
+  for (DeclContext::decl_iterator D = DC->decls_begin(),
+                               DEnd = DC->decls_end();
+       D != DEnd; ++D) {
+    if (FunctionDecl *FD = dyn_cast<FunctionDecl>(*D))
+      FD->getBody();
+    if (DeclContext *Inner = dyn_cast<DeclContext>(*D))
+      loadAllDecls(Inner);
+  }
+}
+
+static void loadASTFile(PendingASTFile &File,
+                        const FileSystemOptions &FileSystemOpts,
+                        bool LoadAllDecls) {
+  File.Unit = ASTUnit::LoadFromASTFile(File.Filename, File.Diags,
+                                       FileSystemOpts, false);
+  if (File.Unit && LoadAllDecls)
+    loadAllDecls(File.Unit->getASTContext().getTranslationUnitDecl());
+}
+
+void ASTFileLoadQueue::run() {
+  while (true) {
+    unsigned I;
+    {
+      llvm::sys::ScopedLock Guard(Lock);
+      if (Next == Files.size())
+        return;
+      I = Next++;
+    }
+    loadASTFile(Files[I], FileSystemOpts, /*LoadAllDecls=*/true);
+  }
+}
+
+static void loadQueuedASTFiles(void *Arg) {
+  static_cast<ASTFileLoadQueue *>(Arg)->run();
+}
+
+/// \brief Load and fully deserialize all of the given AST files, using up to
+/// \p NumJobs threads at once, including the calling one.
+static void loadASTFilesAhead(std::vector<PendingASTFile> &Files,
+                              const FileSystemOptions &FileSystemOpts,
+                              unsigned NumJobs) {
+  // Deserialization can recurse deeply; match the stack size used for
+  // compiling modules on a separate thread.
+  static const unsigned ThreadStackSize = 8 << 20;
+  ASTFileLoadQueue Queue(Files, FileSystemOpts);
+  ThreadGroup Threads(ThreadStackSize);
+  for (unsigned I = 1; I < NumJobs && I < Files.size(); ++I)
+    if (!Threads.start(loadQueuedASTFiles, &Queue))
+      break;
+  Queue.run();
+  Threads.join();
+}
+
 void ASTMergeAction::ExecuteAction() {
   CompilerInstance &CI = getCompilerInstance();
   CI.getDiagnostics().getClient()->BeginSourceFile(
@@ -39,14 +146,56 @@ void ASTMergeAction::ExecuteAction() {
                                        &CI.getASTContext());
   IntrusiveRefCntPtr<DiagnosticIDs>
       DiagIDs(CI.getDiagnostics().getDiagnosticIDs());
+
+  // With more than one job, load every AST file (into its own AST context)
+  // up front on that many threads at once, then merge them in order on this
+  // thread. Otherwise, or without threads, load each file only when it is
+  // merged, so that only one is in memory at a time.
+  bool Ahead = NumJobs > 1 && ASTFiles.size() > 1 &&
+               ThreadGroup::isSupported();
+  std::vector<PendingASTFile> Files(ASTFiles.size());
   for (unsigned I = 0, N = ASTFiles.size(); I != N; ++I) {
-    IntrusiveRefCntPtr<DiagnosticsEngine>
-        Diags(new DiagnosticsEngine(DiagIDs, &CI.getDiagnosticOpts(),
-                                    new ForwardingDiagnosticConsumer(
-                                          *CI.getDiagnostics().getClient()),
-                                    /*ShouldOwnClient=*/true));
-    ASTUnit *Unit = ASTUnit::LoadFromASTFile(ASTFiles[I], Diags,
-                                             CI.getFileSystemOpts(), false);
+    PendingASTFile &File = Files[I];
+    File.Filename = ASTFiles[I];
+    DiagnosticConsumer *Client;
+    if (Ahead)
+      Client = new LoadDiagnosticBuffer(File.LoadDiags);
+    else
+      Client = new ForwardingDiagnosticConsumer(
+                                          *CI.getDiagnostics().getClient());
+    File.Diags = new DiagnosticsEngine(DiagIDs, &CI.getDiagnosticOpts(),
+                                       Client, /*ShouldOwnClient=*/true);
+  }
+
+  if (Ahead)
+    loadASTFilesAhead(Files, CI.getFileSystemOpts(), NumJobs);
+
+  for (unsigned I = 0, N = Files.size(); I != N; ++I) {
+    PendingASTFile &File = Files[I];
+    if (Ahead) {
+      // Report the diagnostics from loading the file, then send any further
+      // diagnostics straight to the shared client.
+      File.Diags->setClient(new ForwardingDiagnosticConsumer(
+                                            *CI.getDiagnostics().getClient()),
+                            /*ShouldOwnClient=*/true);
+      for (unsigned D = 0, DN = File.LoadDiags.size(); D != DN; ++D) {
+        const StoredDiagnostic &Stored = File.LoadDiags[D];
+        if (File.Unit) {
+          File.Diags->Report(Stored);
+        } else {
+          // The source manager of a file that failed to load is gone, so
+          // drop the location.
+          File.Diags->Report(StoredDiagnostic(Stored.getLevel(),
+                                              Stored.getID(),
+                                              Stored.getMessage()));
+        }
+      }
+      File.LoadDiags.clear();
+    } else {
+      loadASTFile(File, CI.getFileSystemOpts(), /*LoadAllDecls=*/false);
+    }
+
+    ASTUnit *Unit = File.Unit;
     if (!Unit)
       continue;
 
@@ -70,6 +219,7 @@ void ASTMergeAction::ExecuteAction() {
     }
 
     delete Unit;
+    File.Unit = 0;
   }
 
   AdaptedAction->ExecuteAction();
@@ -81,8 +231,10 @@ void ASTMergeAction::EndSourceFileAction() {
 }
 
 ASTMergeAction::ASTMergeAction(FrontendAction *AdaptedAction,
-                               ArrayRef<std::string> ASTFiles)
-  : AdaptedAction(AdaptedAction), ASTFiles(ASTFiles.begin(), ASTFiles.end()) {
+                               ArrayRef<std::string> ASTFiles,
+                               unsigned NumJobs)
+  : AdaptedAction(AdaptedAction), ASTFiles(ASTFiles.begin(), ASTFiles.end()),
+    NumJobs(NumJobs) {
   assert(AdaptedAction && "ASTMergeAction needs an action to adapt");
 }
 
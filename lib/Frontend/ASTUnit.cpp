@@ -2023,7 +2023,9 @@ ASTUnit *ASTUnit::LoadFromCommandLine(const char **ArgBegin,
   // Override the resources path.
   CI->getHeaderSearchOpts().ResourceDir = ResourceFilesPath;
 
-  CI->getFrontendOpts().SkipFunctionBodies = SkipFunctionBodies;
+  // Function bodies may also have been requested to be skipped only in some
+  // files, on the command line.
+  CI->getFrontendOpts().SkipFunctionBodies |= SkipFunctionBodies;
 
   // Create the AST unit.
   OwningPtr<ASTUnit> AST;
@@ -21,6 +21,8 @@
 #include "clang/Lex/HeaderSearch.h"
 #include "clang/Lex/Preprocessor.h"
 #include "clang/Parse/ParseAST.h"
+#include "clang/Sema/Sema.h"
+#include "clang/Sema/TemplateInstantiationProfiler.h"
 #include "clang/Serialization/ASTDeserializationListener.h"
 #include "clang/Serialization/ASTReader.h"
 #include "clang/Serialization/GlobalModuleIndex.h"
@@ -472,8 +474,34 @@ void ASTFrontendAction::ExecuteAction() {
   if (!CI.hasSema())
     CI.createSema(getTranslationUnitKind(), CompletionConsumer);
 
+  const FrontendOptions &FEOpts = CI.getFrontendOpts();
+  if (FEOpts.SkipFunctionBodiesOutsideMainFile ||
+      !FEOpts.SkipFunctionBodiesPaths.empty())
+    CI.getSema().restrictSkippedFunctionBodies(
+        FEOpts.SkipFunctionBodiesOutsideMainFile, FEOpts.SkipFunctionBodiesPaths);
+
+  if (FEOpts.TemplateProfile || !FEOpts.TemplateProfileTrace.empty())
+    CI.getSema().enableTemplateProfiling(
+                                      !FEOpts.TemplateProfileTrace.empty());
+
   ParseAST(CI.getSema(), CI.getFrontendOpts().ShowStats,
            CI.getFrontendOpts().SkipFunctionBodies);
+
+  if (TemplateInstantiationProfiler *Profiler
+        = CI.getSema().getTemplateProfiler()) {
+    if (FEOpts.TemplateProfile)
+      Profiler->printReport(llvm::errs());
+
+    if (!FEOpts.TemplateProfileTrace.empty()) {
+      std::string ErrorInfo;
+      llvm::raw_fd_ostream OS(FEOpts.TemplateProfileTrace.c_str(), ErrorInfo);
+      if (ErrorInfo.empty())
+        Profiler->writeTrace(OS);
+      else
+        CI.getDiagnostics().Report(diag::err_fe_unable_to_open_output)
+          << FEOpts.TemplateProfileTrace << ErrorInfo;
+    }
+  }
 }
 
 void PluginASTAction::anchor() { }
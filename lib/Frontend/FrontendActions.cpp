@@ -63,6 +63,11 @@ ASTConsumer *ASTDeclListAction::CreateASTConsumer(CompilerInstance &CI,
   return CreateASTDeclNodeLister();
 }
 
+ASTConsumer *ASTHashTimingAction::CreateASTConsumer(CompilerInstance &CI,
+                                                    StringRef InFile) {
+  return CreateASTHashTimer();
+}
+
 ASTConsumer *ASTDumpXMLAction::CreateASTConsumer(CompilerInstance &CI,
                                                  StringRef InFile) {
   raw_ostream *OS;
@@ -71,6 +71,7 @@ void Preprocessor::CachingLex(Token &Result) {
     // All cached tokens were consumed.
     CachedTokens.clear();
     CachedLexPos = 0;
+    ++CachedTokensWindow;
   }
 }
 
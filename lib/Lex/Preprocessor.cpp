@@ -99,6 +99,7 @@ Preprocessor::Preprocessor(IntrusiveRefCntPtr<PreprocessorOptions> PPOpts,
   PreprocessedOutput = false;
 
   CachedLexPos = 0;
+  CachedTokensWindow = 0;
 
   // We haven't read anything from the external source.
   ReadMacrosFromExternalSource = false;
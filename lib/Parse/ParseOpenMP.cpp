@@ -24,6 +24,20 @@ using namespace clang;
 // OpenMP declarative directives.
 //===----------------------------------------------------------------------===//
 
+/// \brief Returns the kind of the directive at the current token. The last
+/// token of a combined directive like 'parallel for' is left unconsumed, like
+/// the only token of a simple one.
+OpenMPDirectiveKind Parser::ParseOpenMPDirectiveKind() {
+  OpenMPDirectiveKind DKind = Tok.isAnnotation() ?
+                                  OMPD_unknown :
+                                  getOpenMPDirectiveKind(PP.getSpelling(Tok));
+  if (DKind == OMPD_parallel && NextToken().is(tok::kw_for)) {
+    ConsumeToken();
+    DKind = OMPD_parallel_for;
+  }
+  return DKind;
+}
+
 /// \brief Parsing of declarative OpenMP directives.
 ///
 ///       threadprivate-directive:
@@ -34,9 +48,7 @@ Parser::DeclGroupPtrTy Parser::ParseOpenMPDeclarativeDirective() {
 
   SourceLocation Loc = ConsumeToken();
   SmallVector<Expr *, 5> Identifiers;
-  OpenMPDirectiveKind DKind = Tok.isAnnotation() ?
-                                  OMPD_unknown :
-                                  getOpenMPDirectiveKind(PP.getSpelling(Tok));
+  OpenMPDirectiveKind DKind = ParseOpenMPDirectiveKind();
 
   switch (DKind) {
   case OMPD_threadprivate:
@@ -59,6 +71,7 @@ Parser::DeclGroupPtrTy Parser::ParseOpenMPDeclarativeDirective() {
     Diag(Tok, diag::err_omp_unknown_directive);
     break;
   case OMPD_parallel:
+  case OMPD_parallel_for:
   case OMPD_task:
   case NUM_OPENMP_DIRECTIVES:
     Diag(Tok, diag::err_omp_unexpected_directive)
@@ -78,17 +91,19 @@ Parser::DeclGroupPtrTy Parser::ParseOpenMPDeclarativeDirective() {
 ///       parallel-directive:
 ///         annot_pragma_openmp 'parallel' {clause} annot_pragma_openmp_end
 ///
+///       parallel-for-directive:
+///         annot_pragma_openmp 'parallel' 'for' {clause}
+///         annot_pragma_openmp_end
+///
 StmtResult Parser::ParseOpenMPDeclarativeOrExecutableDirective() {
   assert(Tok.is(tok::annot_pragma_openmp) && "Not an OpenMP directive!");
   SmallVector<Expr *, 5> Identifiers;
   SmallVector<OMPClause *, 5> Clauses;
   SmallVector<llvm::PointerIntPair<OMPClause *, 1, bool>, NUM_OPENMP_CLAUSES>
                                                FirstClauses(NUM_OPENMP_CLAUSES);
-  const unsigned ScopeFlags = Scope::FnScope | Scope::DeclScope;
+  unsigned ScopeFlags = Scope::FnScope | Scope::DeclScope;
   SourceLocation Loc = ConsumeToken(), EndLoc;
-  OpenMPDirectiveKind DKind = Tok.isAnnotation() ?
-                                  OMPD_unknown :
-                                  getOpenMPDirectiveKind(PP.getSpelling(Tok));
+  OpenMPDirectiveKind DKind = ParseOpenMPDirectiveKind();
   StmtResult Directive = StmtError();
 
   switch (DKind) {
@@ -109,8 +124,11 @@ StmtResult Parser::ParseOpenMPDeclarativeOrExecutableDirective() {
     }
     SkipUntil(tok::annot_pragma_openmp_end, false);
     break;
-  case OMPD_parallel: {
+  case OMPD_parallel:
+  case OMPD_parallel_for: {
     ConsumeToken();
+    if (DKind == OMPD_parallel_for)
+      ScopeFlags |= Scope::OpenMPLoopDirectiveScope;
     while (Tok.isNot(tok::annot_pragma_openmp_end)) {
       OpenMPClauseKind CKind = Tok.isAnnotation() ?
                                   OMPC_unknown :
@@ -138,7 +156,7 @@ StmtResult Parser::ParseOpenMPDeclarativeOrExecutableDirective() {
     {
       // The body is a block scope like in Lambdas and Blocks.
       Sema::CompoundScopeRAII CompoundScope(Actions);
-      Actions.ActOnCapturedRegionStart(Loc, getCurScope(), CR_Default, 1);
+      Actions.ActOnCapturedRegionStart(Loc, getCurScope(), CR_OpenMP, 1);
       Actions.ActOnStartOfCompoundStmt();
       // Parse statement
       AssociatedStmt = ParseStatement();
@@ -245,7 +263,7 @@ bool Parser::ParseOpenMPSimpleVarList(OpenMPDirectiveKind Kind,
 /// \brief Parsing of OpenMP clauses.
 ///
 ///    clause:
-///       default-clause|private-clause
+///       default-clause|private-clause|schedule-clause
 ///
 OMPClause *Parser::ParseOpenMPClause(OpenMPDirectiveKind DKind,
                                      OpenMPClauseKind CKind, bool FirstClause) {
@@ -270,6 +288,16 @@ OMPClause *Parser::ParseOpenMPClause(OpenMPDirectiveKind DKind,
 
     Clause = ParseOpenMPSimpleClause(CKind);
     break;
+  case OMPC_schedule:
+    // OpenMP [2.5.1, Loop Construct, Restrictions]
+    //  Only one schedule clause can appear on a loop directive.
+    if (!FirstClause) {
+      Diag(Tok, diag::err_omp_more_one_clause)
+           << getOpenMPDirectiveName(DKind) << getOpenMPClauseName(CKind);
+    }
+
+    Clause = ParseOpenMPScheduleClause();
+    break;
   case OMPC_private:
     Clause = ParseOpenMPVarListClause(CKind);
     break;
@@ -317,6 +345,52 @@ OMPClause *Parser::ParseOpenMPSimpleClause(OpenMPClauseKind Kind) {
                                          Tok.getLocation());
 }
 
+/// \brief Parsing of OpenMP clause 'schedule'.
+///
+///    schedule-clause:
+///         'schedule' '(' kind [',' chunk-size] ')'
+///
+///    kind:
+///         'static' | 'dynamic' | 'guided' | 'auto' | 'runtime'
+///
+OMPClause *Parser::ParseOpenMPScheduleClause() {
+  SourceLocation Loc = Tok.getLocation();
+  ConsumeToken();
+  // Parse '('.
+  BalancedDelimiterTracker T(*this, tok::l_paren, tok::annot_pragma_openmp_end);
+  if (T.expectAndConsume(diag::err_expected_lparen_after,
+                         getOpenMPClauseName(OMPC_schedule)))
+    return 0;
+
+  unsigned Type = Tok.isAnnotation() ?
+                     unsigned(OMPC_SCHEDULE_unknown) :
+                     getOpenMPSimpleClauseType(OMPC_schedule,
+                                               PP.getSpelling(Tok));
+  SourceLocation TypeLoc = Tok.getLocation();
+  if (Tok.isNot(tok::r_paren) && Tok.isNot(tok::comma) &&
+      Tok.isNot(tok::annot_pragma_openmp_end))
+    ConsumeAnyToken();
+
+  // Parse ',' chunk-size, if any.
+  ExprResult ChunkSize;
+  if (Tok.is(tok::comma)) {
+    ConsumeToken();
+    ChunkSize = ParseAssignmentExpression();
+    if (ChunkSize.isInvalid())
+      SkipUntil(tok::r_paren, tok::annot_pragma_openmp_end, false, true);
+  }
+
+  // Parse ')'.
+  T.consumeClose();
+  if (ChunkSize.isInvalid())
+    return 0;
+
+  return Actions.ActOnOpenMPScheduleClause(
+                                  static_cast<OpenMPScheduleClauseKind>(Type),
+                                  TypeLoc, ChunkSize.take(), Loc,
+                                  T.getOpenLocation(), Tok.getLocation());
+}
+
 /// \brief Parsing of OpenMP clause 'private', 'firstprivate',
 /// 'shared', 'copyin', or 'reduction'.
 ///
@@ -151,6 +151,57 @@ StmtResult Parser::HandlePragmaCaptured()
   return Actions.ActOnCapturedRegionEnd(R.get());
 }
 
+struct PragmaLoopHintInfo {
+  Token PragmaName;
+  Token Option;
+  Token Value;
+  SourceLocation RParenLoc;
+};
+
+void Parser::HandlePragmaLoopHint(ParsedAttributes &Attrs) {
+  assert(Tok.is(tok::annot_pragma_loop_hint));
+  PragmaLoopHintInfo *Info =
+    static_cast<PragmaLoopHintInfo *>(Tok.getAnnotationValue());
+  SourceLocation PragmaLoc = ConsumeToken(); // The annotation token.
+
+  IdentifierInfo *OptionInfo = Info->Option.getIdentifierInfo();
+  bool IsEnableOption = llvm::StringSwitch<bool>(OptionInfo->getName())
+    .Cases("vectorize", "interleave", "unroll", true)
+    .Default(false);
+
+  // The enabling options take 'enable' or 'disable', which become 1 or 0;
+  // the others take a count, which Sema checks once it is evaluated.
+  ExprResult Value;
+  SourceLocation ValueLoc = Info->Value.getLocation();
+  if (IsEnableOption) {
+    IdentifierInfo *ValueInfo =
+      Info->Value.is(tok::identifier) ? Info->Value.getIdentifierInfo() : 0;
+    if (!ValueInfo ||
+        (!ValueInfo->isStr("enable") && !ValueInfo->isStr("disable"))) {
+      Diag(ValueLoc, diag::err_pragma_loop_invalid_argument)
+        << /*Keyword=*/0 << OptionInfo;
+      return;
+    }
+    Value = Actions.ActOnIntegerConstant(ValueLoc, ValueInfo->isStr("enable"));
+  } else {
+    if (Info->Value.isNot(tok::numeric_constant)) {
+      Diag(ValueLoc, diag::err_pragma_loop_invalid_argument)
+        << /*Keyword=*/1 << OptionInfo;
+      return;
+    }
+    Value = Actions.ActOnNumericConstant(Info->Value);
+  }
+  if (Value.isInvalid())
+    return;
+
+  Expr *ValueExpr = Value.take();
+  Attrs.addNew(Info->PragmaName.getIdentifierInfo(),
+               SourceRange(Info->Option.getLocation(), Info->RParenLoc),
+               PP.getIdentifierInfo("clang"), PragmaLoc,
+               OptionInfo, Info->Option.getLocation(), &ValueExpr, 1,
+               AttributeList::AS_Pragma);
+}
+
 namespace {
   typedef llvm::PointerIntPair<IdentifierInfo *, 1, bool> OpenCLExtData;
 }
@@ -794,6 +845,97 @@ PragmaOpenMPHandler::HandlePragma(Preprocessor &PP,
                       /*DisableMacroExpansion=*/true, /*OwnsTokens=*/true);
 }
 
+/// \brief Handle '#pragma clang loop' hints for the loop that follows.
+///
+/// The syntax is:
+/// \code
+///   #pragma clang loop vectorize(enable) vectorize_width(4)
+///   #pragma clang loop interleave(disable) unroll_count(8)
+/// \endcode
+///
+/// Each hint becomes an annot_pragma_loop_hint token for the parser. The
+/// options are vectorize, interleave and unroll, which take 'enable' or
+/// 'disable', and vectorize_width, interleave_count and unroll_count, which
+/// take a positive integer.
+void PragmaLoopHintHandler::HandlePragma(Preprocessor &PP,
+                                         PragmaIntroducerKind Introducer,
+                                         Token &Tok) {
+  Token PragmaName = Tok;
+  SmallVector<Token, 4> TokenList;
+
+  PP.Lex(Tok);
+  if (Tok.isNot(tok::identifier)) {
+    PP.Diag(Tok.getLocation(), diag::err_pragma_loop_invalid_option)
+      << /*MissingOption=*/true << "";
+    return;
+  }
+
+  while (Tok.is(tok::identifier)) {
+    Token Option = Tok;
+    IdentifierInfo *OptionInfo = Tok.getIdentifierInfo();
+    bool OptionValid = llvm::StringSwitch<bool>(OptionInfo->getName())
+      .Cases("vectorize", "vectorize_width", true)
+      .Cases("interleave", "interleave_count", true)
+      .Cases("unroll", "unroll_count", true)
+      .Default(false);
+    if (!OptionValid) {
+      PP.Diag(Tok.getLocation(), diag::err_pragma_loop_invalid_option)
+        << /*MissingOption=*/false << OptionInfo;
+      return;
+    }
+
+    PP.Lex(Tok);
+    if (Tok.isNot(tok::l_paren)) {
+      PP.Diag(Tok.getLocation(), diag::err_expected_lparen);
+      return;
+    }
+
+    // Whether the value is valid for the option is checked by the parser.
+    PP.Lex(Tok);
+    if (Tok.isNot(tok::identifier) && Tok.isNot(tok::numeric_constant)) {
+      PP.Diag(Tok.getLocation(), diag::err_pragma_loop_missing_argument)
+        << OptionInfo;
+      return;
+    }
+    Token Value = Tok;
+
+    PP.Lex(Tok);
+    if (Tok.isNot(tok::r_paren)) {
+      PP.Diag(Tok.getLocation(), diag::err_expected_rparen);
+      return;
+    }
+
+    PragmaLoopHintInfo *Info =
+      (PragmaLoopHintInfo*) PP.getPreprocessorAllocator().Allocate(
+        sizeof(PragmaLoopHintInfo), llvm::alignOf<PragmaLoopHintInfo>());
+    new (Info) PragmaLoopHintInfo();
+    Info->PragmaName = PragmaName;
+    Info->Option = Option;
+    Info->Value = Value;
+    Info->RParenLoc = Tok.getLocation();
+
+    Token LoopHintTok;
+    LoopHintTok.startToken();
+    LoopHintTok.setKind(tok::annot_pragma_loop_hint);
+    LoopHintTok.setLocation(PragmaName.getLocation());
+    LoopHintTok.setAnnotationValue(static_cast<void *>(Info));
+    TokenList.push_back(LoopHintTok);
+
+    PP.Lex(Tok);
+  }
+
+  if (Tok.isNot(tok::eod)) {
+    PP.Diag(Tok.getLocation(), diag::warn_pragma_extra_tokens_at_eol)
+      << "clang loop";
+    return;
+  }
+
+  Token *TokenArray = new Token[TokenList.size()];
+  std::copy(TokenList.begin(), TokenList.end(), TokenArray);
+  PP.EnterTokenStream(TokenArray, TokenList.size(),
+                      /*DisableMacroExpansion=*/false, /*OwnsTokens=*/true);
+}
+
 /// \brief Handle the Microsoft \#pragma detect_mismatch extension.
 ///
 /// The syntax is:
@@ -99,6 +99,13 @@ public:
                             Token &FirstToken);
 };
 
+class PragmaLoopHintHandler : public PragmaHandler {
+public:
+  PragmaLoopHintHandler() : PragmaHandler("loop") {}
+  virtual void HandlePragma(Preprocessor &PP, PragmaIntroducerKind Introducer,
+                            Token &FirstToken);
+};
+
 class PragmaNoOpenMPHandler : public PragmaHandler {
 public:
   PragmaNoOpenMPHandler() : PragmaHandler("omp") { }
@@ -22,6 +22,7 @@
 #include "clang/Sema/DeclSpec.h"
 #include "clang/Sema/PrettyDeclStackTrace.h"
 #include "clang/Sema/Scope.h"
+#include "clang/Sema/SemaDiagnostic.h"
 #include "clang/Sema/TypoCorrection.h"
 #include "llvm/MC/MCAsmInfo.h"
 #include "llvm/MC/MCContext.h"
@@ -305,6 +306,9 @@ Retry:
   case tok::annot_pragma_captured:
     return HandlePragmaCaptured();
 
+  case tok::annot_pragma_loop_hint:
+    return ParsePragmaLoopHint(Stmts, OnlyStatement, TrailingElseLoc, Attrs);
+
   case tok::annot_pragma_openmp:
     return ParseOpenMPDeclarativeOrExecutableDirective();
 
@@ -1586,6 +1590,50 @@ StmtResult Parser::ParseForStatement(SourceLocation *TrailingElseLoc) {
                               T.getCloseLocation(), Body.take());
 }
 
+/// ParsePragmaLoopHint
+///       loop-hint-statement:
+///         '#pragma' 'clang' 'loop' loop-hint-list statement
+///
+///       loop-hint-list:
+///         loop-hint
+///         loop-hint-list loop-hint
+///
+///       loop-hint:
+///         identifier '(' identifier ')'
+///         identifier '(' numeric-constant ')'
+///
+/// The pragma handler turns each hint into an annot_pragma_loop_hint token.
+/// The hints become attributes of the statement that follows, which Sema
+/// checks is a loop.
+StmtResult Parser::ParsePragmaLoopHint(StmtVector &Stmts, bool OnlyStatement,
+                                       SourceLocation *TrailingElseLoc,
+                                       ParsedAttributesWithRange &Attrs) {
+  // Collect the hints of this directive and of any that directly follow it.
+  ParsedAttributesWithRange TempAttrs(AttrFactory);
+  SourceLocation PragmaLoc = Tok.getLocation();
+  while (Tok.is(tok::annot_pragma_loop_hint))
+    HandlePragmaLoopHint(TempAttrs);
+
+  MaybeParseCXX11Attributes(Attrs);
+
+  StmtResult S = ParseStatementOrDeclarationAfterAttributes(
+      Stmts, OnlyStatement, TrailingElseLoc, Attrs);
+  if (S.isInvalid())
+    return S;
+
+  // Another pragma, for instance, does not produce a statement to attach the
+  // hints to.
+  if (!S.isUsable()) {
+    Diag(PragmaLoc, diag::err_pragma_loop_precedes_nonloop);
+    return S;
+  }
+
+  Attrs.takeAllFrom(TempAttrs);
+  if (Attrs.Range.isInvalid())
+    Attrs.Range = SourceRange(PragmaLoc, PragmaLoc);
+  return S;
+}
+
 /// ParseGotoStatement
 ///       jump-statement:
 ///         'goto' identifier ';'
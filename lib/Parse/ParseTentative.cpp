@@ -17,6 +17,47 @@
 #include "clang/Sema/ParsedTemplate.h"
 using namespace clang;
 
+Parser::DisambiguationMemo::DisambiguationMemo(Parser &P,
+                                               DisambiguationKind Kind)
+  : P(P), Key(P.Tok.getLocation().getRawEncoding(), Kind),
+    PrevUsedTentativeDecl(P.DisambiguationUsedTentativeDecl) {
+  // Token locations only identify the same tokens within one window of
+  // cached tokens; forget everything from earlier windows.
+  unsigned Window = P.PP.getCachedTokensWindow();
+  if (Window != P.DisambiguationsWindow) {
+    P.Disambiguations.clear();
+    P.DisambiguationsWindow = Window;
+  }
+  P.DisambiguationUsedTentativeDecl = false;
+}
+
+Parser::DisambiguationMemo::~DisambiguationMemo() {
+  // An enclosing disambiguation depends on whatever this one depended on.
+  P.DisambiguationUsedTentativeDecl |= PrevUsedTentativeDecl;
+}
+
+bool Parser::DisambiguationMemo::lookup(bool &Result,
+                                        bool &IsAmbiguous) const {
+  if (!Key.first)
+    return false;
+
+  llvm::DenseMap<std::pair<unsigned, unsigned>, unsigned char>::const_iterator
+    Known = P.Disambiguations.find(Key);
+  if (Known == P.Disambiguations.end())
+    return false;
+
+  Result = Known->second & 0x1;
+  IsAmbiguous = Known->second & 0x2;
+  return true;
+}
+
+void Parser::DisambiguationMemo::remember(bool Result, bool IsAmbiguous) {
+  if (!Key.first || P.DisambiguationUsedTentativeDecl)
+    return;
+
+  P.Disambiguations[Key] = (Result ? 0x1 : 0) | (IsAmbiguous ? 0x2 : 0);
+}
+
 /// isCXXDeclarationStatement - C++-specialized function that disambiguates
 /// between a declaration or an expression statement, when parsing function
 /// bodies. Returns true for declaration, false for expression.
@@ -124,7 +165,13 @@ bool Parser::isCXXSimpleDeclaration(bool AllowForRangeDecl) {
 
   // Ok, we have a simple-type-specifier/typename-specifier followed by a '(',
   // or an identifier which doesn't resolve as anything. We need tentative
-  // parsing...
+  // parsing, unless we've already done it for these tokens...
+
+  DisambiguationMemo Memo(*this, AllowForRangeDecl ? DK_ForRangeDeclaration
+                                                   : DK_SimpleDeclaration);
+  bool IsDecl, IsAmbiguous;
+  if (Memo.lookup(IsDecl, IsAmbiguous))
+    return IsDecl;
 
   TentativeParsingAction PA(*this);
   TPR = TryParseSimpleDeclaration(AllowForRangeDecl);
@@ -132,13 +179,14 @@ bool Parser::isCXXSimpleDeclaration(bool AllowForRangeDecl) {
 
   // In case of an error, let the declaration parsing code handle it.
   if (TPR == TPResult::Error())
-    return true;
+    TPR = TPResult::True();
 
   // Declarations take precedence over expressions.
   if (TPR == TPResult::Ambiguous())
     TPR = TPResult::True();
 
   assert(TPR == TPResult::True() || TPR == TPResult::False());
+  Memo.remember(TPR == TPResult::True());
   return TPR == TPResult::True();
 }
 
@@ -281,7 +329,13 @@ bool Parser::isCXXConditionDeclaration() {
   // and how they were resolved (number of declarations+number of expressions).
 
   // Ok, we have a simple-type-specifier/typename-specifier followed by a '('.
-  // We need tentative parsing...
+  // We need tentative parsing, unless we've already done it for these
+  // tokens...
+
+  DisambiguationMemo Memo(*this, DK_ConditionDeclaration);
+  bool IsDecl, IsAmbiguous;
+  if (Memo.lookup(IsDecl, IsAmbiguous))
+    return IsDecl;
 
   TentativeParsingAction PA(*this);
 
@@ -318,6 +372,7 @@ bool Parser::isCXXConditionDeclaration() {
   PA.Revert();
 
   assert(TPR == TPResult::True() || TPR == TPResult::False());
+  Memo.remember(TPR == TPResult::True());
   return TPR == TPResult::True();
 }
 
@@ -358,7 +413,15 @@ bool Parser::isCXXTypeId(TentativeCXXTypeIdContext Context, bool &isAmbiguous) {
   // and how they were resolved (number of declarations+number of expressions).
 
   // Ok, we have a simple-type-specifier/typename-specifier followed by a '('.
-  // We need tentative parsing...
+  // We need tentative parsing, unless we've already done it for these
+  // tokens...
+
+  DisambiguationMemo Memo(*this, Context == TypeIdInParens
+                                     ? DK_TypeIdInParens
+                                     : DK_TypeIdAsTemplateArgument);
+  bool IsTypeId;
+  if (Memo.lookup(IsTypeId, isAmbiguous))
+    return IsTypeId;
 
   TentativeParsingAction PA(*this);
 
@@ -404,6 +467,7 @@ bool Parser::isCXXTypeId(TentativeCXXTypeIdContext Context, bool &isAmbiguous) {
   PA.Revert();
 
   assert(TPR == TPResult::True() || TPR == TPResult::False());
+  Memo.remember(TPR == TPResult::True(), isAmbiguous);
   return TPR == TPResult::True();
 }
 
@@ -871,9 +935,15 @@ Parser::isExpressionOrTypeSpecifierSimple(tok::TokenKind Kind) {
 }
 
 bool Parser::isTentativelyDeclared(IdentifierInfo *II) {
-  return std::find(TentativelyDeclaredIdentifiers.begin(),
-                   TentativelyDeclaredIdentifiers.end(), II)
-      != TentativelyDeclaredIdentifiers.end();
+  if (std::find(TentativelyDeclaredIdentifiers.begin(),
+                TentativelyDeclaredIdentifiers.end(), II)
+      == TentativelyDeclaredIdentifiers.end())
+    return false;
+
+  // The outcome of any disambiguation in progress now depends on the
+  // tentative parse that declared this identifier.
+  DisambiguationUsedTentativeDecl = true;
+  return true;
 }
 
 /// isCXXDeclarationSpecifier - Returns TPResult::True() if it is a declaration
@@ -1408,6 +1478,16 @@ bool Parser::isCXXFunctionDeclarator(bool *IsAmbiguous) {
   // ambiguities mentioned in 6.8, the resolution is to consider any construct
   // that could possibly be a declaration a declaration.
 
+  // A declarator is disambiguated both while tentatively parsing the
+  // statement containing it and again while parsing it for real.
+  DisambiguationMemo Memo(*this, DK_FunctionDeclarator);
+  bool IsFunction, WasAmbiguous;
+  if (Memo.lookup(IsFunction, WasAmbiguous)) {
+    if (IsAmbiguous && WasAmbiguous)
+      *IsAmbiguous = true;
+    return IsFunction;
+  }
+
   TentativeParsingAction PA(*this);
 
   ConsumeParen();
@@ -1440,6 +1520,7 @@ bool Parser::isCXXFunctionDeclarator(bool *IsAmbiguous) {
     *IsAmbiguous = true;
 
   // In case of an error, let the declaration parsing code handle it.
+  Memo.remember(TPR != TPResult::False(), TPR == TPResult::Ambiguous());
   return TPR != TPResult::False();
 }
 
@@ -24,7 +24,6 @@
 #include "clang/AST/StmtCXX.h"
 #include "clang/AST/StmtObjC.h"
 #include "clang/AST/StmtVisitor.h"
-#include "clang/Analysis/Analyses/CFGReachabilityAnalysis.h"
 #include "clang/Analysis/Analyses/ReachableCode.h"
 #include "clang/Analysis/Analyses/ThreadSafety.h"
 #include "clang/Analysis/Analyses/UninitializedValues.h"
@@ -98,14 +97,15 @@ enum ControlFlowKind {
 /// statement but we may return.  We assume that functions not marked noreturn
 /// will return.
 static ControlFlowKind CheckFallThrough(AnalysisDeclContext &AC) {
+  reachable_code::ReachableBlocks *RB =
+    AC.getAnalysis<reachable_code::ReachableBlocks>();
+  if (RB == 0) return UnknownFallThrough;
   CFG *cfg = AC.getCFG();
-  if (cfg == 0) return UnknownFallThrough;
 
   // The CFG leaves in dead things, and we don't want the dead code paths to
   // confuse us, so we mark all live things first.
-  llvm::BitVector live(cfg->getNumBlockIDs());
-  unsigned count = reachable_code::ScanReachableFromBlock(&cfg->getEntry(),
-                                                          live);
+  llvm::BitVector live(RB->getBlocks());
+  unsigned count = RB->getNumReachable();
 
   bool AddEHEdges = AC.getAddEHEdges();
   if (!AddEHEdges && count != cfg->getNumBlockIDs())
@@ -1517,7 +1517,10 @@ AnalysisBasedWarnings::IssueWarnings(sema::AnalysisBasedWarnings::Policy P,
       .setAlwaysAdd(Stmt::AttributedStmtClass);
   }
 
-  // Construct the analysis context with the specified CFG build options.
+  // All of the analyses below share the CFG that AC builds with these options,
+  // along with whatever AC derives from it (the blocks reachable from the
+  // entry, the post-order view, the parent map), so each is computed at most
+  // once per function.
   
   // Emit delayed diagnostics.
   if (!fscope->PossiblyUnreachableDiags.empty()) {
@@ -1543,14 +1546,14 @@ AnalysisBasedWarnings::IssueWarnings(sema::AnalysisBasedWarnings::Policy P,
         bool processed = false;
         if (const Stmt *stmt = i->stmt) {
           const CFGBlock *block = AC.getBlockForRegisteredExpression(stmt);
-          CFGReverseBlockReachabilityAnalysis *cra =
-              AC.getCFGReachablityAnalysis();
+          reachable_code::ReachableBlocks *RB =
+              AC.getAnalysis<reachable_code::ReachableBlocks>();
           // FIXME: We should be able to assert that block is non-null, but
           // the CFG analysis can skip potentially-evaluated expressions in
           // edge cases; see test/Sema/vla-2.c.
-          if (block && cra) {
+          if (block && RB) {
             // Can this block be reached from the entrance?
-            if (cra->isReachable(&AC.getCFG()->getEntry(), block))
+            if (RB->isReachable(block))
               S.Diag(D.Loc, D.PD);
             processed = true;
           }
@@ -69,6 +69,7 @@ clang_sema_SRC_FILES :=	\
 	SemaTemplateVariadic.cpp	\
 	SemaType.cpp	\
 	TargetAttributesSema.cpp	\
+	TemplateInstantiationProfiler.cpp	\
 	TypeLocBuilder.cpp
 
 LOCAL_SRC_FILES := $(clang_sema_SRC_FILES)
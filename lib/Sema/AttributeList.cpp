@@ -117,6 +117,17 @@ AttributeList::Kind AttributeList::getKind(const IdentifierInfo *Name,
     AttrName = AttrName.substr(2, AttrName.size() - 4);
 
   SmallString<64> Buf;
+  // Pragma attributes are looked up as '#pragma scope name'.
+  if (SyntaxUsed == AS_Pragma) {
+    Buf += "#pragma ";
+    if (ScopeName) {
+      Buf += ScopeName->getName();
+      Buf += " ";
+    }
+    Buf += AttrName;
+    return ::getAttrKind(Buf);
+  }
+
   if (ScopeName)
     Buf += ScopeName->getName();
   // Ensure that in the case of C++11 attributes, we look for '::foo' if it is
@@ -81,6 +81,14 @@ CXXBaseSpecifier *MultiplexExternalSemaSource::GetExternalCXXBaseSpecifiers(
   return 0; 
 }
 
+const ASTRecordLayout *
+MultiplexExternalSemaSource::GetExternalRecordLayout(const RecordDecl *RD) {
+  for(size_t i = 0; i < Sources.size(); ++i)
+    if (const ASTRecordLayout *R = Sources[i]->GetExternalRecordLayout(RD))
+      return R;
+  return 0;
+}
+
 bool MultiplexExternalSemaSource::
 FindExternalVisibleDeclsByName(const DeclContext *DC, DeclarationName Name) {
   bool AnyDeclsFound = false;
@@ -32,11 +32,13 @@
 #include "clang/Sema/ExternalSemaSource.h"
 #include "clang/Sema/MultiplexExternalSemaSource.h"
 #include "clang/Sema/ObjCMethodList.h"
+#include "clang/Sema/Overload.h"
 #include "clang/Sema/PrettyDeclStackTrace.h"
 #include "clang/Sema/Scope.h"
 #include "clang/Sema/ScopeInfo.h"
 #include "clang/Sema/SemaConsumer.h"
 #include "clang/Sema/TemplateDeduction.h"
+#include "clang/Sema/TemplateInstantiationProfiler.h"
 #include "llvm/ADT/APFloat.h"
 #include "llvm/ADT/DenseMap.h"
 #include "llvm/ADT/SmallSet.h"
@@ -86,13 +88,17 @@ Sema::Sema(Preprocessor &pp, ASTContext &ctxt, ASTConsumer &consumer,
     NSDictionaryDecl(0), DictionaryWithObjectsMethod(0),
     GlobalNewDeleteDeclared(false),
     TUKind(TUKind),
-    NumSFINAEErrors(0), InFunctionDeclarator(0),
+    NumSFINAEErrors(0),
+    NumBuiltinOperatorSets(0), NumBuiltinOperatorSetsSkipped(0),
+    NumBuiltinCandidates(0), NumNonViableBuiltinCandidates(0),
+    InFunctionDeclarator(0),
     AccessCheckingSFINAE(false), InNonInstantiationSFINAEContext(false),
     NonInstantiationEntries(0), ArgumentPackSubstitutionIndex(-1),
     CurrentInstantiationScope(0), TyposCorrected(0),
     AnalysisWarnings(*this), CurScope(0), Ident_super(0), Ident___float128(0)
 {
   TUScope = 0;
+  SkipFunctionBodiesOutsideMainFile = false;
 
   LoadedExternalKnownNamespaces = false;
   for (unsigned I = 0; I != NSAPI::NumNSNumberLiteralMethods; ++I)
@@ -104,6 +110,8 @@ Sema::Sema(Preprocessor &pp, ASTContext &ctxt, ASTConsumer &consumer,
   if (getLangOpts().CPlusPlus)
     FieldCollector.reset(new CXXFieldCollector());
 
+  CandidateArena.reset(new OverloadCandidateArena());
+
   // Tell diagnostics how to render things from the AST library.
   PP.getDiagnostics().SetArgToStringFn(&FormatASTNodeDiagnosticArgument,
                                        &Context);
@@ -251,9 +259,26 @@ void Sema::addExternalSource(ExternalSemaSource *E) {
 void Sema::PrintStats() const {
   llvm::errs() << "\n*** Semantic Analysis Stats:\n";
   llvm::errs() << NumSFINAEErrors << " SFINAE diagnostics trapped.\n";
+  llvm::errs() << NumBuiltinOperatorSets
+               << " sets of built-in operator candidates, "
+               << NumBuiltinOperatorSetsSkipped << " skipped.\n"
+               << "  " << NumBuiltinCandidates
+               << " built-in candidates generated, "
+               << NumNonViableBuiltinCandidates
+               << " discarded as non-viable.\n";
 
   BumpAlloc.PrintStats();
   AnalysisWarnings.PrintStats();
+  if (ImplicitConversions)
+    ImplicitConversions->PrintStats();
+  CandidateArena->PrintStats();
+}
+
+void Sema::enableTemplateProfiling(bool RecordTrace) {
+  // The profiler attributes AST allocations to instantiations.
+  Context.setCountAllocations(true);
+  TemplateProfiler.reset(new TemplateInstantiationProfiler(Context,
+                                                           RecordTrace));
 }
 
 /// ImpCastExprToType - If Expr is not of type 'Type', insert an implicit cast.
@@ -549,7 +574,7 @@ void Sema::ActOnEndOfTranslationUnit() {
     return;
 
   // Complete translation units and modules define vtables and perform implicit
-  // instantiations. PCH files do not.
+  // instantiations. PCH files do not, unless asked to instantiate.
   if (TUKind != TU_Prefix) {
     DiagnoseUseOfUnimplementedSelectors();
 
@@ -583,6 +608,17 @@ void Sema::ActOnEndOfTranslationUnit() {
     // valid, but we could do better by diagnosing if an instantiation uses a
     // name that was not visible at its first point of instantiation.
     PerformPendingInstantiations();
+  } else if (LangOpts.PCHInstantiateTemplates) {
+    // Perform the implicit instantiations the PCH needs now, so that the
+    // translation units using it find the definitions there instead of
+    // instantiating them again. The end of the PCH follows every use in it,
+    // so it is as good a point of instantiation as the end of the translation
+    // unit. Whatever can't be instantiated yet stays pending.
+    PerformPendingInstantiations();
+    PendingInstantiations.insert(PendingInstantiations.end(),
+                                 DeferredPCHInstantiations.begin(),
+                                 DeferredPCHInstantiations.end());
+    DeferredPCHInstantiations.clear();
   }
 
   // Remove file scoped decls that turned out to be used.
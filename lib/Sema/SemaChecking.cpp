@@ -178,6 +178,10 @@ Sema::CheckBuiltinFunctionCall(unsigned BuiltinID, CallExpr *TheCall) {
     if (SemaBuiltinObjectSize(TheCall))
       return ExprError();
     break;
+  case Builtin::BI__builtin_assume_aligned:
+    if (SemaBuiltinAssumeAligned(TheCall))
+      return ExprError();
+    break;
   case Builtin::BI__builtin_longjmp:
     if (SemaBuiltinLongjmp(TheCall))
       return ExprError();
@@ -1900,6 +1904,48 @@ bool Sema::SemaBuiltinObjectSize(CallExpr *TheCall) {
   return false;
 }
 
+/// SemaBuiltinAssumeAligned - Handle __builtin_assume_aligned.
+// This is declared to take (const void*, size_t, ...) and can take an
+// optional offset, which is converted to size_t.  The alignment must be a
+// constant power of two.
+bool Sema::SemaBuiltinAssumeAligned(CallExpr *TheCall) {
+  unsigned NumArgs = TheCall->getNumArgs();
+
+  if (NumArgs > 3)
+    return Diag(TheCall->getLocEnd(),
+             diag::err_typecheck_call_too_many_args_at_most)
+             << 0 /*function call*/ << 3 << NumArgs
+             << TheCall->getSourceRange();
+
+  // We can't check the value of a dependent argument.
+  Expr *Arg = TheCall->getArg(1);
+  if (!Arg->isTypeDependent() && !Arg->isValueDependent()) {
+    llvm::APSInt Result;
+    if (SemaBuiltinConstantArg(TheCall, 1, Result))
+      return true;
+
+    if (!Result.isPowerOf2())
+      return Diag(TheCall->getLocStart(),
+                  diag::err_attribute_aligned_not_power_of_two)
+               << Arg->getSourceRange();
+  }
+
+  if (NumArgs > 2) {
+    ExprResult Offset(TheCall->getArg(2));
+    if (Offset.get()->isTypeDependent())
+      return false;
+    InitializedEntity Entity =
+      InitializedEntity::InitializeParameter(Context, Context.getSizeType(),
+                                             /*consume*/ false);
+    Offset = PerformCopyInitialization(Entity, SourceLocation(), Offset);
+    if (Offset.isInvalid())
+      return true;
+    TheCall->setArg(2, Offset.take());
+  }
+
+  return false;
+}
+
 /// SemaBuiltinLongjmp - Handle __builtin_longjmp(void *env[5], int val).
 /// This checks that val is a constant 1.
 bool Sema::SemaBuiltinLongjmp(CallExpr *TheCall) {
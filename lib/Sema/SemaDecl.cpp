@@ -41,6 +41,7 @@
 #include "clang/Sema/ScopeInfo.h"
 #include "llvm/ADT/SmallString.h"
 #include "llvm/ADT/Triple.h"
+#include "llvm/Support/Path.h"
 #include <algorithm>
 #include <cstring>
 #include <functional>
@@ -9394,10 +9395,57 @@ void Sema::computeNRVO(Stmt *Body, FunctionScopeInfo *Scope) {
     const_cast<VarDecl*>(NRVOCandidate)->setNRVOVariable(true);
 }
 
+void Sema::restrictSkippedFunctionBodies(bool OutsideMainFile,
+                                         ArrayRef<std::string> Paths) {
+  SkipFunctionBodiesOutsideMainFile = OutsideMainFile;
+  SkipFunctionBodiesPaths.assign(Paths.begin(), Paths.end());
+}
+
+/// \brief Determine whether \p Path names \p Dir or a file under it, comparing
+/// whole path components.
+static bool isPathUnder(StringRef Path, StringRef Dir) {
+  llvm::sys::path::const_iterator PI = llvm::sys::path::begin(Path),
+                                  PE = llvm::sys::path::end(Path);
+  for (llvm::sys::path::const_iterator DI = llvm::sys::path::begin(Dir),
+                                       DE = llvm::sys::path::end(Dir);
+       DI != DE; ++DI) {
+    // "." components, including the one that stands for a trailing
+    // separator, do not name anything.
+    if (*DI == ".")
+      continue;
+    while (PI != PE && *PI == ".")
+      ++PI;
+    if (PI == PE || *PI != *DI)
+      return false;
+    ++PI;
+  }
+  return true;
+}
+
+/// \brief Determine whether the bodies of functions defined at \p Loc may be
+/// skipped, when only those in some files may be.
+static bool isInFileWithSkippedBodies(Sema &S, SourceLocation Loc) {
+  SourceManager &SM = S.getSourceManager();
+  Loc = SM.getExpansionLoc(Loc);
+  if (S.SkipFunctionBodiesOutsideMainFile && !SM.isFromMainFile(Loc))
+    return true;
+
+  StringRef Filename = SM.getFilename(Loc);
+  for (unsigned I = 0, N = S.SkipFunctionBodiesPaths.size(); I != N; ++I)
+    if (isPathUnder(Filename, S.SkipFunctionBodiesPaths[I]))
+      return true;
+  return false;
+}
+
 bool Sema::canSkipFunctionBody(Decl *D) {
   if (!Consumer.shouldSkipFunctionBody(D))
     return false;
 
+  bool SkipSomeBodies = SkipFunctionBodiesOutsideMainFile ||
+                        !SkipFunctionBodiesPaths.empty();
+  if (SkipSomeBodies && !isInFileWithSkippedBodies(*this, D->getLocation()))
+    return false;
+
   if (isa<ObjCMethodDecl>(D))
     return true;
 
@@ -9407,6 +9455,12 @@ bool Sema::canSkipFunctionBody(Decl *D) {
   else
     FD = cast<FunctionDecl>(D);
 
+  // When only the bodies in some files are skipped, the rest of the program
+  // is analyzed, and may instantiate templates or call inline functions from
+  // those files; keep their bodies.
+  if (SkipSomeBodies && (FD->isInlined() || FD->isDependentContext()))
+    return false;
+
   // We cannot skip the body of a function (or function template) which is
   // constexpr, since we may need to evaluate its body in order to parse the
   // rest of the file.
@@ -1194,6 +1194,99 @@ static void handleAllocSizeAttr(Sema &S, Decl *D, const AttributeList &Attr) {
                            Attr.getAttributeSpellingListIndex()));
 }
 
+static void handleAllocAlignAttr(Sema &S, Decl *D, const AttributeList &Attr) {
+  if (!isFunctionOrMethod(D)) {
+    S.Diag(Attr.getLoc(), diag::warn_attribute_wrong_decl_type)
+    << Attr.getName() << ExpectedFunctionOrMethod;
+    return;
+  }
+
+  if (!checkAttributeNumArgs(S, Attr, 1))
+    return;
+
+  Expr *Ex = Attr.getArg(0);
+  uint64_t Idx;
+  if (!checkFunctionOrMethodArgumentIndex(S, D, Attr.getName()->getName(),
+                                          Attr.getLoc(), 1, Ex, Idx))
+    return;
+
+  // The alignment must be a named parameter, even of a variadic function.
+  if (Idx >= getFunctionOrMethodNumArgs(D)) {
+    S.Diag(Attr.getLoc(), diag::err_attribute_argument_out_of_bounds)
+      << Attr.getName()->getName() << 1 << Ex->getSourceRange();
+    return;
+  }
+
+  // check if the function argument is of an integer type
+  QualType T = getFunctionOrMethodArgType(D, Idx).getNonReferenceType();
+  if (!T->isIntegerType()) {
+    S.Diag(Attr.getLoc(), diag::err_attribute_integers_only)
+      << Attr.getName() << Ex->getSourceRange();
+    return;
+  }
+
+  // check if the function returns a pointer
+  if (!getFunctionOrMethodResultType(D)->isAnyPointerType()) {
+    S.Diag(Attr.getLoc(), diag::warn_ns_attribute_wrong_return_type)
+    << Attr.getName() << 0 /*function*/<< 1 /*pointer*/ << D->getSourceRange();
+    return;
+  }
+
+  D->addAttr(::new (S.Context)
+             AllocAlignAttr(Attr.getRange(), S.Context, Idx,
+                            Attr.getAttributeSpellingListIndex()));
+}
+
+/// Handle __attribute__((assume_aligned(alignment[, offset]))), which states
+/// that the returned pointer minus the offset is a multiple of the alignment.
+static void handleAssumeAlignedAttr(Sema &S, Decl *D,
+                                    const AttributeList &Attr) {
+  if (!isFunctionOrMethod(D)) {
+    S.Diag(Attr.getLoc(), diag::warn_attribute_wrong_decl_type)
+    << Attr.getName() << ExpectedFunctionOrMethod;
+    return;
+  }
+
+  if (!checkAttributeAtLeastNumArgs(S, Attr, 1))
+    return;
+  if (Attr.getNumArgs() > 2) {
+    S.Diag(Attr.getLoc(), diag::err_attribute_too_many_arguments) << 2;
+    return;
+  }
+
+  uint64_t Values[2] = { 0, 0 };
+  for (unsigned i = 0; i < Attr.getNumArgs(); ++i) {
+    Expr *E = Attr.getArg(i);
+    llvm::APSInt Val;
+    if (E->isTypeDependent() || E->isValueDependent() ||
+        !E->isIntegerConstantExpr(Val, S.Context)) {
+      S.Diag(Attr.getLoc(), diag::err_attribute_argument_n_type)
+        << Attr.getName() << i + 1 << AANT_ArgumentIntegerConstant
+        << E->getSourceRange();
+      return;
+    }
+    Values[i] = Val.getZExtValue();
+  }
+
+  if (!llvm::isPowerOf2_64(Values[0])) {
+    S.Diag(Attr.getLoc(), diag::err_attribute_aligned_not_power_of_two)
+      << Attr.getArg(0)->getSourceRange();
+    return;
+  }
+
+  // check if the function returns a pointer
+  if (!getFunctionOrMethodResultType(D)->isAnyPointerType()) {
+    S.Diag(Attr.getLoc(), diag::warn_ns_attribute_wrong_return_type)
+    << Attr.getName() << 0 /*function*/<< 1 /*pointer*/ << D->getSourceRange();
+    return;
+  }
+
+  D->addAttr(::new (S.Context)
+             AssumeAlignedAttr(Attr.getRange(), S.Context, Values[0],
+                               Values[1],
+                               Attr.getAttributeSpellingListIndex()));
+}
+
 static void handleNonNullAttr(Sema &S, Decl *D, const AttributeList &Attr) {
   // GCC ignores the nonnull attribute on K&R style function prototypes, so we
   // ignore it as well
@@ -2823,6 +2916,140 @@ static void handleSectionAttr(Sema &S, Decl *D, const AttributeList &Attr) {
     D->addAttr(NewAttr);
 }
 
+/// \brief Check that \p Feature, optionally prefixed with "no-" to turn it
+/// off, is a feature the target can enable and disable for a function.
+static bool checkTargetFeature(Sema &S, const AttributeList &Attr,
+                               StringRef Feature) {
+  const TargetInfo &Target = S.Context.getTargetInfo();
+  StringRef Name = Feature;
+  bool Enabled = !Name.startswith("no-");
+  if (!Enabled)
+    Name = Name.substr(3);
+
+  llvm::StringMap<bool> Features;
+  Target.getDefaultFeatures(Features);
+  if (!Name.empty() && Target.setFeatureEnabled(Features, Name, Enabled))
+    return true;
+
+  S.Diag(Attr.getLoc(), diag::warn_attribute_unknown_target_feature)
+    << Feature << Attr.getName();
+  return false;
+}
+
+static void handleTargetAttr(Sema &S, Decl *D, const AttributeList &Attr) {
+  if (!checkAttributeNumArgs(S, Attr, 1))
+    return;
+
+  Expr *Arg = Attr.getArg(0)->IgnoreParenCasts();
+  StringLiteral *Str = dyn_cast<StringLiteral>(Arg);
+  if (!Str || !Str->isAscii()) {
+    S.Diag(Attr.getLoc(), diag::err_attribute_argument_type)
+      << Attr.getName() << AANT_ArgumentString;
+    return;
+  }
+
+  if (!isa<FunctionDecl>(D)) {
+    S.Diag(Attr.getLoc(), diag::warn_attribute_wrong_decl_type)
+      << Attr.getName() << ExpectedFunction;
+    return;
+  }
+
+  if (D->hasAttr<TargetClonesAttr>()) {
+    S.Diag(Attr.getLoc(), diag::err_attributes_are_not_compatible)
+      << Attr.getName() << "target_clones";
+    return;
+  }
+
+  // The string is a comma-separated list of features.
+  SmallVector<StringRef, 4> Features;
+  Str->getString().split(Features, ",");
+  for (unsigned I = 0, E = Features.size(); I != E; ++I)
+    if (!checkTargetFeature(S, Attr, Features[I].trim()))
+      return;
+
+  D->addAttr(::new (S.Context) TargetAttr(Attr.getRange(), S.Context,
+                                          Str->getString(),
+                                          Attr.getAttributeSpellingListIndex()));
+}
+
+static void handleTargetClonesAttr(Sema &S, Decl *D,
+                                   const AttributeList &Attr) {
+  if (!checkAttributeAtLeastNumArgs(S, Attr, 1))
+    return;
+
+  if (!isa<FunctionDecl>(D)) {
+    S.Diag(Attr.getLoc(), diag::warn_attribute_wrong_decl_type)
+      << Attr.getName() << ExpectedFunction;
+    return;
+  }
+
+  if (isa<CXXConstructorDecl>(D) || isa<CXXDestructorDecl>(D)) {
+    S.Diag(Attr.getLoc(), diag::err_target_clones_structor) << Attr.getName();
+    return;
+  }
+
+  if (D->hasAttr<TargetAttr>()) {
+    S.Diag(Attr.getLoc(), diag::err_attributes_are_not_compatible)
+      << Attr.getName() << "target";
+    return;
+  }
+
+  // The clones are dispatched to by an ELF indirect function whose resolver
+  // checks the features with CPUID.
+  const llvm::Triple &T = S.Context.getTargetInfo().getTriple();
+  if (!T.isOSBinFormatELF() ||
+      (T.getArch() != llvm::Triple::x86 &&
+       T.getArch() != llvm::Triple::x86_64)) {
+    S.Diag(Attr.getLoc(), diag::err_target_clones_not_supported)
+      << Attr.getName();
+    return;
+  }
+
+  // Each argument is a comma-separated list of versions, each of which is
+  // a single feature or "default".
+  SmallVector<StringRef, 4> Versions;
+  for (unsigned I = 0, E = Attr.getNumArgs(); I != E; ++I) {
+    Expr *Arg = Attr.getArg(I)->IgnoreParenCasts();
+    StringLiteral *Str = dyn_cast<StringLiteral>(Arg);
+    if (!Str || !Str->isAscii()) {
+      S.Diag(Attr.getLoc(), diag::err_attribute_argument_type)
+        << Attr.getName() << AANT_ArgumentString;
+      return;
+    }
+    Str->getString().split(Versions, ",");
+  }
+
+  bool HasDefault = false;
+  std::string Joined;
+  for (unsigned I = 0, E = Versions.size(); I != E; ++I) {
+    StringRef Version = Versions[I].trim();
+    for (unsigned J = 0; J != I; ++J) {
+      if (Versions[J].trim() == Version) {
+        S.Diag(Attr.getLoc(), diag::err_target_clones_duplicate_version)
+          << Version << Attr.getName();
+        return;
+      }
+    }
+    if (Version == "default")
+      HasDefault = true;
+    else if (!checkTargetFeature(S, Attr, Version))
+      return;
+    if (I)
+      Joined += ',';
+    Joined += Version;
+  }
+
+  if (!HasDefault) {
+    S.Diag(Attr.getLoc(), diag::err_target_clones_no_default)
+      << Attr.getName();
+    return;
+  }
+
+  D->addAttr(::new (S.Context)
+             TargetClonesAttr(Attr.getRange(), S.Context, Joined,
+                              Attr.getAttributeSpellingListIndex()));
+}
+
 
 static void handleNothrowAttr(Sema &S, Decl *D, const AttributeList &Attr) {
   // check the attribute arguments.
@@ -4709,11 +4936,14 @@ static void ProcessInheritableDeclAttr(Sema &S, Scope *scope, Decl *D,
     break;
   case AttributeList::AT_Alias:       handleAliasAttr       (S, D, Attr); break;
   case AttributeList::AT_Aligned:     handleAlignedAttr     (S, D, Attr); break;
+  case AttributeList::AT_AllocAlign:  handleAllocAlignAttr  (S, D, Attr); break;
   case AttributeList::AT_AllocSize:   handleAllocSizeAttr   (S, D, Attr); break;
   case AttributeList::AT_AlwaysInline:
     handleAlwaysInlineAttr  (S, D, Attr); break;
   case AttributeList::AT_AnalyzerNoReturn:
     handleAnalyzerNoReturnAttr  (S, D, Attr); break;
+  case AttributeList::AT_AssumeAligned:
+    handleAssumeAlignedAttr  (S, D, Attr); break;
   case AttributeList::AT_TLSModel:    handleTLSModelAttr    (S, D, Attr); break;
   case AttributeList::AT_Annotate:    handleAnnotateAttr    (S, D, Attr); break;
   case AttributeList::AT_Availability:handleAvailabilityAttr(S, D, Attr); break;
@@ -4807,6 +5037,10 @@ static void ProcessInheritableDeclAttr(Sema &S, Scope *scope, Decl *D,
       
   case AttributeList::AT_Packed:      handlePackedAttr      (S, D, Attr); break;
   case AttributeList::AT_Section:     handleSectionAttr     (S, D, Attr); break;
+  case AttributeList::AT_Target:      handleTargetAttr      (S, D, Attr); break;
+  case AttributeList::AT_TargetClones:
+    handleTargetClonesAttr(S, D, Attr);
+    break;
   case AttributeList::AT_Unavailable:
     handleAttrWithMessage<UnavailableAttr>(S, D, Attr);
     break;
@@ -512,6 +512,11 @@ bool Sema::MergeCXXFunctionDecl(FunctionDecl *New, FunctionDecl *Old,
       else
         NewParam->setDefaultArg(OldParam->getInit());
     } else if (NewParamHasDfl) {
+      // A default argument added to a constructor of a complete class can
+      // turn it into a converting constructor.
+      if (isa<CXXConstructorDecl>(New))
+        invalidateImplicitConversionCache();
+
       if (New->getDescribedFunctionTemplate()) {
         // Paragraph 4, quoted above, only applies to non-template functions.
         Diag(NewParam->getLocation(),
@@ -39,6 +39,7 @@
 #include "llvm/ADT/TinyPtrVector.h"
 #include "llvm/ADT/edit_distance.h"
 #include "llvm/Support/ErrorHandling.h"
+#include "llvm/Support/MathExtras.h"
 #include <algorithm>
 #include <iterator>
 #include <limits>
@@ -2475,7 +2476,7 @@ Sema::SpecialMemberOverloadResult *Sema::LookupSpecialMember(CXXRecordDecl *RD,
   // Now we perform lookup on the name we computed earlier and do overload
   // resolution. Lookup is only performed directly into the class since there
   // will always be a (possibly implicit) declaration to shadow any others.
-  OverloadCandidateSet OCS((SourceLocation()));
+  OverloadCandidateSet OCS(*this, SourceLocation());
   DeclContext::lookup_result R = RD->lookup(Name);
 
   assert(!R.empty() &&
@@ -3360,6 +3361,12 @@ void TypoCorrectionConsumer::FoundDecl(NamedDecl *ND, NamedDecl *Hiding,
   FoundName(Name->getName());
 }
 
+/// \brief Compute an upper bound on the edit distance of an acceptable
+/// correction for the given typo.
+static unsigned getMaxTypoEditDistance(StringRef Typo) {
+  return (Typo.size() + 2) / 3;
+}
+
 void TypoCorrectionConsumer::FoundName(StringRef Name) {
   // Use a simple length-based heuristic to determine the minimum possible
   // edit distance. If the minimum isn't good enough, bail out early.
@@ -3369,13 +3376,119 @@ void TypoCorrectionConsumer::FoundName(StringRef Name) {
 
   // Compute an upper bound on the allowable edit distance, so that the
   // edit-distance algorithm can short-circuit.
-  unsigned UpperBound = (Typo.size() + 2) / 3;
+  unsigned UpperBound = getMaxTypoEditDistance(Typo);
 
   // Compute the edit distance between the typo and the name of this
   // entity, and add the identifier to the list of results.
   addName(Name, NULL, Typo.edit_distance(Name, true, UpperBound));
 }
 
+/// \brief Compute the set of characters in the given name, with a bit for
+/// each letter, digit and '_', and one bit shared by all other characters.
+static uint64_t getCharacterMask(StringRef Name) {
+  uint64_t Mask = 0;
+  for (StringRef::iterator I = Name.begin(), E = Name.end(); I != E; ++I) {
+    unsigned char C = *I;
+    unsigned Bit;
+    if (C >= 'a' && C <= 'z')
+      Bit = C - 'a';
+    else if (C >= 'A' && C <= 'Z')
+      Bit = 26 + (C - 'A');
+    else if (C >= '0' && C <= '9')
+      Bit = 52 + (C - '0');
+    else if (C == '_')
+      Bit = 62;
+    else
+      Bit = 63;
+    Mask |= uint64_t(1) << Bit;
+  }
+  return Mask;
+}
+
+void TypoCorrectionIndex::addName(LengthBuckets &Buckets, StringRef Name) {
+  if (Name.size() >= Buckets.size())
+    Buckets.resize(Name.size() + 1);
+  Entry E = { Name, getCharacterMask(Name) };
+  Buckets[Name.size()].push_back(E);
+}
+
+void TypoCorrectionIndex::update(IdentifierTable &Idents) {
+  if (!HasLocal || LocalTable != &Idents) {
+    // Index the whole table once; from then on, the table reports the
+    // identifiers it creates.
+    if (LocalTable)
+      LocalTable->setNewIdentifierList(0);
+    Local.clear();
+    NewIdentifiers.clear();
+    for (IdentifierTable::iterator I = Idents.begin(), IEnd = Idents.end();
+         I != IEnd; ++I)
+      addName(Local, I->getKey());
+    LocalTable = &Idents;
+    LocalTable->setNewIdentifierList(&NewIdentifiers);
+    HasLocal = true;
+  } else {
+    for (unsigned I = 0, N = NewIdentifiers.size(); I != N; ++I)
+      addName(Local, NewIdentifiers[I]->getName());
+    NewIdentifiers.clear();
+  }
+
+  IdentifierInfoLookup *ExternalLookup = Idents.getExternalIdentifierLookup();
+  if (!ExternalLookup) {
+    External.clear();
+    HasExternal = false;
+    return;
+  }
+  if (HasExternal &&
+      ExternalGeneration == ExternalLookup->getIdentifiersGeneration())
+    return;
+
+  // The names returned by the external source point into its AST files,
+  // which stay loaded for the lifetime of the source.
+  External.clear();
+  OwningPtr<IdentifierIterator> Iter(ExternalLookup->getIdentifiers());
+  do {
+    StringRef Name = Iter->Next();
+    if (Name.empty())
+      break;
+
+    addName(External, Name);
+  } while (true);
+  ExternalGeneration = ExternalLookup->getIdentifiersGeneration();
+  HasExternal = true;
+}
+
+void TypoCorrectionIndex::lookup(const LengthBuckets &Buckets, StringRef Typo,
+                                 uint64_t TypoCharacters,
+                                 unsigned MaxEditDistance,
+                                 SmallVectorImpl<StringRef> &Names) {
+  unsigned MinLength = Typo.size() > MaxEditDistance
+                         ? Typo.size() - MaxEditDistance : 0;
+  unsigned MaxLength = Typo.size() + MaxEditDistance;
+  for (unsigned Length = MinLength;
+       Length <= MaxLength && Length < Buckets.size(); ++Length) {
+    const std::vector<Entry> &Bucket = Buckets[Length];
+    for (std::vector<Entry>::const_iterator I = Bucket.begin(),
+                                         IEnd = Bucket.end();
+         I != IEnd; ++I) {
+      // Every character that occurs in only one of the two names requires
+      // at least one edit of its own.
+      unsigned Missing = llvm::CountPopulation_64(TypoCharacters &
+                                                  ~I->Characters);
+      unsigned Extra = llvm::CountPopulation_64(I->Characters &
+                                                ~TypoCharacters);
+      if (std::max(Missing, Extra) <= MaxEditDistance)
+        Names.push_back(I->Name);
+    }
+  }
+}
+
+void TypoCorrectionIndex::lookup(StringRef Typo, unsigned MaxEditDistance,
+                                 SmallVectorImpl<StringRef> &Names) const {
+  uint64_t TypoCharacters = getCharacterMask(Typo);
+  lookup(Local, Typo, TypoCharacters, MaxEditDistance, Names);
+  lookup(External, Typo, TypoCharacters, MaxEditDistance, Names);
+}
+
 void TypoCorrectionConsumer::addKeywordResult(StringRef Keyword) {
   // Compute the edit distance between the typo and this keyword,
   // and add the keyword to the list of results.
@@ -3896,6 +4009,17 @@ TypoCorrection Sema::CorrectTypo(const DeclarationNameInfo &TypoName,
 
   TypoCorrectionConsumer Consumer(*this, Typo);
 
+  // Provide a stop gap for files that are just seriously broken.  Trying
+  // to correct all typos can turn into a HUGE performance penalty, causing
+  // some files to take minutes to get rejected by the parser.
+  const DiagnosticOptions &DiagOpts = Diags.getDiagnosticOptions();
+  unsigned Limit = DiagOpts.SpellCheckingLimit;
+
+  // Bound the number of name lookups performed to validate candidates, so
+  // that a single typo can't take too long to correct.
+  unsigned CandidateLimit = DiagOpts.SpellCheckingCandidateLimit;
+  unsigned NumCandidateLookups = 0;
+
   // If a callback object considers an empty typo correction candidate to be
   // viable, assume it does not do any actual validation of the candidates.
   TypoCorrection EmptyCorrection;
@@ -3919,10 +4043,7 @@ TypoCorrection Sema::CorrectTypo(const DeclarationNameInfo &TypoName,
     if (!QualifiedDC)
       return TypoCorrection();
 
-    // Provide a stop gap for files that are just seriously broken.  Trying
-    // to correct all typos can turn into a HUGE performance penalty, causing
-    // some files to take minutes to get rejected by the parser.
-    if (TyposCorrected + UnqualifiedTyposCorrected.size() >= 20)
+    if (Limit && TyposCorrected + UnqualifiedTyposCorrected.size() >= Limit)
       return TypoCorrection();
     ++TyposCorrected;
 
@@ -3945,13 +4066,9 @@ TypoCorrection Sema::CorrectTypo(const DeclarationNameInfo &TypoName,
           return TypoCorrection();
       }
     }
-    if (Cached == UnqualifiedTyposCorrected.end()) {
-      // Provide a stop gap for files that are just seriously broken.  Trying
-      // to correct all typos can turn into a HUGE performance penalty, causing
-      // some files to take minutes to get rejected by the parser.
-      if (TyposCorrected + UnqualifiedTyposCorrected.size() >= 20)
-        return TypoCorrection();
-    }
+    if (Cached == UnqualifiedTyposCorrected.end() && Limit &&
+        TyposCorrected + UnqualifiedTyposCorrected.size() >= Limit)
+      return TypoCorrection();
   }
 
   // Determine whether we are going to search in the various namespaces for
@@ -3965,26 +4082,17 @@ TypoCorrection Sema::CorrectTypo(const DeclarationNameInfo &TypoName,
   
   if (IsUnqualifiedLookup || SearchNamespaces) {
     // For unqualified lookup, look through all of the names that we have
-    // seen in this translation unit.
-    // FIXME: Re-add the ability to skip very unlikely potential corrections.
-    for (IdentifierTable::iterator I = Context.Idents.begin(),
-                                IEnd = Context.Idents.end();
-         I != IEnd; ++I)
-      Consumer.FoundName(I->getKey());
-
-    // Walk through identifiers in external identifier sources.
-    // FIXME: Re-add the ability to skip very unlikely potential corrections.
-    if (IdentifierInfoLookup *External
-                            = Context.Idents.getExternalIdentifierLookup()) {
-      OwningPtr<IdentifierIterator> Iter(External->getIdentifiers());
-      do {
-        StringRef Name = Iter->Next();
-        if (Name.empty())
-          break;
-
-        Consumer.FoundName(Name);
-      } while (true);
-    }
+    // seen in this translation unit, including those in external identifier
+    // sources, skipping the ones the index rules out.
+    TypoIndex.update(Context.Idents);
+    SmallVector<StringRef, 32> Candidates;
+    TypoIndex.lookup(Typo->getName(), getMaxTypoEditDistance(Typo->getName()),
+                     Candidates);
+    for (unsigned I = 0, N = Candidates.size(); I != N; ++I)
+      Consumer.FoundName(Candidates[I]);
+
+    // The consumer interned the names it kept, all of which are indexed.
+    TypoIndex.noteIndexedIdentifiers(Context.Idents);
   }
 
   AddKeywordsToConsumer(*this, Consumer, S, CCC, SS && SS->isNotEmpty());
@@ -4079,6 +4187,8 @@ TypoCorrection Sema::CorrectTypo(const DeclarationNameInfo &TypoName,
       DeclContext *TempMemberContext = MemberContext;
       CXXScopeSpec *TempSS = SS;
 retry_lookup:
+      if (CandidateLimit && ++NumCandidateLookups > CandidateLimit)
+        return TypoCorrection();
       LookupPotentialTypoResult(*this, TmpRes, Name, S, TempSS,
                                 TempMemberContext, EnteringContext,
                                 CCC.IsObjCIvarLookup);
@@ -4161,9 +4271,20 @@ retry_lookup:
              NI != NIEnd; ++NI) {
           DeclContext *Ctx = NI->DeclCtx;
 
-          // FIXME: Stop searching once the namespaces are too far away to create
+          // Stop searching once the namespaces are too far away to create
           // acceptable corrections for this identifier (since the namespaces
           // are sorted in ascending order by edit distance).
+          if (!AllowOnlyNNSChanges) {
+            TypoCorrection TC(*QRI);
+            TC.setQualifierDistance(NI->EditDistance);
+            TC.setCallbackDistance(0);
+            unsigned QualifiedED = TC.getEditDistance(true);
+            if (QualifiedED > 0 && Typo->getName().size() / QualifiedED < 3)
+              break;
+          }
+
+          if (CandidateLimit && ++NumCandidateLookups > CandidateLimit)
+            return TypoCorrection();
 
           TmpRes.clear();
           TmpRes.setLookupName(QRI->getCorrectionAsIdentifierInfo());
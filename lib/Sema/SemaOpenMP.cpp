@@ -209,6 +209,9 @@ StmtResult Sema::ActOnOpenMPExecutableDirective(OpenMPDirectiveKind Kind,
   case OMPD_parallel:
     Res = ActOnOpenMPParallelDirective(Clauses, AStmt, StartLoc, EndLoc);
     break;
+  case OMPD_parallel_for:
+    Res = ActOnOpenMPParallelForDirective(Clauses, AStmt, StartLoc, EndLoc);
+    break;
   case OMPD_threadprivate:
   case OMPD_task:
     llvm_unreachable("OpenMP Directive is not allowed");
@@ -229,6 +232,63 @@ StmtResult Sema::ActOnOpenMPParallelDirective(ArrayRef<OMPClause *> Clauses,
                                             Clauses, AStmt));
 }
 
+/// \brief Check that \p For is in the canonical form that OpenMP requires of
+/// loops associated with the directive \p DKind, and diagnose it if not.
+///
+/// \returns true if an error was diagnosed.
+static bool CheckOpenMPCanonicalLoop(Sema &S, OpenMPDirectiveKind DKind,
+                                     Stmt *AStmt) {
+  if (!isa<ForStmt>(AStmt)) {
+    S.Diag(AStmt->getLocStart(), diag::err_omp_not_for)
+      << getOpenMPDirectiveName(DKind);
+    return true;
+  }
+  ForStmt *For = cast<ForStmt>(AStmt);
+
+  // The checks are repeated when a template is instantiated.
+  if (S.CurContext->isDependentContext())
+    return false;
+
+  OMPCanonicalLoop Loop;
+  switch (Loop.analyze(For)) {
+  case OMPCanonicalLoop::Canonical:
+    return false;
+  case OMPCanonicalLoop::BadInit:
+    S.Diag(For->getInit() ? For->getInit()->getLocStart() :
+                            For->getForLoc(),
+           diag::err_omp_loop_not_canonical_init);
+    return true;
+  case OMPCanonicalLoop::BadVarType:
+    S.Diag(For->getInit()->getLocStart(), diag::err_omp_loop_variable_type)
+      << Loop.Var;
+    return true;
+  case OMPCanonicalLoop::BadTest:
+    S.Diag(For->getCond() ? For->getCond()->getExprLoc() : For->getForLoc(),
+           diag::err_omp_loop_not_canonical_cond) << Loop.Var;
+    return true;
+  case OMPCanonicalLoop::BadIncr:
+    S.Diag(For->getInc() ? For->getInc()->getExprLoc() : For->getForLoc(),
+           diag::err_omp_loop_not_canonical_incr) << Loop.Var;
+    return true;
+  }
+  llvm_unreachable("Invalid canonical loop form");
+}
+
+StmtResult Sema::ActOnOpenMPParallelForDirective(ArrayRef<OMPClause *> Clauses,
+                                                 Stmt *AStmt,
+                                                 SourceLocation StartLoc,
+                                                 SourceLocation EndLoc) {
+  assert(isa<CapturedStmt>(AStmt) && "Captured statement expected");
+  if (CheckOpenMPCanonicalLoop(*this, OMPD_parallel_for,
+                               cast<CapturedStmt>(AStmt)->getCapturedStmt()))
+    return StmtError();
+
+  getCurFunction()->setHasBranchProtectedScope();
+
+  return Owned(OMPParallelForDirective::Create(Context, StartLoc, EndLoc,
+                                               Clauses, AStmt));
+}
+
 OMPClause *Sema::ActOnOpenMPSimpleClause(OpenMPClauseKind Kind,
                                          unsigned Argument,
                                          SourceLocation ArgumentLoc,
@@ -243,6 +303,7 @@ OMPClause *Sema::ActOnOpenMPSimpleClause(OpenMPClauseKind Kind,
                              ArgumentLoc, StartLoc, LParenLoc, EndLoc);
     break;
   case OMPC_private:
+  case OMPC_schedule:
   case OMPC_threadprivate:
   case OMPC_unknown:
   case NUM_OPENMP_CLAUSES:
@@ -251,38 +312,86 @@ OMPClause *Sema::ActOnOpenMPSimpleClause(OpenMPClauseKind Kind,
   return Res;
 }
 
+/// \brief Returns the values of the simple clause \p K, quoted and separated
+/// like "'a', 'b' or 'c'", for diagnostics.
+static std::string getListOfPossibleValues(OpenMPClauseKind K,
+                                           unsigned NumValues) {
+  std::string Values;
+  for (unsigned i = 1; i < NumValues; ++i) {
+    Values += "'";
+    Values += getOpenMPSimpleClauseTypeName(K, i);
+    Values += "'";
+    if (i == NumValues - 2)
+      Values += " or ";
+    else if (i != NumValues - 1)
+      Values += ", ";
+  }
+  return Values;
+}
+
 OMPClause *Sema::ActOnOpenMPDefaultClause(OpenMPDefaultClauseKind Kind,
                                           SourceLocation KindKwLoc,
                                           SourceLocation StartLoc,
                                           SourceLocation LParenLoc,
                                           SourceLocation EndLoc) {
   if (Kind == OMPC_DEFAULT_unknown) {
-    std::string Values;
-    std::string Sep(NUM_OPENMP_DEFAULT_KINDS > 1 ? ", " : "");
-    for (unsigned i = OMPC_DEFAULT_unknown + 1;
-         i < NUM_OPENMP_DEFAULT_KINDS; ++i) {
-      Values += "'";
-      Values += getOpenMPSimpleClauseTypeName(OMPC_default, i);
-      Values += "'";
-      switch (i) {
-      case NUM_OPENMP_DEFAULT_KINDS - 2:
-        Values += " or ";
-        break;
-      case NUM_OPENMP_DEFAULT_KINDS - 1:
-        break;
-      default:
-        Values += Sep;
-        break;
-      }
-    }
     Diag(KindKwLoc, diag::err_omp_unexpected_clause_value)
-      << Values << getOpenMPClauseName(OMPC_default);
+      << getListOfPossibleValues(OMPC_default, NUM_OPENMP_DEFAULT_KINDS)
+      << getOpenMPClauseName(OMPC_default);
     return 0;
   }
   return new (Context) OMPDefaultClause(Kind, KindKwLoc, StartLoc, LParenLoc,
                                         EndLoc);
 }
 
+OMPClause *Sema::ActOnOpenMPScheduleClause(OpenMPScheduleClauseKind Kind,
+                                           SourceLocation KindKwLoc,
+                                           Expr *ChunkSize,
+                                           SourceLocation StartLoc,
+                                           SourceLocation LParenLoc,
+                                           SourceLocation EndLoc) {
+  if (Kind == OMPC_SCHEDULE_unknown) {
+    Diag(KindKwLoc, diag::err_omp_unexpected_clause_value)
+      << getListOfPossibleValues(OMPC_schedule, NUM_OPENMP_SCHEDULE_KINDS)
+      << getOpenMPClauseName(OMPC_schedule);
+    return 0;
+  }
+  if (ChunkSize) {
+    // OpenMP [2.5.1, Loop Construct, Description]
+    //  When schedule(runtime) or schedule(auto) is specified, chunk_size must
+    //  not be specified.
+    if (Kind == OMPC_SCHEDULE_runtime || Kind == OMPC_SCHEDULE_auto) {
+      Diag(ChunkSize->getExprLoc(), diag::err_omp_schedule_kind_chunk)
+        << getOpenMPSimpleClauseTypeName(OMPC_schedule, Kind)
+        << ChunkSize->getSourceRange();
+      return 0;
+    }
+    // OpenMP [2.5.1, Loop Construct, Restrictions]
+    //  The chunk_size expression must evaluate to the same value for all
+    //  threads in the team, and it must be a positive integer.
+    if (!ChunkSize->isTypeDependent() && !ChunkSize->isValueDependent()) {
+      if (!ChunkSize->getType()->isIntegralOrUnscopedEnumerationType()) {
+        Diag(ChunkSize->getExprLoc(), diag::err_omp_schedule_chunk_size)
+          << 0 << ChunkSize->getSourceRange();
+        return 0;
+      }
+      ExprResult Res = DefaultLvalueConversion(ChunkSize);
+      if (Res.isInvalid())
+        return 0;
+      ChunkSize = Res.take();
+      llvm::APSInt Value;
+      if (ChunkSize->isIntegerConstantExpr(Value, Context) &&
+          !Value.isStrictlyPositive()) {
+        Diag(ChunkSize->getExprLoc(), diag::err_omp_schedule_chunk_size)
+          << 1 << ChunkSize->getSourceRange();
+        return 0;
+      }
+    }
+  }
+  return new (Context) OMPScheduleClause(Kind, KindKwLoc, ChunkSize, StartLoc,
+                                         LParenLoc, EndLoc);
+}
+
 OMPClause *Sema::ActOnOpenMPVarListClause(OpenMPClauseKind Kind,
                                           ArrayRef<Expr *> VarList,
                                           SourceLocation StartLoc,
@@ -294,6 +403,7 @@ OMPClause *Sema::ActOnOpenMPVarListClause(OpenMPClauseKind Kind,
     Res = ActOnOpenMPPrivateClause(VarList, StartLoc, LParenLoc, EndLoc);
     break;
   case OMPC_default:
+  case OMPC_schedule:
   case OMPC_threadprivate:
   case OMPC_unknown:
   case NUM_OPENMP_CLAUSES:
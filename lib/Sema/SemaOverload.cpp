@@ -532,6 +532,12 @@ void ImplicitConversionSequence::DebugPrint() const {
   OS << "\n";
 }
 
+void ImplicitConversionCache::PrintStats() const {
+  llvm::errs() << "\n*** Implicit Conversion Cache Stats:\n";
+  llvm::errs() << Conversions.size() << " conversion sequences cached.\n"
+               << "  " << NumHits << " hits, " << NumMisses << " misses.\n";
+}
+
 void AmbiguousConversionSequence::construct() {
   new (&conversions()) ConversionSet();
 }
@@ -563,7 +569,7 @@ namespace {
 
 /// \brief Convert from Sema's representation of template deduction information
 /// to the form used in overload-candidate information.
-DeductionFailureInfo MakeDeductionFailureInfo(ASTContext &Context,
+DeductionFailureInfo MakeDeductionFailureInfo(Sema &S,
                                               Sema::TemplateDeductionResult TDK,
                                               TemplateDeductionInfo &Info) {
   DeductionFailureInfo Result;
@@ -584,8 +590,8 @@ DeductionFailureInfo MakeDeductionFailureInfo(ASTContext &Context,
     break;
 
   case Sema::TDK_NonDeducedMismatch: {
-    // FIXME: Should allocate from normal heap so that we can free this later.
-    DFIArguments *Saved = new (Context) DFIArguments;
+    DFIArguments *Saved
+      = new (S.CandidateArena->Allocate<DFIArguments>()) DFIArguments;
     Saved->FirstArg = Info.FirstArg;
     Saved->SecondArg = Info.SecondArg;
     Result.Data = Saved;
@@ -594,8 +600,9 @@ DeductionFailureInfo MakeDeductionFailureInfo(ASTContext &Context,
 
   case Sema::TDK_Inconsistent:
   case Sema::TDK_Underqualified: {
-    // FIXME: Should allocate from normal heap so that we can free this later.
-    DFIParamWithArguments *Saved = new (Context) DFIParamWithArguments;
+    DFIParamWithArguments *Saved
+      = new (S.CandidateArena->Allocate<DFIParamWithArguments>())
+          DFIParamWithArguments;
     Saved->Param = Info.Param;
     Saved->FirstArg = Info.FirstArg;
     Saved->SecondArg = Info.SecondArg;
@@ -639,7 +646,7 @@ void DeductionFailureInfo::Destroy() {
   case Sema::TDK_Inconsistent:
   case Sema::TDK_Underqualified:
   case Sema::TDK_NonDeducedMismatch:
-    // FIXME: Destroy the data?
+    // The data lives in the overload candidate arena.
     Data = 0;
     break;
 
@@ -778,19 +785,63 @@ Expr *DeductionFailureInfo::getExpr() {
   return 0;
 }
 
+void OverloadCandidateArena::exitSet() {
+  assert(NumActiveSets && "Candidate set left the arena twice");
+  if (--NumActiveSets)
+    return;
+
+  // Nothing refers to the storage any more; keep the first slab around for
+  // the next overload resolution.
+  MaxSlabs = std::max(MaxSlabs, Allocator.GetNumSlabs());
+  MaxMemory = std::max(MaxMemory, Allocator.getTotalMemory());
+  Allocator.Reset();
+  ++NumResets;
+}
+
+void OverloadCandidateArena::PrintStats() const {
+  llvm::errs() << "\n*** Overload Candidate Arena Stats:\n";
+  llvm::errs() << NumSets << " candidate sets, " << NumAllocations
+               << " allocations, " << NumResets << " resets.\n"
+               << "  At most " << MaxMemory << " bytes in " << MaxSlabs
+               << " slabs.\n";
+}
+
+OverloadCandidateSet::OverloadCandidateSet(Sema &S, SourceLocation Loc)
+  : Arena(*S.CandidateArena), Candidates(0), NumCandidates(0),
+    CandidateCapacity(0), Loc(Loc) {
+  Arena.enterSet();
+}
+
+OverloadCandidateSet::~OverloadCandidateSet() {
+  destroyCandidates();
+  Arena.exitSet();
+}
+
+void OverloadCandidateSet::growCandidates() {
+  unsigned NewCapacity = CandidateCapacity ? 2 * CandidateCapacity : 16;
+  OverloadCandidate *NewCandidates
+    = Arena.Allocate<OverloadCandidate>(NewCapacity);
+  for (unsigned I = 0; I != NumCandidates; ++I) {
+    new (&NewCandidates[I]) OverloadCandidate(Candidates[I]);
+    Candidates[I].~OverloadCandidate();
+  }
+  Candidates = NewCandidates;
+  CandidateCapacity = NewCapacity;
+}
+
 void OverloadCandidateSet::destroyCandidates() {
   for (iterator i = begin(), e = end(); i != e; ++i) {
     for (unsigned ii = 0, ie = i->NumConversions; ii != ie; ++ii)
       i->Conversions[ii].~ImplicitConversionSequence();
     if (!i->Viable && i->FailureKind == ovl_fail_bad_deduction)
       i->DeductionFailure.Destroy();
+    i->~OverloadCandidate();
   }
 }
 
 void OverloadCandidateSet::clear() {
   destroyCandidates();
-  NumInlineSequences = 0;
-  Candidates.clear();
+  NumCandidates = 0;
   Functions.clear();
 }
 
@@ -1106,7 +1157,7 @@ TryUserDefinedConversion(Sema &S, Expr *From, QualType ToType,
   }
 
   // Attempt user-defined conversion.
-  OverloadCandidateSet Conversions(From->getExprLoc());
+  OverloadCandidateSet Conversions(S, From->getExprLoc());
   OverloadingResult UserDefResult
     = IsUserDefinedConversion(S, From, ToType, ICS.UserDefined, Conversions,
                               AllowExplicit);
@@ -1193,12 +1244,12 @@ TryUserDefinedConversion(Sema &S, Expr *From, QualType ToType,
 /// writeback conversion, which allows __autoreleasing id* parameters to
 /// be initialized with __strong id* or __weak id* arguments.
 static ImplicitConversionSequence
-TryImplicitConversion(Sema &S, Expr *From, QualType ToType,
-                      bool SuppressUserConversions,
-                      bool AllowExplicit,
-                      bool InOverloadResolution,
-                      bool CStyle,
-                      bool AllowObjCWritebackConversion) {
+ComputeImplicitConversion(Sema &S, Expr *From, QualType ToType,
+                          bool SuppressUserConversions,
+                          bool AllowExplicit,
+                          bool InOverloadResolution,
+                          bool CStyle,
+                          bool AllowObjCWritebackConversion) {
   ImplicitConversionSequence ICS;
   if (IsStandardConversion(S, From, ToType, InOverloadResolution,
                            ICS.Standard, CStyle, AllowObjCWritebackConversion)){
@@ -1245,6 +1296,130 @@ TryImplicitConversion(Sema &S, Expr *From, QualType ToType,
                                   AllowObjCWritebackConversion);
 }
 
+/// \brief Determine whether the implicit conversion sequence from the given
+/// expression to the given type depends only on the type and value kind of
+/// the expression (and whether it is a null pointer constant), rather than
+/// on the expression itself or on the context of the conversion.
+static bool isContextIndependentConversion(Sema &S, Expr *From,
+                                           QualType ToType) {
+  const LangOptions &LangOpts = S.getLangOpts();
+  if (!LangOpts.CPlusPlus || LangOpts.ObjC1 || LangOpts.OpenCL ||
+      LangOpts.CUDA)
+    return false;
+
+  if (From->isTypeDependent() || ToType->isDependentType() ||
+      From->getType()->isPlaceholderType())
+    return false;
+
+  // Whether a value-dependent expression is a null pointer constant depends
+  // on whether we are in overload resolution.
+  if (From->isValueDependent())
+    return false;
+
+  // Bit-fields have their own promotion rules, and string literals can be
+  // converted to non-const 'char *'.
+  if (From->getObjectKind() != OK_Ordinary || From->getSourceBitField())
+    return false;
+  Expr *Inner = From->IgnoreParens();
+  if (isa<StringLiteral>(Inner) || isa<InitListExpr>(Inner))
+    return false;
+
+  // Unavailable functions are only rejected outside of unavailable
+  // contexts.
+  if (cast<Decl>(S.CurContext)->isUnavailable())
+    return false;
+
+  return true;
+}
+
+/// \brief Determine whether the given type is, or points to, a class whose
+/// definition isn't complete yet. Conversions involving such a class may
+/// change once it has been defined.
+static bool involvesIncompleteClass(QualType T) {
+  while (true) {
+    if (const ReferenceType *Ref = T->getAs<ReferenceType>())
+      T = Ref->getPointeeType();
+    else if (const PointerType *Ptr = T->getAs<PointerType>())
+      T = Ptr->getPointeeType();
+    else if (const MemberPointerType *MemPtr = T->getAs<MemberPointerType>()) {
+      if (involvesIncompleteClass(QualType(MemPtr->getClass(), 0)))
+        return true;
+      T = MemPtr->getPointeeType();
+    } else if (const ArrayType *Array = T->getAsArrayTypeUnsafe())
+      T = Array->getElementType();
+    else
+      break;
+  }
+
+  if (const RecordType *Record = T->getAs<RecordType>())
+    return !Record->getDecl()->isCompleteDefinition();
+  return false;
+}
+
+/// TryImplicitConversion - Determine the implicit conversion sequence for
+/// converting From to ToType, as described by ComputeImplicitConversion.
+/// Conversions that don't depend on the particular expression are looked up
+/// in, and recorded in, the Sema's implicit conversion cache.
+static ImplicitConversionSequence
+TryImplicitConversion(Sema &S, Expr *From, QualType ToType,
+                      bool SuppressUserConversions,
+                      bool AllowExplicit,
+                      bool InOverloadResolution,
+                      bool CStyle,
+                      bool AllowObjCWritebackConversion) {
+  if (!isContextIndependentConversion(S, From, ToType))
+    return ComputeImplicitConversion(S, From, ToType, SuppressUserConversions,
+                                     AllowExplicit, InOverloadResolution,
+                                     CStyle, AllowObjCWritebackConversion);
+
+  // A null pointer constant can be converted to pointer types, either
+  // directly or through a converting constructor.
+  QualType FromType = From->getType();
+  bool IsNullPointerConstant
+    = (FromType->isIntegralOrUnscopedEnumerationType() ||
+       FromType->isNullPtrType()) &&
+      !ToType->isArithmeticType() &&
+      From->isNullPointerConstant(S.Context,
+                                  Expr::NPC_ValueDependentIsNotNull);
+
+  unsigned Flags = From->getValueKind();
+  Flags = (Flags << 1) | SuppressUserConversions;
+  Flags = (Flags << 1) | AllowExplicit;
+  Flags = (Flags << 1) | InOverloadResolution;
+  Flags = (Flags << 1) | CStyle;
+  Flags = (Flags << 1) | AllowObjCWritebackConversion;
+  Flags = (Flags << 1) | IsNullPointerConstant;
+  ImplicitConversionCache::Key Key(
+      std::make_pair(FromType.getAsOpaquePtr(), ToType.getAsOpaquePtr()),
+      Flags);
+
+  if (!S.ImplicitConversions)
+    S.ImplicitConversions.reset(new ImplicitConversionCache());
+  if (const ImplicitConversionSequence *Known
+        = S.ImplicitConversions->lookup(Key)) {
+    ImplicitConversionSequence ICS = *Known;
+    if (ICS.isBad())
+      ICS.Bad.setFromExpr(From);
+    return ICS;
+  }
+
+  ImplicitConversionSequence ICS
+    = ComputeImplicitConversion(S, From, ToType, SuppressUserConversions,
+                                AllowExplicit, InOverloadResolution, CStyle,
+                                AllowObjCWritebackConversion);
+
+  // Computing the conversion may have completed the classes involved (by
+  // instantiating them); only record it once none of them can change.
+  if (!involvesIncompleteClass(FromType) && !involvesIncompleteClass(ToType))
+    S.ImplicitConversions->insert(Key, ICS);
+  return ICS;
+}
+
+void Sema::invalidateImplicitConversionCache() {
+  if (ImplicitConversions)
+    ImplicitConversions->clear();
+}
+
 ImplicitConversionSequence
 Sema::TryImplicitConversion(Expr *From, QualType ToType,
                             bool SuppressUserConversions,
@@ -3195,7 +3370,7 @@ IsUserDefinedConversion(Sema &S, Expr *From, QualType ToType,
 bool
 Sema::DiagnoseMultipleUserDefinedConversion(Expr *From, QualType ToType) {
   ImplicitConversionSequence ICS;
-  OverloadCandidateSet CandidateSet(From->getExprLoc());
+  OverloadCandidateSet CandidateSet(*this, From->getExprLoc());
   OverloadingResult OvResult =
     IsUserDefinedConversion(*this, From, ToType, ICS.UserDefined,
                             CandidateSet, false);
@@ -3994,7 +4169,7 @@ FindConversionForRefInit(Sema &S, ImplicitConversionSequence &ICS,
   CXXRecordDecl *T2RecordDecl
     = dyn_cast<CXXRecordDecl>(T2->getAs<RecordType>()->getDecl());
 
-  OverloadCandidateSet CandidateSet(DeclLoc);
+  OverloadCandidateSet CandidateSet(S, DeclLoc);
   std::pair<CXXRecordDecl::conversion_iterator,
             CXXRecordDecl::conversion_iterator>
     Conversions = T2RecordDecl->getVisibleConversionFunctions();
@@ -5342,7 +5517,7 @@ ExprResult Sema::PerformContextualImplicitConversion(
     // If one unique T is found:
     // First, build a candidate set from the previously recorded
     // potentially viable conversions.
-    OverloadCandidateSet CandidateSet(Loc);
+    OverloadCandidateSet CandidateSet(*this, Loc);
     collectViableConversionCandidates(*this, From, ToType, ViableConversions,
                                       CandidateSet);
 
@@ -5740,7 +5915,7 @@ Sema::AddMethodTemplateCandidate(FunctionTemplateDecl *MethodTmpl,
     Candidate.IsSurrogate = false;
     Candidate.IgnoreObjectArgument = false;
     Candidate.ExplicitCallArguments = Args.size();
-    Candidate.DeductionFailure = MakeDeductionFailureInfo(Context, Result,
+    Candidate.DeductionFailure = MakeDeductionFailureInfo(*this, Result,
                                                           Info);
     return;
   }
@@ -5790,7 +5965,7 @@ Sema::AddTemplateOverloadCandidate(FunctionTemplateDecl *FunctionTemplate,
     Candidate.IsSurrogate = false;
     Candidate.IgnoreObjectArgument = false;
     Candidate.ExplicitCallArguments = Args.size();
-    Candidate.DeductionFailure = MakeDeductionFailureInfo(Context, Result,
+    Candidate.DeductionFailure = MakeDeductionFailureInfo(*this, Result,
                                                           Info);
     return;
   }
@@ -5982,7 +6157,7 @@ Sema::AddTemplateConversionCandidate(FunctionTemplateDecl *FunctionTemplate,
     Candidate.IsSurrogate = false;
     Candidate.IgnoreObjectArgument = false;
     Candidate.ExplicitCallArguments = 1;
-    Candidate.DeductionFailure = MakeDeductionFailureInfo(Context, Result,
+    Candidate.DeductionFailure = MakeDeductionFailureInfo(*this, Result,
                                                           Info);
     return;
   }
@@ -6166,6 +6341,7 @@ void Sema::AddBuiltinCandidate(QualType ResultTy, QualType *ParamTys,
   EnterExpressionEvaluationContext Unevaluated(*this, Sema::Unevaluated);
 
   // Add this candidate
+  ++NumBuiltinCandidates;
   OverloadCandidate &Candidate = CandidateSet.addCandidate(Args.size());
   Candidate.FoundDecl = DeclAccessPair::make(0, AS_none);
   Candidate.Function = 0;
@@ -6208,6 +6384,7 @@ void Sema::AddBuiltinCandidate(QualType ResultTy, QualType *ParamTys,
     if (Candidate.Conversions[ArgIdx].isBad()) {
       Candidate.Viable = false;
       Candidate.FailureKind = ovl_fail_bad_conversion;
+      ++NumNonViableBuiltinCandidates;
       break;
     }
   }
@@ -7653,6 +7830,27 @@ public:
 
 } // end anonymous namespace
 
+/// \brief Determine whether \p T is a class type with no conversion functions,
+/// which therefore cannot be converted to any non-class type.
+static bool isClassWithoutConversionFunctions(QualType T) {
+  const RecordType *RT = T->getAs<RecordType>();
+  if (!RT)
+    return false;
+  CXXRecordDecl *ClassDecl = dyn_cast<CXXRecordDecl>(RT->getDecl());
+  if (!ClassDecl)
+    return false;
+
+  // An incomplete class has no conversion functions to use.
+  ClassDecl = ClassDecl->getDefinition();
+  if (!ClassDecl)
+    return true;
+
+  std::pair<CXXRecordDecl::conversion_iterator,
+            CXXRecordDecl::conversion_iterator>
+    Conversions = ClassDecl->getVisibleConversionFunctions();
+  return Conversions.first == Conversions.second;
+}
+
 /// AddBuiltinOperatorCandidates - Add the appropriate built-in
 /// operator overloads to the candidate set (C++ [over.built]), based
 /// on the operator @p Op and the arguments given. For example, if the
@@ -7667,6 +7865,7 @@ Sema::AddBuiltinOperatorCandidates(OverloadedOperatorKind Op,
   // if the operator we're looking at has built-in operator candidates
   // that make use of these types. Also record whether we encounter non-record
   // candidate types or either arithmetic or enumeral candidate types.
+  ++NumBuiltinOperatorSets;
   Qualifiers VisibleTypeConversionsQuals;
   VisibleTypeConversionsQuals.addConst();
   for (unsigned ArgIdx = 0, N = Args.size(); ArgIdx != N; ++ArgIdx)
@@ -7684,6 +7883,16 @@ Sema::AddBuiltinOperatorCandidates(OverloadedOperatorKind Op,
                                                   Op == OO_AmpAmp ||
                                                   Op == OO_PipePipe),
                                                  VisibleTypeConversionsQuals);
+
+    // Every parameter of a built-in candidate has non-class type, and a class
+    // can only be converted to one by a conversion function. If this operand
+    // has a class type without any, none of the candidates would be viable,
+    // so don't bother generating them.
+    if (isClassWithoutConversionFunctions(Args[ArgIdx]->getType())) {
+      ++NumBuiltinOperatorSetsSkipped;
+      return;
+    }
+
     HasNonRecordCandidateType = HasNonRecordCandidateType ||
         CandidateTypes[ArgIdx].hasNonRecordTypes();
     HasArithmeticOrEnumeralCandidateType =
@@ -7697,8 +7906,10 @@ Sema::AddBuiltinOperatorCandidates(OverloadedOperatorKind Op,
   // We can't exit early for !, ||, or &&, since there we have always have
   // 'bool' overloads.
   if (!HasNonRecordCandidateType &&
-      !(Op == OO_Exclaim || Op == OO_AmpAmp || Op == OO_PipePipe))
+      !(Op == OO_Exclaim || Op == OO_AmpAmp || Op == OO_PipePipe)) {
+    ++NumBuiltinOperatorSetsSkipped;
     return;
+  }
 
   // Setup an object to manage the common state for building overloads.
   BuiltinOperatorOverloadBuilder OpBuilder(*this, Args,
@@ -9188,6 +9399,16 @@ void TemplateSpecCandidate::NoteDeductionFailure(Sema &S) {
                        DeductionFailure, /*NumArgs=*/0);
 }
 
+TemplateSpecCandidateSet::TemplateSpecCandidateSet(Sema &S, SourceLocation Loc)
+  : Arena(*S.CandidateArena), Loc(Loc) {
+  Arena.enterSet();
+}
+
+TemplateSpecCandidateSet::~TemplateSpecCandidateSet() {
+  destroyCandidates();
+  Arena.exitSet();
+}
+
 void TemplateSpecCandidateSet::destroyCandidates() {
   for (iterator i = begin(), e = end(); i != e; ++i) {
     i->DeductionFailure.Destroy();
@@ -9301,7 +9522,7 @@ public:
         StaticMemberFunctionFromBoundPointer(false),
         OvlExprInfo(OverloadExpr::find(SourceExpr)),
         OvlExpr(OvlExprInfo.Expression),
-        FailedCandidates(OvlExpr->getNameLoc()) {
+        FailedCandidates(S, OvlExpr->getNameLoc()) {
     ExtractUnqualifiedFunctionTypeFromTargetType();
 
     if (TargetFunctionType->isFunctionType()) {
@@ -9389,7 +9610,7 @@ private:
       // Make a note of the failed deduction for diagnostics.
       FailedCandidates.addCandidate()
           .set(FunctionTemplate->getTemplatedDecl(),
-               MakeDeductionFailureInfo(Context, Result, Info));
+               MakeDeductionFailureInfo(S, Result, Info));
       (void)Result;
       return false;
     } 
@@ -9662,7 +9883,7 @@ Sema::ResolveSingleFunctionTemplateSpecialization(OverloadExpr *ovl,
 
   TemplateArgumentListInfo ExplicitTemplateArgs;
   ovl->getExplicitTemplateArgs().copyInto(ExplicitTemplateArgs);
-  TemplateSpecCandidateSet FailedCandidates(ovl->getNameLoc());
+  TemplateSpecCandidateSet FailedCandidates(*this, ovl->getNameLoc());
 
   // Look through all of the overloaded functions, searching for one
   // whose type matches exactly.
@@ -9694,7 +9915,7 @@ Sema::ResolveSingleFunctionTemplateSpecialization(OverloadExpr *ovl,
       // TODO: Actually use the failed-deduction info?
       FailedCandidates.addCandidate()
           .set(FunctionTemplate->getTemplatedDecl(),
-               MakeDeductionFailureInfo(Context, Result, Info));
+               MakeDeductionFailureInfo(*this, Result, Info));
       (void)Result;
       continue;
     }
@@ -9941,7 +10162,7 @@ DiagnoseTwoPhaseLookup(Sema &SemaRef, SourceLocation FnLoc,
         return false;
       }
 
-      OverloadCandidateSet Candidates(FnLoc);
+      OverloadCandidateSet Candidates(SemaRef, FnLoc);
       for (LookupResult::iterator I = R.begin(), E = R.end(); I != E; ++I)
         AddOverloadedCallCandidate(SemaRef, I.getPair(),
                                    ExplicitTemplateArgs, Args,
@@ -10262,7 +10483,7 @@ ExprResult Sema::BuildOverloadedCallExpr(Scope *S, Expr *Fn,
                                          SourceLocation RParenLoc,
                                          Expr *ExecConfig,
                                          bool AllowTypoCorrection) {
-  OverloadCandidateSet CandidateSet(Fn->getExprLoc());
+  OverloadCandidateSet CandidateSet(*this, Fn->getExprLoc());
   ExprResult result;
 
   if (buildOverloadedCallSet(S, Fn, ULE, Args, LParenLoc, &CandidateSet,
@@ -10351,7 +10572,7 @@ Sema::CreateOverloadedUnaryOp(SourceLocation OpLoc, unsigned OpcIn,
   }
 
   // Build an empty overload set.
-  OverloadCandidateSet CandidateSet(OpLoc);
+  OverloadCandidateSet CandidateSet(*this, OpLoc);
 
   // Add the candidates from the given function set.
   AddFunctionCandidates(Fns, ArgsArray, CandidateSet, false);
@@ -10567,7 +10788,7 @@ Sema::CreateOverloadedBinOp(SourceLocation OpLoc,
     return CreateBuiltinBinOp(OpLoc, Opc, Args[0], Args[1]);
 
   // Build an empty overload set.
-  OverloadCandidateSet CandidateSet(OpLoc);
+  OverloadCandidateSet CandidateSet(*this, OpLoc);
 
   // Add the candidates from the given function set.
   AddFunctionCandidates(Fns, Args, CandidateSet, false);
@@ -10798,7 +11019,7 @@ Sema::CreateOverloadedArraySubscriptExpr(SourceLocation LLoc,
     return ExprError();
 
   // Build an empty overload set.
-  OverloadCandidateSet CandidateSet(LLoc);
+  OverloadCandidateSet CandidateSet(*this, LLoc);
 
   // Subscript can only be overloaded as a member function.
 
@@ -11023,7 +11244,7 @@ Sema::BuildCallToMemberFunction(Scope *S, Expr *MemExprE,
                             : UnresExpr->getBase()->Classify(Context);
 
     // Add overload candidates
-    OverloadCandidateSet CandidateSet(UnresExpr->getMemberLoc());
+    OverloadCandidateSet CandidateSet(*this, UnresExpr->getMemberLoc());
 
     // FIXME: avoid copy.
     TemplateArgumentListInfo TemplateArgsBuffer, *TemplateArgs = 0;
@@ -11207,7 +11428,7 @@ Sema::BuildCallToObjectOfClassType(Scope *S, Expr *Obj,
   //  operators of T. The function call operators of T are obtained by
   //  ordinary lookup of the name operator() in the context of
   //  (E).operator().
-  OverloadCandidateSet CandidateSet(LParenLoc);
+  OverloadCandidateSet CandidateSet(*this, LParenLoc);
   DeclarationName OpName = Context.DeclarationNames.getCXXOperatorName(OO_Call);
 
   if (RequireCompleteType(LParenLoc, Object.get()->getType(),
@@ -11498,7 +11719,7 @@ Sema::BuildOverloadedArrowExpr(Scope *S, Expr *Base, SourceLocation OpLoc,
   //   overload resolution mechanism (13.3).
   DeclarationName OpName =
     Context.DeclarationNames.getCXXOperatorName(OO_Arrow);
-  OverloadCandidateSet CandidateSet(Loc);
+  OverloadCandidateSet CandidateSet(*this, Loc);
   const RecordType *BaseRecord = Base->getType()->getAs<RecordType>();
 
   if (RequireCompleteType(Loc, Base->getType(),
@@ -11601,7 +11822,7 @@ ExprResult Sema::BuildLiteralOperatorCall(LookupResult &R,
                                        TemplateArgumentListInfo *TemplateArgs) {
   SourceLocation UDSuffixLoc = SuffixInfo.getCXXLiteralOperatorNameLoc();
 
-  OverloadCandidateSet CandidateSet(UDSuffixLoc);
+  OverloadCandidateSet CandidateSet(*this, UDSuffixLoc);
   AddFunctionCandidates(R.asUnresolvedSet(), Args, CandidateSet, true,
                         TemplateArgs);
 
@@ -20,6 +20,8 @@
 #include "clang/Sema/Lookup.h"
 #include "clang/Sema/ScopeInfo.h"
 #include "llvm/ADT/StringExtras.h"
+#include "llvm/ADT/StringSwitch.h"
+#include "llvm/Support/MathExtras.h"
 
 using namespace clang;
 using namespace sema;
@@ -44,6 +46,116 @@ static Attr *handleFallThroughAttr(Sema &S, Stmt *St, const AttributeList &A,
   return ::new (S.Context) FallThroughAttr(A.getRange(), S.Context);
 }
 
+static Attr *handleLoopHintAttr(Sema &S, Stmt *St, const AttributeList &A,
+                                SourceRange Range) {
+  if (!isa<ForStmt>(St) && !isa<WhileStmt>(St) && !isa<DoStmt>(St) &&
+      !isa<CXXForRangeStmt>(St)) {
+    S.Diag(A.getLoc(), diag::err_pragma_loop_precedes_nonloop);
+    return 0;
+  }
+
+  // The parser has already checked the option name, and that the enabling
+  // options were given 'enable' or 'disable'.
+  IdentifierInfo *OptionInfo = A.getParameterName();
+  LoopHintAttr::OptionType Option =
+    llvm::StringSwitch<LoopHintAttr::OptionType>(OptionInfo->getName())
+      .Case("vectorize", LoopHintAttr::Vectorize)
+      .Case("vectorize_width", LoopHintAttr::VectorizeWidth)
+      .Case("interleave", LoopHintAttr::Interleave)
+      .Case("interleave_count", LoopHintAttr::InterleaveCount)
+      .Case("unroll", LoopHintAttr::Unroll)
+      .Case("unroll_count", LoopHintAttr::UnrollCount)
+      .Default(LoopHintAttr::Vectorize);
+
+  llvm::APSInt Value;
+  Expr *ValueExpr = A.getArg(0);
+  if (!ValueExpr->isIntegerConstantExpr(Value, S.Context) ||
+      Value.getActiveBits() > 31) {
+    S.Diag(ValueExpr->getExprLoc(), diag::err_pragma_loop_invalid_value)
+      << OptionInfo;
+    return 0;
+  }
+
+  if (!LoopHintAttr::isEnableOption(Option)) {
+    if (Value == 0) {
+      S.Diag(ValueExpr->getExprLoc(), diag::err_pragma_loop_invalid_value)
+        << OptionInfo;
+      return 0;
+    }
+    // The vectorizer only handles vector widths and interleave counts that
+    // are powers of two.
+    if ((Option == LoopHintAttr::VectorizeWidth ||
+         Option == LoopHintAttr::InterleaveCount) &&
+        !llvm::isPowerOf2_32(Value.getZExtValue())) {
+      S.Diag(ValueExpr->getExprLoc(), diag::err_pragma_loop_not_power_of_two)
+        << OptionInfo;
+      return 0;
+    }
+  }
+
+  return ::new (S.Context) LoopHintAttr(A.getRange(), S.Context, Option,
+                                        Value.getZExtValue(),
+                                        A.getAttributeSpellingListIndex());
+}
+
+/// \brief Diagnose two loop hints that conflict, at the one that comes later
+/// in the source.
+static void DiagnoseLoopHintConflict(Sema &S, const LoopHintAttr *A,
+                                     const LoopHintAttr *B, bool Duplicate) {
+  if (S.getSourceManager().isBeforeInTranslationUnit(B->getLocation(),
+                                                     A->getLocation()))
+    std::swap(A, B);
+  S.Diag(B->getLocation(), diag::err_pragma_loop_compatibility)
+    << Duplicate << A->getDiagnosticName() << B->getDiagnosticName();
+}
+
+/// \brief Diagnose loop hints on the same loop that repeat or contradict one
+/// another.
+///
+/// Vectorization, interleaving and unrolling each have an option that enables
+/// or disables them and one that sets a count. Each option may be given once,
+/// and a count may not be set for a transformation that is disabled.
+static void CheckForIncompatibleLoopHints(Sema &S,
+                                          ArrayRef<const Attr *> Attrs) {
+  const LoopHintAttr *Hints[3][2] = { { 0, 0 }, { 0, 0 }, { 0, 0 } };
+
+  for (unsigned I = 0, E = Attrs.size(); I != E; ++I) {
+    const LoopHintAttr *LH = dyn_cast<LoopHintAttr>(Attrs[I]);
+    if (!LH)
+      continue;
+
+    int Option = LH->getOption();
+    unsigned Category;
+    switch (Option) {
+    case LoopHintAttr::Vectorize:
+    case LoopHintAttr::VectorizeWidth:
+      Category = 0;
+      break;
+    case LoopHintAttr::Interleave:
+    case LoopHintAttr::InterleaveCount:
+      Category = 1;
+      break;
+    case LoopHintAttr::Unroll:
+    case LoopHintAttr::UnrollCount:
+      Category = 2;
+      break;
+    default:
+      llvm_unreachable("unknown loop hint option");
+    }
+
+    bool IsCount = !LoopHintAttr::isEnableOption(Option);
+    if (const LoopHintAttr *Prev = Hints[Category][IsCount]) {
+      DiagnoseLoopHintConflict(S, Prev, LH, /*Duplicate=*/true);
+      continue;
+    }
+    Hints[Category][IsCount] = LH;
+
+    const LoopHintAttr *Enable = Hints[Category][0];
+    const LoopHintAttr *Count = Hints[Category][1];
+    if (Enable && Count && Enable->getValue() == 0)
+      DiagnoseLoopHintConflict(S, Enable, Count, /*Duplicate=*/false);
+  }
+}
 
 static Attr *ProcessStmtAttribute(Sema &S, Stmt *St, const AttributeList &A,
                                   SourceRange Range) {
@@ -55,6 +167,8 @@ static Attr *ProcessStmtAttribute(Sema &S, Stmt *St, const AttributeList &A,
     return 0;
   case AttributeList::AT_FallThrough:
     return handleFallThroughAttr(S, St, A, Range);
+  case AttributeList::AT_LoopHint:
+    return handleLoopHintAttr(S, St, A, Range);
   default:
     // if we're here, then we parsed a known attribute, but didn't recognize
     // it as a statement attribute => it is declaration attribute
@@ -72,6 +186,8 @@ StmtResult Sema::ProcessStmtAttributes(Stmt *S, AttributeList *AttrList,
       Attrs.push_back(a);
   }
 
+  CheckForIncompatibleLoopHints(*this, Attrs);
+
   if (Attrs.empty())
     return S;
 
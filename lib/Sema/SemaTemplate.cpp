@@ -2574,7 +2574,7 @@ Sema::CheckVarTemplateId(VarTemplateDecl *Template, SourceLocation TemplateLoc,
   typedef PartialSpecMatchResult MatchResult;
   SmallVector<MatchResult, 4> Matched;
   SourceLocation PointOfInstantiation = TemplateNameLoc;
-  TemplateSpecCandidateSet FailedCandidates(PointOfInstantiation);
+  TemplateSpecCandidateSet FailedCandidates(*this, PointOfInstantiation);
 
   // 1. Attempt to find the closest partial specialization that this
   // specializes, if any.
@@ -2598,7 +2598,7 @@ Sema::CheckVarTemplateId(VarTemplateDecl *Template, SourceLocation TemplateLoc,
               DeduceTemplateArguments(Partial, TemplateArgList, Info)) {
         // Store the failed-deduction information for use in diagnostics, later.
         FailedCandidates.addCandidate()
-            .set(Partial, MakeDeductionFailureInfo(Context, Result, Info));
+            .set(Partial, MakeDeductionFailureInfo(*this, Result, Info));
         (void)Result;
       } else {
         Matched.push_back(PartialSpecMatchResult());
@@ -6374,7 +6374,7 @@ bool Sema::CheckFunctionTemplateSpecialization(
   // The set of function template specializations that could match this
   // explicit function template specialization.
   UnresolvedSet<8> Candidates;
-  TemplateSpecCandidateSet FailedCandidates(FD->getLocation());
+  TemplateSpecCandidateSet FailedCandidates(*this, FD->getLocation());
 
   DeclContext *FDLookupContext = FD->getDeclContext()->getRedeclContext();
   for (LookupResult::iterator I = Previous.begin(), E = Previous.end();
@@ -6421,7 +6421,7 @@ bool Sema::CheckFunctionTemplateSpecialization(
         // that we can provide nifty diagnostics.
         FailedCandidates.addCandidate()
             .set(FunTmpl->getTemplatedDecl(),
-                 MakeDeductionFailureInfo(Context, TDK, Info));
+                 MakeDeductionFailureInfo(*this, TDK, Info));
         (void)TDK;
         continue;
       }
@@ -7322,7 +7322,7 @@ DeclResult Sema::ActOnExplicitInstantiation(Scope *S,
   //  instantiated from the member definition associated with its class
   //  template.
   UnresolvedSet<8> Matches;
-  TemplateSpecCandidateSet FailedCandidates(D.getIdentifierLoc());
+  TemplateSpecCandidateSet FailedCandidates(*this, D.getIdentifierLoc());
   for (LookupResult::iterator P = Previous.begin(), PEnd = Previous.end();
        P != PEnd; ++P) {
     NamedDecl *Prev = *P;
@@ -7351,7 +7351,7 @@ DeclResult Sema::ActOnExplicitInstantiation(Scope *S,
       // Keep track of almost-matches.
       FailedCandidates.addCandidate()
           .set(FunTmpl->getTemplatedDecl(),
-               MakeDeductionFailureInfo(Context, TDK, Info));
+               MakeDeductionFailureInfo(*this, TDK, Info));
       (void)TDK;
       continue;
     }
@@ -22,6 +22,7 @@
 #include "clang/Sema/Lookup.h"
 #include "clang/Sema/Template.h"
 #include "clang/Sema/TemplateDeduction.h"
+#include "clang/Sema/TemplateInstantiationProfiler.h"
 
 using namespace clang;
 using namespace sema;
@@ -204,6 +205,8 @@ InstantiatingTemplate(Sema &SemaRef, SourceLocation PointOfInstantiation,
     Inst.InstantiationRange = InstantiationRange;
     SemaRef.InNonInstantiationSFINAEContext = false;
     SemaRef.ActiveTemplateInstantiations.push_back(Inst);
+    if (SemaRef.TemplateProfiler)
+      SemaRef.TemplateProfiler->startInstantiation(Entity);
   }
 }
 
@@ -450,6 +453,12 @@ void Sema::InstantiatingTemplate::Clear() {
       SemaRef.ActiveTemplateInstantiationLookupModules.pop_back();
     }
 
+    const ActiveTemplateInstantiation &Inst
+      = SemaRef.ActiveTemplateInstantiations.back();
+    if (SemaRef.TemplateProfiler &&
+        Inst.Kind == ActiveTemplateInstantiation::TemplateInstantiation)
+      SemaRef.TemplateProfiler->finishInstantiation(Inst.Entity);
+
     SemaRef.ActiveTemplateInstantiations.pop_back();
     Invalid = true;
   }
@@ -2307,7 +2316,7 @@ Sema::InstantiateClassTemplateSpecialization(
   SmallVector<MatchResult, 4> Matched;
   SmallVector<ClassTemplatePartialSpecializationDecl *, 4> PartialSpecs;
   Template->getPartialSpecializations(PartialSpecs);
-  TemplateSpecCandidateSet FailedCandidates(PointOfInstantiation);
+  TemplateSpecCandidateSet FailedCandidates(*this, PointOfInstantiation);
   for (unsigned I = 0, N = PartialSpecs.size(); I != N; ++I) {
     ClassTemplatePartialSpecializationDecl *Partial = PartialSpecs[I];
     TemplateDeductionInfo Info(FailedCandidates.getLocation());
@@ -2318,7 +2327,7 @@ Sema::InstantiateClassTemplateSpecialization(
       // Store the failed-deduction information for use in diagnostics, later.
       // TODO: Actually use the failed-deduction info?
       FailedCandidates.addCandidate()
-          .set(Partial, MakeDeductionFailureInfo(Context, Result, Info));
+          .set(Partial, MakeDeductionFailureInfo(*this, Result, Info));
       (void)Result;
     } else {
       Matched.push_back(PartialSpecMatchResult());
@@ -4242,6 +4242,20 @@ void Sema::PerformPendingInstantiations(bool LocalOnly) {
       PendingLocalImplicitInstantiations.pop_front();
     }
 
+    // While building a PCH with -fpch-instantiate-templates, only
+    // instantiate the function definitions whose templates are already
+    // defined; the rest may be defined by the translation units using the
+    // PCH, so leave them to those.
+    if (TUKind == TU_Prefix && LangOpts.PCHInstantiateTemplates) {
+      FunctionDecl *Function = dyn_cast<FunctionDecl>(Inst.first);
+      const FunctionDecl *Pattern
+        = Function ? Function->getTemplateInstantiationPattern() : 0;
+      if (!Pattern || !Pattern->isDefined()) {
+        DeferredPCHInstantiations.push_back(Inst);
+        continue;
+      }
+    }
+
     // Instantiate function definitions
     if (FunctionDecl *Function = dyn_cast<FunctionDecl>(Inst.first)) {
       PrettyDeclStackTraceEntry CrashInfo(*this, Function, SourceLocation(),
@@ -0,0 +1,238 @@
+//===--- TemplateInstantiationProfiler.cpp - Instantiation costs ----------===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+//  This file implements TemplateInstantiationProfiler.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/Sema/TemplateInstantiationProfiler.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/AST/DeclCXX.h"
+#include "clang/AST/DeclTemplate.h"
+#include "llvm/Support/Format.h"
+#include "llvm/Support/Timer.h"
+#include "llvm/Support/raw_ostream.h"
+#include <algorithm>
+
+using namespace clang;
+
+/// \brief The maximum number of entries printed in each table of the report.
+static const unsigned MaxReportEntries = 50;
+
+static double getCurrentWallTime() {
+  return llvm::TimeRecord::getCurrentTime().getWallTime();
+}
+
+/// \brief Determine the template (or member of a class template) from which
+/// the given entity is being instantiated.
+static const Decl *getInstantiatedTemplate(const Decl *D) {
+  if (const ClassTemplateSpecializationDecl *Spec
+        = dyn_cast<ClassTemplateSpecializationDecl>(D))
+    return Spec->getSpecializedTemplate()->getCanonicalDecl();
+  if (const CXXRecordDecl *Record = dyn_cast<CXXRecordDecl>(D)) {
+    if (CXXRecordDecl *Pattern = Record->getInstantiatedFromMemberClass())
+      return Pattern->getCanonicalDecl();
+  }
+  if (const FunctionDecl *Function = dyn_cast<FunctionDecl>(D)) {
+    if (FunctionTemplateDecl *Template = Function->getPrimaryTemplate())
+      return Template->getCanonicalDecl();
+    if (FunctionDecl *Pattern = Function->getInstantiatedFromMemberFunction())
+      return Pattern->getCanonicalDecl();
+  }
+  if (const VarTemplateSpecializationDecl *Spec
+        = dyn_cast<VarTemplateSpecializationDecl>(D))
+    return Spec->getSpecializedTemplate()->getCanonicalDecl();
+  if (const VarDecl *Var = dyn_cast<VarDecl>(D)) {
+    if (VarDecl *Pattern = Var->getInstantiatedFromStaticDataMember())
+      return Pattern->getCanonicalDecl();
+  }
+  if (const EnumDecl *Enum = dyn_cast<EnumDecl>(D)) {
+    if (EnumDecl *Pattern = Enum->getInstantiatedFromMemberEnum())
+      return Pattern->getCanonicalDecl();
+  }
+  return D->getCanonicalDecl();
+}
+
+static std::string getEntityName(const Decl *D,
+                                 const PrintingPolicy &Policy) {
+  const NamedDecl *ND = dyn_cast<NamedDecl>(D);
+  if (!ND || !ND->getDeclName())
+    return "<anonymous>";
+
+  std::string Name;
+  llvm::raw_string_ostream OS(Name);
+  ND->getNameForDiagnostic(OS, Policy, /*Qualified=*/true);
+  return OS.str();
+}
+
+static void writeJSONString(raw_ostream &OS, StringRef Str) {
+  OS << '"';
+  for (StringRef::iterator I = Str.begin(), E = Str.end(); I != E; ++I) {
+    unsigned char C = *I;
+    if (C == '"' || C == '\\')
+      OS << '\\' << C;
+    else if (C < 0x20)
+      OS << llvm::format("\\u%04x", C);
+    else
+      OS << C;
+  }
+  OS << '"';
+}
+
+TemplateInstantiationProfiler::TemplateInstantiationProfiler(
+    const ASTContext &Context, bool RecordTrace)
+  : Context(Context), RecordTrace(RecordTrace),
+    ProfileStartTime(getCurrentWallTime()), TotalTime(0),
+    NumInstantiations(0) { }
+
+void TemplateInstantiationProfiler::startInstantiation(const Decl *Entity) {
+  ActiveInstantiation Inst;
+  Inst.Entity = Entity;
+  Inst.Template = getInstantiatedTemplate(Entity);
+  Inst.StartAllocations = Context.getNumASTAllocations();
+  Inst.StartBytes = Context.getNumASTAllocatedBytes();
+  Inst.NestedTime = 0;
+  Inst.NestedAllocations = 0;
+  Inst.NestedBytes = 0;
+  Inst.NumNested = 0;
+
+  ++BySpecialization[Inst.Entity].Active;
+  ++ByTemplate[Inst.Template].Active;
+
+  // Read the clock last, so that the bookkeeping above is not attributed to
+  // the instantiation.
+  Inst.StartTime = getCurrentWallTime();
+  Stack.push_back(Inst);
+}
+
+void TemplateInstantiationProfiler::finishInstantiation(const Decl *Entity) {
+  double Now = getCurrentWallTime();
+  assert(!Stack.empty() && Stack.back().Entity == Entity &&
+         "Mismatched template instantiation profile entries");
+  ActiveInstantiation Inst = Stack.pop_back_val();
+
+  double Duration = Now - Inst.StartTime;
+  unsigned Allocations = Context.getNumASTAllocations() -
+                         Inst.StartAllocations;
+  uint64_t Bytes = Context.getNumASTAllocatedBytes() - Inst.StartBytes;
+
+  Stats *Entries[2] = { &BySpecialization[Inst.Entity],
+                        &ByTemplate[Inst.Template] };
+  for (unsigned I = 0; I != 2; ++I) {
+    Stats &S = *Entries[I];
+    ++S.Count;
+    S.Nested += Inst.NumNested;
+    S.SelfTime += Duration - Inst.NestedTime;
+    S.SelfAllocations += Allocations - Inst.NestedAllocations;
+    S.SelfBytes += Bytes - Inst.NestedBytes;
+
+    // Only count the outermost of a set of recursive instantiations towards
+    // the total time, so that it isn't counted more than once.
+    if (--S.Active == 0)
+      S.TotalTime += Duration;
+  }
+
+  if (!Stack.empty()) {
+    ActiveInstantiation &Parent = Stack.back();
+    Parent.NestedTime += Duration;
+    Parent.NestedAllocations += Allocations;
+    Parent.NestedBytes += Bytes;
+    ++Parent.NumNested;
+  } else {
+    TotalTime += Duration;
+  }
+  ++NumInstantiations;
+
+  if (RecordTrace) {
+    TraceEvent Event;
+    Event.Entity = Inst.Entity;
+    Event.StartTime = Inst.StartTime - ProfileStartTime;
+    Event.Duration = Duration;
+    Event.Allocations = Allocations;
+    Event.Bytes = Bytes;
+    Trace.push_back(Event);
+  }
+}
+
+namespace {
+  typedef std::pair<const Decl *, const TemplateInstantiationProfiler::Stats *>
+    StatsEntry;
+
+  /// \brief Orders entries by decreasing self time.
+  struct MoreSelfTime {
+    bool operator()(const StatsEntry &X, const StatsEntry &Y) const {
+      if (X.second->SelfTime != Y.second->SelfTime)
+        return X.second->SelfTime > Y.second->SelfTime;
+      return X.second->Count > Y.second->Count;
+    }
+  };
+}
+
+void TemplateInstantiationProfiler::printTable(
+    raw_ostream &OS, StringRef Title,
+    const llvm::DenseMap<const Decl *, Stats> &Table) const {
+  std::vector<StatsEntry> Entries;
+  Entries.reserve(Table.size());
+  for (llvm::DenseMap<const Decl *, Stats>::const_iterator
+         I = Table.begin(), E = Table.end(); I != E; ++I)
+    Entries.push_back(StatsEntry(I->first, &I->second));
+
+  unsigned NumShown = std::min<unsigned>(Entries.size(), MaxReportEntries);
+  std::partial_sort(Entries.begin(), Entries.begin() + NumShown,
+                    Entries.end(), MoreSelfTime());
+
+  OS << "\n  " << Title << " (" << NumShown << " of " << Entries.size()
+     << ", sorted by self time):\n";
+  OS << "   Self (s)  Total (s)    Count   Nested  AST nodes   AST bytes"
+        "  Name\n";
+  const PrintingPolicy &Policy = Context.getPrintingPolicy();
+  for (unsigned I = 0; I != NumShown; ++I) {
+    const Stats &S = *Entries[I].second;
+    OS << llvm::format("  %9.4f  %9.4f %8u %8u %10u %11llu  ",
+                       S.SelfTime, S.TotalTime, S.Count, S.Nested,
+                       S.SelfAllocations, (unsigned long long)S.SelfBytes)
+       << getEntityName(Entries[I].first, Policy) << '\n';
+  }
+}
+
+void TemplateInstantiationProfiler::printReport(raw_ostream &OS) const {
+  OS << "===" << std::string(73, '-') << "===\n"
+     << "                       Template instantiation profile\n"
+     << "===" << std::string(73, '-') << "===\n";
+  OS << llvm::format("  Total instantiation time: %.4f seconds", TotalTime)
+     << " (" << NumInstantiations << " instantiations)\n";
+
+  printTable(OS, "Templates", ByTemplate);
+  printTable(OS, "Specializations", BySpecialization);
+  OS << '\n';
+}
+
+void TemplateInstantiationProfiler::writeTrace(raw_ostream &OS) const {
+  const PrintingPolicy &Policy = Context.getPrintingPolicy();
+
+  // Each instantiation becomes a "complete" event; the viewer nests them
+  // by their time ranges. Times are in microseconds.
+  OS << "{\"traceEvents\":[";
+  for (unsigned I = 0, N = Trace.size(); I != N; ++I) {
+    const TraceEvent &Event = Trace[I];
+    if (I)
+      OS << ',';
+    OS << "\n{\"name\":";
+    writeJSONString(OS, getEntityName(Event.Entity, Policy));
+    OS << ",\"cat\":\"instantiation\",\"ph\":\"X\",\"pid\":1,\"tid\":1"
+       << llvm::format(",\"ts\":%.3f,\"dur\":%.3f", Event.StartTime * 1e6,
+                       Event.Duration * 1e6)
+       << ",\"args\":{\"template\":";
+    writeJSONString(OS, getEntityName(getInstantiatedTemplate(Event.Entity),
+                                      Policy));
+    OS << ",\"allocations\":" << Event.Allocations
+       << ",\"bytes\":" << Event.Bytes << "}}";
+  }
+  OS << "\n],\"displayTimeUnit\":\"ms\"}\n";
+}
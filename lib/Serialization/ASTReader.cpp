@@ -20,6 +20,7 @@
 #include "clang/AST/Expr.h"
 #include "clang/AST/ExprCXX.h"
 #include "clang/AST/NestedNameSpecifier.h"
+#include "clang/AST/RecordLayout.h"
 #include "clang/AST/Type.h"
 #include "clang/AST/TypeLocVisitor.h"
 #include "clang/Basic/FileManager.h"
@@ -2599,6 +2600,22 @@ bool ASTReader::ReadASTBlock(ModuleFile &F) {
     case OBJC_CATEGORIES:
       F.ObjCCategories.swap(Record);
       break;
+
+    case RECORD_LAYOUTS_MAP: {
+      if (F.LocalNumRecordLayoutsInMap != 0) {
+        Error("duplicate RECORD_LAYOUTS_MAP record in AST file");
+        return true;
+      }
+
+      F.LocalNumRecordLayoutsInMap = Record[0];
+      F.RecordLayoutsMap = (const RecordLayoutInfo *)Blob.data();
+      TotalNumRecordLayouts += F.LocalNumRecordLayoutsInMap;
+      break;
+    }
+
+    case RECORD_LAYOUTS:
+      F.RecordLayouts.swap(Record);
+      break;
         
     case CXX_BASE_SPECIFIER_OFFSETS: {
       if (F.LocalNumCXXBaseSpecifiers != 0) {
@@ -5390,6 +5407,91 @@ CXXBaseSpecifier *ASTReader::GetExternalCXXBaseSpecifiers(uint64_t Offset) {
   return Bases;
 }
 
+namespace {
+  struct CompareRecordLayoutInfoToID {
+    bool operator()(const RecordLayoutInfo &X, DeclID Y) {
+      return X.RecordID < Y;
+    }
+
+    bool operator()(DeclID X, const RecordLayoutInfo &Y) {
+      return X < Y.RecordID;
+    }
+
+    bool operator()(const RecordLayoutInfo &X, const RecordLayoutInfo &Y) {
+      return X.RecordID < Y.RecordID;
+    }
+  };
+}
+
+const ASTRecordLayout *
+ASTReader::GetExternalRecordLayout(const RecordDecl *RD) {
+  ModuleFile *M = getOwningModuleFile(RD);
+  if (!M || M->LocalNumRecordLayoutsInMap == 0)
+    return 0;
+
+  // Map the global ID of the definition down to the ID used in the module
+  // file, and look for a layout computed when building it.
+  DeclID ID = mapGlobalIDToModuleFileGlobalID(*M, RD->getGlobalID());
+  const RecordLayoutInfo *MapEnd
+    = M->RecordLayoutsMap + M->LocalNumRecordLayoutsInMap;
+  const RecordLayoutInfo *Result
+    = std::lower_bound(M->RecordLayoutsMap, MapEnd, ID,
+                       CompareRecordLayoutInfoToID());
+  if (Result == MapEnd || Result->RecordID != ID)
+    return 0;
+
+  ++NumRecordLayoutsRead;
+  const SmallVectorImpl<uint64_t> &Record = M->RecordLayouts;
+  unsigned Idx = Result->Offset;
+  CharUnits Size = CharUnits::fromQuantity(Record[Idx++]);
+  CharUnits DataSize = CharUnits::fromQuantity(Record[Idx++]);
+  CharUnits Alignment = CharUnits::fromQuantity(Record[Idx++]);
+  unsigned FieldCount = Record[Idx++];
+  SmallVector<uint64_t, 16> FieldOffsets(Record.begin() + Idx,
+                                         Record.begin() + Idx + FieldCount);
+  Idx += FieldCount;
+
+  bool IsCXX = Record[Idx++];
+  if (!IsCXX)
+    return new (Context) ASTRecordLayout(Context, Size, Alignment, DataSize,
+                                         FieldOffsets.data(), FieldCount);
+
+  CharUnits NonVirtualSize = CharUnits::fromQuantity(Record[Idx++]);
+  CharUnits NonVirtualAlign = CharUnits::fromQuantity(Record[Idx++]);
+  CharUnits SizeOfLargestEmptySubobject
+    = CharUnits::fromQuantity(Record[Idx++]);
+  CharUnits VBPtrOffset = CharUnits::fromQuantity(Record[Idx++]);
+  bool HasOwnVFPtr = Record[Idx++];
+  const CXXRecordDecl *PrimaryBase = 0;
+  if (DeclID PrimaryBaseID = Record[Idx++])
+    PrimaryBase = GetLocalDeclAs<CXXRecordDecl>(*M, PrimaryBaseID);
+  bool IsPrimaryBaseVirtual = Record[Idx++];
+
+  ASTRecordLayout::BaseOffsetsMapTy BaseOffsets;
+  for (unsigned I = 0, N = Record[Idx++]; I != N; ++I) {
+    const CXXRecordDecl *Base
+      = GetLocalDeclAs<CXXRecordDecl>(*M, Record[Idx++]);
+    BaseOffsets[Base] = CharUnits::fromQuantity(Record[Idx++]);
+  }
+
+  ASTRecordLayout::VBaseOffsetsMapTy VBaseOffsets;
+  for (unsigned I = 0, N = Record[Idx++]; I != N; ++I) {
+    const CXXRecordDecl *VBase
+      = GetLocalDeclAs<CXXRecordDecl>(*M, Record[Idx++]);
+    CharUnits Offset = CharUnits::fromQuantity(Record[Idx++]);
+    bool HasVtorDisp = Record[Idx++];
+    VBaseOffsets[VBase] = ASTRecordLayout::VBaseInfo(Offset, HasVtorDisp);
+  }
+
+  return new (Context) ASTRecordLayout(Context, Size, Alignment, HasOwnVFPtr,
+                                       VBPtrOffset, DataSize,
+                                       FieldOffsets.data(), FieldCount,
+                                       NonVirtualSize, NonVirtualAlign,
+                                       SizeOfLargestEmptySubobject,
+                                       PrimaryBase, IsPrimaryBaseVirtual,
+                                       BaseOffsets, VBaseOffsets);
+}
+
 serialization::DeclID 
 ASTReader::getGlobalDeclID(ModuleFile &F, LocalDeclID LocalID) const {
   if (LocalID < NUM_PREDEF_DECL_IDS)
@@ -6002,6 +6104,10 @@ void ASTReader::PrintStats() {
     std::fprintf(stderr, "  %u/%u macros read (%f%%)\n",
                  NumMacrosRead, TotalNumMacros,
                  ((float)NumMacrosRead/TotalNumMacros * 100));
+  if (TotalNumRecordLayouts)
+    std::fprintf(stderr, "  %u/%u record layouts read (%f%%)\n",
+                 NumRecordLayoutsRead, TotalNumRecordLayouts,
+                 ((float)NumRecordLayoutsRead/TotalNumRecordLayouts * 100));
   if (TotalLexicalDeclContexts)
     std::fprintf(stderr, "  %u/%u lexical declcontexts read (%f%%)\n",
                  NumLexicalDeclContextsRead, TotalLexicalDeclContexts,
@@ -7498,7 +7604,8 @@ ASTReader::ASTReader(Preprocessor &PP, ASTContext &Context,
     NumVisibleDeclContextsRead(0), TotalVisibleDeclContexts(0),
     TotalModulesSizeInBits(0), NumCurrentElementsDeserializing(0),
     PassingDeclsToConsumer(false),
-    NumCXXBaseSpecifiersLoaded(0), ReadingKind(Read_None)
+    NumCXXBaseSpecifiersLoaded(0), NumRecordLayoutsRead(0),
+    TotalNumRecordLayouts(0), ReadingKind(Read_None)
 {
   SourceMgr.setExternalSLocEntrySource(this);
 }
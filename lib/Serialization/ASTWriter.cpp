@@ -20,6 +20,7 @@
 #include "clang/AST/DeclTemplate.h"
 #include "clang/AST/Expr.h"
 #include "clang/AST/ExprCXX.h"
+#include "clang/AST/RecordLayout.h"
 #include "clang/AST/Type.h"
 #include "clang/AST/TypeLocVisitor.h"
 #include "clang/Basic/FileManager.h"
@@ -3654,6 +3655,98 @@ void ASTWriter::WriteObjCCategories() {
   Stream.EmitRecord(OBJC_CATEGORIES, Categories);
 }
 
+void ASTWriter::WriteRecordLayouts() {
+  // Collect the layouts of the local record definitions that were laid out
+  // while building this AST file, sorted by declaration ID so that the
+  // output does not depend on pointer values.
+  SmallVector<std::pair<DeclID, const RecordDecl *>, 16> Records;
+  for (llvm::DenseMap<const RecordDecl *, const ASTRecordLayout *>::iterator
+         I = Context->ASTRecordLayouts.begin(),
+         E = Context->ASTRecordLayouts.end();
+       I != E; ++I) {
+    const RecordDecl *RD = I->first;
+    if (!I->second || RD->isFromASTFile())
+      continue;
+
+    llvm::DenseMap<const Decl *, DeclID>::iterator Known = DeclIDs.find(RD);
+    if (Known == DeclIDs.end() || Known->second == 0)
+      continue;
+
+    Records.push_back(std::make_pair(Known->second, RD));
+  }
+  if (Records.empty())
+    return;
+
+  llvm::array_pod_sort(Records.begin(), Records.end());
+
+  SmallVector<serialization::RecordLayoutInfo, 16> LayoutsMap;
+  RecordData Layouts;
+  for (unsigned I = 0, N = Records.size(); I != N; ++I) {
+    const ASTRecordLayout &Layout
+      = *Context->ASTRecordLayouts[Records[I].second];
+    serialization::RecordLayoutInfo Info = { Records[I].first,
+                                             (unsigned)Layouts.size() };
+    LayoutsMap.push_back(Info);
+
+    Layouts.push_back(Layout.Size.getQuantity());
+    Layouts.push_back(Layout.DataSize.getQuantity());
+    Layouts.push_back(Layout.Alignment.getQuantity());
+    Layouts.push_back(Layout.FieldCount);
+    for (unsigned F = 0; F != Layout.FieldCount; ++F)
+      Layouts.push_back(Layout.FieldOffsets[F]);
+
+    const ASTRecordLayout::CXXRecordLayoutInfo *CXXInfo = Layout.CXXInfo;
+    Layouts.push_back(CXXInfo != 0);
+    if (!CXXInfo)
+      continue;
+
+    Layouts.push_back(CXXInfo->NonVirtualSize.getQuantity());
+    Layouts.push_back(CXXInfo->NonVirtualAlign.getQuantity());
+    Layouts.push_back(CXXInfo->SizeOfLargestEmptySubobject.getQuantity());
+    Layouts.push_back(CXXInfo->VBPtrOffset.getQuantity());
+    Layouts.push_back(CXXInfo->HasOwnVFPtr);
+    Layouts.push_back(getDeclID(CXXInfo->PrimaryBase.getPointer()));
+    Layouts.push_back(CXXInfo->PrimaryBase.getInt());
+
+    Layouts.push_back(CXXInfo->BaseOffsets.size());
+    for (ASTRecordLayout::BaseOffsetsMapTy::const_iterator
+           B = CXXInfo->BaseOffsets.begin(), BEnd = CXXInfo->BaseOffsets.end();
+         B != BEnd; ++B) {
+      Layouts.push_back(getDeclID(B->first));
+      Layouts.push_back(B->second.getQuantity());
+    }
+
+    Layouts.push_back(CXXInfo->VBaseOffsets.size());
+    for (ASTRecordLayout::VBaseOffsetsMapTy::const_iterator
+           B = CXXInfo->VBaseOffsets.begin(),
+           BEnd = CXXInfo->VBaseOffsets.end();
+         B != BEnd; ++B) {
+      Layouts.push_back(getDeclID(B->first));
+      Layouts.push_back(B->second.VBaseOffset.getQuantity());
+      Layouts.push_back(B->second.hasVtorDisp());
+    }
+  }
+
+  // Emit the record layouts map.
+  using namespace llvm;
+  llvm::BitCodeAbbrev *Abbrev = new BitCodeAbbrev();
+  Abbrev->Add(BitCodeAbbrevOp(RECORD_LAYOUTS_MAP));
+  Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::VBR, 6)); // # of entries
+  Abbrev->Add(BitCodeAbbrevOp(BitCodeAbbrevOp::Blob));
+  unsigned AbbrevID = Stream.EmitAbbrev(Abbrev);
+
+  RecordData Record;
+  Record.push_back(RECORD_LAYOUTS_MAP);
+  Record.push_back(LayoutsMap.size());
+  Stream.EmitRecordWithBlob(AbbrevID, Record,
+                            reinterpret_cast<char*>(LayoutsMap.data()),
+                            LayoutsMap.size() *
+                              sizeof(serialization::RecordLayoutInfo));
+
+  // Emit the layouts themselves.
+  Stream.EmitRecord(RECORD_LAYOUTS, Layouts);
+}
+
 void ASTWriter::WriteMergedDecls() {
   if (!Chain || Chain->MergedDecls.empty())
     return;
@@ -4255,6 +4348,7 @@ void ASTWriter::WriteASTCore(Sema &SemaRef,
   WriteRedeclarations();
   WriteMergedDecls();
   WriteObjCCategories();
+  WriteRecordLayouts();
   
   // Some simple statistics
   Record.clear();
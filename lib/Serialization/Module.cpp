@@ -41,6 +41,7 @@ ModuleFile::ModuleFile(ModuleKind Kind, unsigned Generation)
     FileSortedDecls(0), NumFileSortedDecls(0),
     RedeclarationsMap(0), LocalNumRedeclarationsInMap(0),
     ObjCCategoriesMap(0), LocalNumObjCCategoriesInMap(0),
+    RecordLayoutsMap(0), LocalNumRecordLayoutsInMap(0),
     LocalNumTypes(0), TypeOffsets(0), BaseTypeIndex(0)
 {}
 
@@ -0,0 +1,76 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -emit-llvm -verify -o - %s | FileCheck %s
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -emit-llvm -o - %s | FileCheck -check-prefix=ONCE %s
+
+// The IR keeps the features of each function for the code generator, so
+// emitting it is not diagnosed.
+// expected-no-diagnostics
+
+// A function with a target attribute is compiled for the features it names,
+// and is not inlined into callers compiled for others.
+// CHECK-LABEL: define i32 @f1(i32 %x) [[F1:#[0-9]+]]
+int __attribute__((target("avx2"))) f1(int x) { return x + 1; }
+
+// CHECK-LABEL: define i32 @f2(i32 %x) [[F2:#[0-9]+]]
+int __attribute__((target("no-sse4.2"))) f2(int x) { return x + 2; }
+
+// A function with a target_clones attribute gets a local copy for each
+// version, and its symbol is an indirect function whose resolver picks one.
+int __attribute__((target_clones("avx2", "sse4.2", "default"))) g(int x) {
+  return x * 3;
+}
+
+int use(int x) { return f1(x) + f2(x) + g(x); }
+
+// The extern declaration emits the inline definition at once, and its use
+// has already queued it for emission; it still gets one set of copies.
+inline int __attribute__((target_clones("avx2", "default"))) h(int x) {
+  return x - 1;
+}
+int use_h(int x) { return h(x); }
+extern int h(int);
+
+int taken(void) __asm__("k.resolver");
+int taken(void) { return 0; }
+int __attribute__((target_clones("avx2", "default"))) k(int x) { return x; }
+
+// ONCE: module asm "\09.set\09h,h.resolver"
+// ONCE-NOT: module asm "\09.set\09h,h.resolver"
+// ONCE: define internal i32 @h.avx2(
+// ONCE-NOT: define internal i32 @h.avx2{{[0-9]+}}(
+
+// CHECK: module asm "\09.globl\09g"
+// CHECK: module asm "\09.type\09g,@gnu_indirect_function"
+// CHECK: module asm "\09.set\09g,g.resolver"
+// CHECK: module asm "\09.set\09k,k.resolver1"
+
+// CHECK: @llvm.used = appending global {{.*}} @g.resolver
+
+// Uses of the function refer to the indirect function by name.
+// CHECK: declare i32 @g(i32)
+
+// CHECK-LABEL: define internal i32 @g.avx2(i32 %x) [[G_AVX2:#[0-9]+]]
+// CHECK: mul nsw i32 {{.*}}, 3
+// CHECK-LABEL: define internal i32 @g.sse4.2(i32 %x) [[G_SSE42:#[0-9]+]]
+// CHECK-LABEL: define internal i32 @g.default(i32 %x)
+
+// The resolver tests for the most demanding version last, so that its copy
+// is selected over the others.
+// CHECK-LABEL: define internal i8* @g.resolver()
+// CHECK: call { i32, i32, i32, i32 } asm "cpuid"
+// CHECK: select i1 {{.*}}, i8* bitcast (i32 (i32)* @g.sse4.2 to i8*), i8* bitcast (i32 (i32)* @g.default to i8*)
+// CHECK: xgetbv
+// CHECK: select i1 {{.*}}, i8* bitcast (i32 (i32)* @g.avx2 to i8*), i8*
+// CHECK: ret i8*
+
+// CHECK-LABEL: define i32 @use
+// CHECK: call i32 @g(i32
+
+// A resolver is named once the module is complete, so a symbol that already
+// has its name keeps it, and the assembly refers to the resolver's final name.
+// CHECK-LABEL: define i32 @k.resolver()
+// CHECK-LABEL: define internal i8* @k.resolver1()
+
+// CHECK: attributes [[F1]] = { {{.*}}noinline{{.*}}"target-features"="{{.*}}+avx2{{.*}}" }
+// CHECK: attributes [[F2]] = { {{.*}}noinline{{.*}}"target-features"="{{.*}}-sse42{{.*}}" }
+// CHECK: attributes [[G_AVX2]] = { {{.*}}"target-features"="{{.*}}+avx2{{.*}}" }
+// CHECK: attributes [[G_SSE42]] = { {{.*}}"target-features"="{{.*}}+sse42{{.*}}" }
@@ -0,0 +1,106 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -O2 -emit-llvm -o - %s | FileCheck %s -check-prefix=OPT
+
+// The alignment is stated by clearing the low bits of the pointer, which
+// leaves an aligned pointer unchanged.
+
+int *test1(int *a) {
+// CHECK-LABEL: define i32* @test1(
+// CHECK: [[PTRINT:%.+]] = ptrtoint i8* {{%.+}} to i64
+// CHECK: [[MASKED:%.+]] = and i64 [[PTRINT]], -32
+// CHECK: inttoptr i64 [[MASKED]] to i8*
+  return __builtin_assume_aligned(a, 32);
+}
+
+int *test2(int *a) {
+// CHECK-LABEL: define i32* @test2(
+// CHECK: [[PTRINT:%.+]] = ptrtoint i8* {{%.+}} to i64
+// CHECK: [[OFFSET:%.+]] = sub i64 [[PTRINT]], 4
+// CHECK: [[MASKED:%.+]] = and i64 [[OFFSET]], -64
+// CHECK: [[ADDED:%.+]] = add i64 [[MASKED]], 4
+// CHECK: inttoptr i64 [[ADDED]] to i8*
+  return __builtin_assume_aligned(a, 64, 4);
+}
+
+int *test3(int *a) {
+// CHECK-LABEL: define i32* @test3(
+// CHECK-NOT: ptrtoint
+// CHECK: ret i32*
+  return __builtin_assume_aligned(a, 1, 0);
+}
+
+void *my_aligned_alloc(unsigned long size) __attribute__((assume_aligned(32)));
+void *my_offset_alloc(unsigned long size) __attribute__((assume_aligned(32, 8)));
+void *my_memalign(unsigned long align, unsigned long size)
+    __attribute__((alloc_align(1)));
+
+int *test4(void) {
+// CHECK-LABEL: define i32* @test4(
+// CHECK: [[CALL:%.+]] = call i8* @my_aligned_alloc(i64 16)
+// CHECK: [[PTRINT:%.+]] = ptrtoint i8* [[CALL]] to i64
+// CHECK: and i64 [[PTRINT]], -32
+  return my_aligned_alloc(16);
+}
+
+int *test5(void) {
+// CHECK-LABEL: define i32* @test5(
+// CHECK: [[CALL:%.+]] = call i8* @my_offset_alloc(i64 16)
+// CHECK: [[PTRINT:%.+]] = ptrtoint i8* [[CALL]] to i64
+// CHECK: [[OFFSET:%.+]] = sub i64 [[PTRINT]], 8
+// CHECK: and i64 [[OFFSET]], -32
+  return my_offset_alloc(16);
+}
+
+int *test6(unsigned long n) {
+// CHECK-LABEL: define i32* @test6(
+// CHECK: [[CALL:%.+]] = call i8* @my_memalign(i64 128,
+// CHECK: [[PTRINT:%.+]] = ptrtoint i8* [[CALL]] to i64
+// CHECK: and i64 [[PTRINT]], -128
+  return my_memalign(128, n);
+}
+
+// An alignment that is not known at compile time is not used.
+int *test7(unsigned long align, unsigned long n) {
+// CHECK-LABEL: define i32* @test7(
+// CHECK: call i8* @my_memalign(
+// CHECK-NOT: ptrtoint
+// CHECK: ret i32*
+  return my_memalign(align, n);
+}
+
+int test8(int *a) {
+// OPT-LABEL: define i32 @test8(
+// OPT: load i32* {{%.+}}, align 32
+  int *p = __builtin_assume_aligned(a, 32);
+  return *p;
+}
+
+// The builtin states the alignment of a restrict parameter too, since it was
+// asked for explicitly.
+int *test9(int *__restrict a) {
+// CHECK-LABEL: define i32* @test9(
+// CHECK: [[PTRINT:%.+]] = ptrtoint i8* {{%.+}} to i64
+// CHECK: and i64 [[PTRINT]], -32
+  return __builtin_assume_aligned(a, 32);
+}
+
+int test11(int *__restrict a) {
+// OPT-LABEL: define i32 @test11(
+// OPT: load i32* {{%.+}}, align 32
+  int *p = __builtin_assume_aligned(a, 32);
+  return *p;
+}
+
+// Masking would hide a noalias pointer from alias analysis, so the alignment
+// the attributes give the results of malloc-like functions is not used.
+
+void *my_malloc(unsigned long size)
+    __attribute__((malloc, assume_aligned(32)));
+
+int *test10(void) {
+// CHECK-LABEL: define i32* @test10(
+// CHECK: call noalias i8* @my_malloc(i64 16)
+// CHECK-NOT: ptrtoint
+// CHECK: ret i32*
+  return my_malloc(16);
+}
@@ -0,0 +1,17 @@
+// REQUIRES: system-linker, x86-registered-target
+// RUN: not %clang_cc1 -triple x86_64-unknown-linux -emit-obj -codegen-partitions 2 -codegen-partitions-linker ld -o %t.o %s 2>&1 | FileCheck %s
+
+// An error in inline asm is reported at the asm statement, whichever part it
+// is generated in.
+
+int a(int X) {
+// CHECK-DAG: codegen-partitions-asm.c:[[@LINE+1]]:{{[0-9]+}}: error: invalid instruction mnemonic 'abc'
+  __asm__ ("abc incl    %0" : "+r" (X));
+  return X;
+}
+
+int b(int X) {
+// CHECK-DAG: codegen-partitions-asm.c:[[@LINE+1]]:{{[0-9]+}}: error: invalid instruction mnemonic 'def'
+  __asm__ ("def incl    %0" : "+r" (X));
+  return X;
+}
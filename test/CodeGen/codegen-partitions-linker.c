@@ -0,0 +1,23 @@
+// REQUIRES: x86-registered-target
+// RUN: not %clang_cc1 -triple x86_64-unknown-linux -O2 -emit-obj -codegen-partitions 4 -o %t.o %s 2>&1 | FileCheck %s
+// RUN: not %clang_cc1 -triple x86_64-unknown-linux -O2 -emit-obj -codegen-partitions 4 -codegen-partitions-linker %t.missing/ld -o %t.o %s 2>&1 | FileCheck -check-prefix=MISSING %s
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -O2 -emit-obj -DTARGET -o %t.o %s 2>&1 | FileCheck -check-prefix=TARGET %s
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -O2 -S -DTARGET -codegen-partitions-linker ld -o %t.s %s 2>&1 | FileCheck -check-prefix=ASM %s
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -O2 -emit-obj -DTARGET -Wno-target-features-ignored -verify -o %t.o %s
+
+// The parts are only merged by a linker that is named explicitly.
+
+// CHECK: error: generating code in 4 parts requires a linker to merge them; pass one with -codegen-partitions-linker
+// MISSING: error: cannot find linker '{{.*}}.missing/ld' to merge the objects generated in parts
+
+int a(int n) { return n + 1; }
+int b(int n) { return n - 1; }
+
+// Without the linker, and in assembly output, a function with a target
+// attribute is compiled for the features of the translation unit.
+#ifdef TARGET
+// expected-no-diagnostics
+// TARGET: warning: target features of function 'c' are ignored: no linker to merge objects was given with -codegen-partitions-linker
+// ASM: warning: target features of function 'c' are ignored: they are only supported when generating an object file
+int __attribute__((target("avx2"))) c(int n) { return n * 2; }
+#endif
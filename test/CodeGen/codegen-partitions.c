@@ -0,0 +1,42 @@
+// REQUIRES: system-linker
+// RUN: %clang_cc1 -O2 -emit-obj -o %t.1.o %s
+// RUN: %clang_cc1 -O2 -emit-obj -codegen-partitions 4 -codegen-partitions-linker ld -o %t.4.o %s
+// RUN: llvm-nm %t.1.o | FileCheck %s
+// RUN: llvm-nm %t.4.o | FileCheck %s
+
+// Generating the object in parts defines the same symbols, with the same
+// binding, as generating it at once.
+
+// CHECK-DAG: D {{_?}}counter{{$}}
+int counter = 1;
+// CHECK-DAG: {{[bd]}} {{_?}}hits{{$}}
+static int hits;
+
+// Local symbols stay local, even when they are used from several functions.
+// CHECK-DAG: t {{_?}}bump{{$}}
+__attribute__((noinline)) static void bump(int n) {
+  hits += n;
+}
+
+// CHECK-DAG: T {{_?}}a{{$}}
+int a(int n) { bump(n); return hits; }
+// CHECK-DAG: T {{_?}}b{{$}}
+int b(int n) { bump(-n); return counter; }
+// CHECK-DAG: T {{_?}}c{{$}}
+int c(int *p, int n) {
+  int i, s = 0;
+  for (i = 0; i < n; ++i)
+    s += p[i] * i;
+  return s;
+}
+// CHECK-DAG: T {{_?}}d{{$}}
+void d(void) { ++counter; }
+
+// The constructor list references a local function.
+// CHECK-DAG: t {{_?}}init{{$}}
+__attribute__((constructor)) static void init(void) { counter = 1; }
+
+// CHECK-DAG: U {{_?}}external{{$}}
+extern void external(void);
+// CHECK-DAG: T {{_?}}e{{$}}
+void e(void) { external(); }
@@ -0,0 +1,47 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -emit-llvm -o - %s | FileCheck %s
+
+// Arrays of literals are emitted as a single data array, with the literals
+// converted to the element type and the remaining elements zero-filled.
+
+// CHECK: @bytes = global [6 x i8] c"\01\FFa\00\00\00"
+unsigned char bytes[6] = { 0x01, 0xff, 'a' };
+
+// CHECK: @schars = global [4 x i8] c"\FF\80\7F\00"
+signed char schars[] = { -1, -128, 127, 0 };
+
+// CHECK: @shorts = global [4 x i16] [i16 1, i16 -1, i16 0, i16 4]
+short shorts[] = { 1, -1, [3] = 4 };
+
+// CHECK: @ints = global [3 x i32] [i32 -2147483648, i32 65, i32 0]
+int ints[3] = { -2147483648, 'A' };
+
+// CHECK: @longs = global [2 x i64] [i64 -1, i64 4294967296]
+long long longs[] = { -1, 4294967296 };
+
+// CHECK: @floats = global [3 x float] [float 1.000000e+00, float -2.500000e+00, float 0x3FB99999A0000000]
+float floats[] = { 1, -2.5, .1 };
+
+// CHECK: @doubles = constant [2 x double] [double -3.000000e+00, double 5.000000e-01]
+const double doubles[] = { -3, +.5f };
+
+// CHECK: @zeros = global [1000 x i32] zeroinitializer
+int zeros[1000] = { 0, 0 };
+
+// CHECK: @rows = global [3 x [3 x i16]] {{\[}}[3 x i16] [i16 1, i16 2, i16 3], [3 x i16] [i16 4, i16 0, i16 0], [3 x i16] zeroinitializer]
+short rows[3][3] = { { 1, 2, 3 }, { 4 } };
+
+// CHECK: @names = global [3 x [4 x i8]] {{\[}}[4 x i8] c"one\00", [4 x i8] c"two\00", [4 x i8] zeroinitializer]
+char names[3][4] = { "one", "two" };
+
+// CHECK: @string = global [8 x i8] c"string\00\00"
+char string[8] = "string";
+
+// Initializers that are not all literals take the general path.
+// CHECK: @mixed = global [3 x i32] [i32 1, i32 2, i32 3]
+int mixed[3] = { 1, 1 + 1, 3 };
+
+void local(void) {
+  // CHECK: @local.table = internal global [4 x i8] c"\01\02\03\00"
+  static unsigned char table[4] = { 1, 2, 3 };
+  (void)table;
+}
@@ -0,0 +1,31 @@
+// REQUIRES: native
+// RUN: %clang -fprofile-instr-generate -c %s -o %t.o
+// RUN: %clang -c %S/../../utils/profile/InstrProfilingRuntime.c -o %t.rt.o
+// RUN: %clang %t.o %t.rt.o -o %t
+// RUN: env LLVM_PROFILE_FILE=%t.1.profdata %t 1
+// RUN: env LLVM_PROFILE_FILE=%t.2.profdata %t 1 2 3
+// RUN: python %S/../../utils/profile/merge-instr-profiles.py -o %t.profdata %t.1.profdata %t.2.profdata
+// RUN: %clang -S -emit-llvm -fprofile-instr-use=%t.profdata -Werror=profile-instr-out-of-date %s -o - | FileCheck %s
+
+// Profiles written by the runtime and merged by the script are read back by
+// the compiler. The two runs call classify with 0 and 1, then with 0 to 3.
+
+// CHECK-LABEL: define i32 @classify(
+// CHECK: br i1 %{{.*}}, label %{{.*}}, label %{{.*}}, !prof ![[IF:[0-9]+]]
+int classify(int n) {
+  if (n > 2)
+    return 1;
+  return 0;
+}
+
+// CHECK-LABEL: define i32 @main(
+// CHECK: br i1 %{{.*}}, label %{{.*}}, label %{{.*}}, !prof ![[FOR:[0-9]+]]
+int main(int argc, char **argv) {
+  int s = 0;
+  for (int i = 0; i < argc; ++i)
+    s += classify(i);
+  return s > 100;
+}
+
+// CHECK-DAG: ![[IF]] = metadata !{metadata !"branch_weights", i32 2, i32 6}
+// CHECK-DAG: ![[FOR]] = metadata !{metadata !"branch_weights", i32 7, i32 3}
@@ -0,0 +1,74 @@
+// RUN: cd %S && %clang_cc1 -triple x86_64-unknown-linux-gnu -main-file-name instr-profile-generate.c instr-profile-generate.c -o - -emit-llvm -fprofile-instr-generate | FileCheck %s
+// RUN: cd %S/.. && %clang_cc1 -triple x86_64-unknown-linux-gnu -main-file-name instr-profile-generate.c CodeGen/instr-profile-generate.c -o - -emit-llvm -fprofile-instr-generate | FileCheck -check-prefix=PATH %s
+
+// Each function gets an array of counters: one for its entry, two for each
+// two-way branch and one for each switch edge. It is registered with a hash of
+// the statements that own the counters. Functions with local linkage are
+// qualified with the path of the main file.
+
+// CHECK-DAG: @__llvm_profile_counters_branches = internal global [13 x i64] zeroinitializer
+// CHECK-DAG: @__llvm_profile_counters_switches = internal global [5 x i64] zeroinitializer
+// CHECK-DAG: @__llvm_profile_counters_helper = internal global [1 x i64] zeroinitializer
+// CHECK-DAG: c"branches\00"
+// CHECK-DAG: c"instr-profile-generate.c:helper\00"
+// PATH: c"CodeGen/instr-profile-generate.c:helper\00"
+// CHECK-DAG: @llvm.global_ctors = appending global {{.*}} @__llvm_profile_register_functions
+
+// CHECK-LABEL: define i32 @branches(
+// CHECK-DAG: load i64* getelementptr inbounds ([13 x i64]* @__llvm_profile_counters_branches, i64 0, i64 0)
+// CHECK-DAG: load i64* getelementptr inbounds ([13 x i64]* @__llvm_profile_counters_branches, i64 0, i64 1)
+// CHECK-DAG: load i64* getelementptr inbounds ([13 x i64]* @__llvm_profile_counters_branches, i64 0, i64 2)
+// CHECK-DAG: load i64* getelementptr inbounds ([13 x i64]* @__llvm_profile_counters_branches, i64 0, i64 3)
+// CHECK-DAG: load i64* getelementptr inbounds ([13 x i64]* @__llvm_profile_counters_branches, i64 0, i64 4)
+// CHECK-DAG: load i64* getelementptr inbounds ([13 x i64]* @__llvm_profile_counters_branches, i64 0, i64 5)
+// CHECK-DAG: load i64* getelementptr inbounds ([13 x i64]* @__llvm_profile_counters_branches, i64 0, i64 6)
+// CHECK-DAG: load i64* getelementptr inbounds ([13 x i64]* @__llvm_profile_counters_branches, i64 0, i64 7)
+// CHECK-DAG: load i64* getelementptr inbounds ([13 x i64]* @__llvm_profile_counters_branches, i64 0, i64 8)
+// CHECK-DAG: load i64* getelementptr inbounds ([13 x i64]* @__llvm_profile_counters_branches, i64 0, i64 9)
+// CHECK-DAG: load i64* getelementptr inbounds ([13 x i64]* @__llvm_profile_counters_branches, i64 0, i64 10)
+// CHECK-DAG: load i64* getelementptr inbounds ([13 x i64]* @__llvm_profile_counters_branches, i64 0, i64 11)
+// CHECK-DAG: load i64* getelementptr inbounds ([13 x i64]* @__llvm_profile_counters_branches, i64 0, i64 12)
+int branches(int x, int n) {
+  int s = 0;
+  if (x > 0)
+    s = 1;
+  for (int i = 0; i < n; ++i)
+    s += i;
+  while (s > 100)
+    s /= 2;
+  do {
+    --s;
+  } while (s > 10);
+  return s && x ? s + 1 : x - 1;
+}
+
+static int helper(int x) {
+  return x;
+}
+
+// CHECK-LABEL: define i32 @switches(
+// CHECK: switch i32 %{{.*}}, label %pgo.count{{[0-9]*}} [
+// CHECK-NEXT: i32 1, label %pgo.count{{[0-9]*}}
+// CHECK-NEXT: i32 2, label %pgo.count{{[0-9]*}}
+// CHECK-NEXT: i32 3, label %pgo.count{{[0-9]*}}
+// CHECK-NEXT: ]
+// CHECK-DAG: load i64* getelementptr inbounds ([5 x i64]* @__llvm_profile_counters_switches, i64 0, i64 1)
+// CHECK-DAG: load i64* getelementptr inbounds ([5 x i64]* @__llvm_profile_counters_switches, i64 0, i64 2)
+// CHECK-DAG: load i64* getelementptr inbounds ([5 x i64]* @__llvm_profile_counters_switches, i64 0, i64 3)
+// CHECK-DAG: load i64* getelementptr inbounds ([5 x i64]* @__llvm_profile_counters_switches, i64 0, i64 4)
+int switches(int x) {
+  switch (x) {
+  case 1:
+    return 10;
+  case 2:
+  case 3:
+    return helper(20);
+  default:
+    return 30;
+  }
+}
+
+// CHECK-LABEL: define internal void @__llvm_profile_register_functions()
+// CHECK: call void @__llvm_profile_register_function(i8* {{.*}}, i64 6612923463139649961, i32 13, i64* getelementptr inbounds ([13 x i64]* @__llvm_profile_counters_branches, i32 0, i32 0))
+// CHECK: call void @__llvm_profile_register_function(i8* {{.*}}, i64 -7724119988197897361, i32 5, i64* getelementptr inbounds ([5 x i64]* @__llvm_profile_counters_switches, i32 0, i32 0))
+// CHECK: ret void
@@ -0,0 +1,71 @@
+// RUN: cd %S && %clang_cc1 -triple x86_64-unknown-linux-gnu -main-file-name instr-profile-use.c instr-profile-use.c -o - -emit-llvm -fprofile-instr-use=Inputs/instr-profile-use.profdata 2>&1 | FileCheck %s
+// RUN: not %clang_cc1 %s -o - -emit-llvm -fprofile-instr-use=%t.missing 2>&1 | FileCheck -check-prefix=MISSING %s
+// RUN: cat %S/Inputs/instr-profile-use.profdata %S/Inputs/instr-profile-use.profdata > %t.dup
+// RUN: not %clang_cc1 %s -o - -emit-llvm -fprofile-instr-use=%t.dup 2>&1 | FileCheck -check-prefix=DUP %s
+
+// The counts of each branch become its branch weights, and the entry counts
+// mark functions as hot or cold. Records are matched on the structural hash of
+// the function: the profile also holds a stale version of branches with the
+// same number of counters, and a version of mismatched with another hash.
+
+// CHECK: warning: profile data may be out of date: of 4 functions, 1 has mismatched data that will be ignored
+// MISSING: error: could not read profile data file '{{.*}}.missing'
+// DUP: error: could not read profile data file '{{.*}}.dup': duplicate function 'branches'
+
+// CHECK-LABEL: define i32 @branches(i32 %x, i32 %n) [[NORMAL:#[0-9]+]]
+int branches(int x, int n) {
+  int s = 0;
+  // CHECK: br i1 %{{.*}}, label %{{.*}}, label %{{.*}}, !prof ![[IF:[0-9]+]]
+  if (x > 0)
+    s = 1;
+  // CHECK: br i1 %{{.*}}, label %{{.*}}, label %{{.*}}, !prof ![[FOR:[0-9]+]]
+  for (int i = 0; i < n; ++i)
+    s += i;
+  // CHECK: br i1 %{{.*}}, label %{{.*}}, label %{{.*}}, !prof ![[WHILE:[0-9]+]]
+  while (s > 100)
+    s /= 2;
+  do {
+    --s;
+  // CHECK: br i1 %{{.*}}, label %{{.*}}, label %{{.*}}, !prof ![[DO:[0-9]+]]
+  } while (s > 10);
+  // CHECK: br i1 %{{.*}}, label %{{.*}}, label %{{.*}}, !prof ![[AND_LHS:[0-9]+]]
+  // CHECK: br i1 %{{.*}}, label %{{.*}}, label %{{.*}}, !prof ![[AND_RHS:[0-9]+]]
+  return s && x ? s + 1 : x - 1;
+}
+
+// CHECK-LABEL: define i32 @switches(i32 %x) [[COLD:#[0-9]+]]
+// CHECK: switch i32 %{{.*}}, label %{{.*}} [
+// CHECK: ], !prof ![[SWITCH:[0-9]+]]
+static int helper(int x);
+int switches(int x) {
+  switch (x) {
+  case 1:
+    return 10;
+  case 2:
+  case 3:
+    return helper(20);
+  default:
+    return 30;
+  }
+}
+
+// CHECK-LABEL: define internal i32 @helper(i32 %x) [[HOT:#[0-9]+]]
+static int helper(int x) {
+  return x;
+}
+
+int mismatched(int x) {
+  return x;
+}
+
+// CHECK-DAG: attributes [[NORMAL]] = { nounwind
+// CHECK-DAG: attributes [[COLD]] = { cold nounwind
+// CHECK-DAG: attributes [[HOT]] = { inlinehint nounwind
+
+// CHECK-DAG: ![[IF]] = metadata !{metadata !"branch_weights", i32 8, i32 4}
+// CHECK-DAG: ![[FOR]] = metadata !{metadata !"branch_weights", i32 41, i32 11}
+// CHECK-DAG: ![[WHILE]] = metadata !{metadata !"branch_weights", i32 3, i32 11}
+// CHECK-DAG: ![[DO]] = metadata !{metadata !"branch_weights", i32 91, i32 11}
+// CHECK-DAG: ![[AND_LHS]] = metadata !{metadata !"branch_weights", i32 9, i32 3}
+// CHECK-DAG: ![[AND_RHS]] = metadata !{metadata !"branch_weights", i32 7, i32 3}
+// CHECK-DAG: ![[SWITCH]] = metadata !{metadata !"branch_weights", i32 2, i32 6, i32 3, i32 3}
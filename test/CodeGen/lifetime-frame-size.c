@@ -0,0 +1,37 @@
+// REQUIRES: x86-registered-target
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -O2 -S -o - %s | FileCheck %s
+
+// Objects whose lifetimes do not overlap share a stack slot, so each of these
+// functions only needs a frame for one of its 4096-byte objects.
+
+struct Big { char data[4096]; };
+struct Big make(int);
+void use(struct Big *);
+
+// CHECK-LABEL: temporaries:
+// CHECK: subq $4{{[0-9][0-9][0-9]}}, %rsp
+// CHECK: .cfi_endproc
+int temporaries(int i) {
+  int s = 0;
+  s += make(1).data[i];
+  s += make(2).data[i];
+  s += make(3).data[i];
+  return s;
+}
+
+// CHECK-LABEL: blocks:
+// CHECK: subq $4{{[0-9][0-9][0-9]}}, %rsp
+// CHECK: .cfi_endproc
+void blocks(int n) {
+  if (n) {
+    struct Big a;
+    use(&a);
+  } else {
+    struct Big b;
+    use(&b);
+  }
+  {
+    struct Big c;
+    use(&c);
+  }
+}
@@ -0,0 +1,72 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -O1 -disable-llvm-optzns -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -O0 -emit-llvm -o - %s | FileCheck %s -check-prefix=O0
+
+// O0-NOT: @llvm.lifetime
+
+struct Pair { int a, b; };
+struct Big { char data[64]; };
+struct Big make(int);
+void take(struct Big);
+void use(void *);
+
+// Aggregates get lifetime markers whatever their size; scalars only when they
+// are larger than 32 bytes.
+// CHECK-LABEL: define void @block_scoped
+void block_scoped(int n) {
+  // CHECK-NOT: @llvm.lifetime.start(i64 4,
+  int i = n;
+  if (n) {
+    // CHECK: call void @llvm.lifetime.start(i64 8,
+    // CHECK: call void @use
+    // CHECK: call void @llvm.lifetime.end(i64 8,
+    struct Pair p = { i, n };
+    use(&p);
+  }
+  // CHECK: ret void
+}
+
+// The temporary of each statement ends its lifetime at the end of the
+// statement.
+// CHECK-LABEL: define i32 @temporaries
+int temporaries(int i) {
+  int s = 0;
+  // CHECK: call void @llvm.lifetime.start(i64 64,
+  // CHECK-NEXT: call void @make(%struct.Big* sret {{%[^,]*}}, i32 1)
+  // CHECK: call void @llvm.lifetime.end(i64 64,
+  s += make(1).data[i];
+  // CHECK: call void @llvm.lifetime.start(i64 64,
+  // CHECK-NEXT: call void @make(%struct.Big* sret {{%[^,]*}}, i32 2)
+  // CHECK: call void @llvm.lifetime.end(i64 64,
+  s += make(2).data[i];
+  // CHECK: ret i32
+  return s;
+}
+
+// An argument passed by value is built in a temporary that lives until the
+// end of the full-expression.
+// CHECK-LABEL: define void @arguments
+void arguments(void) {
+  // CHECK: call void @llvm.lifetime.start(i64 64,
+  // CHECK-NEXT: call void @make(%struct.Big* sret [[A:%[^,]*]], i32 1)
+  // CHECK-NEXT: call void @take(%struct.Big* byval {{.*}}[[A]])
+  // CHECK-NEXT: bitcast
+  // CHECK-NEXT: call void @llvm.lifetime.end(i64 64,
+  take(make(1));
+  // CHECK: ret void
+}
+
+// A jump to a label in the scope of a variable bypasses its declaration, so
+// the variable gets no markers.
+// CHECK-LABEL: define void @bypassed
+void bypassed(int n) {
+  // CHECK-NOT: @llvm.lifetime
+  // CHECK: ret void
+  if (n)
+    goto inside;
+  {
+    struct Big b;
+    use(&b);
+  inside:
+    use(&b);
+  }
+}
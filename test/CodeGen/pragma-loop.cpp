@@ -0,0 +1,76 @@
+// RUN: %clang_cc1 -triple x86_64-apple-darwin -std=c++11 -emit-llvm -o - %s | FileCheck %s
+
+// The hints of '#pragma clang loop' are attached as llvm.loop metadata to the
+// branch that closes the loop.
+
+// CHECK-LABEL: define void @_Z10while_testPii
+void while_test(int *List, int Length) {
+  int i = 0;
+
+#pragma clang loop vectorize(enable)
+#pragma clang loop interleave_count(4)
+  while (i < Length) {
+    // CHECK: br label {{.*}}, !llvm.loop ![[LOOP_1:.*]]
+    List[i] = i * 2;
+    i++;
+  }
+}
+
+// CHECK-LABEL: define void @_Z7do_testPii
+void do_test(int *List, int Length) {
+  int i = 0;
+
+#pragma clang loop vectorize_width(8) unroll(disable)
+  do {
+    // CHECK: br i1 {{.*}}, label {{.*}}, label {{.*}}, !llvm.loop ![[LOOP_2:.*]]
+    List[i] = i * 2;
+    i++;
+  } while (i < Length);
+}
+
+// CHECK-LABEL: define void @_Z8for_testPii
+void for_test(int *List, int Length) {
+#pragma clang loop vectorize(disable) interleave(disable)
+#pragma clang loop unroll_count(4)
+  for (int i = 0; i < Length; i++) {
+    // CHECK: br label {{.*}}, !llvm.loop ![[LOOP_3:.*]]
+    List[i] = i * 2;
+  }
+}
+
+// CHECK-LABEL: define void @_Z14for_range_testv
+void for_range_test() {
+  double List[100];
+
+#pragma clang loop vectorize_width(2) interleave_count(2)
+  for (int i : List) {
+    // CHECK: br label {{.*}}, !llvm.loop ![[LOOP_4:.*]]
+    List[i] = i;
+  }
+}
+
+// A loop without hints gets no metadata.
+// CHECK-LABEL: define void @_Z12no_hint_testPii
+void no_hint_test(int *List, int Length) {
+  for (int i = 0; i < Length; i++) {
+    // CHECK: br label
+    // CHECK-NOT: !llvm.loop
+    // CHECK: ret void
+    List[i] = i * 2;
+  }
+}
+
+// The hints are in the order of the source.
+// CHECK: ![[LOOP_1]] = metadata !{metadata ![[LOOP_1]], metadata ![[ENABLE_1:.*]], metadata ![[UNROLL_4:.*]]}
+// CHECK: ![[ENABLE_1]] = metadata !{metadata !"llvm.vectorizer.enable", i1 true}
+// CHECK: ![[UNROLL_4]] = metadata !{metadata !"llvm.vectorizer.unroll", i32 4}
+// CHECK: ![[LOOP_2]] = metadata !{metadata ![[LOOP_2]], metadata ![[WIDTH_8:.*]], metadata ![[UNROLL_DISABLE:.*]]}
+// CHECK: ![[WIDTH_8]] = metadata !{metadata !"llvm.vectorizer.width", i32 8}
+// CHECK: ![[UNROLL_DISABLE]] = metadata !{metadata !"llvm.loop.unroll.enable", i1 false}
+// CHECK: ![[LOOP_3]] = metadata !{metadata ![[LOOP_3]], metadata ![[WIDTH_1:.*]], metadata ![[INTERLEAVE_1:.*]], metadata ![[UNROLL_COUNT_4:.*]]}
+// CHECK: ![[WIDTH_1]] = metadata !{metadata !"llvm.vectorizer.width", i32 1}
+// CHECK: ![[INTERLEAVE_1]] = metadata !{metadata !"llvm.vectorizer.unroll", i32 1}
+// CHECK: ![[UNROLL_COUNT_4]] = metadata !{metadata !"llvm.loop.unroll.count", i32 4}
+// CHECK: ![[LOOP_4]] = metadata !{metadata ![[LOOP_4]], metadata ![[WIDTH_2:.*]], metadata ![[INTERLEAVE_2:.*]]}
+// CHECK: ![[WIDTH_2]] = metadata !{metadata !"llvm.vectorizer.width", i32 2}
+// CHECK: ![[INTERLEAVE_2]] = metadata !{metadata !"llvm.vectorizer.unroll", i32 2}
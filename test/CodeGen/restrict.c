@@ -24,3 +24,29 @@ void test3(rp x, int y) {
 void test4(int *x, rp y) {
 }
 
+
+// Restrict-qualified members of a struct passed in registers.
+
+struct pair { int * restrict a; int * restrict b; };
+
+// CHECK: define void @test5(i32* noalias %{{.*}}, i32* noalias %{{.*}})
+void test5(struct pair p) {
+}
+
+struct mixed { int * restrict a; int *b; };
+
+// CHECK: define void @test6(i32* noalias %{{.*}}, i32* %{{.*}})
+void test6(struct mixed m) {
+}
+
+struct one { float * restrict a; };
+
+// CHECK: define void @test7(float* noalias %{{.*}})
+void test7(struct one o) {
+}
+
+struct nested { struct one x; int * restrict y; };
+
+// CHECK: define void @test8(float* noalias %{{.*}}, i32* noalias %{{.*}})
+void test8(struct nested n) {
+}
@@ -0,0 +1,83 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -O1 -disable-llvm-optzns -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -O1 -no-struct-path-tbaa -disable-llvm-optzns -emit-llvm -o - %s | FileCheck %s -check-prefix=SCALAR
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -O2 -emit-llvm -o - %s | FileCheck %s -check-prefix=OPT
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -O2 -no-struct-path-tbaa -emit-llvm -o - %s | FileCheck %s -check-prefix=OPT-SCALAR
+
+// Member accesses are tagged with the enclosing struct, the accessed scalar
+// type and the offset of the member, which tells apart fields of the same
+// type in different structs.
+
+struct A { int x; int y; };
+struct B { int y; };
+struct Outer { short s; struct A in; struct A arr[4]; };
+
+int fields(struct A *a, struct B *b) {
+// CHECK-LABEL: define i32 @fields(
+// CHECK: store i32 1, i32* {{.*}}, !tbaa [[TAG_A_x:![0-9]+]]
+// CHECK: store i32 2, i32* {{.*}}, !tbaa [[TAG_B_y:![0-9]+]]
+// CHECK: load i32* {{.*}}, !tbaa [[TAG_A_x]]
+// SCALAR-LABEL: define i32 @fields(
+// SCALAR: store i32 1, i32* {{.*}}, !tbaa [[INT:![0-9]+]]
+// SCALAR: store i32 2, i32* {{.*}}, !tbaa [[INT]]
+// SCALAR: load i32* {{.*}}, !tbaa [[INT]]
+// OPT-LABEL: define i32 @fields(
+// OPT: ret i32 1
+// OPT-SCALAR-LABEL: define i32 @fields(
+// OPT-SCALAR: [[X:%.*]] = load i32*
+// OPT-SCALAR: ret i32 [[X]]
+  a->x = 1;
+  b->y = 2;
+  return a->x;
+}
+
+void nested(struct Outer *o, int i) {
+// CHECK-LABEL: define void @nested(
+// CHECK: store i32 3, i32* {{.*}}, !tbaa [[TAG_Outer_in_y:![0-9]+]]
+// CHECK: store i32 4, i32* {{.*}}, !tbaa [[TAG_A_y:![0-9]+]]
+// CHECK: store i16 5, i16* {{.*}}, !tbaa [[TAG_Outer_s:![0-9]+]]
+  o->in.y = 3;
+  o->arr[i].y = 4;
+  o->s = 5;
+}
+
+void array_of_structs(struct A *p, int i) {
+// CHECK-LABEL: define void @array_of_structs(
+// CHECK: store i32 6, i32* {{.*}}, !tbaa [[TAG_A_y]]
+  p[i].y = 6;
+}
+
+struct Particle { float x; float v; };
+struct Params { int n; float dt; };
+
+// The load of q->dt is loop-invariant only if the stores to p[i].x, which
+// have the same scalar type, are known not to modify it.
+void step(struct Particle *p, struct Params *q) {
+// OPT-LABEL: define void @step(
+// OPT: [[DT:%.*]] = getelementptr inbounds %struct.Params* %q, i64 0, i32 1
+// OPT: load float* [[DT]]
+// OPT: phi
+// OPT-NOT: load float* [[DT]]
+// OPT: ret void
+// OPT-SCALAR-LABEL: define void @step(
+// OPT-SCALAR: [[DT:%.*]] = getelementptr inbounds %struct.Params* %q, i64 0, i32 1
+// OPT-SCALAR: phi
+// OPT-SCALAR: load float* [[DT]]
+// OPT-SCALAR: ret void
+  int i;
+  for (i = 0; i < q->n; ++i)
+    p[i].x += p[i].v * q->dt;
+}
+
+// CHECK-DAG: [[TAG_A_x]] = metadata !{metadata [[TYPE_A:![0-9]+]], metadata [[TYPE_INT:![0-9]+]], i64 0}
+// CHECK-DAG: [[TYPE_A]] = metadata !{metadata !"_ZTS1A", metadata [[TYPE_INT]], i64 0, metadata [[TYPE_INT]], i64 4}
+// CHECK-DAG: [[TYPE_INT]] = metadata !{metadata !"int", metadata [[TYPE_CHAR:![0-9]+]], i64 0}
+// CHECK-DAG: [[TYPE_CHAR]] = metadata !{metadata !"omnipotent char", metadata !{{[0-9]+}}, i64 0}
+// CHECK-DAG: [[TAG_B_y]] = metadata !{metadata [[TYPE_B:![0-9]+]], metadata [[TYPE_INT]], i64 0}
+// CHECK-DAG: [[TYPE_B]] = metadata !{metadata !"_ZTS1B", metadata [[TYPE_INT]], i64 0}
+// CHECK-DAG: [[TAG_Outer_in_y]] = metadata !{metadata [[TYPE_Outer:![0-9]+]], metadata [[TYPE_INT]], i64 8}
+// CHECK-DAG: [[TYPE_Outer]] = metadata !{metadata !"_ZTS5Outer", metadata [[TYPE_SHORT:![0-9]+]], i64 0, metadata [[TYPE_A]], i64 4, metadata [[TYPE_CHAR]], i64 12}
+// CHECK-DAG: [[TAG_A_y]] = metadata !{metadata [[TYPE_A]], metadata [[TYPE_INT]], i64 4}
+// CHECK-DAG: [[TAG_Outer_s]] = metadata !{metadata [[TYPE_Outer]], metadata [[TYPE_SHORT]], i64 0}
+// CHECK-DAG: [[TYPE_SHORT]] = metadata !{metadata !"short", metadata [[TYPE_CHAR]], i64 0}
+
+// SCALAR: [[INT]] = metadata !{metadata !"int", metadata !{{[0-9]+}}}
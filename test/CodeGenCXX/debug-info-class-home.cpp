@@ -0,0 +1,67 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -emit-llvm -g -fno-emit-class-debug-always %s -o - | FileCheck %s
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -emit-llvm -g -fno-emit-class-debug-always %s -o - | FileCheck %s -check-prefix=NODEF
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -emit-llvm -g %s -o - | FileCheck %s -check-prefix=ALWAYS
+
+// With -fno-emit-class-debug-always, a dynamic class is only described in the
+// unit that emits its vtable, and an explicitly instantiated template in the
+// unit with the explicit instantiation definition. Other units only declare
+// them.
+
+// CHECK-DAG: [ DW_TAG_structure_type ] [Elsewhere] [line [[@LINE+2]], {{.*}} [decl]
+// ALWAYS-DAG: [ DW_TAG_structure_type ] [Elsewhere] [line [[@LINE+1]], {{.*}} [def]
+struct Elsewhere {
+  virtual ~Elsewhere();
+  int member;
+};
+void use_elsewhere(Elsewhere &e) { e.member = 1; }
+
+// The key function is defined here, so is the class, even though nothing
+// else refers to it.
+// CHECK-DAG: [ DW_TAG_structure_type ] [Here] [line [[@LINE+1]], {{.*}} [def]
+struct Here {
+  virtual ~Here();
+  int member;
+};
+Here::~Here() {}
+
+// Without a key function, the vtable is emitted wherever it is used.
+// CHECK-DAG: [ DW_TAG_structure_type ] [Inline] [line [[@LINE+1]], {{.*}} [def]
+struct Inline {
+  virtual void f() {}
+  int member;
+};
+void use_inline() { Inline i; i.f(); }
+
+template <typename T> struct Tmpl {
+  T member;
+};
+
+// CHECK-DAG: [ DW_TAG_structure_type ] [Tmpl<int>] {{.*}} [decl]
+// ALWAYS-DAG: [ DW_TAG_structure_type ] [Tmpl<int>] {{.*}} [def]
+extern template struct Tmpl<int>;
+void use_tmpl(Tmpl<int> &t) { t.member = 0; }
+
+// CHECK-DAG: [ DW_TAG_structure_type ] [Tmpl<long>] {{.*}} [def]
+template struct Tmpl<long>;
+
+// Other classes are described wherever they are needed.
+// CHECK-DAG: [ DW_TAG_structure_type ] [Plain] [line [[@LINE+1]], {{.*}} [def]
+struct Plain {
+  int member;
+};
+void use_plain(Plain &p) { p.member = 0; }
+
+// A class nested in a class described elsewhere only needs a declaration of
+// the outer class as its scope.
+// CHECK-DAG: [ DW_TAG_structure_type ] [Outer] [line [[@LINE+1]], {{.*}} [decl]
+struct Outer {
+  virtual ~Outer();
+// CHECK-DAG: [ DW_TAG_structure_type ] [Inner] [line [[@LINE+1]], {{.*}} [def]
+  struct Inner {
+    int member;
+  };
+};
+void use_inner(Outer::Inner &i) { i.member = 0; }
+
+// NODEF-NOT: [ DW_TAG_structure_type ] [Elsewhere] {{.*}} [def]
+// NODEF-NOT: [ DW_TAG_structure_type ] [Outer] {{.*}} [def]
@@ -0,0 +1,16 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-linux-gnu %s -o - -emit-llvm -fprofile-instr-generate | FileCheck %s
+
+// Inline functions may be emitted in several translation units, and their
+// counters are merged along with them.
+
+// CHECK-DAG: @__llvm_profile_counters__Z6selecti = linkonce_odr global [3 x i64] zeroinitializer
+// CHECK-DAG: @__llvm_profile_counters__Z3usev = internal global [1 x i64] zeroinitializer
+inline int select(int x) {
+  if (x)
+    return 1;
+  return 2;
+}
+
+int use() {
+  return select(5);
+}
@@ -0,0 +1,44 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -O1 -disable-llvm-optzns -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -O0 -emit-llvm -o - %s | FileCheck %s -check-prefix=O0
+
+// O0-NOT: @llvm.lifetime
+
+struct A {
+  A();
+  ~A();
+  int x;
+};
+void f(const A &);
+
+// A temporary bound to a reference parameter lives until the end of the
+// full-expression; its lifetime ends after it has been destroyed.
+// CHECK-LABEL: define void @_Z5firstv()
+void first() {
+  // CHECK: [[T:%.*]] = alloca %struct.A
+  // CHECK: call void @llvm.lifetime.start(i64 4,
+  // CHECK-NEXT: call void @_ZN1AC1Ev(%struct.A* [[T]])
+  // CHECK-NEXT: call void @_Z1fRK1A(%struct.A* [[T]])
+  // CHECK-NEXT: call void @_ZN1AD1Ev(%struct.A* [[T]])
+  // CHECK-NEXT: bitcast %struct.A* [[T]] to i8*
+  // CHECK-NEXT: call void @llvm.lifetime.end(i64 4,
+  f(A());
+  // CHECK: ret void
+}
+
+// A temporary that is only created on some paths through the full-expression
+// gets no markers.
+// CHECK-LABEL: define void @_Z11conditionalb
+void conditional(bool b) {
+  // CHECK-NOT: @llvm.lifetime
+  // CHECK: ret void
+  b ? f(A()) : void();
+}
+
+// A temporary bound to a local reference lives as long as the reference.
+// CHECK-LABEL: define void @_Z8extendedv()
+void extended() {
+  // CHECK-NOT: @llvm.lifetime
+  // CHECK: ret void
+  const A &a = A();
+  f(a);
+}
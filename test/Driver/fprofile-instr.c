@@ -0,0 +1,7 @@
+// RUN: %clang -### -S -fprofile-instr-generate %s 2>&1 | FileCheck -check-prefix=CHECK-GENERATE %s
+// RUN: %clang -### -S -fprofile-instr-use=file.profdata %s 2>&1 | FileCheck -check-prefix=CHECK-USE %s
+// RUN: %clang -### -S %s 2>&1 | FileCheck -check-prefix=CHECK-NONE %s
+
+// CHECK-GENERATE: "-fprofile-instr-generate"
+// CHECK-USE: "-fprofile-instr-use=file.profdata"
+// CHECK-NONE-NOT: "-fprofile-instr
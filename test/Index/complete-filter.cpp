@@ -0,0 +1,29 @@
+// The run lines are below, because this test is line- and
+// column-number sensitive.
+struct Widget {
+  int width;
+  int height;
+  int windowCount;
+  void setWidth(int);
+  int getWidth() const;
+};
+
+void f(Widget &w) {
+  w.width = 0;
+}
+
+// RUN: env CINDEXTEST_COMPLETION_FILTER=wid c-index-test -code-completion-at=%s:12:5 %s | FileCheck -check-prefix=CHECK-WID %s
+// CHECK-WID: FieldDecl:{ResultType int}{TypedText width} (35)
+// CHECK-WID-NOT: height
+// CHECK-WID-NOT: Height
+// CHECK-WID: Completion contexts:
+
+// Typing more characters narrows the results down further.
+// RUN: env CINDEXTEST_COMPLETION_FILTER=setw c-index-test -code-completion-at=%s:12:5 %s | FileCheck -check-prefix=CHECK-SETW %s
+// CHECK-SETW: CXXMethod:{ResultType void}{TypedText setWidth}{LeftParen (}{Placeholder int}{RightParen )} (34)
+// CHECK-SETW-NEXT: Completion contexts:
+
+// Matching is by subsequence and ignores case.
+// RUN: env CINDEXTEST_COMPLETION_FILTER=gw c-index-test -code-completion-at=%s:12:5 %s | FileCheck -check-prefix=CHECK-GW %s
+// CHECK-GW: CXXMethod:{ResultType int}{TypedText getWidth}{LeftParen (}{RightParen )}{Informative  const} (35)
+// CHECK-GW-NEXT: Completion contexts:
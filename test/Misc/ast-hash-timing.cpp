@@ -0,0 +1,14 @@
+// RUN: %clang_cc1 -ast-hash-timing %s 2>&1 | FileCheck %s
+
+int f(int x) { return x + 1; }
+int g(int y) { return y + 1; }
+int declared(int);
+
+template<typename T> T h(T t) { return t + 1; }
+int use() { return h(1); }
+
+// The template and its instantiation both have bodies.
+// CHECK: *** Function body hashing:
+// CHECK-NEXT: 5 function bodies
+// CHECK-NEXT: {{[0-9.]+}}s with StructuralHasher, {{[0-9]+}} distinct
+// CHECK-NEXT: {{[0-9.]+}}s with Stmt::Profile, {{[0-9]+}} distinct
@@ -0,0 +1,117 @@
+// RUN: %clang_cc1 -fopenmp -triple x86_64-unknown-linux -emit-llvm -o - %s | FileCheck %s
+// RUN: %clang_cc1 -fopenmp -triple i386-unknown-linux -emit-llvm -o - %s | FileCheck -check-prefix=CHECK32 %s
+// REQUIRES: asserts
+
+void foo(int);
+
+struct S {
+  S();
+  ~S();
+};
+
+// CHECK-LABEL: define void @_Z8parallelii
+void parallel(int a, int b) {
+  // CHECK: [[CTX:%.*]] = alloca %struct.anon
+  // CHECK: [[DATA:%.*]] = bitcast %struct.anon* [[CTX]] to i8*
+  // CHECK: call void @GOMP_parallel_start(void (i8*)* bitcast (void (%struct.anon*)* [[OUTLINED:@[^ ]*]] to void (i8*)*), i8* [[DATA]], i32 0)
+  // CHECK-NEXT: call void [[OUTLINED]](%struct.anon* [[CTX]])
+  // CHECK-NEXT: call void @GOMP_parallel_end()
+#pragma omp parallel private(b)
+  {
+    S s;
+    b = a;
+    foo(b);
+  }
+}
+
+// The private copy of 'b' is a local of the outlined function, while 'a' is
+// shared through the captured struct.
+// CHECK: define internal void [[OUTLINED]](%struct.anon*
+// CHECK: [[B:%b.private]] = alloca i32
+// CHECK: call void @_ZN1SC1Ev
+// CHECK: getelementptr inbounds %struct.anon*
+// CHECK: store i32 {{.*}}, i32* [[B]]
+// CHECK: call void @_Z3fooi
+// CHECK: call void @_ZN1SD1Ev
+// CHECK: ret void
+
+// CHECK-LABEL: define void @_Z12parallel_forPii
+void parallel_for(int *a, int n) {
+  // CHECK: call void @GOMP_parallel_start(void (i8*)* bitcast (void (%struct.anon.0*)* [[OUTLINED_FOR:@[^ ]*]] to void (i8*)*)
+  // CHECK-NEXT: call void [[OUTLINED_FOR]](
+  // CHECK-NEXT: call void @GOMP_parallel_end()
+#pragma omp parallel for schedule(dynamic, 4)
+  for (int i = 0; i < n; i += 2)
+    a[i] = i;
+}
+
+// The iterations [0, n) are handed out in chunks by the runtime.
+// CHECK: define internal void [[OUTLINED_FOR]](
+// CHECK: call i8 @GOMP_loop_dynamic_start(i64 0, i64 {{%.*}}, i64 2, i64 4, i64* [[ISTART:%[^,]*]], i64* [[IEND:%[^)]*]])
+// CHECK: br i1 {{%.*}}, label %omp.loop.chunk, label %omp.loop.end
+// CHECK: omp.loop.chunk:
+// CHECK: load i64* [[ISTART]]
+// CHECK: omp.loop.cond:
+// CHECK: icmp slt i64
+// CHECK: omp.loop.body:
+// CHECK: trunc i64 {{.*}} to i32
+// CHECK: omp.loop.inc:
+// CHECK: add i64 {{.*}}, 2
+// CHECK: omp.loop.next:
+// CHECK: call i8 @GOMP_loop_dynamic_next(i64* [[ISTART]], i64* [[IEND]])
+// CHECK: omp.loop.end:
+// CHECK: call void @GOMP_loop_end()
+// CHECK: ret void
+
+// An unsigned loop that counts down uses the 'unsigned long long' entry points.
+// CHECK-LABEL: define void @_Z16parallel_for_ullPij
+void parallel_for_ull(int *a, unsigned n) {
+#pragma omp parallel for
+  for (unsigned i = n; i >= 1; --i)
+    a[i] = 0;
+}
+
+// CHECK: define internal void @.omp_outlined.{{.*}}(
+// CHECK: call i8 @GOMP_loop_ull_static_start(i8 zeroext 0, i64 {{%.*}}, i64 0, i64 -1, i64 0, i64*
+// CHECK: icmp ugt i64
+// CHECK: call i8 @GOMP_loop_ull_static_next(
+// CHECK: call void @GOMP_loop_end()
+
+// A chunk size that is not a constant is evaluated before the region and
+// passed to the outlined function after the captured struct.
+// CHECK-LABEL: define void @_Z18parallel_for_chunkPiii
+void parallel_for_chunk(int *a, int n, int c) {
+  // CHECK: [[CTX:%.*]] = alloca { [[REC:%struct.anon[.0-9]*]], i32 }
+  // CHECK: [[REC_ADDR:%.*]] = getelementptr inbounds { [[REC]], i32 }* [[CTX]], i32 0, i32 0
+  // CHECK: [[C:%.*]] = load i32* %c.addr
+  // CHECK: [[CHUNK_ADDR:%.*]] = getelementptr inbounds { [[REC]], i32 }* [[CTX]], i32 0, i32 1
+  // CHECK: store i32 [[C]], i32* [[CHUNK_ADDR]]
+  // CHECK: call void @GOMP_parallel_start(void (i8*)* bitcast (void ([[REC]]*)* [[OUTLINED_CHUNK:@[^ ]*]] to void (i8*)*)
+  // CHECK-NEXT: call void [[OUTLINED_CHUNK]]([[REC]]* [[REC_ADDR]])
+#pragma omp parallel for schedule(dynamic, c)
+  for (int i = 0; i < n; ++i)
+    a[i] = i;
+}
+
+// CHECK: define internal void [[OUTLINED_CHUNK]]([[REC]]*
+// CHECK: [[WRAPPER:%.*]] = bitcast [[REC]]* {{%.*}} to { [[REC]], i32 }*
+// CHECK: [[ADDR:%.*]] = getelementptr inbounds { [[REC]], i32 }* [[WRAPPER]], i32 0, i32 1
+// CHECK: [[CHUNK:%.*]] = load i32* [[ADDR]]
+// CHECK: [[CHUNK64:%.*]] = sext i32 [[CHUNK]] to i64
+// CHECK: call i8 @GOMP_loop_dynamic_start(i64 0, i64 {{%.*}}, i64 1, i64 [[CHUNK64]], i64*
+
+// A 'long long' loop uses the 'long' entry points where 'long' is as wide,
+// and the biased 'unsigned long long' ones elsewhere.
+// CHECK-LABEL: define void @_Z22parallel_for_long_longPix
+// CHECK32-LABEL: define void @_Z22parallel_for_long_longPix
+void parallel_for_long_long(int *a, long long n) {
+#pragma omp parallel for
+  for (long long i = 0; i < n; ++i)
+    a[i] = 0;
+}
+
+// CHECK: call i8 @GOMP_loop_static_start(i64 0, i64 {{%.*}}, i64 1, i64 0, i64*
+// CHECK32: call i8 @GOMP_loop_ull_static_start(i8 zeroext 1, i64 -9223372036854775808, i64 {{%.*}}, i64 1, i64 0, i64*
+// CHECK32: icmp ult i64
+// CHECK32: [[IV:%.*]] = sub i64 {{%.*}}, -9223372036854775808
+// CHECK32: store i64 [[IV]], i64* %i
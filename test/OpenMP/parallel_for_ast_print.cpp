@@ -0,0 +1,34 @@
+// RUN: %clang_cc1 -verify -fopenmp -ast-print %s | FileCheck %s
+// RUN: %clang_cc1 -fopenmp -x c++ -std=c++11 -emit-pch -o %t %s
+// RUN: %clang_cc1 -fopenmp -std=c++11 -include-pch %t -fsyntax-only -verify %s -ast-print | FileCheck %s
+// expected-no-diagnostics
+
+#ifndef HEADER
+#define HEADER
+
+void foo() {}
+
+int main (int argc, char **argv) {
+  int b = argc, c;
+#pragma omp parallel for
+// CHECK: #pragma omp parallel for
+  for (int i = 0; i < argc; ++i)
+// CHECK-NEXT: for (int i = 0; i < argc; ++i)
+    foo();
+// CHECK-NEXT: foo();
+#pragma omp parallel for default(none), private(c) schedule(dynamic, b + 1)
+// CHECK-NEXT: #pragma omp parallel for default(none) private(c) schedule(dynamic, b + 1)
+  for (b = argc; b > 0; b -= 2)
+// CHECK-NEXT: for (b = argc; b > 0; b -= 2)
+    c = b;
+// CHECK-NEXT: c = b;
+#pragma omp parallel for schedule(runtime)
+// CHECK-NEXT: #pragma omp parallel for schedule(runtime)
+  for (unsigned u = 10; u >= 1; u--)
+// CHECK-NEXT: for (unsigned int u = 10; u >= 1; u--)
+    foo();
+// CHECK-NEXT: foo();
+  return (0);
+}
+
+#endif
@@ -0,0 +1,82 @@
+// RUN: %clang_cc1 -triple x86_64-apple-macos10.7.0 -verify -fopenmp -ferror-limit 100 -o - %s
+
+void foo();
+
+int g;
+
+template <class T, int N>
+T tmain(T argc) {
+  #pragma omp parallel for schedule(dynamic, N) // expected-error {{chunk size of OpenMP clause 'schedule' must be positive}}
+  for (T i = 0; i < argc; ++i)
+    foo();
+  return argc;
+}
+
+int main(int argc, char **argv) {
+  int i;
+  float f;
+  #pragma omp parallel for
+  for (int j = 0; j < argc; ++j)
+    foo();
+  #pragma omp parallel for
+  for (i = argc; i >= 0; i -= 2)
+    foo();
+  #pragma omp parallel for
+  for (g = 0; 10 > g; g++)
+    foo();
+  #pragma omp parallel for private(f) schedule(guided)
+  for (unsigned u = 0; u <= 10u; u = u + 3)
+    foo();
+
+  #pragma omp parallel for
+  foo(); // expected-error {{statement after '#pragma omp parallel for' must be a for loop}}
+  #pragma omp parallel for
+  for (;;) // expected-error {{initialization clause of OpenMP for loop must be of the form 'var = init' or 'T var = init'}}
+    foo();
+  #pragma omp parallel for
+  for (int j = 0, k = 0; j < argc; ++j) // expected-error {{initialization clause of OpenMP for loop must be of the form 'var = init' or 'T var = init'}}
+    foo();
+  #pragma omp parallel for
+  for (f = 0; f < argc; ++f) // expected-error {{loop iteration variable 'f' of OpenMP for loop must have integer type}}
+    foo();
+  #pragma omp parallel for
+  for (i = 0; i != argc; ++i) // expected-error {{condition of OpenMP for loop must be a relational comparison ('<', '<=', '>', or '>=') of loop variable 'i'}}
+    foo();
+  #pragma omp parallel for
+  for (i = 0; argc > 0; ++i) // expected-error {{condition of OpenMP for loop must be a relational comparison ('<', '<=', '>', or '>=') of loop variable 'i'}}
+    foo();
+  #pragma omp parallel for
+  for (i = 0; i < argc; i *= 2) // expected-error {{increment clause of OpenMP for loop must perform simple addition or subtraction on loop variable 'i'}}
+    foo();
+  #pragma omp parallel for
+  for (i = 0; i < argc; ++i) {
+    if (argv[i])
+      break; // expected-error {{'break' statement cannot be used in OpenMP for loop}}
+    for (int j = 0; j < argc; ++j)
+      break;
+    continue;
+  }
+
+  #pragma omp parallel for schedule // expected-error {{expected '(' after 'schedule'}}
+  for (i = 0; i < argc; ++i)
+    foo();
+  #pragma omp parallel for schedule (x) // expected-error {{expected 'static', 'dynamic', 'guided', 'auto' or 'runtime' in OpenMP clause 'schedule'}}
+  for (i = 0; i < argc; ++i)
+    foo();
+  #pragma omp parallel for schedule (static), schedule (dynamic) // expected-error {{directive '#pragma omp parallel for' cannot contain more than one 'schedule' clause}}
+  for (i = 0; i < argc; ++i)
+    foo();
+  #pragma omp parallel for schedule (runtime, 4) // expected-error {{'runtime' schedule kind does not accept a chunk size}}
+  for (i = 0; i < argc; ++i)
+    foo();
+  #pragma omp parallel for schedule (static, f) // expected-error {{chunk size of OpenMP clause 'schedule' must be an integer expression}}
+  for (i = 0; i < argc; ++i)
+    foo();
+  #pragma omp parallel for schedule (guided, 0) // expected-error {{chunk size of OpenMP clause 'schedule' must be positive}}
+  for (i = 0; i < argc; ++i)
+    foo();
+  #pragma omp parallel schedule (static) // expected-error {{unexpected OpenMP clause 'schedule' in directive '#pragma omp parallel'}}
+  foo();
+
+  return tmain<int, 0>(argc); // expected-note {{in instantiation of function template specialization 'tmain<int, 0>' requested here}}
+}
@@ -0,0 +1,49 @@
+// Test this without pch.
+// RUN: %clang_cc1 -triple x86_64-linux-gnu -std=c++11 -include %s -fsyntax-only -verify %s
+
+// Test with pch.
+// RUN: %clang_cc1 -triple x86_64-linux-gnu -std=c++11 -x c++-header -emit-pch -o %t %s
+// RUN: %clang_cc1 -triple x86_64-linux-gnu -std=c++11 -include-pch %t -fsyntax-only -verify %s
+// RUN: %clang_cc1 -triple x86_64-linux-gnu -std=c++11 -include-pch %t -fsyntax-only -print-stats %s 2>&1 | FileCheck %s
+
+// RUN: %clang_cc1 -triple x86_64-linux-gnu -std=c++11 -include-pch %t -fsyntax-only -fdump-record-layouts-simple %s | FileCheck -check-prefix=DUMP %s
+
+// CHECK: record layouts read
+
+// Layouts read from the PCH are dumped like the ones computed here.
+// DUMP: *** Dumping AST Record Layout
+// DUMP: Type: struct Plain
+// DUMP: Size:160
+// DUMP: FieldOffsets: [0, 32, 128]>
+
+#ifndef HEADER
+#define HEADER
+
+struct Empty { };
+struct Base { int b; virtual void f(); };
+struct Other { char c; };
+struct VBase { long v; };
+struct Derived : Empty, Base, Other, virtual VBase {
+  char d;
+  double e;
+};
+struct Plain { char a; int b[3]; short c; };
+
+// Lay the records out while building the PCH.
+char derived_size[sizeof(Derived)];
+char plain_size[sizeof(Plain)];
+
+#else
+
+// expected-no-diagnostics
+
+static_assert(sizeof(Plain) == 20, "");
+static_assert(__builtin_offsetof(Plain, c) == 16, "");
+static_assert(sizeof(Derived) == 32, "");
+static_assert(alignof(Derived) == 8, "");
+
+Derived d;
+Other *o = &d;
+VBase *v = &d;
+
+#endif
@@ -0,0 +1,63 @@
+// Without -fpch-instantiate-templates, the translation unit using the PCH
+// performs the instantiations that the PCH needs.
+// RUN: %clang_cc1 -x c++-header -emit-pch -o %t.1 %s -verify
+// RUN: %clang_cc1 -include-pch %t.1 %s -verify -DUSE_INSTANTIATES -emit-llvm -o - | FileCheck %s
+
+// With it, they're performed while building the PCH, and not repeated.
+// RUN: %clang_cc1 -x c++-header -emit-pch -fpch-instantiate-templates -o %t.2 %s -verify -DPCH_INSTANTIATES
+// RUN: %clang_cc1 -include-pch %t.2 %s -verify -DPCH_INSTANTIATES -emit-llvm -o - | FileCheck %s
+
+#ifndef HEADER
+#define HEADER
+
+template<typename T> T shift(T t) {
+  return t << 40;
+}
+
+inline int useShift() { return shift(1); }
+
+// The definition of this template only follows the PCH, so its instantiation
+// stays pending.
+template<typename T> T later(T t);
+
+inline int useLater() { return later(1); }
+
+// The explicit instantiation instantiates the member of the local class at
+// once, and that instantiates the static data member it uses.
+template<typename T> struct Counter { static int count; };
+template<typename T> int Counter<T>::count = 42;
+
+template<typename T> int readCount() {
+  struct Reader {
+    static int read() { return Counter<T>::count; }
+  };
+  return Reader::read();
+}
+template int readCount<int>();
+
+#ifdef PCH_INSTANTIATES
+// expected-warning@14 {{shift count >= width of type}}
+// expected-note@17 {{in instantiation of function template specialization 'shift<int>' requested here}}
+#else
+// expected-no-diagnostics
+#endif
+
+#else
+
+#ifdef USE_INSTANTIATES
+// expected-warning@14 {{shift count >= width of type}}
+// expected-note@17 {{in instantiation of function template specialization 'shift<int>' requested here}}
+#else
+// expected-no-diagnostics
+#endif
+
+template<typename T> T later(T t) { return t; }
+
+int main() { return useShift() + useLater() + readCount<int>(); }
+
+// CHECK-DAG: @_ZN7CounterIiE5countE = {{.*}}global i32 42
+// CHECK-DAG: define linkonce_odr i32 @_Z5shiftIiET_S0_
+// CHECK-DAG: define linkonce_odr i32 @_Z5laterIiET_S0_
+// CHECK-DAG: define weak_odr i32 @_Z9readCountIiEiv
+
+#endif
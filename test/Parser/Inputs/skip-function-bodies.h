@@ -0,0 +1,35 @@
+// Skipped, so the error isn't diagnosed.
+void outOfLine() {
+  undeclared1();
+}
+
+inline void inlineFunction() {
+  undeclared2(); // expected-error {{use of undeclared identifier 'undeclared2'}}
+}
+
+struct S {
+  void inClass() {
+    undeclared3(); // expected-error {{use of undeclared identifier 'undeclared3'}}
+  }
+  void outOfClass();
+};
+
+// Skipped.
+void S::outOfClass() {
+  undeclared4();
+}
+
+template<typename T> T functionTemplate(T t) {
+  undeclared5(); // expected-error {{use of undeclared identifier 'undeclared5'}}
+  return t;
+}
+
+template<typename T> struct ClassTemplate {
+  void member();
+};
+
+template<typename T> void ClassTemplate<T>::member() {
+  undeclared6(); // expected-error {{use of undeclared identifier 'undeclared6'}}
+}
+
+constexpr int square(int x) { return x * x; }
@@ -0,0 +1,23 @@
+// RUN: %clang_cc1 -fsyntax-only -verify %s
+
+// Disambiguation results are reused when the parser disambiguates the same
+// tokens again, e.g. a declarator inside a statement that was itself
+// disambiguated by tentative parsing.
+
+struct S { S(int); };
+template<typename T> struct A { };
+int n;
+
+void f() {
+  S w(int(n)); // expected-warning {{disambiguated as a function declaration}} expected-note {{add a pair of parentheses}}
+
+  // 'a' is only tentatively declared when 'b(a)' is first disambiguated.
+  S a(n), b(a);
+  b = a;
+
+  A<int(int)> fn;
+  A<int(*)(S(int))> ptr;
+
+  if (int(n) == 0) { }
+  while (int(m) = n) { }
+}
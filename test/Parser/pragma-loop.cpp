@@ -0,0 +1,89 @@
+// RUN: %clang_cc1 -std=c++11 -fsyntax-only -verify %s
+
+#define VECWIDTH 4
+
+void test(int *List, int Length) {
+  int i = 0;
+
+#pragma clang loop vectorize(enable)
+#pragma clang loop interleave(enable)
+#pragma clang loop unroll(enable)
+  while (i + 1 < Length) {
+    List[i] = i;
+  }
+
+#pragma clang loop vectorize_width(4)
+#pragma clang loop interleave_count(8)
+#pragma clang loop unroll_count(3)
+  do {
+    List[i] = i;
+  } while (i < Length);
+
+#pragma clang loop vectorize(disable) interleave(disable) unroll(disable)
+  for (int i = 0; i < Length; i++) {
+    List[i] = i;
+  }
+
+  int Array[4] = { 1, 2, 3, 4 };
+#pragma clang loop vectorize_width(VECWIDTH) interleave_count(2)
+  for (int &X : Array)
+    X *= 2;
+
+#pragma clang loop vectorize_width(4) unroll_count(2)
+  [[]] for (int i = 0; i < Length; i++) {
+    List[i] = i;
+  }
+
+#pragma clang loop // expected-error {{missing option in '#pragma clang loop'}}
+#pragma clang loop badoption(enable) // expected-error {{invalid option 'badoption' in '#pragma clang loop'}}
+#pragma clang loop vectorize enable) // expected-error {{expected '('}}
+#pragma clang loop vectorize(enable // expected-error {{expected ')'}}
+#pragma clang loop unroll_count() // expected-error {{missing argument to '#pragma clang loop' option 'unroll_count'}}
+#pragma clang loop vectorize(enable), // expected-warning {{extra tokens at end of '#pragma clang loop'}}
+  while (i < Length) {
+    List[i] = i;
+  }
+
+#pragma clang loop vectorize(4) // expected-error {{invalid argument to '#pragma clang loop' option 'vectorize'; expected 'enable' or 'disable'}}
+#pragma clang loop unroll(on) // expected-error {{invalid argument to '#pragma clang loop' option 'unroll'; expected 'enable' or 'disable'}}
+#pragma clang loop vectorize_width(enable) // expected-error {{invalid argument to '#pragma clang loop' option 'vectorize_width'; expected a positive integer}}
+#pragma clang loop interleave_count(Length) // expected-error {{invalid argument to '#pragma clang loop' option 'interleave_count'; expected a positive integer}}
+  while (i < Length) {
+    List[i] = i;
+  }
+
+#pragma clang loop vectorize_width(0) // expected-error {{invalid value for '#pragma clang loop' option 'vectorize_width'; expected a positive integer}}
+#pragma clang loop unroll_count(2.5) // expected-error {{invalid value for '#pragma clang loop' option 'unroll_count'; expected a positive integer}}
+#pragma clang loop interleave_count(4294967296) // expected-error {{invalid value for '#pragma clang loop' option 'interleave_count'; expected a positive integer}}
+#pragma clang loop vectorize_width(3) // expected-error {{value of '#pragma clang loop' option 'vectorize_width' must be a power of two}}
+#pragma clang loop interleave_count(6) // expected-error {{value of '#pragma clang loop' option 'interleave_count' must be a power of two}}
+  while (i < Length) {
+    List[i] = i;
+  }
+
+#pragma clang loop vectorize_width(4) vectorize_width(8) // expected-error {{duplicate '#pragma clang loop' directives 'vectorize_width(4)' and 'vectorize_width(8)'}}
+#pragma clang loop unroll(enable)
+#pragma clang loop unroll(disable) // expected-error {{duplicate '#pragma clang loop' directives 'unroll(enable)' and 'unroll(disable)'}}
+  while (i < Length) {
+    List[i] = i;
+  }
+
+#pragma clang loop vectorize(disable)
+#pragma clang loop vectorize_width(4) // expected-error {{incompatible '#pragma clang loop' directives 'vectorize(disable)' and 'vectorize_width(4)'}}
+#pragma clang loop unroll_count(4)
+#pragma clang loop unroll(disable) // expected-error {{incompatible '#pragma clang loop' directives 'unroll_count(4)' and 'unroll(disable)'}}
+  while (i < Length) {
+    List[i] = i;
+  }
+
+#pragma clang loop vectorize(enable) // expected-error {{expected a for, while, or do-while loop to follow '#pragma clang loop'}}
+  int j = Length;
+#pragma clang loop unroll_count(4) // expected-error {{expected a for, while, or do-while loop to follow '#pragma clang loop'}}
+  if (j)
+    List[j] = j;
+#pragma clang loop interleave(enable) // expected-error {{expected a for, while, or do-while loop to follow '#pragma clang loop'}}
+#pragma pack(4)
+  ;
+}
+
+#pragma clang loop vectorize(enable) // expected-error {{expected a for, while, or do-while loop to follow '#pragma clang loop'}}
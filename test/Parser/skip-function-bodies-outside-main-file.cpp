@@ -0,0 +1,17 @@
+// RUN: %clang_cc1 -fsyntax-only -std=c++11 -verify -skip-function-bodies-outside-main-file %s
+// RUN: %clang_cc1 -fsyntax-only -std=c++11 -verify -skip-function-bodies-in %S/Inputs %s
+// RUN: %clang_cc1 -fsyntax-only -std=c++11 -verify -skip-function-bodies-in %S/Inputs/ %s
+// RUN: not %clang_cc1 -fsyntax-only -std=c++11 -skip-function-bodies-in %S/Input %s 2>&1 | FileCheck -check-prefix=PARTIAL %s
+
+// A path only matches whole components of the file name.
+// PARTIAL: use of undeclared identifier 'undeclared1'
+
+// Only the bodies of the non-inline functions in the header are skipped.
+#include "Inputs/skip-function-bodies.h"
+
+void mainFile() {
+  undeclared(); // expected-error {{use of undeclared identifier 'undeclared'}}
+}
+
+int array[square(4)];
+int check[sizeof(array) == 16 * sizeof(int) ? 1 : -1];
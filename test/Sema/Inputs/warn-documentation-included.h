@@ -0,0 +1,7 @@
+int included_before_decl(int a);
+
+// expected-warning@+1 {{parameter 'b' not found in the function declaration}} expected-note@+1 {{did you mean 'c'?}}
+/// \param b Blah blah.
+int included_decl(int c);
+
+/// \param d Blah blah.
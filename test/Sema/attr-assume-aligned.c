@@ -0,0 +1,23 @@
+// RUN: %clang_cc1 -fsyntax-only -verify %s
+
+int n;
+
+void *a1(unsigned long) __attribute__((assume_aligned(32)));
+void *a2(void) __attribute__((assume_aligned(32, 8)));
+void *a3(void) __attribute__((assume_aligned)); // expected-error{{attribute takes at least 1 argument}}
+void *a4(void) __attribute__((assume_aligned(32, 8, 0))); // expected-error{{attribute takes no more than 2 arguments}}
+void *a5(void) __attribute__((assume_aligned(n))); // expected-error{{'assume_aligned' attribute requires parameter 1 to be an integer constant}}
+void *a6(void) __attribute__((assume_aligned(16, n))); // expected-error{{'assume_aligned' attribute requires parameter 2 to be an integer constant}}
+void *a7(void) __attribute__((assume_aligned(12))); // expected-error{{requested alignment is not a power of 2}}
+int a8(void) __attribute__((assume_aligned(16))); // expected-warning{{only applies to functions that return a pointer}}
+int a9 __attribute__((assume_aligned(16))); // expected-warning{{'assume_aligned' attribute only applies to functions and methods}}
+
+void *b1(unsigned long) __attribute__((alloc_align(1)));
+void *b2(int, unsigned) __attribute__((alloc_align(2)));
+void *b3(unsigned) __attribute__((alloc_align)); // expected-error{{'alloc_align' attribute takes one argument}}
+void *b4(unsigned) __attribute__((alloc_align(0))); // expected-error{{attribute parameter 1 is out of bounds}}
+void *b5(unsigned) __attribute__((alloc_align(2))); // expected-error{{attribute parameter 1 is out of bounds}}
+void *b6(void *) __attribute__((alloc_align(1))); // expected-error{{'alloc_align' attribute argument may only refer to a function parameter of integer type}}
+int b7(unsigned) __attribute__((alloc_align(1))); // expected-warning{{only applies to functions that return a pointer}}
+void *b8(int, ...) __attribute__((alloc_align(1)));
+void *b9(int, ...) __attribute__((alloc_align(2))); // expected-error{{attribute parameter 1 is out of bounds}}
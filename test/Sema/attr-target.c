@@ -0,0 +1,23 @@
+// RUN: %clang_cc1 -triple x86_64-unknown-linux -fsyntax-only -verify %s
+// RUN: %clang_cc1 -triple x86_64-apple-darwin10 -fsyntax-only -verify -DDARWIN %s
+
+#ifndef DARWIN
+int __attribute__((target("avx2"))) f1(void);
+int __attribute__((target("sse4.2,no-avx"))) f2(void);
+int __attribute__((target("avx2, fma"))) f3(void);
+int __attribute__((target("avx7"))) f4(void); // expected-warning {{unknown target feature 'avx7' in 'target' attribute; attribute ignored}}
+int __attribute__((target("no-"))) f5(void); // expected-warning {{unknown target feature 'no-' in 'target' attribute; attribute ignored}}
+int __attribute__((target)) f6(void); // expected-error {{'target' attribute takes one argument}}
+int __attribute__((target(3))) f7(void); // expected-error {{'target' attribute requires a string}}
+int x __attribute__((target("avx"))); // expected-warning {{'target' attribute only applies to functions}}
+
+int __attribute__((target_clones("avx2", "default"))) g1(void);
+int __attribute__((target_clones("sse4.2,avx,default"))) g2(void);
+int __attribute__((target_clones("avx2"))) g3(void); // expected-error {{'target_clones' attribute requires a 'default' version}}
+int __attribute__((target_clones("avx2", "default", "avx2"))) g4(void); // expected-error {{version 'avx2' appears more than once in 'target_clones' attribute}}
+int __attribute__((target_clones("avx7", "default"))) g5(void); // expected-warning {{unknown target feature 'avx7' in 'target_clones' attribute; attribute ignored}}
+int __attribute__((target_clones("avx", "default"), target("avx2"))) g6(void); // expected-error {{'target' and target_clones attributes are not compatible}}
+#else
+int __attribute__((target("avx2"))) f1(void);
+int __attribute__((target_clones("avx2", "default"))) g1(void); // expected-error {{'target_clones' attribute is not supported on this target}}
+#endif
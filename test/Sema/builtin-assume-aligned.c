@@ -0,0 +1,19 @@
+// RUN: %clang_cc1 -fsyntax-only -verify %s
+
+int test1(int *a) {
+  a = __builtin_assume_aligned(a, 32);
+  a = __builtin_assume_aligned(a, 32, 0);
+  a = __builtin_assume_aligned(a, 16, 4ull);
+  return a[0];
+}
+
+int test2(int *a, int n) {
+  a = __builtin_assume_aligned(a, 32, n);
+  a = __builtin_assume_aligned(a, n); // expected-error{{argument to '__builtin_assume_aligned' must be a constant integer}}
+  a = __builtin_assume_aligned(a, 31); // expected-error{{requested alignment is not a power of 2}}
+  a = __builtin_assume_aligned(a, 0); // expected-error{{requested alignment is not a power of 2}}
+  a = __builtin_assume_aligned(a, 32, a); // expected-warning{{incompatible pointer to integer conversion}}
+  a = __builtin_assume_aligned(a, 32, 0, 0); // expected-error{{too many arguments to function}}
+  a = __builtin_assume_aligned(a); // expected-error{{too few arguments to function}}
+  return a[0];
+}
@@ -0,0 +1,26 @@
+// RUN: %clang_cc1 -fsyntax-only -verify %s
+// RUN: %clang_cc1 -fsyntax-only -verify -fspell-checking-limit 1 -DTYPO_LIMIT %s
+// RUN: %clang_cc1 -fsyntax-only -verify -fspell-checking-candidate-limit 2 -DCANDIDATE_LIMIT %s
+
+int counter; // expected-note {{'counter' declared here}}
+struct S { int abcdefg; };
+
+#ifdef CANDIDATE_LIMIT
+// Correcting 'abcdef' looks up 'abcdef' itself, then 'abcdefg', which is closer
+// but isn't visible, and only then 'abcdefgh'.
+int abcdefgh;
+#else
+int abcdefgh; // expected-note {{'abcdefgh' declared here}}
+#endif
+
+void f(void) {
+  countr = 1; // expected-error {{use of undeclared identifier 'countr'; did you mean 'counter'?}}
+
+#if defined(TYPO_LIMIT)
+  abcdef = 2; // expected-error {{use of undeclared identifier 'abcdef'}}
+#elif defined(CANDIDATE_LIMIT)
+  abcdef = 2; // expected-error {{use of undeclared identifier 'abcdef'}}
+#else
+  abcdef = 2; // expected-error {{use of undeclared identifier 'abcdef'; did you mean 'abcdefgh'?}}
+#endif
+}
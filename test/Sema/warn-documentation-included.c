@@ -0,0 +1,16 @@
+// RUN: %clang_cc1 -fsyntax-only -Wdocumentation -verify %s
+
+// Doc comments are only attached to declarations in the same file, even when
+// the declaration directly follows the comment in translation unit order.
+
+/// \param x Blah blah.
+#include "Inputs/warn-documentation-included.h"
+
+int main_decl(int y);
+
+// expected-warning@+1 {{parameter 'z' not found in the function declaration}} expected-note@+1 {{did you mean 'w'?}}
+/// \param z Blah blah.
+int main_decl2(int w);
+
+/// \param v Blah blah.
+int main_decl3(int v);
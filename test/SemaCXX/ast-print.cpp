@@ -153,3 +153,20 @@ void test13() {
   __c11_atomic_load(&i, 0);
 }
 
+
+// CHECK: void test14(int *List, int Length) {
+// CHECK:   #pragma clang loop interleave_count(8)
+// CHECK-NEXT:   #pragma clang loop vectorize(enable)
+// CHECK-NEXT:   for (int i = 0; i < Length; i++)
+// CHECK:   #pragma clang loop unroll(disable)
+// CHECK-NEXT:   while (Length)
+void test14(int *List, int Length) {
+#pragma clang loop vectorize(enable)
+#pragma clang loop interleave_count(8)
+  for (int i = 0; i < Length; i++)
+    List[i] = i;
+
+#pragma clang loop unroll(disable)
+  while (Length)
+    List[--Length] = 0;
+}
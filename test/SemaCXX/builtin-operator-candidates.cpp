@@ -0,0 +1,24 @@
+// RUN: %clang_cc1 -fsyntax-only -print-stats %s 2>&1 | FileCheck %s
+
+// Built-in operator candidates are only generated when every operand of class
+// type has a conversion function that could make one of them viable.
+
+struct NoConversions { };
+NoConversions operator+(NoConversions, int);
+
+struct Derived : NoConversions { };
+
+struct ConvertsToInt { operator int() const; };
+
+struct InheritsConversion : ConvertsToInt { };
+
+void f(NoConversions n, Derived d, ConvertsToInt c, InheritsConversion ic,
+       int i) {
+  (void)(n + 1);
+  (void)(d + 1);
+  (void)(c + i);
+  (void)(ic + i);
+}
+
+// CHECK: 4 sets of built-in operator candidates, 2 skipped.
+// CHECK-NEXT: {{[1-9][0-9]*}} built-in candidates generated, {{[0-9]+}} discarded as non-viable.
@@ -0,0 +1,31 @@
+// RUN: %clang_cc1 -fsyntax-only -verify %s
+
+// Implicit conversion sequences are cached across overload resolutions; make
+// sure the cached results don't outlive the declarations they depend on.
+
+struct A {
+  A(int, int);
+};
+void f(A); // expected-note {{candidate function not viable}}
+void f1() { f(1); } // expected-error {{no matching function for call to 'f'}}
+
+// Adding a default argument makes A(int, int) a converting constructor.
+A::A(int, int = 0) { }
+void f2() { f(1); }
+
+struct B { };
+struct D;
+void g(B *); // expected-note {{candidate function not viable}}
+void g1(D *d) { g(d); } // expected-error {{no matching function for call to 'g'}}
+
+// Once D is complete, D * converts to B *.
+struct D : B { };
+void g2(D *d) { g(d); }
+
+template<typename T> struct Wrapper { Wrapper(T); };
+void h(Wrapper<int>);
+void h1() { h(1); h(2); h('c'); }
+
+void p(int *);
+void p(A);
+void p1() { p(0); p(1); } // 0 converts to a pointer, 1 to A
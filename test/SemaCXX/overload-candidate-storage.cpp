@@ -0,0 +1,26 @@
+// RUN: %clang_cc1 -fsyntax-only -verify %s
+
+// Overload candidates, their conversion sequences and the details of failed
+// template argument deductions live in an arena that is reset when the
+// outermost candidate set goes away. Make sure they survive nested overload
+// resolution and the growth of large candidate sets.
+
+template<int N> struct A { };
+
+void f(A<0>); void f(A<1>); void f(A<2>); void f(A<3>); void f(A<4>); void f(A<5>); void f(A<6>); void f(A<7>); void f(A<8>); // expected-note 9 {{candidate function not viable: no known conversion from 'int' to 'A<}}
+void f(A<9>); void f(A<10>); void f(A<11>); void f(A<12>); void f(A<13>); void f(A<14>); void f(A<15>); void f(A<16>); void f(A<17>); // expected-note 9 {{candidate function not viable: no known conversion from 'int' to 'A<}}
+
+void f1() { f(1); } // expected-error {{no matching function for call to 'f'}}
+
+struct B {
+  B(int);
+  B(const char *);
+};
+
+template<typename T> void g(T, T); // expected-note {{candidate template ignored: deduced conflicting types for parameter 'T' ('int' vs. 'void *')}}
+void g(B, B); // expected-note {{candidate function not viable: no known conversion from 'void *' to 'B' for 2nd argument}}
+
+// Converting the arguments to B resolves B's constructors after the
+// deduction failure for the template has been recorded.
+void g1() { g(1, (void *)0); } // expected-error {{no matching function for call to 'g'}}
+void g2() { g(1, "two"); }
@@ -0,0 +1,33 @@
+// RUN: %clang_cc1 -fsyntax-only -ftemplate-profile %s 2>&1 | FileCheck %s
+// RUN: %clang_cc1 -fsyntax-only -ftemplate-profile-trace=%t.json %s
+// RUN: FileCheck -check-prefix=TRACE %s < %t.json
+
+template<int N> struct Fib {
+  static const int value = Fib<N-1>::value + Fib<N-2>::value;
+};
+template<> struct Fib<1> { static const int value = 1; };
+template<> struct Fib<0> { static const int value = 0; };
+
+int fib = Fib<10>::value;
+
+template<typename T> T twice(T t) { return t + t; }
+
+int i = twice(1);
+double d = twice(1.0);
+
+// CHECK: Template instantiation profile
+// CHECK: Total instantiation time: {{.*}} seconds ({{[0-9]+}} instantiations)
+// CHECK: Templates (
+// CHECK: Self (s)  Total (s)    Count   Nested  AST nodes   AST bytes  Name
+// CHECK-DAG: Fib
+// CHECK-DAG: twice
+// CHECK: Specializations (
+// CHECK-DAG: Fib<10>
+// CHECK-DAG: Fib<2>
+// CHECK-DAG: twice<int>
+// CHECK-DAG: twice<double>
+
+// TRACE: {"traceEvents":[
+// TRACE: {"name":"Fib<10>","cat":"instantiation","ph":"X","pid":1,"tid":1,"ts":{{[0-9.]+}},"dur":{{[0-9.]+}},"args":{"template":"Fib","allocations":{{[0-9]+}},"bytes":{{[0-9]+}}}}
+// TRACE: {"name":"twice<int>",{{.*}}"args":{"template":"twice",
+// TRACE: ],"displayTimeUnit":"ms"}
@@ -72,6 +72,8 @@ static unsigned getDefaultParsingOptions() {
     options &= ~CXTranslationUnit_CacheCompletionResults;
   if (getenv("CINDEXTEST_SKIP_FUNCTION_BODIES"))
     options |= CXTranslationUnit_SkipFunctionBodies;
+  if (getenv("CINDEXTEST_SKIP_FUNCTION_BODIES_OUTSIDE_MAIN_FILE"))
+    options |= CXTranslationUnit_SkipFunctionBodiesOutsideMainFile;
   if (getenv("CINDEXTEST_COMPLETION_BRIEF_COMMENTS"))
     options |= CXTranslationUnit_IncludeBriefCommentsInCodeCompletion;
   
@@ -1875,6 +1877,7 @@ int perform_code_completion(int argc, const char **argv, int timing_only) {
   CXTranslationUnit TU = 0;
   unsigned I, Repeats = 1;
   unsigned completionOptions = clang_defaultCodeCompleteOptions();
+  const char *filterPrefix = getenv("CINDEXTEST_COMPLETION_FILTER");
   
   if (getenv("CINDEXTEST_CODE_COMPLETE_PATTERNS"))
     completionOptions |= CXCodeComplete_IncludeCodePatterns;
@@ -1924,6 +1927,19 @@ int perform_code_completion(int argc, const char **argv, int timing_only) {
       clang_disposeCodeCompleteResults(results);
   }
 
+  if (results && filterPrefix) {
+    /* Filter the results as if the prefix were typed one character at a
+       time after completion was triggered. */
+    size_t len = strlen(filterPrefix);
+    char *prefix = (char *)malloc(len + 1);
+    for (I = 1; I <= len; ++I) {
+      memcpy(prefix, filterPrefix, I);
+      prefix[I] = '\0';
+      clang_codeCompleteFilterResults(results, prefix);
+    }
+    free(prefix);
+  }
+
   if (results) {
     unsigned i, n = results->NumResults, containerIsIncomplete = 0;
     unsigned long long contexts;
@@ -1931,8 +1947,10 @@ int perform_code_completion(int argc, const char **argv, int timing_only) {
     CXString objCSelector;
     const char *selectorString;
     if (!timing_only) {      
-      /* Sort the code-completion results based on the typed text. */
-      clang_sortCodeCompletionResults(results->Results, results->NumResults);
+      /* Sort the code-completion results based on the typed text, unless
+         filtering has ranked them. */
+      if (!filterPrefix)
+        clang_sortCodeCompletionResults(results->Results, results->NumResults);
 
       for (i = 0; i != n; ++i)
         print_completion_result(results->Results + i, stdout);
@@ -1856,6 +1856,7 @@ public:
   void VisitLambdaExpr(const LambdaExpr *E);
   void VisitOMPExecutableDirective(const OMPExecutableDirective *D);
   void VisitOMPParallelDirective(const OMPParallelDirective *D);
+  void VisitOMPParallelForDirective(const OMPParallelForDirective *D);
 
 private:
   void AddDeclarationNameInfo(const Stmt *S);
@@ -1926,6 +1927,9 @@ public:
 };
 
 void OMPClauseEnqueue::VisitOMPDefaultClause(const OMPDefaultClause *C) { }
+void OMPClauseEnqueue::VisitOMPScheduleClause(const OMPScheduleClause *C) {
+  Visitor->AddStmt(C->getChunkSize());
+}
 #define PROCESS_OMP_CLAUSE_LIST(Class, Node)                                   \
   for (OMPVarList<Class>::varlist_const_iterator I = Node->varlist_begin(),    \
                                                  E = Node->varlist_end();      \
@@ -2239,6 +2243,11 @@ void EnqueueVisitor::VisitOMPParallelDirective(const OMPParallelDirective *D) {
   VisitOMPExecutableDirective(D);
 }
 
+void EnqueueVisitor::VisitOMPParallelForDirective(
+                                            const OMPParallelForDirective *D) {
+  VisitOMPExecutableDirective(D);
+}
+
 void CursorVisitor::EnqueueWorkList(VisitorWorkList &WL, const Stmt *S) {
   EnqueueVisitor(WL, MakeCXCursor(S, StmtParent, TU,RegionOfInterest)).Visit(S);
 }
@@ -2675,7 +2684,8 @@ static void clang_parseTranslationUnit_Impl(void *UserData) {
     = options & CXTranslationUnit_CacheCompletionResults;
   bool IncludeBriefCommentsInCodeCompletion
     = options & CXTranslationUnit_IncludeBriefCommentsInCodeCompletion;
-  bool SkipFunctionBodies = options & CXTranslationUnit_SkipFunctionBodies;
+  bool SkipFunctionBodies = options & (CXTranslationUnit_SkipFunctionBodies |
+                            CXTranslationUnit_SkipFunctionBodiesOutsideMainFile);
   bool ForSerialization = options & CXTranslationUnit_ForSerialization;
 
   // Configure the diagnostics.
@@ -2741,6 +2751,12 @@ static void clang_parseTranslationUnit_Impl(void *UserData) {
     Args->push_back("-Xclang");
     Args->push_back("-detailed-preprocessing-record");
   }
+
+  // Should only the bodies outside the main file be skipped?
+  if (options & CXTranslationUnit_SkipFunctionBodiesOutsideMainFile) {
+    Args->push_back("-Xclang");
+    Args->push_back("-skip-function-bodies-outside-main-file");
+  }
   
   unsigned NumErrors = Diags->getClient()->getNumErrors();
   OwningPtr<ASTUnit> ErrUnit;
@@ -3815,6 +3831,8 @@ CXString clang_getCursorKindSpelling(enum CXCursorKind Kind) {
     return cxstring::createRef("ModuleImport");
   case CXCursor_OMPParallelDirective:
       return cxstring::createRef("OMPParallelDirective");
+  case CXCursor_OMPParallelForDirective:
+      return cxstring::createRef("OMPParallelForDirective");
   }
 
   llvm_unreachable("Unhandled CXCursorKind");
@@ -21,6 +21,7 @@
 #include "clang/AST/Decl.h"
 #include "clang/AST/DeclObjC.h"
 #include "clang/AST/Type.h"
+#include "clang/Basic/CharInfo.h"
 #include "clang/Basic/FileManager.h"
 #include "clang/Basic/SourceManager.h"
 #include "clang/Frontend/ASTUnit.h"
@@ -36,9 +37,11 @@
 #include "llvm/Support/Program.h"
 #include "llvm/Support/Timer.h"
 #include "llvm/Support/raw_ostream.h"
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <string>
+#include <vector>
 
 
 #ifdef UDP_CODE_COMPLETION_LOGGER
@@ -306,6 +309,14 @@ struct AllocatedCXCodeCompleteResults : public CXCodeCompleteResults {
   /// \brief A string containing the Objective-C selector entered thus far for a
   /// message send.
   std::string Selector;
+
+  /// \brief All of the results produced by code completion, in their original
+  /// order. Captured the first time the results are filtered, since
+  /// filtering rewrites \c Results in place.
+  std::vector<CXCompletionResult> UnfilteredResults;
+
+  /// \brief The prefix that the results were last filtered with.
+  std::string FilterPrefix;
 };
 
 } // end anonymous namespace
@@ -999,3 +1010,162 @@ extern "C" {
     std::stable_sort(Results, Results + NumResults, OrderCompletionResults());
   }
 }
+
+/// \brief Determine whether the character at \p Index in \p Text starts a
+/// word, i.e., it follows punctuation or it is an uppercase letter that
+/// follows a lowercase letter or digit.
+static bool isWordStart(StringRef Text, unsigned Index) {
+  if (Index == 0)
+    return true;
+
+  char Prev = Text[Index - 1], Cur = Text[Index];
+  if (!isAlphanumeric(Prev))
+    return isAlphanumeric(Cur);
+  return isUppercase(Cur) && !isUppercase(Prev);
+}
+
+/// \brief Determine whether the characters of \p Pattern appear in order in
+/// \p Text, ignoring case.
+static bool isFuzzyMatch(StringRef Text, StringRef Pattern) {
+  unsigned TextIdx = 0;
+  for (unsigned PatIdx = 0, N = Pattern.size(); PatIdx != N; ++PatIdx) {
+    char P = toLowercase(Pattern[PatIdx]);
+    while (TextIdx != Text.size() && toLowercase(Text[TextIdx]) != P)
+      ++TextIdx;
+    if (TextIdx == Text.size())
+      return false;
+    ++TextIdx;
+  }
+  return true;
+}
+
+/// \brief Score how well \p Text matches \p Pattern, as described for
+/// clang_getCompletionFuzzyMatchScore().
+static unsigned getFuzzyMatchScore(StringRef Text, StringRef Pattern) {
+  unsigned Score = 1;
+  unsigned TextIdx = 0;
+  for (unsigned PatIdx = 0, N = Pattern.size(); PatIdx != N; ++PatIdx) {
+    char P = toLowercase(Pattern[PatIdx]);
+
+    // Continue the current run of matches if we can. Otherwise, prefer the
+    // start of a word, as long as the rest of the pattern still matches
+    // after it, and fall back to the first occurrence.
+    unsigned Match = Text.size();
+    if (TextIdx != Text.size() && toLowercase(Text[TextIdx]) == P)
+      Match = TextIdx;
+    else {
+      for (unsigned I = TextIdx, E = Text.size(); I != E; ++I) {
+        if (toLowercase(Text[I]) != P)
+          continue;
+        if (Match == Text.size())
+          Match = I;
+        if (isWordStart(Text, I) &&
+            isFuzzyMatch(Text.substr(I + 1), Pattern.substr(PatIdx + 1))) {
+          Match = I;
+          break;
+        }
+      }
+    }
+    if (Match == Text.size())
+      return 0;
+
+    ++Score;
+    if (Match == 0)
+      Score += 6;
+    else if (isWordStart(Text, Match))
+      Score += 4;
+    if (PatIdx != 0 && Match == TextIdx)
+      Score += 3;
+    if (Text[Match] == Pattern[PatIdx])
+      ++Score;
+    TextIdx = Match + 1;
+  }
+
+  return Score;
+}
+
+namespace {
+  typedef std::pair<unsigned, CXCompletionResult> ScoredCompletionResult;
+
+  /// \brief Orders filtered code-completion results by decreasing score, then
+  /// by priority, then by their typed text.
+  struct OrderScoredCompletionResults {
+    bool operator()(const ScoredCompletionResult &X,
+                    const ScoredCompletionResult &Y) const {
+      if (X.first != Y.first)
+        return X.first > Y.first;
+
+      unsigned XPriority
+        = clang_getCompletionPriority(X.second.CompletionString);
+      unsigned YPriority
+        = clang_getCompletionPriority(Y.second.CompletionString);
+      if (XPriority != YPriority)
+        return XPriority < YPriority;
+
+      return OrderCompletionResults()(X.second, Y.second);
+    }
+  };
+}
+
+extern "C" {
+unsigned
+clang_getCompletionFuzzyMatchScore(CXCompletionString completion_string,
+                                   const char *pattern) {
+  CodeCompletionString *CCStr = (CodeCompletionString *)completion_string;
+  if (!CCStr)
+    return 0;
+
+  SmallString<256> Buffer;
+  return getFuzzyMatchScore(GetTypedName(CCStr, Buffer),
+                            pattern ? pattern : "");
+}
+
+unsigned clang_codeCompleteFilterResults(CXCodeCompleteResults *ResultsIn,
+                                         const char *prefix) {
+  AllocatedCXCodeCompleteResults *Results =
+    static_cast<AllocatedCXCodeCompleteResults *>(ResultsIn);
+  if (!Results)
+    return 0;
+
+  StringRef Prefix = prefix ? prefix : "";
+  std::vector<CXCompletionResult> &Unfiltered = Results->UnfilteredResults;
+  if (Unfiltered.empty())
+    Unfiltered.assign(Results->Results,
+                      Results->Results + Results->NumResults);
+
+  if (Prefix.empty()) {
+    std::copy(Unfiltered.begin(), Unfiltered.end(), Results->Results);
+    Results->NumResults = Unfiltered.size();
+    Results->FilterPrefix.clear();
+    return Results->NumResults;
+  }
+
+  // A result that matches a prefix also matches every shorter prefix, so
+  // when the user keeps typing only the results that matched so far need
+  // to be scored again.
+  const CXCompletionResult *Begin = Unfiltered.empty() ? 0 : &Unfiltered[0];
+  const CXCompletionResult *End = Begin + Unfiltered.size();
+  if (!Results->FilterPrefix.empty() &&
+      Prefix.startswith(Results->FilterPrefix)) {
+    Begin = Results->Results;
+    End = Begin + Results->NumResults;
+  }
+
+  SmallVector<ScoredCompletionResult, 64> Matches;
+  for (const CXCompletionResult *R = Begin; R != End; ++R) {
+    SmallString<256> Buffer;
+    StringRef TypedText
+      = GetTypedName((CodeCompletionString *)R->CompletionString, Buffer);
+    if (unsigned Score = getFuzzyMatchScore(TypedText, Prefix))
+      Matches.push_back(std::make_pair(Score, *R));
+  }
+  std::stable_sort(Matches.begin(), Matches.end(),
+                   OrderScoredCompletionResults());
+
+  for (unsigned I = 0, N = Matches.size(); I != N; ++I)
+    Results->Results[I] = Matches[I].second;
+  Results->NumResults = Matches.size();
+  Results->FilterPrefix = Prefix;
+  return Results->NumResults;
+}
+}
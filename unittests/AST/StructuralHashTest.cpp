@@ -0,0 +1,109 @@
+//===- unittests/AST/StructuralHashTest.cpp --- Structural hash tests -----===//
+//
+//                     The LLVM Compiler Infrastructure
+//
+// This file is distributed under the University of Illinois Open Source
+// License. See LICENSE.TXT for details.
+//
+//===----------------------------------------------------------------------===//
+//
+// Unit tests for StructuralHasher.
+//
+//===----------------------------------------------------------------------===//
+
+#include "clang/AST/StructuralHash.h"
+#include "clang/AST/ASTContext.h"
+#include "clang/ASTMatchers/ASTMatchFinder.h"
+#include "clang/Tooling/Tooling.h"
+#include "gtest/gtest.h"
+#include <map>
+
+using namespace clang;
+using namespace clang::ast_matchers;
+using namespace clang::tooling;
+
+namespace {
+
+/// \brief Records the structural hash of the body of every function
+/// definition, keyed by the function's name.
+class HashBodies : public MatchFinder::MatchCallback {
+  unsigned Flags;
+  llvm::OwningPtr<StructuralHasher> Hasher;
+
+public:
+  std::map<std::string, StructuralHash> Hashes;
+
+  explicit HashBodies(unsigned Flags) : Flags(Flags) { }
+
+  virtual void run(const MatchFinder::MatchResult &Result) {
+    const FunctionDecl *FD = Result.Nodes.getNodeAs<FunctionDecl>("fn");
+    if (!FD)
+      return;
+    if (!Hasher)
+      Hasher.reset(new StructuralHasher(*Result.Context, Flags));
+    Hashes[FD->getNameAsString()] = Hasher->hash(FD->getBody());
+  }
+};
+
+bool hashBodies(StringRef Code, HashBodies &Callback) {
+  MatchFinder Finder;
+  Finder.addMatcher(functionDecl(isDefinition()).bind("fn"), &Callback);
+  llvm::OwningPtr<FrontendActionFactory> Factory(
+      newFrontendActionFactory(&Finder));
+  return runToolOnCode(Factory->create(), Code);
+}
+
+const char *const Bodies =
+  "struct S { int m; };"
+  "int g(int);"
+  "int f1(S s) { int x = s.m + 1; return g(x) * 2; }"
+  "int f2(S s) { int x = s.m + 1; return g(x) * 2; }"
+  "int f3(S s) { int y = s.m + 1; return g(y) * 2; }"
+  "int f4(S s) { int x = s.m + 7; return g(x) * 2; }"
+  "int f5(S s) { int x = s.m - 1; return g(x) * 2; }"
+  "int f6(S t) { int x = t.m + 1; return g(x) * 2; }";
+
+} // end anonymous namespace
+
+TEST(StructuralHash, IdenticalBodiesHashEqually) {
+  HashBodies Callback(SHF_Default);
+  ASSERT_TRUE(hashBodies(Bodies, Callback));
+  EXPECT_EQ(Callback.Hashes["f1"], Callback.Hashes["f2"]);
+
+  // Parameters are identified by position, not by name.
+  EXPECT_EQ(Callback.Hashes["f1"], Callback.Hashes["f6"]);
+
+  // Different operators always matter.
+  EXPECT_NE(Callback.Hashes["f1"], Callback.Hashes["f5"]);
+}
+
+TEST(StructuralHash, IsStableAcrossRuns) {
+  HashBodies First(SHF_Default), Second(SHF_Default);
+  ASSERT_TRUE(hashBodies(Bodies, First));
+  ASSERT_TRUE(hashBodies(std::string("int unrelated;") + Bodies, Second));
+  EXPECT_EQ(First.Hashes["f1"], Second.Hashes["f1"]);
+  EXPECT_EQ(First.Hashes["f4"], Second.Hashes["f4"]);
+}
+
+TEST(StructuralHash, IgnoreIdentifiers) {
+  HashBodies Default(SHF_Default);
+  ASSERT_TRUE(hashBodies(Bodies, Default));
+  EXPECT_NE(Default.Hashes["f1"], Default.Hashes["f3"]);
+
+  HashBodies Ignoring(SHF_IgnoreIdentifiers);
+  ASSERT_TRUE(hashBodies(Bodies, Ignoring));
+  EXPECT_EQ(Ignoring.Hashes["f1"], Ignoring.Hashes["f3"]);
+  EXPECT_NE(Ignoring.Hashes["f1"], Ignoring.Hashes["f4"]);
+}
+
+TEST(StructuralHash, IgnoreLiterals) {
+  HashBodies Default(SHF_Default);
+  ASSERT_TRUE(hashBodies(Bodies, Default));
+  EXPECT_NE(Default.Hashes["f1"], Default.Hashes["f4"]);
+
+  HashBodies Ignoring(SHF_IgnoreLiterals);
+  ASSERT_TRUE(hashBodies(Bodies, Ignoring));
+  EXPECT_EQ(Ignoring.Hashes["f1"], Ignoring.Hashes["f4"]);
+  EXPECT_NE(Ignoring.Hashes["f1"], Ignoring.Hashes["f3"]);
+  EXPECT_NE(Ignoring.Hashes["f1"], Ignoring.Hashes["f5"]);
+}
@@ -794,6 +794,14 @@ static void writePrettyPrintFunction(Record &R, std::vector<Argument*> &Args,
     } else if (Variety == "Keyword") {
       Prefix = " ";
       Suffix = "";
+    } else if (Variety == "Pragma") {
+      Prefix = "#pragma ";
+      Suffix = "";
+      std::string Namespace = Spellings[I]->getValueAsString("Namespace");
+      if (Namespace != "") {
+        Spelling += Namespace;
+        Spelling += " ";
+      }
     } else {
       llvm_unreachable("Unknown attribute syntax variety!");
     }
@@ -804,6 +812,15 @@ static void writePrettyPrintFunction(Record &R, std::vector<Argument*> &Args,
       "  case " << I << " : {\n"
       "    OS << \"" + Prefix.str() + Spelling.str();
 
+    // A pragma prints its own arguments, which need not look like a call.
+    if (Variety == "Pragma") {
+      OS << " \";\n";
+      OS << "    printPrettyPragma(OS, Policy);\n";
+      OS << "    break;\n";
+      OS << "  }\n";
+      continue;
+    }
+
     if (Args.size()) OS << "(";
     if (Spelling == "availability") {
       writeAvailabilityValue(OS);
@@ -838,7 +855,8 @@ static unsigned getSpellingListIndex(const std::vector<Record*> &SpellingList,
     Record *S = SpellingList[Index];
     if (S->getValueAsString("Variety") != Spelling.getValueAsString("Variety"))
       continue;
-    if (S->getValueAsString("Variety") == "CXX11" &&
+    if ((S->getValueAsString("Variety") == "CXX11" ||
+         S->getValueAsString("Variety") == "Pragma") &&
         S->getValueAsString("Namespace") !=
         Spelling.getValueAsString("Namespace"))
       continue;
@@ -1272,7 +1290,8 @@ void EmitClangAttrSpellingListIndex(RecordKeeper &Records, raw_ostream &OS) {
       OS << "  case AT_" << R.getName() << " : {\n";
       for (unsigned I = 0; I < Spellings.size(); ++ I) {
         SmallString<16> Namespace;
-        if (Spellings[I]->getValueAsString("Variety") == "CXX11")
+        std::string Variety = Spellings[I]->getValueAsString("Variety");
+        if (Variety == "CXX11" || Variety == "Pragma")
           Namespace = Spellings[I]->getValueAsString("Namespace");
         else
           Namespace = "";
@@ -1285,6 +1304,7 @@ void EmitClangAttrSpellingListIndex(RecordKeeper &Records, raw_ostream &OS) {
             .Case("CXX11", 1)
             .Case("Declspec", 2)
             .Case("Keyword", 3)
+            .Case("Pragma", 4)
             .Default(0)
           << " && Scope == \"" << Namespace << "\")\n"
           << "        return " << I << ";\n";
@@ -1467,6 +1487,12 @@ void EmitClangAttrParsedAttrKinds(RecordKeeper &Records, raw_ostream &OS) {
         if ((*I)->getValueAsString("Variety") == "CXX11") {
           Spelling += (*I)->getValueAsString("Namespace");
           Spelling += "::";
+        } else if ((*I)->getValueAsString("Variety") == "Pragma") {
+          // Pragma attributes are looked up as "#pragma namespace name", which
+          // no other attribute syntax can produce.
+          Spelling += "#pragma ";
+          Spelling += (*I)->getValueAsString("Namespace");
+          Spelling += " ";
         }
         Spelling += NormalizeAttrSpelling(RawSpelling);
 
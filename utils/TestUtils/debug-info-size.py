@@ -0,0 +1,81 @@
+#!/usr/bin/env python
+
+"""
+Measure how much smaller -fno-emit-class-debug-always makes the debug
+information of a set of C++ sources.
+
+Compiles each source file with '-g -c', with and without the option, and
+prints the total size of the .debug_* sections of the objects, as reported by
+'size -A', and of the whole objects.
+
+  debug-info-size.py --clang=path/to/clang file1.cpp [file2.cpp ...] \
+      [-- extra compiler arguments]
+"""
+
+from __future__ import print_function
+
+import optparse
+import os
+import subprocess
+import sys
+import tempfile
+
+def section_sizes(size_tool, path):
+    """Return the total size of the debug sections and of all sections."""
+    out = subprocess.check_output([size_tool, '-A', path]).decode()
+    debug = total = 0
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) != 3 or not fields[1].isdigit():
+            continue
+        total += int(fields[1])
+        if fields[0].startswith('.debug_') or fields[0].startswith('.zdebug_'):
+            debug += int(fields[1])
+    return debug, total
+
+def compile_all(clang, sources, outdir, args):
+    objects = []
+    for i, source in enumerate(sources):
+        obj = os.path.join(outdir, '%d.o' % i)
+        subprocess.check_call([clang, '-g', '-c', '-o', obj, source] + args)
+        objects.append(obj)
+    return objects
+
+def main():
+    parser = optparse.OptionParser(usage=__doc__.strip())
+    parser.add_option('--clang', default='clang++',
+                      help='clang binary to run [%default]')
+    parser.add_option('--size', default='size',
+                      help='size binary used to measure the objects '
+                           '[%default]')
+    opts, args = parser.parse_args()
+
+    extra = []
+    if '--' in sys.argv:
+        extra = sys.argv[sys.argv.index('--') + 1:]
+        args = args[:len(args) - len(extra)]
+    if not args:
+        parser.error('no source files given')
+
+    tmpdir = tempfile.mkdtemp(prefix='debug-info-size')
+    results = []
+    for name, flags in [('always', []),
+                        ('home', ['-fno-emit-class-debug-always'])]:
+        outdir = os.path.join(tmpdir, name)
+        os.mkdir(outdir)
+        debug = total = 0
+        for obj in compile_all(opts.clang, args, outdir, flags + extra):
+            d, t = section_sizes(opts.size, obj)
+            debug += d
+            total += t
+        results.append((name, debug, total))
+        print('%-8s debug sections: %10d bytes, objects: %10d bytes' %
+              (name, debug, total))
+
+    before, after = results[0][1], results[1][1]
+    if before:
+        print('debug sections are %.1f%% smaller' %
+              (100.0 * (before - after) / before))
+
+if __name__ == '__main__':
+    main()
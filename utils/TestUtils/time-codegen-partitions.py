@@ -0,0 +1,106 @@
+#!/usr/bin/env python
+
+"""
+Time 'clang -cc1 -emit-obj' with different values of -codegen-partitions.
+
+Compiles the given source file (or, without one, a generated translation unit
+with many independent functions) once for each partition count, prints the
+wall-clock time of the best of several runs, and checks that every object
+defines the same symbols as the one generated in a single part.
+
+  time-codegen-partitions.py --clang=path/to/clang --linker=ld -j 1,2,4,8 \
+      [file.c] [-- extra cc1 arguments]
+"""
+
+from __future__ import print_function
+
+import optparse
+import os
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+def generate_source(path, num_functions):
+    f = open(path, 'w')
+    f.write('static int table[256];\n')
+    for i in range(num_functions):
+        f.write('int f%d(int *a, int n) {\n' % i)
+        f.write('  int s = %d;\n' % i)
+        f.write('  for (int j = 0; j < n; ++j) {\n')
+        f.write('    s = s * 31 + a[j] * %d;\n' % (i + 1))
+        f.write('    if (s & %d) s ^= table[(s >> 3) & 255];\n' % (i % 7 + 1))
+        f.write('    switch (s & 7) {\n')
+        for k in range(8):
+            f.write('    case %d: a[j] += s >> %d; break;\n' % (k, k))
+        f.write('    }\n')
+        f.write('  }\n')
+        f.write('  return s;\n')
+        f.write('}\n')
+    f.close()
+
+def defined_symbols(nm, path):
+    out = subprocess.check_output([nm, path]).decode()
+    symbols = set()
+    for line in out.splitlines():
+        fields = line.split()
+        if len(fields) == 3:
+            symbols.add((fields[1], fields[2]))
+    return symbols
+
+def main():
+    parser = optparse.OptionParser(usage=__doc__.strip())
+    parser.add_option('--clang', default='clang',
+                      help='clang binary to run [%default]')
+    parser.add_option('--linker', default='ld',
+                      help='linker that merges the parts [%default]')
+    parser.add_option('--nm', default='nm',
+                      help='nm binary used to compare the objects [%default]')
+    parser.add_option('-j', '--partitions', default='1,2,4,8',
+                      help='comma-separated partition counts [%default]')
+    parser.add_option('-n', '--functions', type='int', default=2000,
+                      help='functions in the generated source [%default]')
+    parser.add_option('-r', '--runs', type='int', default=3,
+                      help='runs per partition count [%default]')
+    parser.add_option('-O', dest='opt', default='2',
+                      help='optimization level [%default]')
+    opts, args = parser.parse_args()
+
+    extra = []
+    if '--' in sys.argv:
+        extra = sys.argv[sys.argv.index('--') + 1:]
+        args = args[:len(args) - len(extra)]
+
+    tmpdir = tempfile.mkdtemp(prefix='codegen-partitions')
+    try:
+        if args:
+            source = args[0]
+        else:
+            source = os.path.join(tmpdir, 'generated.c')
+            generate_source(source, opts.functions)
+
+        reference = None
+        for count in [int(p) for p in opts.partitions.split(',')]:
+            obj = os.path.join(tmpdir, 'part%d.o' % count)
+            cmd = [opts.clang, '-cc1', '-O' + opts.opt, '-emit-obj',
+                   '-codegen-partitions', str(count),
+                   '-codegen-partitions-linker', opts.linker,
+                   '-o', obj, source] + extra
+            best = None
+            for _ in range(opts.runs):
+                start = time.time()
+                subprocess.check_call(cmd)
+                elapsed = time.time() - start
+                best = elapsed if best is None else min(best, elapsed)
+
+            symbols = defined_symbols(opts.nm, obj)
+            if reference is None:
+                reference = symbols
+            status = 'ok' if symbols == reference else 'SYMBOLS DIFFER'
+            print('%3d part(s): %8.3fs  %s' % (count, best, status))
+    finally:
+        shutil.rmtree(tmpdir, ignore_errors=True)
+
+if __name__ == '__main__':
+    main()
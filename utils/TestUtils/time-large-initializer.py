@@ -0,0 +1,97 @@
+#!/usr/bin/env python
+
+"""
+Measure the time and peak memory 'clang -cc1' needs for a large array
+initializer, like the tables generated by 'xxd -i'.
+
+Generates a translation unit with an 'unsigned char' array of the given size
+(50MB by default) and compiles it with each of the given clang binaries,
+printing the wall-clock time of the best of several runs and the peak
+resident set size.
+
+  time-large-initializer.py --clang=path/to/clang[,path/to/other/clang] \
+      [--size-mb=50] [-- extra cc1 arguments]
+"""
+
+from __future__ import print_function
+
+import optparse
+import os
+import shutil
+import sys
+import tempfile
+import time
+
+def generate_source(path, num_bytes, element_type):
+    f = open(path, 'w')
+    f.write('%s data[] = {\n' % element_type)
+    line = []
+    for byte in bytearray(os.urandom(num_bytes)):
+        line.append('0x%02x,' % byte)
+        if len(line) == 16:
+            f.write('  %s\n' % ' '.join(line))
+            line = []
+    if line:
+        f.write('  %s\n' % ' '.join(line))
+    f.write('};\n')
+    f.write('unsigned long data_len = sizeof(data);\n')
+    f.close()
+
+def run(cmd):
+    """Run cmd, returning the wall-clock time and the peak RSS in MB."""
+    pid = os.fork()
+    if pid == 0:
+        try:
+            os.execvp(cmd[0], cmd)
+        finally:
+            os._exit(127)
+    start = time.time()
+    _, status, usage = os.wait4(pid, 0)
+    elapsed = time.time() - start
+    if status != 0:
+        raise SystemExit('error: %s failed' % ' '.join(cmd))
+    # ru_maxrss is in kilobytes on Linux and in bytes on Darwin.
+    scale = 1024.0 * 1024.0 if sys.platform == 'darwin' else 1024.0
+    return elapsed, usage.ru_maxrss / scale
+
+def main():
+    parser = optparse.OptionParser(usage=__doc__.strip())
+    parser.add_option('--clang', default='clang',
+                      help='comma-separated clang binaries to run [%default]')
+    parser.add_option('-s', '--size-mb', type='float', default=50,
+                      help='size of the generated array in MB [%default]')
+    parser.add_option('-t', '--type', default='unsigned char',
+                      help='element type of the generated array [%default]')
+    parser.add_option('-r', '--runs', type='int', default=1,
+                      help='runs per clang binary [%default]')
+    parser.add_option('--emit', default='-emit-obj',
+                      help='cc1 action to perform [%default]')
+    opts, args = parser.parse_args()
+
+    extra = []
+    if '--' in sys.argv:
+        extra = sys.argv[sys.argv.index('--') + 1:]
+        args = args[:len(args) - len(extra)]
+
+    tmpdir = tempfile.mkdtemp(prefix='large-initializer')
+    try:
+        source = os.path.join(tmpdir, 'generated.c')
+        generate_source(source, int(opts.size_mb * 1024 * 1024), opts.type)
+        print('%s: %.1fMB of source' %
+              (source, os.path.getsize(source) / (1024.0 * 1024.0)))
+
+        for clang in opts.clang.split(','):
+            out = os.path.join(tmpdir, 'generated.out')
+            cmd = [clang, '-cc1', opts.emit, '-o', out, source] + extra
+            best = None
+            peak = 0
+            for _ in range(opts.runs):
+                elapsed, rss = run(cmd)
+                best = elapsed if best is None else min(best, elapsed)
+                peak = max(peak, rss)
+            print('%-40s %8.2fs %10.1fMB' % (clang, best, peak))
+    finally:
+        shutil.rmtree(tmpdir)
+
+if __name__ == '__main__':
+    main()
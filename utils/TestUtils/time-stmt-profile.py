@@ -0,0 +1,116 @@
+#!/usr/bin/env python
+
+"""
+Measure the time 'clang -cc1 -fsyntax-only' spends on C++ code that uniques
+many dependent types, each of which profiles its expressions with
+Stmt::Profile, and compare hashing every function body of that code with
+StructuralHasher and with Stmt::Profile.
+
+Generates a translation unit of function templates whose return types are
+'decltype' expressions, class templates with dependently-sized arrays, and
+ordinary functions. Each template is redeclared, so its dependent types are
+looked up again. Each clang binary compiles it several times with
+-fsyntax-only, and then with -ast-hash-timing, which hashes the bodies both
+ways. The script prints the wall-clock times of the best runs.
+
+  time-stmt-profile.py --clang=path/to/clang[,path/to/other/clang] \
+      [--templates=20000] [-- extra cc1 arguments]
+"""
+
+from __future__ import print_function
+
+import optparse
+import os
+import re
+import shutil
+import subprocess
+import sys
+import tempfile
+import time
+
+def generate_source(path, num_templates):
+    f = open(path, 'w')
+    for i in range(num_templates):
+        f.write('template<typename T> struct S%d {\n' % i)
+        f.write('  char a[sizeof(T) * %d + (sizeof(T) > 4 ? 1 : 2)];\n' % i)
+        f.write('};\n')
+        decl = ('template<typename T, typename U> auto f%d(T t, U u) '
+                '-> decltype(t * %d + u[sizeof(T)] - (t < u[0] ? t : %d))'
+                % (i, i, i))
+        f.write('%s;\n%s;\n' % (decl, decl))
+        f.write('%s { return t * %d + u[sizeof(T)] - (t < u[0] ? t : %d); }\n'
+                % (decl, i, i))
+        f.write('int g%d(int *p, int n) {\n'
+                '  int s = 0;\n'
+                '  for (int j = 0; j < n; ++j)\n'
+                '    s += p[j] * %d;\n'
+                '  return s;\n'
+                '}\n' % (i, i))
+    f.close()
+
+def time_hashing(cmd):
+    """Return the seconds -ast-hash-timing reports for StructuralHasher and
+    for Stmt::Profile."""
+    proc = subprocess.Popen(cmd, stderr=subprocess.PIPE,
+                            universal_newlines=True)
+    _, err = proc.communicate()
+    if proc.returncode != 0:
+        raise SystemExit('error: %s failed' % ' '.join(cmd))
+    times = {}
+    for line in err.splitlines():
+        m = re.match(r'\s*([0-9.]+)s with (StructuralHasher|Stmt::Profile)',
+                     line)
+        if m:
+            times[m.group(2)] = float(m.group(1))
+    if len(times) != 2:
+        raise SystemExit('error: no timings from %s' % ' '.join(cmd))
+    return times['StructuralHasher'], times['Stmt::Profile']
+
+def main():
+    parser = optparse.OptionParser(usage=__doc__.strip())
+    parser.add_option('--clang', default='clang',
+                      help='comma-separated clang binaries to run [%default]')
+    parser.add_option('-n', '--templates', type='int', default=20000,
+                      help='number of generated templates [%default]')
+    parser.add_option('-r', '--runs', type='int', default=3,
+                      help='runs per clang binary [%default]')
+    opts, args = parser.parse_args()
+
+    extra = []
+    if '--' in sys.argv:
+        extra = sys.argv[sys.argv.index('--') + 1:]
+        args = args[:len(args) - len(extra)]
+
+    tmpdir = tempfile.mkdtemp(prefix='stmt-profile')
+    try:
+        source = os.path.join(tmpdir, 'generated.cpp')
+        generate_source(source, opts.templates)
+
+        for clang in opts.clang.split(','):
+            cmd = [clang, '-cc1', '-fsyntax-only', '-std=c++11', source]
+            cmd += extra
+            best = None
+            for _ in range(opts.runs):
+                start = time.time()
+                if subprocess.call(cmd) != 0:
+                    raise SystemExit('error: %s failed' % ' '.join(cmd))
+                elapsed = time.time() - start
+                best = elapsed if best is None else min(best, elapsed)
+            print('%-40s %8.2fs' % (clang, best))
+
+        print('\n%-40s %17s %17s' % ('hashing every function body',
+                                      'StructuralHasher', 'Stmt::Profile'))
+        for clang in opts.clang.split(','):
+            cmd = [clang, '-cc1', '-ast-hash-timing', '-std=c++11', source]
+            cmd += extra
+            best = None
+            for _ in range(opts.runs):
+                times = time_hashing(cmd)
+                best = times if best is None else (min(best[0], times[0]),
+                                                   min(best[1], times[1]))
+            print('%-40s %16.3fs %16.3fs' % (clang, best[0], best[1]))
+    finally:
+        shutil.rmtree(tmpdir)
+
+if __name__ == '__main__':
+    main()
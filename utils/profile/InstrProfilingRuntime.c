@@ -0,0 +1,178 @@
+/*===- InstrProfilingRuntime.c - Runtime for -fprofile-instr-generate -----===*\
+|*
+|*                     The LLVM Compiler Infrastructure
+|*
+|* This file is distributed under the University of Illinois Open Source
+|* License. See LICENSE.TXT for details.
+|*
+|*===----------------------------------------------------------------------===*|
+|*
+|* A minimal runtime for programs built with -fprofile-instr-generate. Every
+|* instrumented translation unit registers the counters of its functions from a
+|* global constructor; when the program exits, the counts are written to the
+|* file named by the LLVM_PROFILE_FILE environment variable, or to
+|* "default.profdata", in the text format read by -fprofile-instr-use:
+|*
+|*   <function name>
+|*   <structural hash of the function>
+|*   <number of counters>
+|*   <count>
+|*   ...
+|*   <blank line>
+|*
+|* Functions emitted in several translation units share their counters, and
+|* are registered once per translation unit; they are written once. Records
+|* with the same name and hash but distinct counters are summed, so the output
+|* never names a version of a function twice.
+|*
+|* Build and link it into the instrumented program:
+|*
+|*   clang -fprofile-instr-generate -c foo.c
+|*   clang -c InstrProfilingRuntime.c
+|*   clang foo.o InstrProfilingRuntime.o -o foo
+|*   ./foo
+|*   merge-instr-profiles.py -o foo.profdata default.profdata ...
+|*   clang -O2 -fprofile-instr-use=foo.profdata -c foo.c
+|*
+\*===----------------------------------------------------------------------===*/
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct FunctionRecord {
+  const char *Name;
+  uint64_t Hash;
+  uint32_t NumCounters;
+  uint64_t *Counters;
+} FunctionRecord;
+
+static FunctionRecord *Functions = 0;
+static size_t NumFunctions = 0;
+static size_t FunctionCapacity = 0;
+
+/* An open-addressing set of the registered counter arrays, so registering a
+ * function does not scan the functions registered before it. Its size is
+ * always a power of two and at least twice the number of functions. */
+static uint64_t **RegisteredCounters = 0;
+static size_t RegisteredCapacity = 0;
+
+static size_t hashCounters(const uint64_t *Counters, size_t Capacity) {
+  uintptr_t Key = (uintptr_t)Counters;
+  Key ^= Key >> 17;
+  Key *= (uintptr_t)0x9E3779B97F4A7C15ULL;
+  Key ^= Key >> 29;
+  return (size_t)Key & (Capacity - 1);
+}
+
+/* Returns the slot of Counters in the set, or the empty slot where it
+ * belongs. */
+static uint64_t **findCounters(uint64_t **Set, size_t Capacity,
+                               const uint64_t *Counters) {
+  size_t I = hashCounters(Counters, Capacity);
+  while (Set[I] && Set[I] != Counters)
+    I = (I + 1) & (Capacity - 1);
+  return &Set[I];
+}
+
+static int growRegisteredCounters(void) {
+  size_t NewCapacity = RegisteredCapacity ? RegisteredCapacity * 2 : 64;
+  uint64_t **NewSet = (uint64_t **)calloc(NewCapacity, sizeof(uint64_t *));
+  size_t I;
+
+  if (!NewSet)
+    return 0;
+  for (I = 0; I != RegisteredCapacity; ++I)
+    if (RegisteredCounters[I])
+      *findCounters(NewSet, NewCapacity, RegisteredCounters[I]) =
+          RegisteredCounters[I];
+  free(RegisteredCounters);
+  RegisteredCounters = NewSet;
+  RegisteredCapacity = NewCapacity;
+  return 1;
+}
+
+static int compareRecords(const void *LHS, const void *RHS) {
+  const FunctionRecord *L = (const FunctionRecord *)LHS;
+  const FunctionRecord *R = (const FunctionRecord *)RHS;
+  int Cmp = strcmp(L->Name, R->Name);
+  if (Cmp)
+    return Cmp;
+  if (L->Hash != R->Hash)
+    return L->Hash < R->Hash ? -1 : 1;
+  return 0;
+}
+
+static void writeProfile(void) {
+  const char *Path = getenv("LLVM_PROFILE_FILE");
+  FILE *F;
+  size_t I, J;
+  uint32_t C;
+
+  if (!Path || !*Path)
+    Path = "default.profdata";
+  F = fopen(Path, "w");
+  if (!F) {
+    fprintf(stderr, "profiling: cannot open %s for writing\n", Path);
+    return;
+  }
+
+  /* Sort the records so that versions of a function registered with their
+   * own counters are adjacent, and write each version once with the sum of
+   * their counts. */
+  qsort(Functions, NumFunctions, sizeof(FunctionRecord), compareRecords);
+  for (I = 0; I != NumFunctions; I = J) {
+    const FunctionRecord *R = &Functions[I];
+    fprintf(F, "%s\n%llu\n%u\n", R->Name, (unsigned long long)R->Hash,
+            R->NumCounters);
+    for (C = 0; C != R->NumCounters; ++C) {
+      uint64_t Count = R->Counters[C];
+      for (J = I + 1; J != NumFunctions && !compareRecords(R, &Functions[J]);
+           ++J)
+        if (Functions[J].NumCounters == R->NumCounters)
+          Count += Functions[J].Counters[C];
+      fprintf(F, "%llu\n", (unsigned long long)Count);
+    }
+    for (J = I + 1; J != NumFunctions && !compareRecords(R, &Functions[J]); ++J)
+      if (Functions[J].NumCounters != R->NumCounters)
+        fprintf(stderr, "profiling: dropping counters of %s that do not "
+                        "match its other definitions\n", R->Name);
+    fprintf(F, "\n");
+  }
+  fclose(F);
+}
+
+void __llvm_profile_register_function(const char *Name, uint64_t Hash,
+                                      uint32_t NumCounters,
+                                      uint64_t *Counters) {
+  uint64_t **Slot;
+  FunctionRecord *R;
+
+  if (2 * (NumFunctions + 1) > RegisteredCapacity &&
+      !growRegisteredCounters())
+    return;
+  Slot = findCounters(RegisteredCounters, RegisteredCapacity, Counters);
+  if (*Slot)
+    return;
+
+  if (NumFunctions == FunctionCapacity) {
+    size_t NewCapacity = FunctionCapacity ? FunctionCapacity * 2 : 32;
+    FunctionRecord *NewFunctions = (FunctionRecord *)realloc(
+        Functions, NewCapacity * sizeof(FunctionRecord));
+    if (!NewFunctions)
+      return;
+    Functions = NewFunctions;
+    FunctionCapacity = NewCapacity;
+  }
+
+  *Slot = Counters;
+  R = &Functions[NumFunctions++];
+  R->Name = Name;
+  R->Hash = Hash;
+  R->NumCounters = NumCounters;
+  R->Counters = Counters;
+
+  if (NumFunctions == 1)
+    atexit(writeProfile);
+}
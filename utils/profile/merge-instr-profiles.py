@@ -0,0 +1,84 @@
+#!/usr/bin/env python
+
+"""
+Merge profiles written by programs built with -fprofile-instr-generate.
+
+Functions are identified by their name and structural hash, as
+-fprofile-instr-use matches them. The counts of a function that appears in several input profiles
+are summed, so the result describes all of the runs. Like the compiler, the
+script rejects a profile that names the same version of a function twice, and
+a function whose number of counters differs between the inputs cannot be
+merged.
+
+Usage: merge-instr-profiles.py -o <output> <input>...
+"""
+
+import optparse
+import sys
+
+def readProfile(path, functions):
+    with open(path) as f:
+        lines = [line.rstrip('\r\n') for line in f]
+
+    seen = set()
+    i = 0
+    while i < len(lines):
+        name = lines[i]
+        i += 1
+        if not name:
+            continue
+        try:
+            hash = int(lines[i])
+            numCounters = int(lines[i + 1])
+            counts = [int(line) for line in lines[i + 2:i + 2 + numCounters]]
+        except (IndexError, ValueError):
+            raise ValueError('%s:%d: malformed profile data' % (path, i + 1))
+        if len(counts) != numCounters or numCounters == 0:
+            raise ValueError('%s:%d: truncated profile data' % (path, i + 1))
+        i += 2 + numCounters
+
+        key = (name, hash)
+        if key in seen:
+            raise ValueError('%s: duplicate function %r' % (path, name))
+        seen.add(key)
+
+        existing = functions.get(key)
+        if existing is None:
+            functions[key] = counts
+        elif len(existing) != numCounters:
+            raise ValueError('%s: counters of function %r do not match the '
+                             'other profiles' % (path, name))
+        else:
+            for j in range(numCounters):
+                existing[j] += counts[j]
+
+def writeProfile(path, functions):
+    with open(path, 'w') as f:
+        for name, hash in sorted(functions):
+            counts = functions[(name, hash)]
+            f.write('%s\n%d\n%d\n' % (name, hash, len(counts)))
+            for count in counts:
+                f.write('%d\n' % count)
+            f.write('\n')
+
+def main():
+    parser = optparse.OptionParser(usage='%prog -o <output> <input>...')
+    parser.add_option('-o', dest='output', help='write the merged profile to '
+                      'this file')
+    opts, args = parser.parse_args()
+    if not opts.output or not args:
+        parser.error('expected an output file and at least one input')
+
+    functions = {}
+    try:
+        for path in args:
+            readProfile(path, functions)
+    except (IOError, ValueError) as e:
+        sys.stderr.write('error: %s\n' % e)
+        return 1
+
+    writeProfile(opts.output, functions)
+    return 0
+
+if __name__ == '__main__':
+    sys.exit(main())